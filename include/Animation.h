@@ -0,0 +1,93 @@
+#pragma once
+
+#include "JobSystem.h"
+#include "MeshData.h"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// --- SKELETAL ANIMATION (CPU thuần, không OpenGL) ---
+// Mỗi frame, cho từng nhân vật:
+//   1. Lấy mẫu clip: mỗi track nhớ key index của lần trước, thời gian tăng thì chỉ bước tới
+//      (trung bình O(1)); chỉ quay về đầu khi clip loop hoặc thời gian lùi.
+//   2. Trộn hai pose local dạng SoA (mảng riêng từng thành phần -> vòng lặp phẳng, compiler vector hoá).
+//   3. Local TRS -> matrix, world theo thứ tự pre-order của node (parent luôn tính trước).
+//   4. Skinning palette theo bảng SkinJoint.
+// Nhiều nhân vật chia đều cho JobSystem, mỗi nhân vật chỉ ghi vào vùng output của nó.
+
+// Pose local theo node, SoA
+struct LocalPose {
+    std::vector<float> tx, ty, tz;
+    std::vector<float> rx, ry, rz, rw;   // quaternion
+    std::vector<float> sx, sy, sz;
+
+    void Resize(size_t nodeCount);
+    size_t Size() const { return tx.size(); }
+};
+
+// Đầu phát của một clip: thời gian + key index đã dùng lần trước cho từng (channel, track)
+struct AnimationCursor {
+    int clip = -1;                  // -1 = đứng ở bind pose
+    float time = 0.0f;              // giây, trong [0, duration)
+    std::vector<uint32_t> keys;     // channelCount * kTrackCount, gắn với cachedClip
+    int cachedClip = -1;
+};
+
+struct CharacterAnimation {
+    AnimationCursor base;
+    AnimationCursor blend;          // clip thứ hai, trộn với base theo blendWeight
+    float blendWeight = 0.0f;       // 0 = chỉ base
+    float speed = 1.0f;
+};
+
+class AnimationRig {
+public:
+    // Copy dữ liệu (view có thể trỏ vào cache sắp unmap). Channel / joint trỏ ra ngoài node bị bỏ.
+    void Build(const MeshView& mesh);
+    void Clear();
+
+    size_t NodeCount() const { return m_Parent.size(); }
+    size_t JointCount() const { return m_Joints.size(); }
+    size_t ClipCount() const { return m_Clips.size(); }
+    const AnimationClip& Clip(size_t clip) const { return m_Clips[clip]; }
+    const LocalPose& BindPose() const { return m_BindPose; }
+    // Node có channel trong ít nhất một clip (các node khác luôn giữ local của scene)
+    const std::vector<uint32_t>& AnimatedNodes() const { return m_AnimatedNodes; }
+
+    // Tiến thời gian (loop theo duration của clip)
+    void Advance(AnimationCursor& cursor, float dt) const;
+    // Ghi track của clip vào pose; node không có channel giữ giá trị đang có trong pose
+    void Sample(AnimationCursor& cursor, LocalPose& pose) const;
+    // Bản đối chiếu: binary search từng key, không cache
+    void SampleReference(int clip, float time, LocalPose& pose) const;
+
+    void ComputeLocalMatrices(const LocalPose& pose, glm::mat4* outLocal) const;
+    void ComputeWorldMatrices(const glm::mat4* local, glm::mat4* outWorld) const;
+    void ComputeSkinMatrices(const glm::mat4* world, glm::mat4* outPalette) const;
+
+    // Toàn bộ pipeline cho count nhân vật, song song theo nhân vật.
+    // outWorld: count * NodeCount(), outPalette: count * JointCount(); outLocal có thể nullptr.
+    void Evaluate(CharacterAnimation* characters, size_t count, float dt, glm::mat4* outLocal, glm::mat4* outWorld,
+                  glm::mat4* outPalette, JobSystem& jobs = JobSystem::Global()) const;
+
+private:
+    void SampleTrack(const AnimationChannel& channel, unsigned int track, uint32_t& cursor, float time,
+                     float* outValue) const;
+
+    std::vector<int> m_Parent;
+    std::vector<glm::mat4> m_BindLocal;     // local gốc của scene, dùng nguyên cho node không animate
+    std::vector<uint8_t> m_Animated;
+    std::vector<uint32_t> m_AnimatedNodes;
+    LocalPose m_BindPose;
+    std::vector<SkinJoint> m_Joints;
+    std::vector<AnimationClip> m_Clips;
+    std::vector<AnimationChannel> m_Channels;
+    std::vector<AnimationKey> m_Keys;
+};
+
+// out = a trộn b theo weight (lerp translation / scale, nlerp rotation theo bán cầu gần nhất).
+// out có thể trùng a.
+void BlendPoses(const LocalPose& a, const LocalPose& b, float weight, LocalPose& out);
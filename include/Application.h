@@ -14,18 +14,39 @@
 #include "imgui_impl_glfw.h" // Thay imgui_impl_sdl2
 #include "imgui_impl_opengl3.h"
 
-// --- ASSIMP ---
-#include <assimp/Importer.hpp>
-#include <assimp/scene.h>
-#include <assimp/postprocess.h>
+// --- MODEL ---
+#include "Animation.h"
+#include "AsyncModelLoader.h"
+#include "Culling.h"
+#include "DrawBatch.h"
+#include "FrameBenchmark.h"
+#include "FileWatcher.h"
+#include "FrameScheduler.h"
+#include "GLRenderBackend.h"
+#include "GpuProfiler.h"
+#include "LodSelection.h"
+#include "MeshData.h"
+#include "ModelSubmit.h"
+#include "ModelUploader.h"
+#include "SceneGraph.h"
+#include "ShaderProgram.h"
+#include "Skinning.h"
+#include "TextureManager.h"
+#include "VertexFormat.h"
 
 #include <vector>
 #include <string>
 
-struct MeshPart {
-    unsigned int indexOffset;
-    unsigned int indexCount;
-    float color[4];
+struct AppOptions {
+    bool headless = false;  // GLFW null platform + OSMesa (vd. Mesa llvmpipe): không cần display / X server
+    bool vsync = true;
+    std::string modelPath = "res/chess_pieces.glb"; // rỗng = không load lúc khởi động
+    bool autoRotate = true;
+    FramePacing pacing;
+    double runSeconds = 0.0;        // > 0: Run() dừng sau chừng này giây (tính từ lúc load xong) và báo cáo pacing
+    std::string pacingReportPath;   // JSON của báo cáo đó, rỗng = chỉ in ra stdout
+    VertexFormat vertexFormat = VertexFormat::Quantized;
+    std::string shaderDir = "shaders"; // model.vert / model.frag
 };
 
 class Application {
@@ -33,16 +54,41 @@ public:
     Application();
     ~Application();
 
-    bool Init(const char* title, int width, int height);
+    bool Init(const char* title, int width, int height, const AppOptions& options = AppOptions());
     void Run();
+    int RunBenchmark(const BenchConfig& config); // trả về exit code
 
 private:
-    void InitGraphics();
-    void CreateShaderProgram();
-    void HandleEvents(); // Xử lý input GLFW
-    void Render();
+    bool InitGraphics();
+    void InstallRedrawCallbacks();                // input / resize -> cờ dirty (ImGui gọi tiếp callback của nó)
+    static void MarkWindowDirty(GLFWwindow* window, uint32_t flags);
+    void HandleEvents(double waitTimeout = 0.0); // Xử lý input GLFW; waitTimeout > 0: block chờ event tối đa chừng đó giây
+    void FixedUpdate(double step);               // một bước mô phỏng: auto-rotate, thời gian animation
+    bool IsAnimating() const;
+    void BuildUI();      // cửa sổ điều khiển ImGui (chưa render)
+    void Render();       // UI + scene + ImGui, chưa swap
+    void Present();      // swap + chốt frame cho profiler
+    void DrawModel(const glm::mat4& projection, const glm::mat4& view, const glm::mat4& model);
     void Clean();
-    void LoadModelRaw(const char* path);
+    void LoadModelRaw(const char* path, bool reload = false);  // Không block: đẩy sang worker thread
+    void CancelModelLoad();
+    void UpdateModelLoad();               // Gọi mỗi frame trên render thread
+    bool TryIncrementalReload(const ModelAsset& asset); // chỉ ghi part đổi vào buffer đang dùng
+    void FinishModelSwap(const ModelAsset& asset);      // bảng part đã đổi: dựng lại scene / material / texture...
+    void WatchFiles();                                 // shader + model đang vẽ + file phụ thuộc của nó
+    void PollFileChanges();                            // hot reload: model / shader đổi trên đĩa
+    void DeleteModelBuffers();
+    void UploadMaterials();
+    void UploadInstances(bool full);
+    void CullInstances(const glm::mat4& clip); // clip = P * V * M
+    void SelectLods(const glm::mat4& projection, const glm::mat4& modelView);
+    void BuildVisibleLists();                  // gom instance visible theo (part, LOD) + upload
+    void SetupSkinning(const MeshView& mesh);  // rig + buffer cho GPU / CPU skinning, sau khi swap model
+    void DeleteSkinningBuffers();
+    void UpdateAnimation();                    // pose -> scene graph + palette / vertex đã skin
+#if APP_PROFILER
+    void DrawProfilerOverlay();
+#endif
 
 private:
     bool m_IsRunning;
@@ -51,19 +97,133 @@ private:
     
     int m_Width;
     int m_Height;
+    bool m_Headless = false;
 
-    unsigned int m_ShaderProgram;
+    // --- FRAME PACING ---
+    FrameScheduler m_Scheduler;
+    double m_RunSeconds = 0.0;
+    std::string m_PacingReportPath;
+
+    std::string m_ShaderDir;
+    ShaderProgram m_Shader;
+    ModelUniforms m_ModelUniforms;       // location theo reflection của m_Shader
+    unsigned int m_CameraUBO = 0;        // CameraBlock
+
+    // --- RENDER DEVICE ---
+    // GL <- đếm lệnh <- lọc state thừa; thứ tự khai báo là thứ tự khởi tạo
+    GLRenderBackend m_GLBackend;
+    RecordingBackend m_CallCounter{ &m_GLBackend };
+    RenderDevice m_Device{ &m_CallCounter };
+    GpuCallCounts m_FrameGpuCalls;       // lần submit model gần nhất
+    GpuCallCounts m_FrameGpuSkipped;
+    std::vector<unsigned int> m_TextureHandles; // theo textureIndex, scratch của frame
 
     // --- MODEL DATA ---
     unsigned int m_ModelVAO = 0;
     unsigned int m_ModelVBO = 0;
+    unsigned int m_ModelDrawIDVBO = 0;
+    unsigned int m_ModelSkinVBO = 0;
     unsigned int m_ModelEBO = 0;
 
     std::vector<MeshPart> m_MeshParts;
+    TextureManager m_Textures;           // base color theo MeshPart::textureIndex
+    VertexFormat m_VertexFormat = VertexFormat::Quantized; // cho lần upload sau
+    VertexFormat m_ModelVertexFormat = VertexFormat::Float; // của VBO đang vẽ
+    unsigned int m_PartDecodeBuffer = 0;  // 2 x RGBA32F theo part: offset + scale giải position quantized
+    unsigned int m_PartDecodeTexture = 0;
+
+    // --- BATCHING ---
+    unsigned int m_MaterialBuffer = 0;   // RGBA32F theo part
+    unsigned int m_MaterialTexture = 0;  // TBO nhìn vào m_MaterialBuffer
+    DrawList m_DrawList;
+    bool m_BatchedDraw = true;
+    int  m_DrawCallCount = 0;
+
+    // --- SCENE / INSTANCING ---
+    SceneGraph m_Scene;
+    unsigned int m_InstanceBuffer = 0;   // mat4 theo instance, xếp theo part
+    unsigned int m_InstanceTexture = 0;
+    bool m_KeepHierarchy = false;
+
+    // --- CULLING ---
+    BoundsBVH m_Culler;                        // trên InstanceBounds() của scene
+    std::vector<uint8_t> m_InstanceVisible;    // theo slot instance
+    std::vector<int> m_VisibleSlots;           // slot visible, gom theo (part, LOD)
+    std::vector<unsigned int> m_VisibleOffset; // partCount * kMaxMeshLods + 1 phần tử
+    unsigned int m_InstanceIndexBuffer = 0;    // R32I: u_InstanceBase + gl_InstanceID -> slot
+    unsigned int m_InstanceIndexTexture = 0;
+    bool m_FrustumCulling = true;
+    size_t m_VisibleCount = 0;
+
+    // --- LOD ---
+    struct LodStats {
+        size_t meshTriangles = 0; // tổng tam giác của level này trên mọi part (mỗi mesh một lần)
+        size_t instances = 0;     // frame này
+        size_t triangles = 0;     // frame này
+    };
+    std::vector<uint8_t> m_InstanceLod;        // theo slot, giữ giữa các frame cho hysteresis
+    LodParams m_LodParams;
+    LodStats m_LodStats[kMaxMeshLods];
+    int m_ViewportHeight = 1;
+
+    // --- ANIMATION / SKINNING ---
+    AnimationRig m_Rig;
+    CharacterAnimation m_Character;
+    std::vector<glm::mat4> m_NodeLocal;        // theo node, của pose frame này
+    std::vector<glm::mat4> m_NodeWorld;
+    std::vector<glm::mat4> m_Palette;          // theo SkinJoint
+    bool m_PlayAnimation = true;
+    bool m_CpuSkinning = false;                // false: palette lên TBO, vertex shader skin
+    double m_AnimationTime = 0.0;              // thời gian mô phỏng (bước cố định)
+    double m_RenderedAnimationTime = 0.0;      // thời điểm đã pose, nội suy giữa hai bước
+    double m_PoseMs = 0.0;
+    double m_SkinMs = 0.0;
+    unsigned int m_PaletteBuffer = 0;          // RGBA32F, 4 texel / joint
+    unsigned int m_PaletteTexture = 0;
+    // CPU skinning: vertex của part skinned gom liền, skin mỗi frame rồi stream vào VBO riêng
+    std::vector<float> m_SkinSource;
+    std::vector<VertexSkin> m_SkinWeights;
+    std::vector<float> m_SkinnedVertices;
+    std::vector<unsigned int> m_SkinnedBase;   // theo part, ~0u = part không skinned
+    unsigned int m_SkinnedVAO = 0;
+    unsigned int m_SkinnedVBO = 0;
+    unsigned int m_SkinnedDrawIDVBO = 0;
+
+    // --- HOT RELOAD ---
+    FileWatcher m_Watcher;
+    bool m_HotReload = true;
+    std::string m_ModelPath;                   // model đang vẽ (sau khi load xong)
+    std::vector<std::string> m_ModelDependencies; // texture ngoài model
+    unsigned int m_ModelImportFlags = 0;
+    ResidentMesh m_Resident;                   // hash part + chỗ trống trong VBO/EBO
+    uint64_t m_TextureHash = 0;
+    bool m_PendingIsReload = false;
+    std::string m_ReloadStatus;
+    std::vector<std::string> m_ChangedFiles;
+
+    // --- ASYNC LOADING ---
+    AsyncModelLoader m_Loader;
+    ModelLoadHandle m_PendingLoad;
+    ModelUploader m_Uploader;
+    size_t m_UploadBudget = 4 * 1024 * 1024; // byte/frame
+    std::string m_LoadStatus;
+    double m_LoadRequestTime = 0.0;  // glfwGetTime() lúc gửi request
+    double m_LastLoadMs = 0.0;       // request -> model vẽ được (gồm upload nhiều frame)
+    double m_LastImportMs = 0.0;     // phần worker: import/optimize hoặc map cache
+    bool m_LastLoadFromCache = false;
+
+#if APP_PROFILER
+    // --- PROFILER ---
+    GpuProfiler m_GpuProfiler;
+    bool m_ShowProfiler = false;
+    int  m_CaptureFrameCount = 120;
+#endif
 
     // --- CONTROL ---
     float m_Scale = 1.0f;
     float m_RotationAngle = 0.0f;
+    float m_PrevRotationAngle = 0.0f;   // trước bước mô phỏng cuối, để nội suy khi auto-rotate
+    float m_CameraDistance = 8.0f;
     bool  m_AutoRotate = true;
     bool  m_Wireframe = false;
     bool  m_UseOverrideColor = false;
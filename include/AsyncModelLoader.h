@@ -0,0 +1,71 @@
+#pragma once
+
+#include "ModelImporter.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+enum class LoadState { Queued, Loading, Ready, Failed, Cancelled };
+
+// Trạng thái chia sẻ giữa worker và render thread
+struct ModelLoadJob {
+    std::string path;
+    unsigned int importFlags = 0;
+    bool hashParts = false;     // tính ModelAsset::partHashes / textureHash trên worker
+
+    std::atomic<LoadState> state{LoadState::Queued};
+    std::atomic<float> progress{0.0f};
+    std::atomic<bool> cancelRequested{false};
+
+    // Chỉ đọc sau khi state == Ready (worker không đụng tới nữa)
+    ModelAsset asset;
+    std::string error;
+};
+
+// --- LOAD HANDLE (giống future) ---
+class ModelLoadHandle {
+public:
+    ModelLoadHandle() = default;
+    explicit ModelLoadHandle(std::shared_ptr<ModelLoadJob> job) : m_Job(std::move(job)) {}
+
+    bool Valid() const { return m_Job != nullptr; }
+    LoadState State() const { return m_Job->state.load(std::memory_order_acquire); }
+    bool IsDone() const { LoadState s = State(); return s != LoadState::Queued && s != LoadState::Loading; }
+    float Progress() const { return m_Job->progress.load(std::memory_order_relaxed); }
+    void Cancel() { if (m_Job) m_Job->cancelRequested.store(true, std::memory_order_relaxed); }
+
+    const std::string& Path() const { return m_Job->path; }
+    unsigned int ImportFlags() const { return m_Job->importFlags; }
+    const std::string& Error() const { return m_Job->error; }
+    ModelAsset& Asset() { return m_Job->asset; }
+    void Reset() { m_Job.reset(); }
+
+private:
+    std::shared_ptr<ModelLoadJob> m_Job;
+};
+
+// --- ASYNC LOADER ---
+// Một worker thread: import Assimp / map cache + chuyển đổi mesh.
+// Không có lời gọi OpenGL nào ở đây, upload do render thread đảm nhận.
+class AsyncModelLoader {
+public:
+    AsyncModelLoader();
+    ~AsyncModelLoader();
+
+    ModelLoadHandle Request(const std::string& path, unsigned int importFlags = kDefaultImportFlags,
+                            bool hashParts = false);
+
+private:
+    void WorkerLoop();
+
+    std::thread m_Worker;
+    std::mutex m_Mutex;
+    std::condition_variable m_Wake;
+    std::deque<std::shared_ptr<ModelLoadJob>> m_Queue;
+    bool m_Quit = false;
+};
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// --- FRUSTUM CULLING (CPU thuần) ---
+// Box lưu dạng SoA (minX[], minY[], ...) để test 4 (SSE/NEON) hoặc 8 (AVX) box một lần.
+// BVH phẳng nằm phía trên: node hoàn toàn trong frustum -> cả subtree visible không cần test,
+// node hoàn toàn ngoài -> bỏ cả subtree, còn lại xuống tới leaf rồi test SIMD.
+
+struct AABB {
+    glm::vec3 min;
+    glm::vec3 max;
+};
+
+// AABB của box local sau khi biến đổi bởi matrix (Arvo)
+AABB TransformAABB(const glm::mat4& m, const AABB& box);
+
+struct Frustum {
+    glm::vec4 planes[6]; // ax + by + cz + d >= 0 là phía trong
+
+    // Gribb/Hartmann. Truyền P * V * M để cull trong không gian model.
+    static Frustum FromMatrix(const glm::mat4& clip);
+};
+
+enum class CullResult { Outside, Intersect, Inside };
+CullResult TestAABB(const Frustum& frustum, const AABB& box);
+
+struct BoundsSoA {
+    std::vector<float> minX, minY, minZ;
+    std::vector<float> maxX, maxY, maxZ;
+
+    size_t Size() const { return minX.size(); }
+    void Resize(size_t count);
+    void Set(size_t i, const AABB& box);
+    AABB Get(size_t i) const;
+};
+
+// Test box [begin, end), ghi 0/1 vào outVisible[begin..end). Dùng SIMD nếu có.
+void CullBoxes(const Frustum& frustum, const BoundsSoA& boxes, size_t begin, size_t end, uint8_t* outVisible);
+void CullBoxesScalar(const Frustum& frustum, const BoundsSoA& boxes, size_t begin, size_t end, uint8_t* outVisible);
+const char* CullSimdName();
+
+// --- BVH ---
+class BoundsBVH {
+public:
+    static constexpr unsigned int kLeafSize = 8;
+
+    // Xây lại từ đầu (median split theo trục dài nhất)
+    void Build(const std::vector<AABB>& boxes);
+    // Box di chuyển nhưng cấu trúc giữ nguyên: cập nhật leaf + node từ dưới lên
+    void Refit(const std::vector<AABB>& boxes);
+
+    // visible[i] cho object gốc i (kích thước = số box lúc Build). Trả về số object visible.
+    size_t Cull(const Frustum& frustum, std::vector<uint8_t>& visible);
+
+    size_t ObjectCount() const { return m_ObjectIds.size(); }
+    size_t NodeCount() const { return m_Nodes.size(); }
+
+private:
+    // Subtree của mọi node phủ một khoảng primitive liên tục [primFirst, primFirst + primCount)
+    struct Node {
+        AABB bounds;
+        unsigned int child;      // 0 = leaf, ngược lại con trái (con phải = child + 1)
+        unsigned int primFirst;
+        unsigned int primCount;
+    };
+
+    struct BuildPrim {
+        AABB box;
+        glm::vec3 centroid;
+        unsigned int id;
+    };
+
+    void BuildNode(unsigned int nodeIndex, unsigned int first, unsigned int count);
+
+    std::vector<Node> m_Nodes;
+    BoundsSoA m_Leaves;                   // box theo thứ tự BVH
+    std::vector<unsigned int> m_ObjectIds; // vị trí BVH -> object gốc
+    std::vector<BuildPrim> m_BuildPrims;  // scratch khi Build
+    std::vector<uint8_t> m_LeafVisible;   // scratch
+    std::vector<unsigned int> m_Stack;    // scratch
+};
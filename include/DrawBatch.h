@@ -0,0 +1,47 @@
+#pragma once
+
+#include "MeshData.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// --- DRAW BATCHING (CPU thuần) ---
+// Gom các MeshPart thành command list cho glMultiDrawElementsBaseVertex.
+// Màu không còn là uniform theo part mà nằm trong material buffer (TBO),
+// shader tra bằng draw ID lưu theo vertex (GL 4.1 chưa có gl_DrawID).
+// Nhờ vậy part khác màu vẫn nằm chung một lần gọi, chỉ cần tách theo state
+// (kiểu index và texture, vì texture phải bind trước lần gọi).
+
+// Một lần gọi glMultiDrawElementsBaseVertex
+struct DrawBatch {
+    unsigned int indexSize = 4;           // state key: GL_UNSIGNED_SHORT / GL_UNSIGNED_INT
+    int texture = -1;                     // state key: MeshPart::textureIndex
+    std::vector<int> counts;              // GLsizei
+    std::vector<const void*> offsets;     // byte offset trong EBO
+    std::vector<int> baseVertices;        // GLint
+
+    size_t DrawCount() const { return counts.size(); }
+};
+
+struct DrawList {
+    std::vector<DrawBatch> batches; // chỉ batchCount phần tử đầu thuộc frame này, phần sau giữ capacity
+    size_t batchCount = 0;
+    size_t partCount = 0;     // số part được submit
+    std::vector<unsigned int> order; // scratch khi build, giữ capacity giữa các frame
+
+    size_t CallCount() const { return batchCount; }
+    size_t CommandCount() const;
+    void Clear();
+};
+
+// visible == nullptr: vẽ tất cả. lods == nullptr: mọi part dùng LOD 0.
+// Sắp xếp theo state rồi theo vị trí trong EBO, mỗi part một command.
+void BuildDrawList(const MeshPart* parts, size_t partCount, const uint8_t* visible, const uint8_t* lods, DrawList& out);
+
+// Material buffer: RGBA float theo thứ tự part (draw ID = index của part)
+void BuildMaterialBuffer(const MeshPart* parts, size_t partCount, std::vector<float>& outRGBA);
+
+// Stream draw ID theo vertex; dùng uint16 nếu đủ (trả về 2), ngược lại uint32 (trả về 4)
+unsigned int BuildVertexDrawIDs(const MeshPart* parts, size_t partCount, size_t vertexCount,
+                                std::vector<unsigned char>& outIDs);
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// --- FILE WATCHER ---
+// Báo file nào đã đổi, không block. Linux: inotify trên thư mục cha (editor hay ghi file tạm rồi rename,
+// watch thẳng vào file sẽ mất sau lần lưu đầu). Nơi khác, hoặc inotify lỗi: stat mtime/size theo chu kỳ.
+// Một file chỉ được báo khi đã "yên" settle giây kể từ lần đổi cuối, để không reload file đang ghi dở.
+class FileWatcher {
+public:
+    FileWatcher();
+    ~FileWatcher();
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    // File chưa tồn tại cũng được (báo khi nó xuất hiện). Trùng path thì bỏ qua.
+    void Watch(const std::string& path);
+    void Clear();
+    size_t Count() const { return m_Files.size(); }
+
+    // Gọi mỗi vòng lặp; now cùng gốc thời gian giữa các lần gọi (giây)
+    void Poll(double now, std::vector<std::string>& outChanged);
+
+    bool NativeEvents() const { return m_Inotify >= 0; }
+    void SetPollInterval(double seconds) { m_PollInterval = seconds; }
+    void SetSettleTime(double seconds) { m_Settle = seconds; }
+
+private:
+    struct File {
+        std::string path;
+        std::string directory;  // tuyệt đối, chuẩn hoá
+        std::string name;
+        uint64_t mtime = 0;
+        uint64_t size = 0;
+        bool exists = false;
+        double changedAt = -1.0; // < 0: không có thay đổi chờ báo
+    };
+    struct DirectoryWatch {
+        int handle;
+        std::string directory;
+    };
+
+    void ReadEvents(double now);
+    void StatFiles(double now);
+
+    std::vector<File> m_Files;
+    std::vector<DirectoryWatch> m_Directories;
+    int m_Inotify = -1;
+    double m_PollInterval = 0.5;
+    double m_Settle = 0.2;
+    double m_LastStat = -1.0;
+};
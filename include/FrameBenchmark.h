@@ -0,0 +1,79 @@
+#pragma once
+
+#include "FrameScheduler.h"
+#include "RenderDevice.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// --- FRAME BENCHMARK ---
+// Chế độ --bench: load một model, chạy kịch bản camera cố định N frame (vsync tắt),
+// ghi thời gian từng frame + percentile ra JSON để CI so sánh giữa các commit.
+// Phần này không gọi OpenGL; vòng frame nằm trong Application::RunBenchmark.
+
+struct BenchConfig {
+    std::string modelPath;
+    std::string outputPath = "bench.json";
+    std::string cameraScriptPath;   // rỗng = kịch bản mặc định
+    unsigned int frames = 600;
+    unsigned int warmupFrames = 30; // chạy nhưng không tính (driver compile shader, cache nguội...)
+    double loadTimeoutSec = 300.0;
+    bool keepHierarchy = false;
+};
+
+// Một khoá camera; time chuẩn hoá [0, 1] trên toàn bộ số frame đo
+struct CameraKey {
+    float time;
+    float rotation; // độ, quanh trục Y như slider Rotation
+    float scale;
+    float distance; // camera lùi theo -Z
+};
+
+class CameraScript {
+public:
+    // Quay một vòng ở khoảng cách mặc định, lùi xa (LOD thô, ít bị cull) rồi lại gần (cull nhiều)
+    static CameraScript Default();
+
+    // File text, mỗi dòng "time rotation scale distance", '#' là comment. Key phải tăng dần theo time.
+    bool Load(const std::string& path);
+
+    // Nội suy tuyến tính giữa hai key kề nhau, kẹp ngoài khoảng
+    CameraKey Sample(float time) const;
+
+private:
+    std::vector<CameraKey> m_Keys;
+};
+
+struct FrameSample {
+    double cpuMs;       // HandleEvents + UI + cull/LOD + gửi lệnh GL, chưa gồm swap
+    double frameMs;     // cả frame, gồm swap
+    int drawCalls;
+    size_t visibleInstances;
+    uint32_t gpuCalls;  // lệnh qua RenderDevice tới GL trong lần submit model
+};
+
+struct BenchResult {
+    std::string renderer;       // GL_RENDERER
+    int width = 0, height = 0;
+    double loadMs = 0.0;        // từ lúc gửi request tới khi model vẽ được (import/cache + upload)
+    double importMs = 0.0;      // riêng phần worker: Assimp + optimize, hoặc map cache
+    bool fromCache = false;
+    size_t parts = 0, instances = 0;
+    std::string vertexFormat;   // VertexFormatName của VBO
+    size_t vertexBytes = 0;     // VBO chính, không tính headroom / draw ID / skin
+    double cpuSeconds = 0.0;    // CPU của cả process trong phần đo (gồm worker thread)
+    double wallSeconds = 0.0;
+    GpuCallCounts gpuCalls;     // cộng dồn các frame đo, theo loại lệnh
+    GpuCallCounts gpuSkipped;   // lệnh RenderDevice bỏ vì state không đổi
+    std::vector<FrameSample> frames;
+};
+
+// Percentile p (0..100) nội suy tuyến tính giữa hai hạng gần nhất; values không cần sắp xếp
+double Percentile(std::vector<double> values, double p);
+
+bool WriteBenchReport(const BenchConfig& config, const BenchResult& result);
+
+// Báo cáo của Run() có giới hạn thời gian (--run-for): frame vẽ / bước mô phỏng / CPU theo chế độ pacing
+bool WritePacingReport(const std::string& path, const FramePacing& pacing, const FramePacingStats& stats,
+                       double wallSeconds, double cpuSeconds);
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// --- FRAME SCHEDULER ---
+// Tách mô phỏng khỏi vẽ: mô phỏng chạy theo bước cố định (accumulator), frame vẽ nội suy giữa
+// trạng thái trước và sau bằng Alpha(). Không gọi GLFW / OpenGL: thời gian do Application đưa vào
+// (glfwGetTime), Application tự poll / wait event theo WaitTimeout() và tự sleep theo SleepUntil().
+//   Continuous: poll + vẽ mọi vòng lặp (giới hạn bởi vsync / maxFps).
+//   OnDemand:   chỉ vẽ khi có cờ dirty (input, animation, load...), còn lại block trong glfwWaitEventsTimeout.
+//   LowLatency: như Continuous nhưng ngủ TRƯỚC khi poll input, canh sao cho frame xong vừa kịp hạn
+//               (deadline - thời gian làm frame ước lượng) -> input được đọc muộn nhất có thể.
+
+enum class FrameMode { Continuous, OnDemand, LowLatency };
+
+// Lý do cần vẽ lại; gộp bằng OR, xoá sau mỗi frame được vẽ
+enum FrameDirty : uint32_t {
+    kDirtyInput = 1u << 0,      // chuột / phím / cuộn / focus
+    kDirtyWindow = 1u << 1,     // resize, refresh, đổi framebuffer
+    kDirtyAnimation = 1u << 2,  // bước mô phỏng làm đổi trạng thái (auto-rotate, clip đang chạy)
+    kDirtyLoad = 1u << 3,       // model đang load / upload
+    kDirtyStreaming = 1u << 4,  // texture còn mip chờ upload
+};
+
+struct FramePacing {
+    FrameMode mode = FrameMode::Continuous;
+    double maxFps = 0.0;            // 0 = không giới hạn (ngoài vsync)
+    double fixedStep = 1.0 / 60.0;  // giây mỗi bước mô phỏng
+    unsigned int maxSteps = 8;      // tối đa bước / vòng (sau khi bị treo lâu thì bỏ bớt thời gian)
+    double idleTimeout = 0.5;       // OnDemand: thức dậy tối thiểu mỗi chừng này giây khi không có gì
+    unsigned int inputFrames = 3;   // OnDemand: vẽ thêm chừng này frame sau input (ImGui cần vài frame để ổn định)
+    double refreshRate = 60.0;      // LowLatency + vsync không có maxFps: chu kỳ màn hình
+};
+
+// Đếm theo chế độ; đo CPU bằng ProcessCpuSeconds() ở ngoài
+struct FramePacingStats {
+    uint64_t loops = 0;             // số vòng lặp chính
+    uint64_t framesRendered = 0;
+    uint64_t steps = 0;             // bước mô phỏng
+    uint64_t droppedSteps = 0;      // bị bỏ do maxSteps
+    uint64_t waits = 0;             // số lần block chờ event (OnDemand)
+    double sleptSeconds = 0.0;      // sleep do cap / low-latency
+};
+
+class FrameScheduler {
+public:
+    void Configure(const FramePacing& pacing) { m_Pacing = pacing; }
+    const FramePacing& Pacing() const { return m_Pacing; }
+    FramePacing& Pacing() { return m_Pacing; }
+    void Reset(double now);
+
+    // Cộng thời gian trôi vào accumulator, trả về số bước cố định cần chạy ngay
+    unsigned int Advance(double now);
+    double Step() const { return m_Pacing.fixedStep; }
+    // [0, 1): vị trí của thời điểm vẽ giữa trạng thái trước và sau bước cuối
+    double Alpha() const { return m_Accumulator / m_Pacing.fixedStep; }
+
+    void MarkDirty(uint32_t flags);
+    // Có thứ đổi theo thời gian (auto-rotate, clip đang chạy): OnDemand thức dậy đúng bước mô phỏng kế
+    void SetAnimating(bool animating) { m_Animating = animating; }
+    uint32_t Dirty() const { return m_Dirty; }
+    bool ShouldRender() const;
+    // Ngay trước khi vẽ: lấy và xoá cờ (cờ đặt trong lúc vẽ, vd. texture còn chờ, thuộc về frame sau)
+    uint32_t BeginFrame();
+    // Đã swap: ghi thời gian làm frame để cap / LowLatency canh frame sau
+    void FrameRendered(double frameStart, double frameEnd);
+
+    // Giây nên block chờ event trước vòng sau; 0 = chỉ poll
+    double WaitTimeout(double now) const;
+    // Thời điểm nên bắt đầu vòng sau (sleep tới đó trước khi poll); <= now = không cần ngủ
+    double NextFrameStart(double now) const;
+
+    FramePacingStats& Stats() { return m_Stats; }
+    const FramePacingStats& Stats() const { return m_Stats; }
+
+private:
+    FramePacing m_Pacing;
+    FramePacingStats m_Stats;
+    double m_LastTime = 0.0;
+    double m_Accumulator = 0.0;
+    double m_LastFrameStart = -1.0;
+    double m_LastFrameEnd = -1.0;
+    double m_WorkEstimate = 0.0;    // EMA thời gian poll -> swap xong
+    uint32_t m_Dirty = kDirtyWindow; // frame đầu luôn vẽ
+    unsigned int m_InputFrames = 0;
+    bool m_Animating = false;
+};
+
+// Ngủ tới thời điểm target (cùng gốc với now): sleep của OS cho phần lớn, phần cuối yield-spin
+// để không trễ cả ms; trả về số giây đã ngủ
+double SleepUntil(double now, double target);
+
+// Thời gian CPU (user + system) của cả process, giây
+double ProcessCpuSeconds();
+
+const char* FrameModeName(FrameMode mode);
+bool ParseFrameMode(const std::string& name, FrameMode& outMode);
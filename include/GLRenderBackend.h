@@ -0,0 +1,23 @@
+#pragma once
+
+#include "RenderDevice.h"
+
+// RenderBackend gọi OpenGL thật (context hiện tại). Không lọc gì: lọc nằm ở RenderDevice.
+class GLRenderBackend : public RenderBackend {
+public:
+    void UseProgram(unsigned int program) override;
+    void BindVertexArray(unsigned int vao) override;
+    void SetPolygonMode(PolygonMode mode) override;
+    void ActiveTexture(unsigned int unit) override;
+    void BindTexture(TextureTarget target, unsigned int texture) override;
+    void Uniform1i(int location, int value) override;
+    void Uniform4f(int location, const float value[4]) override;
+    void BindUniformBufferBase(unsigned int binding, unsigned int buffer) override;
+    void BindUniformBuffer(unsigned int buffer) override;
+    void UniformBufferData(size_t size, const void* data) override;
+    void UniformBufferSubData(size_t offset, size_t size, const void* data) override;
+    void DrawElements(unsigned int indexSize, int count, size_t indexOffset, int baseVertex,
+                      unsigned int instanceCount) override;
+    void MultiDrawElements(unsigned int indexSize, const int* counts, const void* const* offsets,
+                           const int* baseVertices, int drawCount) override;
+};
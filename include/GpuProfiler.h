@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Profiler.h"
+
+#if APP_PROFILER
+
+#include <glad/glad.h>
+
+#include <cstdint>
+
+// --- GPU PROFILER ---
+// GL_TIME_ELAPSED theo zone, mỗi frame một bộ query, luân phiên kBufferedFrames bộ.
+// Đầu frame đọc bộ cũ nhất (đã gửi từ kBufferedFrames frame trước) chỉ khi GL báo
+// QUERY_RESULT_AVAILABLE: không bao giờ chờ GPU; kết quả chưa xong thì bỏ (đếm trong Dropped()).
+// GL_TIME_ELAPSED không lồng được nên zone GPU phải nối tiếp nhau, không chồng lên nhau.
+class GpuProfiler {
+public:
+    static constexpr unsigned int kBufferedFrames = 2;
+    static constexpr unsigned int kMaxZones = 16;
+
+    void Init();
+    void Shutdown();
+
+    void BeginFrame(); // gọi trên render thread trước mọi zone của frame
+    bool BeginZone(const char* name); // false: zone bị bỏ (lồng nhau / quá kMaxZones), không gọi EndZone
+    void EndZone();
+
+    size_t Dropped() const { return m_Dropped; }
+
+private:
+    struct FrameQueries {
+        unsigned int queries[kMaxZones] = {};
+        const char* names[kMaxZones] = {};
+        uint64_t cpuStartNs[kMaxZones] = {};
+        unsigned int count = 0;
+    };
+
+    FrameQueries m_Frames[kBufferedFrames];
+    unsigned int m_Current = 0;
+    bool m_InZone = false;
+    bool m_Initialized = false;
+    size_t m_Dropped = 0;
+};
+
+class GpuProfileZone {
+public:
+    GpuProfileZone(GpuProfiler& profiler, const char* name) : m_Profiler(profiler), m_Active(profiler.BeginZone(name)) {}
+    ~GpuProfileZone() { if (m_Active) m_Profiler.EndZone(); }
+    GpuProfileZone(const GpuProfileZone&) = delete;
+    GpuProfileZone& operator=(const GpuProfileZone&) = delete;
+
+private:
+    GpuProfiler& m_Profiler;
+    bool m_Active;
+};
+
+#define PROFILE_GPU_SCOPE(profiler, name) GpuProfileZone PROFILE_CONCAT(gpuProfileZone_, __LINE__)(profiler, name)
+
+#else
+
+#define PROFILE_GPU_SCOPE(profiler, name) ((void)0)
+
+#endif
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// --- JOB SYSTEM (work-stealing) ---
+// Mỗi worker có một deque riêng: chủ đẩy/lấy ở cuối (LIFO, cache còn nóng),
+// worker rảnh lấy trộm ở đầu deque của worker khác. Thread ngoài pool (render thread,
+// thread của AsyncModelLoader) đẩy vào một deque chung và tự chạy job của mình trong lúc Wait,
+// nên ParallelFor lồng nhau hoặc gọi từ bất kỳ thread nào cũng không deadlock. Wait chỉ chạy
+// job của counter đang chờ: thời gian chờ không bị kéo dài bởi job không liên quan; hết job để giúp
+// thì ngủ trên m_Finished tới khi counter về 0.
+//
+// Deque dùng mutex riêng từng cái (không lock-free): job ở đây là chunk lớn của ParallelFor,
+// tranh chấp lock không đáng kể so với công việc bên trong.
+
+class JobCounter {
+public:
+    bool Done() const { return m_Pending.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+    std::atomic<size_t> m_Pending{0};
+};
+
+class JobSystem {
+public:
+    // threadCount = tổng số thread tham gia, tính cả thread gọi Wait (0 = số core)
+    explicit JobSystem(unsigned int threadCount = 0);
+    ~JobSystem();
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // Pool dùng chung cho cả ứng dụng
+    static JobSystem& Global();
+
+    unsigned int ThreadCount() const { return (unsigned int)m_Workers.size() + 1; }
+
+    void Submit(JobCounter& counter, std::function<void()> job);
+    // Chạy job của counter này cho tới khi nó về 0
+    void Wait(JobCounter& counter);
+
+    // body(begin, end) trên các khoảng con của [0, count); mỗi khoảng >= grain phần tử
+    // (trừ khoảng cuối). Trả về khi xong hết.
+    void ParallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& body);
+
+private:
+    struct Job {
+        std::function<void()> fn;
+        JobCounter* counter;
+    };
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    void WorkerLoop(unsigned int index);
+    // self = index deque của thread hiện tại; only = chỉ chạy job của counter này (nullptr = bất kỳ)
+    bool TryRun(unsigned int self, const JobCounter* only);
+    // Trừ một job của counter; về 0 thì đánh thức các thread đang Wait
+    void Complete(JobCounter& counter);
+    unsigned int CurrentQueue() const;
+
+    std::vector<std::unique_ptr<Queue>> m_Queues; // [0, workers) của worker, [workers] cho thread ngoài
+    std::vector<std::thread> m_Workers;
+    std::atomic<size_t> m_Queued{0};
+    std::mutex m_SleepMutex;
+    std::condition_variable m_Wake;     // worker rảnh chờ job mới
+    std::condition_variable m_Finished; // thread trong Wait chờ counter về 0
+    bool m_Quit = false;
+};
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "MeshData.h"
+#include "SceneGraph.h"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// --- LOD SELECTION (CPU thuần) ---
+// Sai số màn hình (pixel) = error * scale / khoảng cách * pixelsPerUnit.
+// Chọn level thô nhất có sai số dưới ngưỡng, với hysteresis chống nhấp nháy ở ranh giới:
+//   - level hiện tại vượt threshold -> xuống level mịn hơn ngay
+//   - chỉ lên level thô hơn khi sai số của nó < threshold * hysteresis
+
+struct LodParams {
+    float pixelsPerUnit = 1.0f; // viewportHeight / (2 * tan(fovY / 2)) = P[1][1] * viewportHeight / 2
+    float threshold = 1.0f;     // pixel
+    float hysteresis = 0.75f;
+    int forcedLevel = -1;       // >= 0: bỏ qua sai số, dùng level này (kẹp theo số LOD của part)
+};
+
+float ProjectedError(float error, float distance, float pixelsPerUnit);
+
+// distance: từ camera tới bounds của instance, scale: scale lớn nhất của transform instance
+unsigned int SelectLod(const MeshPart& part, float scale, float distance, unsigned int current, const LodParams& params);
+
+// Chọn LOD cho mọi instance visible (không gian model, cameraPos cùng hệ với InstanceBounds()).
+// inOutLods giữ level của frame trước để áp hysteresis; instance bị cull giữ nguyên level.
+void SelectInstanceLods(const MeshPart* parts, const SceneGraph& scene, const uint8_t* visible,
+                        const glm::vec3& cameraPos, const LodParams& params, std::vector<uint8_t>& inOutLods);
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "MeshData.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// --- MESH CACHE ---
+// File nhị phân "nấu sẵn" đặt cạnh model gốc: <model>.<flags>.meshcache
+// Layout: [MeshCacheHeader][MeshPart table][vertex blob][index blob][SceneNode table][mesh refs]
+//         [TextureDesc table][texture blob (BC1/BC3 + mip)][skin stream][SkinJoint table]
+//         [AnimationClip table][AnimationChannel table][AnimationKey table][dependency table + path]
+// Mỗi blob căn lề kMeshCacheAlignment để mmap rồi glBufferData / glCompressedTexImage2D trực tiếp.
+// Dependency: file texture ngoài model; cache chỉ hợp lệ khi mtime/size của chúng còn khớp.
+
+constexpr uint32_t kMeshCacheVersion = 7;
+constexpr uint64_t kMeshCacheAlignment = 64;
+
+struct MeshCacheKey {
+    uint64_t pathHash = 0;
+    uint64_t sourceMtime = 0;
+    uint64_t sourceSize = 0;
+    uint32_t importFlags = 0;
+};
+
+struct MeshCacheHeader {
+    char     magic[4];          // "HZMC"
+    uint32_t version;
+    uint64_t pathHash;
+    uint64_t sourceMtime;
+    uint64_t sourceSize;
+    uint32_t importFlags;
+    uint32_t partCount;
+    uint64_t vertexCount;
+    uint64_t indexBytes;
+    uint64_t partsOffset;
+    uint64_t verticesOffset;
+    uint64_t indicesOffset;
+    uint64_t nodeCount;
+    uint64_t nodesOffset;
+    uint64_t meshRefCount;
+    uint64_t meshRefsOffset;
+    uint64_t textureCount;
+    uint64_t texturesOffset;
+    uint64_t textureBytes;
+    uint64_t textureDataOffset;
+    uint64_t skinCount;         // 0 hoặc vertexCount
+    uint64_t skinOffset;
+    uint64_t jointCount;
+    uint64_t jointsOffset;
+    uint64_t clipCount;
+    uint64_t clipsOffset;
+    uint64_t channelCount;
+    uint64_t channelsOffset;
+    uint64_t keyCount;
+    uint64_t keysOffset;
+    uint64_t dependencyCount;
+    uint64_t dependenciesOffset; // MeshCacheDependency[dependencyCount] rồi tới chuỗi path
+    uint64_t dependencyBytes;
+    uint64_t fileSize;
+};
+
+struct MeshCacheDependency {
+    uint64_t mtime;
+    uint64_t size;
+    uint32_t pathOffset;        // tính từ cuối bảng dependency
+    uint32_t pathLength;
+};
+
+// Trả về false nếu không stat được file nguồn
+bool MakeMeshCacheKey(const char* sourcePath, unsigned int importFlags, MeshCacheKey& outKey);
+std::string MeshCachePath(const char* sourcePath, unsigned int importFlags);
+
+// dependencies: file phụ (texture ngoài) được stat lúc ghi, kiểm lại mỗi lần Open có key
+bool WriteMeshCache(const std::string& cachePath, const MeshCacheKey& key, const MeshView& mesh,
+                    const std::vector<std::string>& dependencies = {});
+
+// --- MEMORY-MAPPED FILE (read-only) ---
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    bool Open(const std::string& path);
+    void Close();
+
+    const unsigned char* Data() const { return m_Data; }
+    size_t Size() const { return m_Size; }
+    bool IsOpen() const { return m_Data != nullptr; }
+
+private:
+    const unsigned char* m_Data = nullptr;
+    size_t m_Size = 0;
+#ifdef _WIN32
+    void* m_File = nullptr;
+    void* m_Mapping = nullptr;
+#endif
+};
+
+// --- READER ---
+// Không parse, không copy: View() trỏ thẳng vào vùng nhớ đã map.
+class MeshCacheReader {
+public:
+    // expectedKey == nullptr: bỏ qua kiểm tra key (dùng cho tool inspect)
+    bool Open(const std::string& cachePath, const MeshCacheKey* expectedKey);
+    void Close();
+
+    const MeshCacheHeader* Header() const { return m_Header; }
+    const MeshView& View() const { return m_View; }
+    bool IsOpen() const { return m_Header != nullptr; }
+    // Path các file phụ trong bảng dependency
+    void Dependencies(std::vector<std::string>& out) const;
+
+private:
+    MappedFile m_File;
+    const MeshCacheHeader* m_Header = nullptr;
+    MeshView m_View;
+};
@@ -0,0 +1,216 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+constexpr unsigned int kMaxMeshLods = 5; // gồm LOD 0
+
+// Một level chi tiết: index riêng trong cùng EBO (cùng indexSize), dùng chung vertex với LOD 0
+struct MeshLod {
+    unsigned int indexOffset;   // byte offset trong index buffer
+    unsigned int indexCount;
+    float error;                // sai số hình học so với LOD 0, đơn vị local
+};
+
+// MeshPart nằm nguyên trong file cache nên phải là POD, không con trỏ.
+// Index của part là local, vẽ bằng glDrawElementsBaseVertex(..., baseVertex).
+struct MeshPart {
+    unsigned int indexOffset;   // byte offset trong index buffer
+    unsigned int indexCount;
+    unsigned int baseVertex;
+    unsigned int vertexCount;
+    unsigned int indexSize;     // 2 (GL_UNSIGNED_SHORT) hoặc 4 (GL_UNSIGNED_INT)
+    float color[4];             // base color factor (nhân với texture nếu có)
+    int textureIndex;           // vào bảng texture của mesh, -1 = không có
+    unsigned int skinned;       // 1 = vertex có trong skin stream, vị trí phụ thuộc pose
+    float boundsMin[3];         // AABB local của part
+    float boundsMax[3];
+    float sphere[4];            // tâm (xyz) + bán kính (w), tâm = tâm AABB
+    unsigned int lodCount;      // 0 = chưa sinh LOD (part thô); nếu > 0 thì lods[0] trùng indexOffset/indexCount
+    MeshLod lods[kMaxMeshLods]; // error tăng dần theo level
+};
+static_assert(std::is_trivially_copyable<MeshPart>::value, "MeshPart is stored raw in the mesh cache");
+
+inline unsigned int PartLodCount(const MeshPart& part) { return part.lodCount ? part.lodCount : 1; }
+
+// level vượt quá số LOD thì lấy level thô nhất
+inline MeshLod PartLod(const MeshPart& part, unsigned int level) {
+    if (part.lodCount == 0) return { part.indexOffset, part.indexCount, 0.0f };
+    return part.lods[level < part.lodCount ? level : part.lodCount - 1];
+}
+
+// Node của scene graph (chế độ import giữ hierarchy). Lưu theo thứ tự DFS pre-order:
+// parent luôn đứng trước con, subtree của node i là [i, i + subtreeSize).
+struct SceneNode {
+    int parent;                 // -1 = root
+    unsigned int subtreeSize;
+    unsigned int firstMeshRef;  // vào bảng meshRefs (index của MeshPart)
+    unsigned int meshRefCount;
+    float local[16];            // column-major, giống glm::mat4
+};
+static_assert(std::is_trivially_copyable<SceneNode>::value, "SceneNode is stored raw in the mesh cache");
+
+// Vertex layout: position (3 float) + UV kênh 0 (2 float) liên tiếp
+constexpr unsigned int kVertexFloatCount = 5;
+constexpr unsigned int kVertexStride = kVertexFloatCount * sizeof(float);
+
+// --- TEXTURES ---
+// Texture đã "nấu": đủ chuỗi mip, mỗi mip một khối nén liền trong texture blob.
+// Cũng nằm nguyên trong file cache nên là POD.
+constexpr unsigned int kMaxTextureMips = 16; // tới 32768 px
+
+enum class TextureFormat : uint32_t {
+    RGBA8 = 0,
+    BC1 = 1,    // DXT1: RGB, 4 bit/pixel
+    BC3 = 2,    // DXT5: RGB + alpha riêng, 8 bit/pixel
+};
+
+struct TextureMip {
+    uint64_t offset;            // byte offset trong texture blob
+    uint64_t size;
+};
+
+struct TextureDesc {
+    TextureFormat format;
+    uint32_t width;             // của mip 0
+    uint32_t height;
+    uint32_t mipCount;          // tới 1x1
+    TextureMip mips[kMaxTextureMips];
+};
+static_assert(std::is_trivially_copyable<TextureDesc>::value, "TextureDesc is stored raw in the mesh cache");
+
+inline uint32_t MipExtent(uint32_t size, unsigned int level) { return size >> level ? size >> level : 1; }
+
+// --- SKINNING + ANIMATION ---
+// Skin stream song song với vertex buffer (cùng index vertex): rỗng nếu không part nào skinned,
+// vertex của part không skinned có weight = 0. Tối đa 4 xương / vertex (aiProcess_LimitBoneWeights).
+constexpr unsigned int kMaxVertexInfluences = 4;
+
+struct VertexSkin {
+    uint16_t joints[kMaxVertexInfluences];  // index vào bảng SkinJoint của mesh
+    float weights[kMaxVertexInfluences];    // tổng = 1, hoặc toàn 0 = không skinned
+};
+static_assert(sizeof(VertexSkin) == 24, "VertexSkin is a raw vertex attribute stream");
+
+// palette[j] = inverse(world[skinNode]) * world[node] * inverseBind:
+// vertex sau skinning vẫn ở không gian của node chứa mesh, instance matrix áp dụng như mesh tĩnh.
+struct SkinJoint {
+    uint32_t node;              // node xương
+    uint32_t skinNode;          // node đầu tiên tham chiếu mesh dùng xương này
+    float inverseBind[16];      // aiBone::mOffsetMatrix, column-major
+};
+
+enum AnimationTrack : uint32_t {
+    kTrackTranslation = 0,
+    kTrackRotation = 1,
+    kTrackScale = 2,
+    kTrackCount = 3,
+};
+
+struct AnimationClip {
+    char name[64];
+    float duration;             // giây
+    uint32_t firstChannel;
+    uint32_t channelCount;
+};
+
+// Key của mỗi track nằm liền nhau trong bảng key, thời gian tăng dần
+struct AnimationChannel {
+    uint32_t node;
+    uint32_t firstKey[kTrackCount];
+    uint32_t keyCount[kTrackCount]; // 0 = track giữ giá trị bind của node
+};
+
+struct AnimationKey {
+    float time;                 // giây
+    float value[4];             // xyz (translation / scale) hoặc quaternion xyzw
+};
+static_assert(std::is_trivially_copyable<AnimationClip>::value && std::is_trivially_copyable<AnimationChannel>::value
+              && std::is_trivially_copyable<AnimationKey>::value && std::is_trivially_copyable<SkinJoint>::value,
+              "animation tables are stored raw in the mesh cache");
+
+// --- VIEW (không sở hữu dữ liệu) ---
+// Trỏ vào MeshData hoặc vào vùng mmap của file cache, upload thẳng lên GPU.
+struct MeshView {
+    const MeshPart* parts = nullptr;
+    size_t partCount = 0;
+
+    const void* vertexData = nullptr;
+    size_t vertexCount = 0;
+
+    const void* indexData = nullptr;
+    size_t indexBytes = 0;          // 16-bit và 32-bit nằm chung một buffer
+
+    // Rỗng khi import flattened (PreTransformVertices): mỗi part một instance identity
+    const SceneNode* nodes = nullptr;
+    size_t nodeCount = 0;
+    const unsigned int* meshRefs = nullptr;
+    size_t meshRefCount = 0;
+
+    const TextureDesc* textures = nullptr;
+    size_t textureCount = 0;
+    const void* textureData = nullptr;
+    size_t textureBytes = 0;
+
+    const VertexSkin* skin = nullptr;   // vertexCount phần tử, hoặc nullptr
+    const SkinJoint* joints = nullptr;
+    size_t jointCount = 0;
+    const AnimationClip* clips = nullptr;
+    size_t clipCount = 0;
+    const AnimationChannel* channels = nullptr;
+    size_t channelCount = 0;
+    const AnimationKey* keys = nullptr;
+    size_t keyCount = 0;
+
+    size_t VertexBytes() const { return vertexCount * kVertexStride; }
+    size_t IndexBytes() const { return indexBytes; }
+    bool Empty() const { return partCount == 0; }
+};
+
+// --- OWNED DATA (kết quả import từ Assimp) ---
+struct MeshData {
+    std::vector<float> vertices;
+    std::vector<unsigned char> indices;
+    std::vector<MeshPart> parts;
+    std::vector<SceneNode> nodes;
+    std::vector<unsigned int> meshRefs;
+    std::vector<TextureDesc> textures;
+    std::vector<unsigned char> textureData;
+    std::vector<std::string> textureFiles; // file texture ngoài model, thuộc cache key (không nằm trong view)
+    std::vector<VertexSkin> skin;          // rỗng hoặc đủ vertices.size() / kVertexFloatCount
+    std::vector<SkinJoint> joints;
+    std::vector<AnimationClip> clips;
+    std::vector<AnimationChannel> channels;
+    std::vector<AnimationKey> keys;
+
+    MeshView View() const {
+        MeshView view;
+        view.parts = parts.data();
+        view.partCount = parts.size();
+        view.vertexData = vertices.data();
+        view.vertexCount = vertices.size() / kVertexFloatCount;
+        view.indexData = indices.data();
+        view.indexBytes = indices.size();
+        view.nodes = nodes.data();
+        view.nodeCount = nodes.size();
+        view.meshRefs = meshRefs.data();
+        view.meshRefCount = meshRefs.size();
+        view.textures = textures.data();
+        view.textureCount = textures.size();
+        view.textureData = textureData.data();
+        view.textureBytes = textureData.size();
+        view.skin = skin.empty() ? nullptr : skin.data();
+        view.joints = joints.data();
+        view.jointCount = joints.size();
+        view.clips = clips.data();
+        view.clipCount = clips.size();
+        view.channels = channels.data();
+        view.channelCount = channels.size();
+        view.keys = keys.data();
+        view.keyCount = keys.size();
+        return view;
+    }
+};
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "JobSystem.h"
+#include "MeshData.h"
+#include "MeshSimplifier.h"
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+// --- MESH OPTIMIZATION (CPU thuần, không cần GPU) ---
+// Chạy giữa bước import và upload:
+//   1. Weld các vertex trùng nhau (hash theo bit của vertex)
+//   2. Sắp xếp lại tam giác cho post-transform cache (thuật toán Forsyth)
+//   3. Sắp xếp lại vertex theo thứ tự dùng lần đầu (fetch locality)
+//   4. Chọn index 16-bit khi part có <= 65536 vertex
+//   5. Tính AABB + bounding sphere cho part
+//   6. Sinh chuỗi LOD bằng QEM (MeshSimplifier), index các level xếp sau LOD 0 trong cùng buffer
+
+constexpr unsigned int kCacheSimSize = 16; // FIFO dùng để tính ACMR
+
+struct MeshPartStats {
+    size_t vertexCountBefore = 0;
+    size_t vertexCountAfter = 0;
+    size_t triangleCount = 0;
+    float acmrBefore = 0.0f;
+    float acmrAfter = 0.0f;
+    size_t vertexBytesBefore = 0;
+    size_t vertexBytesAfter = 0;
+    size_t indexBytesBefore = 0;
+    size_t indexBytesAfter = 0;   // chỉ LOD 0
+    size_t lodIndexBytes = 0;     // index của LOD 1+
+};
+
+// Trả về số vertex sau khi weld. remap[i] = vertex mới của vertex cũ i.
+size_t WeldVertices(const float* vertices, size_t vertexCount, size_t floatStride, std::vector<unsigned int>& remap);
+
+// Sắp xếp lại tam giác tại chỗ (index local, < vertexCount)
+void OptimizeVertexCache(unsigned int* indices, size_t indexCount, size_t vertexCount);
+
+// Sắp xếp lại vertex theo thứ tự xuất hiện trong index buffer, viết lại index.
+// Trả về số vertex còn được tham chiếu.
+size_t OptimizeVertexFetch(float* vertices, size_t vertexCount, size_t floatStride,
+                           unsigned int* indices, size_t indexCount);
+
+// Average Cache Miss Ratio: số vertex phải transform / số tam giác
+float ComputeACMR(const unsigned int* indices, size_t indexCount, size_t vertexCount,
+                  unsigned int cacheSize = kCacheSimSize);
+
+// AABB + sphere (tâm AABB, bán kính = khoảng cách vertex xa nhất)
+void ComputePartBounds(const float* vertices, size_t vertexCount, size_t floatStride, MeshPart& part);
+
+// Index local (so với baseVertex) của một level của part, đọc theo indexSize của part
+void ReadLodIndices(const MeshData& mesh, const MeshPart& part, const MeshLod& lod, std::vector<unsigned int>& out);
+
+// Đầu vào: mesh vừa import (index 32-bit local theo từng part).
+// Đầu ra: mesh đã tối ưu, index 16/32-bit trộn chung một buffer.
+// Các part được tối ưu song song trên `jobs`; kết quả không phụ thuộc số thread.
+// cancelled() được hỏi trước mỗi part (từ nhiều thread); true -> dừng, trả về false, out không dùng được
+bool OptimizeMesh(const MeshData& in, MeshData& out, std::vector<MeshPartStats>* outStats = nullptr,
+                  const LodSettings& lodSettings = LodSettings(), JobSystem& jobs = JobSystem::Global(),
+                  const std::function<bool()>& cancelled = nullptr);
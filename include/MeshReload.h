@@ -0,0 +1,82 @@
+#pragma once
+
+#include "JobSystem.h"
+#include "MeshData.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// --- HOT RELOAD: DIFF THEO PART ---
+// Model đang ở GPU được import lại: part có nội dung (vertex + skin + index mọi LOD) trùng hash với một part
+// đang resident thì giữ nguyên vùng buffer; part mới / đã đổi được cấp vùng trong chỗ trống của buffer hiện tại
+// và chỉ vùng đó được ghi bằng glBufferSubData. Hết chỗ, đổi format, hoặc chỗ trống vượt ngưỡng
+// -> upload lại toàn bộ (cũng là lúc buffer được nén lại, kèm dư địa cho lần sau).
+// Không gọi OpenGL; ghi buffer nằm ở ModelUploader.
+
+constexpr float kReloadHeadroom = 0.25f;          // upload toàn bộ cấp dư chừng này so với dữ liệu
+constexpr float kReloadCompactThreshold = 0.5f;   // chỗ trống > ngưỡng * dữ liệu đang dùng -> nén lại
+
+// First-fit trên [0, capacity); Free gộp với vùng trống kề bên
+class BufferArena {
+public:
+    void Reset(size_t capacity, size_t used);   // [0, used) đã dùng, phần còn lại trống
+    bool Allocate(size_t size, size_t alignment, size_t& outOffset);
+    void Free(size_t offset, size_t size);
+
+    size_t Capacity() const { return m_Capacity; }
+    size_t FreeBytes() const { return m_FreeBytes; }
+    size_t UsedBytes() const { return m_Capacity - m_FreeBytes; }
+    size_t FreeRangeCount() const { return m_Free.size(); }
+
+private:
+    struct Range { size_t offset, size; };
+    std::vector<Range> m_Free;      // sắp theo offset, không chồng, không kề nhau
+    size_t m_Capacity = 0;
+    size_t m_FreeBytes = 0;
+};
+
+// Hash 64-bit theo word (không dùng cho bảo mật)
+uint64_t HashBytes(const void* data, size_t size, uint64_t seed = 0x9E3779B97F4A7C15ull);
+// Theo part: vertex, skin, index của mọi LOD, số LOD / indexSize. Không gồm offset, màu, texture, bounds
+// (màu / texture lấy từ bảng part mới, không nằm trong buffer).
+void HashMeshParts(const MeshView& mesh, std::vector<uint64_t>& outHashes, JobSystem& jobs = JobSystem::Global());
+
+// Trạng thái buffer của model đang vẽ, song song với bảng MeshPart resident
+struct ResidentMesh {
+    std::vector<uint64_t> hashes;   // rỗng = không diff được, reload sẽ upload toàn bộ
+    BufferArena vertices;           // đơn vị vertex (VBO, draw ID VBO, skin VBO dùng chung chỉ số)
+    BufferArena indices;            // byte trong EBO
+    unsigned int drawIDSize = 2;
+    unsigned int vertexStride = kVertexStride; // byte / vertex của VBO chính (theo VertexFormat), để tính byte
+    bool hasSkin = false;
+};
+
+// Sau upload toàn bộ: mesh nằm liền từ offset 0 của buffer có capacity cho trước
+void ResetResidentMesh(const MeshView& mesh, std::vector<uint64_t> hashes, size_t vertexCapacity, size_t indexCapacity,
+                       unsigned int drawIDSize, unsigned int vertexStride, ResidentMesh& out);
+
+struct MeshReloadPlan {
+    struct Copy {
+        size_t source;  // trong mesh mới
+        size_t dest;    // trong buffer resident
+        size_t count;   // vertex (vertexCopies) hoặc byte (indexCopies)
+        unsigned int part; // chỉ số part mới (vertex quantized giải theo bounds của part)
+    };
+    std::vector<MeshPart> parts;            // bảng part mới, offset trỏ vào buffer resident
+    std::vector<Copy> vertexCopies;         // ghi cả VBO lẫn skin VBO
+    std::vector<Copy> indexCopies;
+    std::vector<unsigned int> drawIDParts;  // part (chỉ số mới) phải ghi lại draw ID: mới, dời chỗ hoặc đổi chỉ số
+    size_t reusedParts = 0;
+    size_t uploadedParts = 0;
+    size_t removedParts = 0;
+    size_t uploadBytes = 0;                 // gồm skin + draw ID
+    std::string fullReason;                 // lý do phải upload toàn bộ (khi Plan trả về false)
+};
+
+// true: kế hoạch incremental, resident đã được cập nhật (arena + hash).
+// false: resident giữ nguyên, caller upload toàn bộ rồi ResetResidentMesh.
+bool PlanMeshReload(const MeshView& mesh, const std::vector<uint64_t>& hashes, const MeshPart* residentParts,
+                    size_t residentCount, ResidentMesh& resident, MeshReloadPlan& outPlan,
+                    float compactThreshold = kReloadCompactThreshold);
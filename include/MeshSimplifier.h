@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// --- MESH SIMPLIFICATION (QEM, CPU thuần) ---
+// Garland-Heckbert quadric error metric với half-edge collapse: vertex chỉ được gộp vào một
+// vertex đã có, nên mọi LOD dùng lại nguyên vertex buffer của LOD 0, chỉ cần index riêng.
+// Chạy theo từng pass: sắp xếp mọi cạnh theo cost rồi collapse tham lam các cạnh không đụng nhau.
+// Không dùng random hay thứ tự hash -> cùng input luôn cho cùng output.
+//
+// Vertex nằm trên biên mở chỉ trượt dọc theo biên; vertex trùng vị trí (seam) hoặc thuộc cạnh
+// non-manifold bị khoá.
+
+// Giảm về <= targetIndexCount index, dừng sớm nếu collapse tiếp theo vượt maxError (đơn vị local).
+// outIndices phải đủ chỗ cho indexCount phần tử. Trả về số index còn lại; *outError = sai số
+// (căn của QEM trung bình theo diện tích) lớn nhất trong các collapse đã nhận.
+size_t SimplifyMesh(const float* vertices, size_t vertexCount, size_t floatStride,
+                    const unsigned int* indices, size_t indexCount,
+                    size_t targetIndexCount, float maxError,
+                    unsigned int* outIndices, float* outError = nullptr);
+
+struct LodSettings {
+    unsigned int maxLevels = 5;       // gồm LOD 0
+    float reduction = 0.5f;           // mỗi level giữ lại ~50% tam giác của level trước
+    float maxRelativeError = 0.25f;   // so với bán kính part
+    float minGain = 0.85f;            // level mới phải <= 85% level trước, không thì dừng
+    size_t minTriangles = 32;         // part nhỏ hơn không cần LOD
+};
+
+// Sinh chuỗi LOD từ LOD 0 (index local). outLods[0] = lod0, outErrors[0] = 0.
+// Mỗi level được simplify từ level trước; sai số cộng dồn nên outErrors tăng dần.
+void BuildLodChain(const float* vertices, size_t vertexCount, size_t floatStride,
+                   const std::vector<unsigned int>& lod0, float partRadius, const LodSettings& settings,
+                   std::vector<std::vector<unsigned int>>& outLods, std::vector<float>& outErrors);
+
+// Khoảng cách lớn nhất từ vertex (lấy mẫu tối đa maxSamples) tới bề mặt của indices: một chiều của Hausdorff,
+// để so với sai số mà BuildLodChain báo
+float MeasureDeviation(const float* vertices, size_t vertexCount, size_t floatStride, const std::vector<unsigned int>& indices,
+                       size_t maxSamples = 500);
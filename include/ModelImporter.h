@@ -0,0 +1,53 @@
+#pragma once
+
+#include "JobSystem.h"
+#include "MeshCache.h"
+#include "MeshData.h"
+#include "MeshOptimizer.h"
+
+#include <functional>
+#include <string>
+
+// Flags import (cũng là một phần của cache key)
+extern const unsigned int kDefaultImportFlags;    // flattened: PreTransformVertices
+extern const unsigned int kInstancedImportFlags;  // giữ aiNode hierarchy, mỗi aiMesh một bản
+
+// Nhận tiến độ 0..1, trả về false để huỷ import
+using ImportProgressFn = std::function<bool(float)>;
+
+// Import qua Assimp, không đụng tới OpenGL (chạy được trong tool / thread khác).
+// Kết quả là mesh thô (index 32-bit local theo part), chưa qua OptimizeMesh.
+bool ImportModel(const char* path, unsigned int importFlags, MeshData& outMesh, std::string* outError = nullptr,
+                 const ImportProgressFn& progress = nullptr);
+
+struct aiMesh;
+
+// Chép vertex + tam giác của các aiMesh vào outMesh (index 32-bit local, mỗi mesh một part, màu mặc định).
+// Prefix sum trên số vertex / tam giác cho offset của từng mesh, cấp phát buffer đích một lần
+// rồi điền song song từng khoảng. Kết quả giống hệt bản tuần tự, không phụ thuộc số thread.
+// progress được gọi sau mỗi mesh (từ nhiều thread); trả về false khi nó báo huỷ.
+bool ConvertMeshes(const aiMesh* const* meshes, unsigned int meshCount, MeshData& outMesh,
+                   JobSystem& jobs = JobSystem::Global(), const ImportProgressFn& progress = nullptr);
+
+// --- MODEL ASSET ---
+// Dữ liệu CPU của một model: hoặc map từ cache, hoặc vừa import xong.
+struct ModelAsset {
+    MeshData imported;
+    std::vector<MeshPartStats> optimizeStats; // rỗng nếu load từ cache
+    MeshCacheReader cache;
+    bool fromCache = false;
+    double loadMs = 0.0;
+    std::vector<uint64_t> partHashes;   // HashMeshParts, chỉ khi loader được yêu cầu (hot reload)
+    uint64_t textureHash = 0;           // bảng texture + dữ liệu nén, cùng điều kiện
+
+    MeshView View() const { return fromCache ? cache.View() : imported.View(); }
+    // File texture ngoài model (để watch khi hot reload)
+    void DependencyFiles(std::vector<std::string>& out) const {
+        if (fromCache) cache.Dependencies(out);
+        else out = imported.textureFiles;
+    }
+};
+
+// Warm start: mmap cache nếu key khớp. Cold start: import, tối ưu rồi ghi cache.
+bool LoadModelAsset(const char* path, unsigned int importFlags, ModelAsset& outAsset, bool useCache = true,
+                    const ImportProgressFn& progress = nullptr, std::string* outError = nullptr);
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "DrawBatch.h"
+#include "MeshData.h"
+#include "RenderDevice.h"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <string>
+
+// --- SUBMIT MODEL (không gọi GL trực tiếp) ---
+// Lệnh vẽ model của một frame đi qua RenderDevice: Application chạy với GLRenderBackend,
+// meshcook check-device chạy cùng hàm này với RecordingBackend để đếm lệnh mà không cần GPU.
+
+// Camera dùng chung, std140; một UBO, ghi một lần mỗi frame (RenderDevice::UpdateUniformBuffer)
+struct CameraBlock {
+    glm::mat4 projection;
+    glm::mat4 view;
+    glm::mat4 model;
+};
+static_assert(sizeof(CameraBlock) == 192, "CameraBlock mirrors the std140 Camera block");
+
+constexpr unsigned int kCameraBlockBinding = 0;
+
+// Texture unit của shaders/model.*
+constexpr unsigned int kUnitMaterials = 0;
+constexpr unsigned int kUnitInstances = 1;
+constexpr unsigned int kUnitInstanceIndices = 2;
+constexpr unsigned int kUnitBaseColor = 3;
+constexpr unsigned int kUnitPalette = 4;
+constexpr unsigned int kUnitPartDecode = 5;
+
+// Sampler unit + block binding truyền cho ShaderProgram::Load, gán lúc link
+ProgramBindings ModelProgramBindings();
+
+// Location cache từ reflection; Resolve lại sau mỗi lần program đổi (hot reload)
+struct ModelUniforms {
+    uint64_t serial = 0;
+    int color = -1;
+    int useMaterials = -1;
+    int instanceBase = -1;
+    int hasTexture = -1;
+    int gpuSkinning = -1;
+    int quantizedPositions = -1;
+
+    // false + error nếu block Camera không khớp CameraBlock
+    bool Resolve(const ProgramReflection& program, std::string& error);
+};
+
+struct ModelSubmitInput {
+    const ProgramReflection* program = nullptr;
+    const ModelUniforms* uniforms = nullptr;
+    unsigned int cameraBuffer = 0;
+    const CameraBlock* camera = nullptr;
+
+    unsigned int modelVAO = 0;
+    unsigned int skinnedVAO = 0;                    // 0 = không có stream CPU skinning
+    const unsigned int* skinnedBase = nullptr;      // theo part, ~0u = không skinned (cần khi skinnedVAO != 0)
+    const unsigned int* textureHandles = nullptr;   // theo MeshPart::textureIndex, 0 = không có
+    size_t textureCount = 0;
+
+    unsigned int materialTexture = 0;
+    unsigned int instanceTexture = 0;
+    unsigned int instanceIndexTexture = 0;
+    unsigned int paletteTexture = 0;
+    unsigned int partDecodeTexture = 0;
+
+    bool wireframe = false;
+    bool batched = true;
+    bool flattened = false;
+    bool gpuSkinning = false;
+    bool cpuSkinning = false;
+    bool quantizedPositions = false;
+    bool useOverrideColor = false;
+    float overrideColor[3] = { 1.0f, 1.0f, 1.0f };
+
+    const MeshPart* parts = nullptr;
+    size_t partCount = 0;
+    const unsigned int* visibleOffset = nullptr;    // partCount * kMaxMeshLods + 1
+    const DrawList* drawList = nullptr;             // khi batched && flattened
+};
+
+// Trả về số draw call đã gửi
+int SubmitModel(RenderDevice& device, const ModelSubmitInput& input);
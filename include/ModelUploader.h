@@ -0,0 +1,77 @@
+#pragma once
+
+#include "MeshData.h"
+#include "MeshReload.h"
+#include "VertexFormat.h"
+
+#include <cstddef>
+#include <vector>
+
+// --- INCREMENTAL GPU UPLOAD ---
+// Upload VBO/EBO mới rải qua nhiều frame (tối đa budget byte/frame).
+// Model cũ vẫn render bình thường cho tới khi IsComplete() rồi mới swap.
+class ModelUploader {
+public:
+    ~ModelUploader();
+
+    // mesh phải còn sống (cache còn map) cho tới khi upload xong.
+    // headroom: buffer cấp dư (tỉ lệ so với dữ liệu) để hot reload ghi part mới vào chỗ trống.
+    // format: Quantized thì vertex được mã hoá ở đây (song song theo part) rồi mới upload.
+    void Begin(const MeshView& mesh, float headroom = 0.0f, VertexFormat format = VertexFormat::Float);
+    // Trả về true khi đã upload hết
+    bool Step(size_t byteBudget);
+    void Abort();
+
+    bool IsActive() const { return m_Active; }
+    float Progress() const { return m_TotalBytes ? (float)m_Uploaded / (float)m_TotalBytes : 1.0f; }
+
+    // Chuyển quyền sở hữu buffer cho caller, uploader về trạng thái rỗng
+    struct Result {
+        unsigned int vao = 0;
+        unsigned int vbo = 0;
+        unsigned int drawIDVBO = 0;   // draw ID theo vertex cho batched path
+        unsigned int skinVBO = 0;     // VertexSkin theo vertex (attrib 3/4), 0 nếu mesh không skinned
+        unsigned int ebo = 0;
+        std::vector<MeshPart> parts;
+        size_t vertexCapacity = 0;    // vertex, gồm headroom
+        size_t indexCapacity = 0;     // byte
+        unsigned int drawIDSize = 2;
+        VertexFormat vertexFormat = VertexFormat::Float;
+    };
+    void Release(Result& out);
+
+private:
+    // Một vùng nguồn -> một buffer đích, đổ dần theo budget
+    struct Segment {
+        unsigned int target;  // GL_ARRAY_BUFFER / GL_ELEMENT_ARRAY_BUFFER
+        unsigned int buffer;
+        const unsigned char* data;
+        size_t size;
+        size_t capacity;      // byte cấp phát, >= size
+    };
+
+    void DeleteObjects();
+
+    MeshView m_Mesh;
+    bool m_Active = false;
+    size_t m_Uploaded = 0;
+    size_t m_TotalBytes = 0;
+    std::vector<Segment> m_Segments;
+
+    std::vector<unsigned char> m_DrawIDs;
+    unsigned int m_DrawIDSize = 2;
+    VertexFormat m_Format = VertexFormat::Float;
+    std::vector<QuantizedVertex> m_Quantized;
+    float m_Headroom = 0.0f;
+
+    unsigned int m_VAO = 0;
+    unsigned int m_VBO = 0;
+    unsigned int m_DrawIDVBO = 0;
+    unsigned int m_SkinVBO = 0;
+    unsigned int m_EBO = 0;
+};
+
+// Hot reload incremental: ghi đúng các vùng trong plan vào buffer đang dùng (VAO giữ nguyên).
+// Ghi qua GL_COPY_WRITE_BUFFER để không đụng EBO gắn với VAO đang bind.
+void UploadReloadPlan(const MeshView& mesh, const MeshReloadPlan& plan, unsigned int drawIDSize, VertexFormat format,
+                      unsigned int vbo, unsigned int drawIDVBO, unsigned int skinVBO, unsigned int ebo);
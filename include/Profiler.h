@@ -0,0 +1,144 @@
+#pragma once
+
+// --- CPU PROFILER ---
+// PROFILE_SCOPE("Tên") đo thời gian một khối, ghi vào ring buffer riêng của thread
+// (chỉ thread đó ghi, không lock). Render thread gom mọi ring một lần mỗi frame trong EndFrame():
+// cập nhật thống kê theo zone cho overlay và, khi đang capture, lưu event để xuất Chrome trace.
+//
+// Tên zone phải là chuỗi hằng (so sánh theo con trỏ).
+// Build không bật APP_PROFILER: mọi macro thành rỗng, không còn lời gọi nào.
+
+#ifndef APP_PROFILER
+#define APP_PROFILER 0
+#endif
+
+#if APP_PROFILER
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class Profiler {
+public:
+    static constexpr size_t kRingSize = 1 << 14;    // event / thread, dư cho vài frame
+    static constexpr size_t kHistoryFrames = 240;
+
+    struct Event {
+        const char* name;
+        uint64_t startNs;
+        uint64_t endNs;
+        uint32_t depth;
+    };
+
+    struct ZoneStats {
+        const char* name = nullptr;
+        bool gpu = false;
+        float history[kHistoryFrames] = {}; // ms mỗi frame (tổng mọi lần gọi)
+        unsigned int lastCalls = 0;         // frame vừa xong
+        unsigned int pendingCalls = 0;      // frame đang gom
+    };
+
+    // Không bao giờ huỷ: thread của job system / loader có thể còn ghi lúc thoát chương trình
+    static Profiler& Get();
+
+    static uint64_t NowNs();
+    static void SetThreadName(const char* name);
+    static void BeginZone();
+    static void EndZone(const char* name, uint64_t startNs);
+
+    // Render thread, cuối mỗi frame
+    void EndFrame();
+    // Kết quả GPU của một frame trước (đọc trễ); cpuStartNs = lúc gửi lệnh, dùng để đặt trên trace
+    void AddGpuZone(const char* name, uint64_t cpuStartNs, double ms);
+
+    void StartCapture(unsigned int frames, const std::string& path);
+    bool IsCapturing() const { return m_CaptureFramesLeft > 0; }
+    const std::string& CaptureStatus() const { return m_CaptureStatus; }
+
+    // Lịch sử theo frame, mới nhất ở cuối (index kHistoryFrames - 1 sau khi xoay)
+    size_t HistoryCursor() const { return m_HistoryCursor; }
+    const float* FrameHistory() const { return m_FrameMs; }
+    const float* GpuHistory() const { return m_GpuMs; }
+    const std::vector<const ZoneStats*>& Zones() const { return m_ZoneOrder; }
+    size_t DroppedEvents() const { return m_Dropped; }
+
+private:
+    // sequence = 2 * index + 2 khi event thứ index ghi xong, lẻ khi đang ghi: EndFrame biết slot đã bị ghi đè
+    struct Slot {
+        std::atomic<uint64_t> sequence{0};
+        Event event;
+    };
+    struct ThreadLog {
+        std::string name;
+        unsigned int id = 0;
+        std::unique_ptr<Slot[]> slots{ new Slot[kRingSize] };
+        std::atomic<uint64_t> writeIndex{0};
+        uint64_t readIndex = 0; // chỉ render thread đọc/ghi
+        uint32_t depth = 0;     // chỉ thread chủ
+        std::atomic<bool> retired{false}; // thread đã thoát: EndFrame gom nốt rồi giải phóng
+    };
+    // thread_local của mỗi thread, huỷ khi thread thoát
+    struct ThreadLogHandle {
+        ThreadLog* log = nullptr;
+        ~ThreadLogHandle();
+    };
+    struct CapturedEvent {
+        Event event;
+        unsigned int thread;
+    };
+
+    Profiler() = default;
+    static ThreadLog& CurrentLog();
+    ZoneStats& Zone(const char* name, bool gpu);
+    void WriteCapture();
+
+    std::mutex m_ThreadsMutex;
+    std::vector<std::unique_ptr<ThreadLog>> m_Threads;
+    unsigned int m_NextThreadId = 1;
+    // Tên thread đã thoát trong lúc capture (trace vẫn cần metadata cho event của chúng)
+    std::vector<std::pair<unsigned int, std::string>> m_RetiredThreads;
+
+    std::unordered_map<const char*, std::unique_ptr<ZoneStats>> m_ZoneMap;
+    std::vector<const ZoneStats*> m_ZoneOrder; // theo lần đầu xuất hiện, ổn định cho UI
+    size_t m_HistoryCursor = 0;                // slot của frame đang gom
+    float m_FrameMs[kHistoryFrames] = {};
+    float m_GpuMs[kHistoryFrames] = {};
+    uint64_t m_LastFrameNs = 0;
+    size_t m_Dropped = 0;
+
+    unsigned int m_CaptureFramesLeft = 0;
+    unsigned int m_CaptureFrames = 0;
+    std::string m_CapturePath;
+    std::string m_CaptureStatus;
+    std::vector<CapturedEvent> m_CaptureEvents;
+};
+
+class ProfileZone {
+public:
+    explicit ProfileZone(const char* name) : m_Name(name), m_Start(Profiler::NowNs()) { Profiler::BeginZone(); }
+    ~ProfileZone() { Profiler::EndZone(m_Name, m_Start); }
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+private:
+    const char* m_Name;
+    uint64_t m_Start;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ProfileZone PROFILE_CONCAT(profileZone_, __LINE__)(name)
+#define PROFILE_THREAD_NAME(name) Profiler::SetThreadName(name)
+
+#else
+
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_THREAD_NAME(name) ((void)0)
+
+#endif
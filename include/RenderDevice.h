@@ -0,0 +1,206 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// --- RENDER DEVICE ---
+// Lớp mỏng giữa code vẽ và OpenGL: nhớ state đã đặt (program, VAO, polygon mode, texture theo unit,
+// UBO, giá trị uniform theo program) và bỏ lệnh không đổi gì. Không gọi GL trực tiếp: lệnh đi qua
+// RenderBackend (GLRenderBackend vẽ thật; RecordingBackend đếm lệnh, có thể chuyển tiếp hoặc không —
+// meshcook check-device chạy cả frame không cần GPU). Header / .cpp này không include GL.
+
+enum class TextureTarget : uint8_t { Texture2D = 0, Buffer = 1 };
+enum class PolygonMode : uint8_t { Fill = 0, Line = 1 };
+
+enum GpuCall : uint32_t {
+    kCallUseProgram = 0,
+    kCallBindVertexArray,
+    kCallPolygonMode,
+    kCallActiveTexture,
+    kCallBindTexture,
+    kCallUniform,
+    kCallBindBufferBase,
+    kCallBindBuffer,
+    kCallBufferData,
+    kCallBufferSubData,
+    kCallDraw,
+    kCallMultiDraw,
+    kCallCount,
+};
+const char* GpuCallName(GpuCall call);
+
+struct GpuCallCounts {
+    uint32_t calls[kCallCount] = {};
+    uint32_t Total() const;
+    void Add(const GpuCallCounts& other);
+};
+
+// --- REFLECTION ---
+// Đọc một lần sau khi link (ShaderProgram), location / layout lấy từ đây thay vì glGetUniformLocation mỗi frame
+struct UniformInfo {
+    std::string name;       // phần tử mảng: tên không có "[0]"
+    int location;
+    uint32_t type;          // GLenum
+    int count;
+};
+
+struct UniformBlockMember {
+    std::string name;
+    int offset;             // byte trong block
+};
+
+struct UniformBlockInfo {
+    std::string name;
+    uint32_t index;
+    uint32_t binding;
+    int dataSize;
+    std::vector<UniformBlockMember> members;
+};
+
+struct ProgramReflection {
+    unsigned int program = 0;
+    uint64_t serial = 0;    // mỗi lần link một số mới: id GL có thể được dùng lại sau khi xoá program
+    std::vector<UniformInfo> uniforms;
+    std::vector<UniformBlockInfo> blocks;
+
+    int Location(const char* name) const;   // -1 nếu không có (bị compiler bỏ)
+    const UniformBlockInfo* Block(const char* name) const;
+};
+uint64_t NextProgramSerial();
+
+// Sampler -> texture unit, block -> binding point: gán một lần lúc link, không đặt lại mỗi frame
+struct ProgramBindings {
+    std::vector<std::pair<std::string, int>> samplers;
+    std::vector<std::pair<std::string, uint32_t>> blocks;
+};
+
+// Block trong program phải có đủ member ở đúng offset của struct C++ (std140), false + error nếu lệch
+bool ValidateBlockLayout(const ProgramReflection& program, const char* block, const UniformBlockMember* expected,
+                         size_t expectedCount, size_t cppSize, std::string& error);
+
+// --- BACKEND ---
+class RenderBackend {
+public:
+    virtual ~RenderBackend() = default;
+    virtual void UseProgram(unsigned int program) = 0;
+    virtual void BindVertexArray(unsigned int vao) = 0;
+    virtual void SetPolygonMode(PolygonMode mode) = 0;
+    virtual void ActiveTexture(unsigned int unit) = 0;
+    virtual void BindTexture(TextureTarget target, unsigned int texture) = 0;
+    virtual void Uniform1i(int location, int value) = 0;
+    virtual void Uniform4f(int location, const float value[4]) = 0;
+    virtual void BindUniformBufferBase(unsigned int binding, unsigned int buffer) = 0;
+    virtual void BindUniformBuffer(unsigned int buffer) = 0;
+    virtual void UniformBufferData(size_t size, const void* data) = 0;   // GL_STREAM_DRAW
+    virtual void UniformBufferSubData(size_t offset, size_t size, const void* data) = 0;
+    // Tam giác, index 2 hoặc 4 byte; instanceCount 0 = không instanced
+    virtual void DrawElements(unsigned int indexSize, int count, size_t indexOffset, int baseVertex,
+                              unsigned int instanceCount) = 0;
+    virtual void MultiDrawElements(unsigned int indexSize, const int* counts, const void* const* offsets,
+                                   const int* baseVertices, int drawCount) = 0;
+};
+
+// Đếm lệnh theo loại; next != nullptr thì chuyển tiếp (đếm lệnh GL thật của app), nullptr = mock không GPU
+class RecordingBackend : public RenderBackend {
+public:
+    explicit RecordingBackend(RenderBackend* next = nullptr) : m_Next(next) {}
+
+    const GpuCallCounts& Counts() const { return m_Counts; }
+    void ResetCounts() { m_Counts = GpuCallCounts(); }
+    // Ghi cả thứ tự lệnh (cho check), tắt mặc định
+    void SetTrace(bool enabled) { m_TraceEnabled = enabled; m_Trace.clear(); }
+    const std::vector<GpuCall>& Trace() const { return m_Trace; }
+
+    void UseProgram(unsigned int program) override;
+    void BindVertexArray(unsigned int vao) override;
+    void SetPolygonMode(PolygonMode mode) override;
+    void ActiveTexture(unsigned int unit) override;
+    void BindTexture(TextureTarget target, unsigned int texture) override;
+    void Uniform1i(int location, int value) override;
+    void Uniform4f(int location, const float value[4]) override;
+    void BindUniformBufferBase(unsigned int binding, unsigned int buffer) override;
+    void BindUniformBuffer(unsigned int buffer) override;
+    void UniformBufferData(size_t size, const void* data) override;
+    void UniformBufferSubData(size_t offset, size_t size, const void* data) override;
+    void DrawElements(unsigned int indexSize, int count, size_t indexOffset, int baseVertex,
+                      unsigned int instanceCount) override;
+    void MultiDrawElements(unsigned int indexSize, const int* counts, const void* const* offsets,
+                           const int* baseVertices, int drawCount) override;
+
+private:
+    void Record(GpuCall call) {
+        m_Counts.calls[call]++;
+        if (m_TraceEnabled) m_Trace.push_back(call);
+    }
+
+    RenderBackend* m_Next;
+    GpuCallCounts m_Counts;
+    bool m_TraceEnabled = false;
+    std::vector<GpuCall> m_Trace;
+};
+
+// --- DEVICE ---
+constexpr unsigned int kMaxTextureUnits = 16;
+constexpr unsigned int kMaxUniformBufferBindings = 8;
+
+class RenderDevice {
+public:
+    explicit RenderDevice(RenderBackend* backend = nullptr) : m_Backend(backend) { Invalidate(); }
+    void SetBackend(RenderBackend* backend) { m_Backend = backend; Invalidate(); }
+
+    // Quên hết state đã nhớ (context mới, hoặc code ngoài device đã đổi state không rõ)
+    void Invalidate();
+    // Đầu mỗi lần submit: quên binding mà code ngoài device hay đổi (VAO, texture, UBO generic —
+    // uploader, texture streaming, ImGui). Program, polygon mode và giá trị uniform được giữ qua frame:
+    // ImGui trả lại program / polygon mode cũ, uniform nằm trong program object.
+    void BeginFrame();
+    // Cuối lần submit: trả VAO 0 và active unit 0 cho code ngoài device (uploader, texture streaming)
+    void EndFrame();
+
+    void UseProgram(const ProgramReflection& program);
+    void BindVertexArray(unsigned int vao);
+    void SetPolygonMode(PolygonMode mode);
+    void BindTexture(unsigned int unit, TextureTarget target, unsigned int texture);
+    void SetUniform(int location, int value);               // của program đang dùng; location < 0 bỏ qua
+    void SetUniform(int location, const float value[4]);
+    void BindUniformBuffer(unsigned int binding, unsigned int buffer);
+    // Orphan (BufferData rỗng) rồi ghi: không chờ GPU đọc xong bản của frame trước
+    void UpdateUniformBuffer(unsigned int buffer, const void* data, size_t size);
+    void DrawElements(unsigned int indexSize, int count, size_t indexOffset, int baseVertex, unsigned int instanceCount = 0);
+    void MultiDrawElements(unsigned int indexSize, const int* counts, const void* const* offsets, const int* baseVertices,
+                           int drawCount);
+
+    // Lệnh bị bỏ vì không đổi state, theo loại (từ lúc ResetSkipped)
+    const GpuCallCounts& Skipped() const { return m_Skipped; }
+    void ResetSkipped() { m_Skipped = GpuCallCounts(); }
+
+private:
+    struct UniformValue {
+        uint8_t kind = 0;   // 0 = chưa biết, 1 = int, 2 = vec4
+        int i = 0;
+        float f[4] = {};
+    };
+    struct ProgramCache {
+        uint64_t serial = 0;
+        std::vector<UniformValue> values;   // theo location
+    };
+    UniformValue* CachedUniform(int location);
+
+    RenderBackend* m_Backend;
+    GpuCallCounts m_Skipped;
+
+    static constexpr unsigned int kUnknown = ~0u;
+    unsigned int m_Program;
+    ProgramCache* m_ProgramCache = nullptr;
+    std::unordered_map<unsigned int, ProgramCache> m_ProgramCaches;
+    unsigned int m_VAO;
+    uint8_t m_PolygonMode;
+    unsigned int m_ActiveUnit;
+    unsigned int m_Textures[kMaxTextureUnits][2];
+    unsigned int m_UniformBindings[kMaxUniformBufferBindings];
+    unsigned int m_UniformBuffer;           // binding generic của GL_UNIFORM_BUFFER
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Culling.h"
+#include "MeshData.h"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// --- SCENE GRAPH + INSTANCE ARRAYS ---
+// World matrix được cache dạng phẳng theo thứ tự pre-order. Đổi local transform chỉ
+// đánh dấu node dirty; UpdateWorldTransforms() tính lại đúng các subtree bị dirty
+// (mỗi subtree là một khoảng liên tục) và ghi thẳng vào instance array.
+//
+// Instance array xếp theo part: instance của part p nằm ở
+// [InstanceOffset(p), InstanceOffset(p) + InstanceCount(p)), đúng layout upload lên GPU.
+class SceneGraph {
+public:
+    // nodeCount == 0 (model flattened): mỗi part một instance identity
+    void Build(const MeshView& mesh);
+    void Clear();
+
+    size_t NodeCount() const { return m_Parent.size(); }
+    size_t PartCount() const { return m_InstanceOffset.empty() ? 0 : m_InstanceOffset.size() - 1; }
+    bool IsFlattened() const { return m_Parent.empty(); }
+
+    const glm::mat4& LocalTransform(size_t node) const { return m_Local[node]; }
+    void SetLocalTransform(size_t node, const glm::mat4& local);
+    const glm::mat4& WorldTransform(size_t node) const { return m_World[node]; }
+
+    // Trả về số node đã tính lại (0 nếu không có gì dirty)
+    size_t UpdateWorldTransforms();
+
+    unsigned int InstanceOffset(size_t part) const { return m_InstanceOffset[part]; }
+    unsigned int InstanceCount(size_t part) const { return m_InstanceOffset[part + 1] - m_InstanceOffset[part]; }
+    size_t TotalInstances() const { return m_Instances.size(); }
+    const std::vector<glm::mat4>& Instances() const { return m_Instances; }
+    // AABB (không gian model) của từng instance, cập nhật cùng lúc với matrix
+    const std::vector<AABB>& InstanceBounds() const { return m_InstanceBounds; }
+
+    // Khoảng instance bị thay đổi kể từ lần ClearInstanceChanges() trước (để upload một phần)
+    bool InstancesChanged() const { return m_ChangedBegin < m_ChangedEnd; }
+    size_t ChangedBegin() const { return m_ChangedBegin; }
+    size_t ChangedEnd() const { return m_ChangedEnd; }
+    void ClearInstanceChanges();
+
+private:
+    void WriteInstance(size_t slot, const glm::mat4& world);
+
+    // SoA theo node
+    std::vector<int> m_Parent;
+    std::vector<unsigned int> m_SubtreeSize;
+    std::vector<glm::mat4> m_Local;
+    std::vector<glm::mat4> m_World;
+    std::vector<uint8_t> m_Dirty;
+    bool m_AnyDirty = false;
+
+    // Node -> các slot instance của nó (CSR)
+    std::vector<unsigned int> m_NodeSlotOffset;
+    std::vector<unsigned int> m_NodeSlots;
+
+    std::vector<unsigned int> m_InstanceOffset; // partCount + 1 phần tử
+    std::vector<unsigned int> m_InstancePart;   // slot -> part
+    std::vector<glm::mat4> m_Instances;
+    std::vector<AABB> m_PartBounds;
+    std::vector<AABB> m_InstanceBounds;
+    size_t m_ChangedBegin = 0;
+    size_t m_ChangedEnd = 0;
+};
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "RenderDevice.h"
+
+#include <functional>
+#include <string>
+
+// --- SHADER PROGRAM (nạp từ file, build lại nóng) ---
+// Reload() chỉ gửi compile + link rồi trả về; Update() mỗi frame hỏi kết quả. Driver có
+// GL_KHR/ARB_parallel_shader_compile thì compile chạy trên thread của driver và việc hỏi không block;
+// không có thì lần hỏi đầu chờ driver xong. Program mới chỉ thay program đang dùng khi link thành công,
+// lỗi thì giữ bản cũ và ghi log vào Status().
+// Sau mỗi lần link: đọc uniform / uniform block một lần (Reflection()) và gán sampler unit, block
+// binding theo ProgramBindings ngay trên program — frame không phải hỏi location hay đặt lại sampler.
+// Validator (nếu có) chạy trên reflection đó trước khi thay: layout sai cũng bị coi như lỗi link.
+class ShaderProgram {
+public:
+    using Validator = std::function<bool(const ProgramReflection& program, std::string& error)>;
+
+    ~ShaderProgram();
+
+    // Build đồng bộ lúc khởi động; false nếu không đọc được file, không link được hoặc validator từ chối
+    bool Load(const std::string& vertexPath, const std::string& fragmentPath,
+              const ProgramBindings& bindings = ProgramBindings(), Validator validator = nullptr);
+    void Reload();
+    // true khi vừa chuyển sang program mới
+    bool Update();
+    void Destroy();
+
+    unsigned int Id() const { return m_Program; }
+    // Của program đang dùng; đổi (serial mới) mỗi lần Update() trả về true
+    const ProgramReflection& Reflection() const { return m_Reflection; }
+    bool Pending() const { return m_PendingProgram != 0; }
+    const std::string& VertexPath() const { return m_VertexPath; }
+    const std::string& FragmentPath() const { return m_FragmentPath; }
+    const std::string& Status() const { return m_Status; }
+
+private:
+    // Gửi compile + link; 0 nếu không đọc được file (m_Status có lỗi)
+    unsigned int Submit();
+    // Kết quả của program đã gửi: true = link được và qua validator; false = lỗi (program bị xóa), log vào m_Status
+    bool Finish(unsigned int program);
+    // Đọc uniform / block của program vừa link và gán binding
+    void Reflect(unsigned int program, ProgramReflection& out) const;
+
+    std::string m_VertexPath;
+    std::string m_FragmentPath;
+    ProgramBindings m_Bindings;
+    Validator m_Validator;
+    ProgramReflection m_Reflection;
+    ProgramReflection m_PendingReflection;
+    unsigned int m_Program = 0;
+    unsigned int m_PendingProgram = 0;
+    unsigned int m_PendingShaders[2] = {0, 0};
+    bool m_ParallelCompile = false;
+    std::string m_Status;
+};
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "JobSystem.h"
+#include "MeshData.h"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <vector>
+
+// --- CPU SKINNING (CPU thuần) ---
+// Linear blend skinning tối đa 4 xương / vertex. Vertex vào / ra cùng layout kVertexFloatCount
+// (UV chép nguyên); vertex có weight toàn 0 giữ nguyên vị trí.
+// Bản SIMD (SSE/NEON) giữ mỗi cột matrix trong một thanh ghi 4 lane, bỏ qua influence weight 0.
+
+void SkinVertices(const float* vertices, const VertexSkin* skin, size_t count, const glm::mat4* palette, float* out);
+void SkinVerticesScalar(const float* vertices, const VertexSkin* skin, size_t count, const glm::mat4* palette,
+                        float* out);
+// Chia theo khoảng vertex trên JobSystem
+void SkinVerticesParallel(const float* vertices, const VertexSkin* skin, size_t count, const glm::mat4* palette,
+                          float* out, JobSystem& jobs = JobSystem::Global());
+const char* SkinSimdName();
+
+// Gom vertex + skin của các part skinned vào mảng liền (nguồn cho CPU skinning và VBO stream riêng).
+// outBase[p] = base vertex của part p trong mảng gom, ~0u nếu không skinned. Trả về số vertex gom được.
+size_t GatherSkinnedVertices(const MeshView& mesh, std::vector<float>& outVertices, std::vector<VertexSkin>& outSkin,
+                             std::vector<unsigned int>& outBase);
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "MeshData.h"
+#include "TextureCodec.h"
+
+#include <cstddef>
+#include <vector>
+
+// --- DỮ LIỆU TỔNG HỢP (CPU thuần) ---
+// Mesh / ảnh / nhân vật dựng bằng code, seed cố định: meshcook bench-* / check-* chạy được khi không có
+// file model, renderer_tests dùng cùng dữ liệu.
+
+// Part giả lập: xen kẽ 16/32-bit, index nối tiếp nhau trong EBO
+void MakeSyntheticParts(size_t count, std::vector<MeshPart>& parts);
+
+// Mặt cầu UV (N x N ô), giữ vertex trùng ở đường nối và ở hai cực như mesh import thật
+void MakeSphere(unsigned int segments, MeshData& out);
+
+// Ảnh thử: gradient + ô cờ + nhiễu, alpha = hình tròn mềm (chỉ dùng khi withAlpha)
+void MakeSyntheticImage(unsigned int size, bool withAlpha, Image& out);
+
+// Nhân vật giả lập: 5 chuỗi xương toả ra từ root (pre-order), mỗi vertex bám 3 xương kề nhau,
+// 2 clip (sóng quanh z ở 30 key/s, xoắn quanh y + scale) để thử trộn
+void MakeSyntheticCharacter(unsigned int bones, unsigned int vertexCount, MeshData& out);
+
+// Scene giả lập: một mesh lưới lặp lại N lần, chia vào các group 64 node (root, group, rồi các node có mesh)
+void MakeSyntheticScene(size_t repeats, MeshData& out);
+// Giống PreTransformVertices: mỗi instance một bản copy đã transform, part theo thứ tự instance, chỉ LOD 0
+void FlattenScene(const MeshData& in, MeshData& out);
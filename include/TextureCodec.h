@@ -0,0 +1,48 @@
+#pragma once
+
+#include "JobSystem.h"
+#include "MeshData.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// --- TEXTURE CODEC (CPU thuần, không OpenGL) ---
+// Decode qua stb_image, sinh mip trên CPU, nén block BC1 (RGB) / BC3 (RGB + alpha).
+// Chạy được trên thread bất kỳ; phần nặng chia theo hàng block qua JobSystem.
+//
+// GL 4.1 không có BPTC (BC7) nên chỉ dùng định dạng S3TC. Màu được lọc mip trong không gian
+// tuyến tính (coi dữ liệu là sRGB) rồi mã hoá lại, để mip xa không bị tối đi.
+
+// Mỗi mip bắt đầu ở bội số của 16 byte trong texture blob
+constexpr size_t kTextureAlignment = 16;
+
+struct Image {
+    unsigned int width = 0;
+    unsigned int height = 0;
+    std::vector<unsigned char> rgba; // 8 bit/kênh, hàng đầu tiên là hàng trên cùng
+};
+
+// Luôn ra 4 kênh. error nhận lý do từ stb_image khi thất bại.
+bool DecodeImage(const void* data, size_t size, Image& outImage, std::string* outError = nullptr);
+bool DecodeImageFile(const char* path, Image& outImage, std::string* outError = nullptr);
+
+unsigned int MipCount(unsigned int width, unsigned int height);
+size_t TextureLevelBytes(TextureFormat format, unsigned int width, unsigned int height);
+bool ImageHasAlpha(const Image& image);
+
+// Mip kế tiếp: box filter 2x2 trên màu tuyến tính (cạnh lẻ thì kẹp mép)
+void DownsampleImage(const Image& src, Image& outDst, JobSystem& jobs = JobSystem::Global());
+
+// out phải đủ TextureLevelBytes(format, width, height)
+void EncodeImage(const Image& image, TextureFormat format, unsigned char* out, JobSystem& jobs = JobSystem::Global());
+// Ngược lại của EncodeImage: cho máy không có S3TC và cho đo chất lượng
+void DecodeTextureLevel(const unsigned char* data, TextureFormat format, unsigned int width, unsigned int height,
+                        Image& outImage);
+// PSNR (dB) trên channels kênh đầu, hai ảnh cùng kích thước
+double ImagePsnr(const Image& a, const Image& b, int channels);
+
+// Sinh mip tới 1x1 rồi nén từng level (BC3 nếu có alpha, ngược lại BC1; compress = false giữ RGBA8).
+// Nối vào outBlob (mỗi mip căn lề kTextureAlignment), offset trong outDesc tính từ đầu outBlob.
+void CookTexture(const Image& base, TextureDesc& outDesc, std::vector<unsigned char>& outBlob, bool compress = true,
+                 JobSystem& jobs = JobSystem::Global());
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "MeshData.h"
+#include "TextureCodec.h"
+#include "TextureResidency.h"
+
+#include <cstddef>
+#include <vector>
+
+// --- GPU TEXTURES ---
+// Giữ bản nén trên CPU của mọi texture (cache bị unmap sau khi load xong), trên GPU chỉ có
+// các mip mà TextureResidency cho phép. Đổi mip trên cùng = tạo lại texture với ít/nhiều level hơn
+// (GL 4.1 không có sparse texture, GL_TEXTURE_BASE_LEVEL không giải phóng bộ nhớ).
+// Thả mip làm ngay; nâng mip giới hạn theo byte/frame giống ModelUploader.
+// Driver không có S3TC: giải nén BC trên CPU lúc upload.
+class TextureManager {
+public:
+    ~TextureManager();
+
+    // Bắt đầu ở mip nhỏ nhất được phép, frame sau mới stream lên theo nhu cầu
+    void Load(const MeshView& mesh);
+    void Clear();
+
+    TextureResidency& Residency() { return m_Residency; }
+    TextureResidencyParams& Params() { return m_Params; }
+    // Sau các Request của frame: tính target, thả/nâng mip (nâng tối đa uploadBudget byte, ít nhất một texture).
+    // true = còn mip phải chờ frame sau
+    bool Update(size_t uploadBudget);
+
+    // 0 nếu không có texture
+    unsigned int Handle(int texture) const {
+        return texture >= 0 && (size_t)texture < m_Textures.size() ? m_Textures[texture].handle : 0;
+    }
+    size_t Count() const { return m_Textures.size(); }
+    unsigned int ResidentMip(unsigned int texture) const { return m_Textures[texture].residentMip; }
+    size_t ResidentBytes() const { return m_ResidentBytes; }   // theo kích thước nén
+    size_t TotalBytes() const { return m_Data.size(); }       // mọi mip của mọi texture
+    bool HardwareCompression() const { return m_HasS3TC; }
+
+private:
+    struct Texture {
+        unsigned int handle = 0;
+        unsigned int residentMip = 0;
+        size_t bytes = 0;
+    };
+
+    void Upload(unsigned int index, unsigned int topMip);
+
+    std::vector<TextureDesc> m_Descs;
+    std::vector<unsigned char> m_Data;
+    std::vector<Texture> m_Textures;
+    TextureResidency m_Residency;
+    TextureResidencyParams m_Params;
+    size_t m_ResidentBytes = 0;
+    bool m_HasS3TC = false;
+    float m_MaxAnisotropy = 1.0f;
+    Image m_Scratch; // level đã giải nén khi không có S3TC
+};
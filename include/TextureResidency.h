@@ -0,0 +1,64 @@
+#pragma once
+
+#include "MeshData.h"
+#include "SceneGraph.h"
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// --- TEXTURE RESIDENCY (CPU thuần) ---
+// Mỗi frame, part visible báo kích thước trên màn hình (pixel) cho texture của nó.
+// Mip trên cùng cần giữ = level đầu tiên không lớn hơn kích thước đó.
+// Vượt budget: thả mip lớn của texture lâu không dùng trước, rồi tới texture nhỏ nhất trên màn hình
+// (xa nhất), mỗi texture tới hết mức cho phép rồi mới sang texture kế tiếp.
+// Mip nhỏ (cạnh <= minResidentSize) luôn được giữ để không bao giờ phải vẽ màu phẳng.
+
+struct TextureResidencyParams {
+    size_t budgetBytes = 128u * 1024 * 1024;
+    unsigned int unusedFrames = 120;      // không được vẽ quá số frame này -> bị thả trước mọi texture khác
+    unsigned int minResidentSize = 64;    // pixel, cạnh lớn
+    float bias = 1.0f;                    // > 1: giữ mip lớn hơn mức màn hình cần
+};
+
+class TextureResidency {
+public:
+    void Reset(const TextureDesc* textures, size_t count);
+
+    // Gọi trước mọi Request của frame
+    void BeginFrame();
+    // screenPixels: cạnh lớn của vùng texture phủ trên màn hình (lấy max trong frame)
+    void Request(unsigned int texture, float screenPixels);
+    // Tính TargetMip() cho mọi texture theo request của frame và budget
+    void Update(const TextureResidencyParams& params);
+
+    size_t Count() const { return m_Entries.size(); }
+    unsigned int TargetMip(unsigned int texture) const { return m_Entries[texture].targetMip; }
+    unsigned int WantedMip(unsigned int texture) const { return m_Entries[texture].wantedMip; }
+    // Tổng byte của mip [topMip, mipCount)
+    size_t ResidentBytes(unsigned int texture, unsigned int topMip) const;
+    size_t TargetBytes() const { return m_TargetBytes; }
+    size_t WantedBytes() const { return m_WantedBytes; }
+
+private:
+    struct Entry {
+        TextureDesc desc;
+        uint64_t lastUsedFrame = 0;     // 0 = chưa bao giờ
+        float screenPixels = 0.0f;      // của lần dùng gần nhất
+        unsigned int wantedMip = 0;
+        unsigned int targetMip = 0;
+    };
+
+    std::vector<Entry> m_Entries;
+    std::vector<unsigned int> m_Order; // scratch khi áp budget
+    uint64_t m_Frame = 0;
+    size_t m_TargetBytes = 0;
+    size_t m_WantedBytes = 0;
+};
+
+// Request cho mọi instance visible có texture (không gian model, cameraPos cùng hệ với InstanceBounds()).
+// Kích thước màn hình ước theo đường kính bounds, cùng cách chiếu với LOD.
+void RequestInstanceTextures(const MeshPart* parts, const SceneGraph& scene, const uint8_t* visible,
+                             const glm::vec3& cameraPos, float pixelsPerUnit, TextureResidency& residency);
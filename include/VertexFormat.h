@@ -0,0 +1,60 @@
+#pragma once
+
+#include "JobSystem.h"
+#include "MeshData.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// --- VERTEX FORMAT TRÊN GPU ---
+// Trên CPU và trong mesh cache vertex luôn là kVertexFloatCount float (simplifier, skinning, bounds đọc thẳng);
+// định dạng GPU được chọn lúc upload:
+// - Float:     position 3 x float + UV 2 x float, 20 byte.
+// - Quantized: position 3 x unorm16 theo AABB của part + 1 lane dự trữ (dấu bitangent khi có tangent),
+//              UV 2 x half, 12 byte. Vertex shader giải position = offset + aPos * scale, offset / scale
+//              của part lấy từ TBO theo draw ID (BuildPositionDecodeBuffer). Bounds của part phải bao
+//              mọi vertex của nó (OptimizeMesh đã tính), vertex ngoài AABB bị kẹp vào mặt hộp.
+// Normal / tangent: octahedral (Meyer et al. 2010, bản "precise" của Cigolle et al. 2014) thành cặp snorm.
+// Importer chưa xuất normal / tangent nên layout GPU chưa có lane cho chúng; encoder và đo sai số có sẵn
+// (tests/VertexFormatTests.cpp, meshcook check-vertex) để thêm attribute không phải đổi định dạng.
+enum class VertexFormat : uint32_t {
+    Float = 0,
+    Quantized = 1,
+};
+
+const char* VertexFormatName(VertexFormat format);
+bool ParseVertexFormat(const char* name, VertexFormat& out);
+unsigned int VertexFormatStride(VertexFormat format);   // byte / vertex của VBO chính
+
+struct QuantizedVertex {
+    uint16_t position[4];   // unorm16 trong AABB của part; [3] = dấu tangent (kTangentSignNegative) hoặc 0
+    uint16_t uv[2];         // half
+};
+static_assert(sizeof(QuantizedVertex) == 12, "QuantizedVertex is a raw vertex attribute stream");
+
+constexpr uint16_t kTangentSignNegative = 0xFFFF;  // unorm 1.0 -> w = -1 (w = 1 - 2 * lane)
+
+// IEEE half, làm tròn về số gần nhất (chẵn khi hoà), giữ denormal, tràn -> vô cực
+uint16_t FloatToHalf(float value);
+float HalfToFloat(uint16_t half);
+
+// value trong [min, min + extent] -> [0, 65535]; extent = 0 thì mọi giá trị về 0
+uint16_t QuantizeUnorm16(float value, float min, float extent);
+float DequantizeUnorm16(uint16_t quantized, float min, float extent);
+
+// Vector đơn vị -> 2 snorm bits bit (2..16) trong int16, giải mã theo kiểu GL 4.2+: max(q / (2^(bits-1) - 1), -1)
+void OctEncode(const float normal[3], unsigned int bits, int16_t out[2]);
+void OctDecode(const int16_t encoded[2], unsigned int bits, float out[3]);
+// Tangent xyz + w (±1, hướng bitangent): hướng octahedral, dấu vào lane [3] của position
+void PackTangent(const float tangent[4], unsigned int bits, int16_t outOct[2], uint16_t& outSignLane);
+void UnpackTangent(const int16_t oct[2], uint16_t signLane, unsigned int bits, float out[4]);
+// Góc (độ) giữa hai vector, không cần chuẩn hoá: sai số hướng sau khi mã hoá
+double AngleDegrees(const float a[3], const float b[3]);
+
+// Hằng số giải position: 2 texel RGBA32F / part (boundsMin.xyz, 0), (extent.xyz, 0), cùng chỉ số với draw ID
+void BuildPositionDecodeBuffer(const MeshPart* parts, size_t partCount, std::vector<float>& outRGBA);
+// vertexCount vertex float của một part -> Quantized theo bounds của part đó
+void QuantizeVertices(const float* vertices, size_t vertexCount, const MeshPart& part, QuantizedVertex* out);
+// Cả mesh, song song theo part; vertex không thuộc part nào để 0
+void QuantizeMesh(const MeshView& mesh, std::vector<QuantizedVertex>& out, JobSystem& jobs = JobSystem::Global());
@@ -0,0 +1,9 @@
+#version 410 core
+flat in vec4 vColor;
+in vec2 vUV;
+uniform sampler2D u_BaseColor;
+uniform int u_HasTexture;
+out vec4 FragColor;
+void main() {
+    FragColor = u_HasTexture != 0 ? vColor * texture(u_BaseColor, vUV) : vColor;
+}
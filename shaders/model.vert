@@ -0,0 +1,48 @@
+#version 410 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in uint aDrawID;
+layout (location = 2) in vec2 aUV;
+layout (location = 3) in uvec4 aJoints;
+layout (location = 4) in vec4 aWeights;
+// Khớp CameraBlock (ModelSubmit.h); binding gán lúc link (GLSL 4.10 chưa có layout(binding))
+layout (std140) uniform Camera {
+    mat4 u_Projection;
+    mat4 u_View;
+    mat4 u_Model;
+};
+uniform samplerBuffer u_Materials;
+uniform samplerBuffer u_Instances;
+uniform isamplerBuffer u_InstanceIndices;
+uniform samplerBuffer u_Palette;
+uniform samplerBuffer u_PartDecode;
+uniform int u_InstanceBase;
+uniform int u_UseMaterials;
+uniform int u_GpuSkinning;
+uniform int u_QuantizedPositions;
+uniform vec4 u_Color;
+flat out vec4 vColor;
+out vec2 vUV;
+mat4 Joint(uint j) {
+    int b = int(j) * 4;
+    return mat4(texelFetch(u_Palette, b), texelFetch(u_Palette, b + 1),
+                texelFetch(u_Palette, b + 2), texelFetch(u_Palette, b + 3));
+}
+void main() {
+    int base = texelFetch(u_InstanceIndices, u_InstanceBase + gl_InstanceID).r * 4;
+    mat4 instance = mat4(texelFetch(u_Instances, base), texelFetch(u_Instances, base + 1),
+                         texelFetch(u_Instances, base + 2), texelFetch(u_Instances, base + 3));
+    vColor = u_UseMaterials != 0 ? texelFetch(u_Materials, int(aDrawID)) : u_Color;
+    vUV = aUV;
+    vec4 position = vec4(aPos, 1.0);
+    if (u_QuantizedPositions != 0) {
+        // unorm16 trong AABB của part: offset + t * extent
+        int d = int(aDrawID) * 2;
+        position.xyz = texelFetch(u_PartDecode, d).xyz + aPos * texelFetch(u_PartDecode, d + 1).xyz;
+    }
+    if (u_GpuSkinning != 0 && aWeights != vec4(0.0)) {
+        mat4 skin = aWeights.x * Joint(aJoints.x) + aWeights.y * Joint(aJoints.y)
+                  + aWeights.z * Joint(aJoints.z) + aWeights.w * Joint(aJoints.w);
+        position = skin * position;
+    }
+    gl_Position = u_Projection * u_View * u_Model * instance * position;
+}
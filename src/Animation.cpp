@@ -0,0 +1,276 @@
+#include "Animation.h"
+
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+void LocalPose::Resize(size_t nodeCount) {
+    for (std::vector<float>* v : { &tx, &ty, &tz, &rx, &ry, &rz, &rw, &sx, &sy, &sz }) v->resize(nodeCount);
+}
+
+// --- RIG ---
+void AnimationRig::Clear() {
+    m_Parent.clear();
+    m_BindLocal.clear();
+    m_Animated.clear();
+    m_AnimatedNodes.clear();
+    m_BindPose.Resize(0);
+    m_Joints.clear();
+    m_Clips.clear();
+    m_Channels.clear();
+    m_Keys.clear();
+}
+
+void AnimationRig::Build(const MeshView& mesh) {
+    Clear();
+    const size_t nodeCount = mesh.nodeCount;
+    m_Parent.resize(nodeCount);
+    m_BindLocal.resize(nodeCount);
+    m_BindPose.Resize(nodeCount);
+    for (size_t i = 0; i < nodeCount; i++) {
+        const SceneNode& node = mesh.nodes[i];
+        m_Parent[i] = node.parent >= 0 && (size_t)node.parent < i ? node.parent : -1;
+        m_BindLocal[i] = glm::make_mat4(node.local);
+
+        // TRS của bind (không có shear); scale âm dồn vào trục x
+        const glm::mat4& m = m_BindLocal[i];
+        glm::vec3 axis[3] = { glm::vec3(m[0]), glm::vec3(m[1]), glm::vec3(m[2]) };
+        glm::vec3 scale(glm::length(axis[0]), glm::length(axis[1]), glm::length(axis[2]));
+        if (glm::dot(glm::cross(axis[0], axis[1]), axis[2]) < 0.0f) scale.x = -scale.x;
+        glm::mat3 rotation(1.0f);
+        for (int k = 0; k < 3; k++)
+            if (scale[k] != 0.0f) rotation[k] = axis[k] / scale[k];
+        glm::quat q = glm::normalize(glm::quat_cast(rotation));
+
+        m_BindPose.tx[i] = m[3].x; m_BindPose.ty[i] = m[3].y; m_BindPose.tz[i] = m[3].z;
+        m_BindPose.rx[i] = q.x; m_BindPose.ry[i] = q.y; m_BindPose.rz[i] = q.z; m_BindPose.rw[i] = q.w;
+        m_BindPose.sx[i] = scale.x; m_BindPose.sy[i] = scale.y; m_BindPose.sz[i] = scale.z;
+    }
+
+    // Joint lỗi vẫn giữ chỗ (vertex tham chiếu theo vị trí) nhưng cho palette identity
+    m_Joints.assign(mesh.joints, mesh.joints + mesh.jointCount);
+    for (SkinJoint& joint : m_Joints) {
+        if (joint.node < nodeCount && joint.skinNode < nodeCount) continue;
+        joint.node = joint.skinNode = 0;
+        const glm::mat4 identity(1.0f);
+        std::copy(glm::value_ptr(identity), glm::value_ptr(identity) + 16, joint.inverseBind);
+    }
+
+    m_Keys.assign(mesh.keys, mesh.keys + mesh.keyCount);
+    m_Channels.assign(mesh.channels, mesh.channels + mesh.channelCount);
+    m_Animated.assign(nodeCount, 0);
+    for (AnimationChannel& channel : m_Channels) {
+        bool valid = channel.node < nodeCount;
+        for (unsigned int t = 0; t < kTrackCount; t++)
+            valid = valid && (uint64_t)channel.firstKey[t] + channel.keyCount[t] <= m_Keys.size();
+        if (!valid) {
+            channel.node = 0;
+            for (unsigned int t = 0; t < kTrackCount; t++) channel.keyCount[t] = 0;
+            continue;
+        }
+        if (channel.keyCount[0] + channel.keyCount[1] + channel.keyCount[2] > 0) m_Animated[channel.node] = 1;
+    }
+    for (uint32_t i = 0; i < (uint32_t)nodeCount; i++)
+        if (m_Animated[i]) m_AnimatedNodes.push_back(i);
+
+    for (size_t i = 0; i < mesh.clipCount; i++) {
+        const AnimationClip& clip = mesh.clips[i];
+        if ((uint64_t)clip.firstChannel + clip.channelCount > m_Channels.size() || !(clip.duration >= 0.0f)) continue;
+        m_Clips.push_back(clip);
+        m_Clips.back().name[sizeof(clip.name) - 1] = '\0';
+    }
+}
+
+void AnimationRig::Advance(AnimationCursor& cursor, float dt) const {
+    if (cursor.clip < 0 || (size_t)cursor.clip >= m_Clips.size()) return;
+    const float duration = m_Clips[cursor.clip].duration;
+    if (duration <= 0.0f) {
+        cursor.time = 0.0f;
+        return;
+    }
+    cursor.time += dt;
+    if (cursor.time >= duration || cursor.time < 0.0f) {
+        cursor.time = std::fmod(cursor.time, duration);
+        if (cursor.time < 0.0f) cursor.time += duration;
+    }
+}
+
+// --- SAMPLING ---
+// Nội suy giữa key a và b; dùng chung cho bản cache và bản đối chiếu để kết quả giống hệt
+static void InterpolateKeys(const AnimationKey& a, const AnimationKey& b, unsigned int track, float time,
+                            float* outValue) {
+    const float span = b.time - a.time;
+    const float t = span > 0.0f ? std::min(std::max((time - a.time) / span, 0.0f), 1.0f) : 0.0f;
+    if (track == kTrackRotation) {
+        glm::quat qa(a.value[3], a.value[0], a.value[1], a.value[2]);
+        glm::quat qb(b.value[3], b.value[0], b.value[1], b.value[2]);
+        glm::quat q = glm::normalize(glm::slerp(qa, qb, t)); // slerp của glm đã chọn đường ngắn
+        outValue[0] = q.x; outValue[1] = q.y; outValue[2] = q.z; outValue[3] = q.w;
+    } else {
+        for (int k = 0; k < 3; k++) outValue[k] = a.value[k] + (b.value[k] - a.value[k]) * t;
+    }
+}
+
+void AnimationRig::SampleTrack(const AnimationChannel& channel, unsigned int track, uint32_t& cursor, float time,
+                               float* outValue) const {
+    const uint32_t count = channel.keyCount[track];
+    const AnimationKey* keys = m_Keys.data() + channel.firstKey[track];
+    if (count == 0) return;
+    if (count == 1 || time <= keys[0].time) {
+        cursor = 0;
+        InterpolateKeys(keys[0], keys[0], track, time, outValue);
+        return;
+    }
+
+    // Thời gian lùi (loop / tua lại): bắt đầu lại từ đầu, còn lại chỉ bước tới
+    if (cursor >= count || keys[cursor].time > time) cursor = 0;
+    while (cursor + 1 < count && keys[cursor + 1].time <= time) cursor++;
+
+    if (cursor + 1 >= count) InterpolateKeys(keys[count - 1], keys[count - 1], track, time, outValue);
+    else InterpolateKeys(keys[cursor], keys[cursor + 1], track, time, outValue);
+}
+
+static void WriteTrack(LocalPose& pose, uint32_t node, unsigned int track, const float* value) {
+    switch (track) {
+    case kTrackTranslation: pose.tx[node] = value[0]; pose.ty[node] = value[1]; pose.tz[node] = value[2]; break;
+    case kTrackRotation:
+        pose.rx[node] = value[0]; pose.ry[node] = value[1]; pose.rz[node] = value[2]; pose.rw[node] = value[3];
+        break;
+    default: pose.sx[node] = value[0]; pose.sy[node] = value[1]; pose.sz[node] = value[2]; break;
+    }
+}
+
+void AnimationRig::Sample(AnimationCursor& cursor, LocalPose& pose) const {
+    if (cursor.clip < 0 || (size_t)cursor.clip >= m_Clips.size()) return;
+    const AnimationClip& clip = m_Clips[cursor.clip];
+    if (cursor.cachedClip != cursor.clip) {
+        cursor.keys.assign((size_t)clip.channelCount * kTrackCount, 0);
+        cursor.cachedClip = cursor.clip;
+    }
+
+    for (uint32_t c = 0; c < clip.channelCount; c++) {
+        const AnimationChannel& channel = m_Channels[clip.firstChannel + c];
+        for (unsigned int track = 0; track < kTrackCount; track++) {
+            if (channel.keyCount[track] == 0) continue;
+            float value[4];
+            SampleTrack(channel, track, cursor.keys[c * kTrackCount + track], cursor.time, value);
+            WriteTrack(pose, channel.node, track, value);
+        }
+    }
+}
+
+void AnimationRig::SampleReference(int clipIndex, float time, LocalPose& pose) const {
+    if (clipIndex < 0 || (size_t)clipIndex >= m_Clips.size()) return;
+    const AnimationClip& clip = m_Clips[clipIndex];
+    for (uint32_t c = 0; c < clip.channelCount; c++) {
+        const AnimationChannel& channel = m_Channels[clip.firstChannel + c];
+        for (unsigned int track = 0; track < kTrackCount; track++) {
+            const uint32_t count = channel.keyCount[track];
+            if (count == 0) continue;
+            const AnimationKey* keys = m_Keys.data() + channel.firstKey[track];
+            // Key cuối có time <= time
+            const AnimationKey* upper = std::upper_bound(keys, keys + count, time,
+                [](float t, const AnimationKey& key) { return t < key.time; });
+            float value[4];
+            if (upper == keys) InterpolateKeys(keys[0], keys[0], track, time, value);
+            else if (upper == keys + count) InterpolateKeys(keys[count - 1], keys[count - 1], track, time, value);
+            else InterpolateKeys(*(upper - 1), *upper, track, time, value);
+            WriteTrack(pose, channel.node, track, value);
+        }
+    }
+}
+
+// --- BLEND (SoA) ---
+void BlendPoses(const LocalPose& a, const LocalPose& b, float weight, LocalPose& out) {
+    const size_t n = a.Size();
+    out.Resize(n);
+    const float wa = 1.0f - weight;
+    auto lerp = [&](const std::vector<float>& x, const std::vector<float>& y, std::vector<float>& o) {
+        const float* px = x.data();
+        const float* py = y.data();
+        float* po = o.data();
+        for (size_t i = 0; i < n; i++) po[i] = px[i] * wa + py[i] * weight;
+    };
+    lerp(a.tx, b.tx, out.tx); lerp(a.ty, b.ty, out.ty); lerp(a.tz, b.tz, out.tz);
+    lerp(a.sx, b.sx, out.sx); lerp(a.sy, b.sy, out.sy); lerp(a.sz, b.sz, out.sz);
+
+    // nlerp: đổi dấu b nếu khác bán cầu với a rồi chuẩn hoá lại
+    for (size_t i = 0; i < n; i++) {
+        const float dot = a.rx[i] * b.rx[i] + a.ry[i] * b.ry[i] + a.rz[i] * b.rz[i] + a.rw[i] * b.rw[i];
+        const float wb = dot < 0.0f ? -weight : weight;
+        const float x = a.rx[i] * wa + b.rx[i] * wb;
+        const float y = a.ry[i] * wa + b.ry[i] * wb;
+        const float z = a.rz[i] * wa + b.rz[i] * wb;
+        const float w = a.rw[i] * wa + b.rw[i] * wb;
+        const float inv = 1.0f / std::sqrt(std::max(x * x + y * y + z * z + w * w, 1e-20f));
+        out.rx[i] = x * inv; out.ry[i] = y * inv; out.rz[i] = z * inv; out.rw[i] = w * inv;
+    }
+}
+
+// --- MATRICES ---
+void AnimationRig::ComputeLocalMatrices(const LocalPose& pose, glm::mat4* outLocal) const {
+    for (size_t i = 0; i < m_Parent.size(); i++) {
+        if (!m_Animated[i]) {
+            outLocal[i] = m_BindLocal[i];
+            continue;
+        }
+        // T * R * S
+        glm::mat4 m = glm::mat4_cast(glm::quat(pose.rw[i], pose.rx[i], pose.ry[i], pose.rz[i]));
+        m[0] *= pose.sx[i];
+        m[1] *= pose.sy[i];
+        m[2] *= pose.sz[i];
+        m[3] = glm::vec4(pose.tx[i], pose.ty[i], pose.tz[i], 1.0f);
+        outLocal[i] = m;
+    }
+}
+
+void AnimationRig::ComputeWorldMatrices(const glm::mat4* local, glm::mat4* outWorld) const {
+    for (size_t i = 0; i < m_Parent.size(); i++)
+        outWorld[i] = m_Parent[i] < 0 ? local[i] : outWorld[m_Parent[i]] * local[i];
+}
+
+void AnimationRig::ComputeSkinMatrices(const glm::mat4* world, glm::mat4* outPalette) const {
+    // Joint của cùng một mesh đứng liền nhau -> inverse của skinNode tính lại rất ít
+    uint32_t cachedNode = ~0u;
+    glm::mat4 inverseSkinNode(1.0f);
+    for (size_t j = 0; j < m_Joints.size(); j++) {
+        const SkinJoint& joint = m_Joints[j];
+        if (joint.skinNode != cachedNode) {
+            cachedNode = joint.skinNode;
+            inverseSkinNode = glm::inverse(world[cachedNode]);
+        }
+        outPalette[j] = inverseSkinNode * world[joint.node] * glm::make_mat4(joint.inverseBind);
+    }
+}
+
+void AnimationRig::Evaluate(CharacterAnimation* characters, size_t count, float dt, glm::mat4* outLocal,
+                            glm::mat4* outWorld, glm::mat4* outPalette, JobSystem& jobs) const {
+    const size_t nodeCount = NodeCount(), jointCount = JointCount();
+    if (nodeCount == 0) return;
+    jobs.ParallelFor(count, 8, [&](size_t begin, size_t end) {
+        // Scratch theo khoảng: không chia sẻ giữa các thread
+        LocalPose pose, blend;
+        std::vector<glm::mat4> localScratch(outLocal ? 0 : nodeCount);
+        for (size_t i = begin; i < end; i++) {
+            CharacterAnimation& character = characters[i];
+            Advance(character.base, dt * character.speed);
+            Advance(character.blend, dt * character.speed);
+
+            pose = m_BindPose;
+            Sample(character.base, pose);
+            if (character.blendWeight > 0.0f && character.blend.clip >= 0) {
+                blend = m_BindPose;
+                Sample(character.blend, blend);
+                BlendPoses(pose, blend, character.blendWeight, pose);
+            }
+
+            glm::mat4* local = outLocal ? outLocal + i * nodeCount : localScratch.data();
+            glm::mat4* world = outWorld + i * nodeCount;
+            ComputeLocalMatrices(pose, local);
+            ComputeWorldMatrices(local, world);
+            ComputeSkinMatrices(world, outPalette + i * jointCount);
+        }
+    });
+}
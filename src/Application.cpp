@@ -1,26 +1,23 @@
 #include "Application.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
 #include <iostream>
 
-// --- SHADERS (GIỮ NGUYÊN) ---
-const char* vertexShaderSource = R"(
-    #version 410 core
-    layout (location = 0) in vec3 aPos;
-    uniform mat4 u_Model;
-    uniform mat4 u_View;
-    uniform mat4 u_Projection;
-    void main() {
-        gl_Position = u_Projection * u_View * u_Model * vec4(aPos, 1.0);
-    }
-)";
+static const float kAutoRotateDegreesPerSecond = 30.0f; // trước đây 0.5 độ / frame ở 60 fps
 
-const char* fragmentShaderSource = R"(
-    #version 410 core
-    out vec4 FragColor;
-    uniform vec4 u_Color; 
-    void main() {
-        FragColor = u_Color;
-    }
-)";
+// --- SHADERS ---
+// u_UseMaterials = 1: màu lấy từ material buffer theo draw ID (batched path)
+// u_UseMaterials = 0: màu là uniform u_Color (per-part path / override)
+// u_InstanceBase + gl_InstanceID tra vào danh sách slot visible (sau culling),
+// rồi transform đọc từ TBO (4 texel / mat4) tại slot đó.
+// GL 4.1 không có baseInstance nên base đi qua uniform.
+// u_HasTexture = 1: màu nhân với base color texture (bind theo batch / part)
+// u_GpuSkinning = 1: vertex có weight được skin bằng palette (TBO, 4 texel / joint);
+// weight toàn 0 (part tĩnh, hoặc VAO của CPU skinning) giữ nguyên vị trí.
+// Nguồn nằm trong AppOptions::shaderDir (shaders/ của repo, hoặc bản copy cạnh file chạy);
+// sửa file lúc chạy thì build lại nóng.
 
 // Callback báo lỗi của GLFW
 void GLFWErrorCallback(int error, const char* description) {
@@ -28,15 +25,16 @@ void GLFWErrorCallback(int error, const char* description) {
 }
 
 Application::Application() 
-    : m_IsRunning(false), m_Window(nullptr), m_ShaderProgram(0) {}
+    : m_IsRunning(false), m_Window(nullptr) {}
 
 Application::~Application() { Clean(); }
 
-bool Application::Init(const char* title, int width, int height) {
+bool Application::Init(const char* title, int width, int height, const AppOptions& options) {
     m_Width = width; m_Height = height;
 
     // 1. Init GLFW
     glfwSetErrorCallback(GLFWErrorCallback);
+    if (options.headless) glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
     if (!glfwInit()) {
         std::cerr << "Failed to initialize GLFW" << std::endl;
         return false;
@@ -46,7 +44,12 @@ bool Application::Init(const char* title, int width, int height) {
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 1);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE); // Bắt buộc cho Mac
+    if (options.headless) {
+        // Null platform chỉ tạo được context OSMesa; OSMesa không hỗ trợ forward-compatible
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+    } else {
+        glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE); // Bắt buộc cho Mac
+    }
     glfwWindowHint(GLFW_COCOA_RETINA_FRAMEBUFFER, GLFW_TRUE); // Hỗ trợ Retina
 
     // 3. Create Window
@@ -59,17 +62,38 @@ bool Application::Init(const char* title, int width, int height) {
 
     glfwMakeContextCurrent(m_Window);
     // Tắt V-Sync (0) hoặc Bật (1)
-    glfwSwapInterval(1); 
+    glfwSwapInterval(options.vsync ? 1 : 0);
+
+    m_Headless = options.headless;
+    m_AutoRotate = options.autoRotate;
+    m_RunSeconds = options.runSeconds;
+    m_PacingReportPath = options.pacingReportPath;
+    m_VertexFormat = options.vertexFormat;
+    m_ShaderDir = options.shaderDir;
+    FramePacing pacing = options.pacing;
+    if (GLFWmonitor* monitor = glfwGetPrimaryMonitor()) {
+        const GLFWvidmode* mode = glfwGetVideoMode(monitor);
+        if (mode && mode->refreshRate > 0) pacing.refreshRate = mode->refreshRate;
+    }
+    m_Scheduler.Configure(pacing);
 
     // 4. Init GLAD
     // Lưu ý: cast sang GLADloadproc
     if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
         std::cerr << "Failed to initialize GLAD" << std::endl;
+        glfwDestroyWindow(m_Window);
+        m_Window = nullptr;
+        glfwTerminate();
         return false;
     }
 
     glEnable(GL_DEPTH_TEST); 
 
+    PROFILE_THREAD_NAME("Main");
+#if APP_PROFILER
+    m_GpuProfiler.Init();
+#endif
+
     // 5. Setup ImGui (Backend GLFW)
     IMGUI_CHECKVERSION();
     ImGui::CreateContext();
@@ -79,12 +103,14 @@ bool Application::Init(const char* title, int width, int height) {
 
     ImGui::StyleColorsDark();
 
-    // Init cho GLFW
+    // Init cho GLFW: cài callback của ta trước, ImGui lưu lại và gọi tiếp chúng
+    InstallRedrawCallbacks();
     ImGui_ImplGlfw_InitForOpenGL(m_Window, true); // true = install callbacks
     ImGui_ImplOpenGL3_Init("#version 410");
 
-    InitGraphics();
-    LoadModelRaw("res/chess_pieces.glb");
+    if (!InitGraphics()) return false;
+    WatchFiles();
+    if (!options.modelPath.empty()) LoadModelRaw(options.modelPath.c_str());
 
     m_IsRunning = true;
     return true;
@@ -94,126 +120,636 @@ void Application::Run() {
     // GLFW dùng double (giây) thay vì Uint32 (ms)
     double lastTime = glfwGetTime(); 
     int frameCount = 0;
-    std::string originalTitle = "OpenGL 4.1 Viewer (GLFW)"; 
+    m_Scheduler.Reset(lastTime);
+
+    // Đo pacing từ lúc model khởi động đã load xong (import / upload không tính vào CPU lúc rảnh)
+    bool measuring = !m_PendingLoad.Valid();
+    double measureStart = lastTime;
+    double cpuStart = ProcessCpuSeconds();
 
     while (!glfwWindowShouldClose(m_Window) && m_IsRunning) {
-        HandleEvents();
+        // 1. Cap / low-latency: ngủ tới lượt frame kế TRƯỚC khi đọc input
+        double now = glfwGetTime();
+        const double nextStart = m_Scheduler.NextFrameStart(now);
+        if (nextStart > now) m_Scheduler.Stats().sleptSeconds += SleepUntil(now, nextStart);
+        const double frameStart = glfwGetTime();
+        HandleEvents(m_Scheduler.WaitTimeout(frameStart));
+        PollFileChanges();
+
+        // 2. Mô phỏng theo bước cố định, tách khỏi tần số vẽ
+        const unsigned int steps = m_Scheduler.Advance(glfwGetTime());
+        for (unsigned int i = 0; i < steps; i++) FixedUpdate(m_Scheduler.Step());
+        m_Scheduler.SetAnimating(IsAnimating());
+        if (m_PendingLoad.Valid()) m_Scheduler.MarkDirty(kDirtyLoad);
+
+        now = glfwGetTime();
+        if (!measuring && !m_PendingLoad.Valid()) {
+            measuring = true;
+            measureStart = now;
+            cpuStart = ProcessCpuSeconds();
+            m_Scheduler.Stats() = FramePacingStats();
+        }
+        if (measuring && m_RunSeconds > 0.0 && now - measureStart >= m_RunSeconds) break;
+
+        // 3. On-demand: không có gì đổi thì không vẽ, quay lại chờ event
+        if (!m_Scheduler.ShouldRender()) continue;
+        m_Scheduler.BeginFrame();
         Render();
+        Present();
+        // Không để driver xếp hàng frame: frame sau chỉ bắt đầu khi frame này đã xong hẳn
+        if (m_Scheduler.Pacing().mode == FrameMode::LowLatency) glFinish();
+        m_Scheduler.FrameRendered(frameStart, glfwGetTime());
 
         // --- TÍNH FPS ---
         double currentTime = glfwGetTime();
         frameCount++;
         
-        // Nếu qua 1.0 giây
+        // Nếu qua 1.0 giây (buffer cố định, không cấp phát; chi tiết xem overlay Profiler)
         if (currentTime - lastTime >= 1.0) {
-            std::string title = originalTitle + " - FPS: " + std::to_string(frameCount);
-            glfwSetWindowTitle(m_Window, title.c_str());
+            char title[64];
+            std::snprintf(title, sizeof(title), "OpenGL 4.1 Viewer (GLFW) - FPS: %d (%s)", frameCount,
+                          FrameModeName(m_Scheduler.Pacing().mode));
+            glfwSetWindowTitle(m_Window, title);
             frameCount = 0;
             lastTime = currentTime;
         }
     }
+
+    if (m_RunSeconds > 0.0) {
+        const double wallSeconds = glfwGetTime() - measureStart;
+        const double cpuSeconds = ProcessCpuSeconds() - cpuStart;
+        const FramePacingStats& stats = m_Scheduler.Stats();
+        std::cout << "Pacing: " << FrameModeName(m_Scheduler.Pacing().mode) << ", " << wallSeconds << " s, "
+                  << stats.framesRendered << " frames rendered, " << stats.steps << " steps, " << stats.loops
+                  << " loops, CPU " << cpuSeconds << " s (" << 100.0 * cpuSeconds / std::max(wallSeconds, 1e-9)
+                  << "% of one core)" << std::endl;
+        if (!m_PacingReportPath.empty())
+            WritePacingReport(m_PacingReportPath, m_Scheduler.Pacing(), stats, wallSeconds, cpuSeconds);
+    }
+}
+
+void Application::InstallRedrawCallbacks() {
+    glfwSetWindowUserPointer(m_Window, this);
+    glfwSetCursorPosCallback(m_Window, [](GLFWwindow* w, double, double) { MarkWindowDirty(w, kDirtyInput); });
+    glfwSetMouseButtonCallback(m_Window, [](GLFWwindow* w, int, int, int) { MarkWindowDirty(w, kDirtyInput); });
+    glfwSetScrollCallback(m_Window, [](GLFWwindow* w, double, double) { MarkWindowDirty(w, kDirtyInput); });
+    glfwSetKeyCallback(m_Window, [](GLFWwindow* w, int, int, int, int) { MarkWindowDirty(w, kDirtyInput); });
+    glfwSetCharCallback(m_Window, [](GLFWwindow* w, unsigned int) { MarkWindowDirty(w, kDirtyInput); });
+    glfwSetCursorEnterCallback(m_Window, [](GLFWwindow* w, int) { MarkWindowDirty(w, kDirtyInput); });
+    glfwSetWindowFocusCallback(m_Window, [](GLFWwindow* w, int) { MarkWindowDirty(w, kDirtyInput); });
+    glfwSetFramebufferSizeCallback(m_Window, [](GLFWwindow* w, int, int) { MarkWindowDirty(w, kDirtyWindow); });
+    glfwSetWindowRefreshCallback(m_Window, [](GLFWwindow* w) { MarkWindowDirty(w, kDirtyWindow); });
 }
 
-void Application::InitGraphics() { CreateShaderProgram(); }
+void Application::MarkWindowDirty(GLFWwindow* window, uint32_t flags) {
+    if (Application* app = static_cast<Application*>(glfwGetWindowUserPointer(window))) app->m_Scheduler.MarkDirty(flags);
+}
 
-// --- CreateShaderProgram và LoadModelRaw GIỮ NGUYÊN KHÔNG ĐỔI ---
-void Application::CreateShaderProgram() {
-    // (Copy y hệt code cũ, không thay đổi logic OpenGL)
-    unsigned int vertexShader = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertexShader, 1, &vertexShaderSource, NULL);
-    glCompileShader(vertexShader);
-    
-    int success; char infoLog[512];
-    glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &success);
-    if(!success) {
-        glGetShaderInfoLog(vertexShader, 512, NULL, infoLog);
-        std::cerr << "Vertex Shader Error: " << infoLog << std::endl;
+void Application::FixedUpdate(double step) {
+    m_PrevRotationAngle = m_RotationAngle;
+    if (m_AutoRotate) {
+        m_RotationAngle += kAutoRotateDegreesPerSecond * (float)step;
+        if (m_RotationAngle >= 360.0f) {
+            // Dời cả hai để nội suy không quay ngược một vòng
+            m_RotationAngle -= 360.0f;
+            m_PrevRotationAngle -= 360.0f;
+        }
+        m_Scheduler.MarkDirty(kDirtyAnimation);
+    }
+    if (m_PlayAnimation && m_Rig.ClipCount() > 0) {
+        m_AnimationTime += step;
+        m_Scheduler.MarkDirty(kDirtyAnimation);
     }
+}
 
-    unsigned int fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragmentShader, 1, &fragmentShaderSource, NULL);
-    glCompileShader(fragmentShader);
-    
-    glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &success);
-    if(!success) {
-        glGetShaderInfoLog(fragmentShader, 512, NULL, infoLog);
-        std::cerr << "Fragment Shader Error: " << infoLog << std::endl;
+bool Application::IsAnimating() const {
+    return m_AutoRotate || (m_PlayAnimation && m_Rig.ClipCount() > 0);
+}
+
+int Application::RunBenchmark(const BenchConfig& config) {
+    CameraScript script = CameraScript::Default();
+    if (!config.cameraScriptPath.empty() && !script.Load(config.cameraScriptPath)) return 1;
+
+    // Lặp lại được giữa các lần chạy: không đọc/ghi imgui.ini, camera chỉ theo kịch bản
+    ImGui::GetIO().IniFilename = nullptr;
+    m_AutoRotate = false;
+    m_KeepHierarchy = config.keepHierarchy;
+    const double cpuStart = ProcessCpuSeconds();
+    const double wallStart = glfwGetTime();
+
+    // 1. Load: vẫn chạy frame bình thường, upload chia theo budget như khi dùng thật
+    LoadModelRaw(config.modelPath.c_str());
+    const double deadline = glfwGetTime() + config.loadTimeoutSec;
+    while (m_PendingLoad.Valid() && m_IsRunning && glfwGetTime() < deadline) {
+        HandleEvents();
+        Render();
+        Present();
+    }
+    if (m_PendingLoad.Valid()) {
+        CancelModelLoad();
+        std::cerr << "Benchmark: loading " << config.modelPath << " timed out" << std::endl;
+        return 1;
+    }
+    if (m_MeshParts.empty()) {
+        std::cerr << "Benchmark: " << config.modelPath << " not loaded (" << m_LoadStatus << ")" << std::endl;
+        return 1;
     }
 
-    m_ShaderProgram = glCreateProgram();
-    glAttachShader(m_ShaderProgram, vertexShader);
-    glAttachShader(m_ShaderProgram, fragmentShader);
-    glLinkProgram(m_ShaderProgram);
-    
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
+    BenchResult result;
+    const GLubyte* renderer = glGetString(GL_RENDERER);
+    result.renderer = renderer ? (const char*)renderer : "";
+    glfwGetFramebufferSize(m_Window, &result.width, &result.height);
+    result.loadMs = m_LastLoadMs;
+    result.importMs = m_LastImportMs;
+    result.fromCache = m_LastLoadFromCache;
+    result.parts = m_MeshParts.size();
+    result.instances = m_Scene.TotalInstances();
+    result.vertexFormat = VertexFormatName(m_ModelVertexFormat);
+    for (const MeshPart& part : m_MeshParts)
+        result.vertexBytes += (size_t)part.vertexCount * VertexFormatStride(m_ModelVertexFormat);
+
+    // 2. Warmup đứng yên ở key đầu, sau đó đo từng frame theo kịch bản
+    using Clock = std::chrono::steady_clock;
+    auto Ms = [](Clock::duration d) { return std::chrono::duration<double, std::milli>(d).count(); };
+    const unsigned int totalFrames = config.warmupFrames + config.frames;
+    result.frames.reserve(config.frames);
+    for (unsigned int frame = 0; frame < totalFrames && m_IsRunning; frame++) {
+        const bool measured = frame >= config.warmupFrames;
+        float time = 0.0f;
+        if (measured && config.frames > 1) time = (float)(frame - config.warmupFrames) / (float)(config.frames - 1);
+        CameraKey key = script.Sample(time);
+        m_RotationAngle = key.rotation;
+        m_Scale = key.scale;
+        m_CameraDistance = key.distance;
+
+        Clock::time_point start = Clock::now();
+        HandleEvents();
+        FixedUpdate(1.0 / 60.0); // animation theo frame, không theo đồng hồ: lần chạy nào cũng pose giống nhau
+        Render();
+        Clock::time_point submitted = Clock::now();
+        Present();
+        Clock::time_point end = Clock::now();
+
+        if (measured) {
+            result.frames.push_back({ Ms(submitted - start), Ms(end - start), m_DrawCallCount, m_VisibleCount,
+                                      m_FrameGpuCalls.Total() });
+            result.gpuCalls.Add(m_FrameGpuCalls);
+            result.gpuSkipped.Add(m_FrameGpuSkipped);
+        }
+    }
+
+    result.cpuSeconds = ProcessCpuSeconds() - cpuStart;
+    result.wallSeconds = glfwGetTime() - wallStart;
+    if (!WriteBenchReport(config, result)) return 1;
+
+    std::vector<double> frameMs;
+    for (const FrameSample& s : result.frames) frameMs.push_back(s.frameMs);
+    std::cout << "Benchmark: " << result.frames.size() << " frames on " << result.renderer << ", load "
+              << result.loadMs << " ms, frame p50 " << Percentile(frameMs, 50.0) << " / p95 "
+              << Percentile(frameMs, 95.0) << " / p99 " << Percentile(frameMs, 99.0) << " ms -> "
+              << config.outputPath << std::endl;
+    return 0;
 }
 
-void Application::LoadModelRaw(const char* path) {
-    // (Copy y hệt code cũ)
-    Assimp::Importer importer;
-    const aiScene* scene = importer.ReadFile(path, 
-        aiProcess_Triangulate | aiProcess_FlipUVs | aiProcess_PreTransformVertices);
+bool Application::InitGraphics() {
+    // Layout Camera kiểm trước khi program được dùng: hot reload sai layout giữ program cũ
+    auto validate = [](const ProgramReflection& program, std::string& error) {
+        ModelUniforms uniforms;
+        return uniforms.Resolve(program, error);
+    };
+    if (!m_Shader.Load(m_ShaderDir + "/model.vert", m_ShaderDir + "/model.frag", ModelProgramBindings(), validate))
+        return false;
+    std::string error;
+    m_ModelUniforms.Resolve(m_Shader.Reflection(), error);
+    // Camera UBO: ghi lại cả block mỗi frame (orphan), binding kCameraBlockBinding
+    glGenBuffers(1, &m_CameraUBO);
+    glBindBuffer(GL_UNIFORM_BUFFER, m_CameraUBO);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(CameraBlock), nullptr, GL_STREAM_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    m_Device.Invalidate();
+    // Giá trị mặc định khi attrib 4 tắt (model không skin, VAO của CPU skinning): không skin
+    glVertexAttrib4f(4, 0.0f, 0.0f, 0.0f, 0.0f);
+    return true;
+}
+
+void Application::LoadModelRaw(const char* path, bool reload) {
+    // Load mới thay thế load đang dở, model hiện tại vẫn tiếp tục được vẽ
+    CancelModelLoad();
+    // Reload giữ flags của model đang vẽ; hash part trên worker để diff với bảng resident
+    unsigned int flags = reload ? m_ModelImportFlags : (m_KeepHierarchy ? kInstancedImportFlags : kDefaultImportFlags);
+    m_PendingLoad = m_Loader.Request(path, flags, m_HotReload);
+    m_PendingIsReload = reload;
+    m_LoadStatus.clear();
+    m_LoadRequestTime = glfwGetTime();
+}
+
+void Application::CancelModelLoad() {
+    if (m_PendingLoad.Valid()) {
+        m_PendingLoad.Cancel();
+        m_PendingLoad.Reset(); // worker giữ shared_ptr riêng, tự dọn
+        m_LoadStatus = "Cancelled";
+    }
+    m_Uploader.Abort();
+}
+
+void Application::DeleteModelBuffers() {
+    if (m_ModelVAO) glDeleteVertexArrays(1, &m_ModelVAO);
+    if (m_ModelVBO) glDeleteBuffers(1, &m_ModelVBO);
+    if (m_ModelDrawIDVBO) glDeleteBuffers(1, &m_ModelDrawIDVBO);
+    if (m_ModelSkinVBO) glDeleteBuffers(1, &m_ModelSkinVBO);
+    if (m_ModelEBO) glDeleteBuffers(1, &m_ModelEBO);
+    m_ModelVAO = m_ModelVBO = m_ModelDrawIDVBO = m_ModelSkinVBO = m_ModelEBO = 0;
+    DeleteSkinningBuffers();
+}
+
+void Application::DeleteSkinningBuffers() {
+    if (m_SkinnedVAO) glDeleteVertexArrays(1, &m_SkinnedVAO);
+    if (m_SkinnedVBO) glDeleteBuffers(1, &m_SkinnedVBO);
+    if (m_SkinnedDrawIDVBO) glDeleteBuffers(1, &m_SkinnedDrawIDVBO);
+    m_SkinnedVAO = m_SkinnedVBO = m_SkinnedDrawIDVBO = 0;
+}
+
+void Application::SetupSkinning(const MeshView& mesh) {
+    m_Rig.Build(mesh);
+    m_Character = CharacterAnimation();
+    if (m_Rig.ClipCount() > 0) m_Character.base.clip = 0;
+    m_NodeLocal.assign(m_Rig.NodeCount(), glm::mat4(1.0f));
+    m_NodeWorld.assign(m_Rig.NodeCount(), glm::mat4(1.0f));
+    m_Palette.assign(m_Rig.JointCount(), glm::mat4(1.0f));
+    m_PoseMs = m_SkinMs = 0.0;
+
+    DeleteSkinningBuffers();
+    GatherSkinnedVertices(mesh, m_SkinSource, m_SkinWeights, m_SkinnedBase);
+    m_SkinnedVertices = m_SkinSource;
+    if (m_SkinWeights.empty()) return;
+
+    if (m_PaletteBuffer == 0) {
+        glGenBuffers(1, &m_PaletteBuffer);
+        glGenTextures(1, &m_PaletteTexture);
+    }
+    glBindBuffer(GL_TEXTURE_BUFFER, m_PaletteBuffer);
+    glBufferData(GL_TEXTURE_BUFFER, m_Palette.size() * sizeof(glm::mat4), m_Palette.data(), GL_STREAM_DRAW);
+    glBindTexture(GL_TEXTURE_BUFFER, m_PaletteTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, m_PaletteBuffer);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+    // VAO cho CPU skinning: vị trí từ VBO stream, draw ID theo vertex đã gom, chung EBO với model
+    std::vector<unsigned int> drawIDs(m_SkinWeights.size());
+    for (size_t p = 0; p < m_MeshParts.size(); p++)
+        if (m_SkinnedBase[p] != ~0u)
+            std::fill(drawIDs.begin() + m_SkinnedBase[p], drawIDs.begin() + m_SkinnedBase[p] + m_MeshParts[p].vertexCount,
+                      (unsigned int)p);
+    glGenVertexArrays(1, &m_SkinnedVAO);
+    glGenBuffers(1, &m_SkinnedVBO);
+    glGenBuffers(1, &m_SkinnedDrawIDVBO);
+    glBindVertexArray(m_SkinnedVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, m_SkinnedVBO);
+    glBufferData(GL_ARRAY_BUFFER, m_SkinnedVertices.size() * sizeof(float), m_SkinnedVertices.data(), GL_STREAM_DRAW);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, kVertexStride, (void*)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, kVertexStride, (void*)(3 * sizeof(float)));
+    glEnableVertexAttribArray(2);
+    glBindBuffer(GL_ARRAY_BUFFER, m_SkinnedDrawIDVBO);
+    glBufferData(GL_ARRAY_BUFFER, drawIDs.size() * sizeof(unsigned int), drawIDs.data(), GL_STATIC_DRAW);
+    glVertexAttribIPointer(1, 1, GL_UNSIGNED_INT, sizeof(unsigned int), (void*)0);
+    glEnableVertexAttribArray(1);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ModelEBO);
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void Application::UpdateAnimation() {
+    // Pose tại thời điểm nội suy giữa hai bước mô phỏng: chuyển động mượt ở mọi tần số vẽ
+    const double renderTime = m_AnimationTime - (1.0 - m_Scheduler.Alpha()) * m_Scheduler.Step();
+    const float dt = m_PlayAnimation ? (float)std::max(renderTime - m_RenderedAnimationTime, 0.0) : 0.0f;
+    m_RenderedAnimationTime = renderTime;
+    if (m_Rig.ClipCount() == 0 && m_Rig.JointCount() == 0) return;
 
-    if(!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) {
-        std::cerr << "ERROR::ASSIMP::" << importer.GetErrorString() << std::endl;
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point start = Clock::now();
+    {
+        PROFILE_SCOPE("Animation Pose");
+        m_Rig.Evaluate(&m_Character, 1, dt, m_NodeLocal.data(), m_NodeWorld.data(), m_Palette.data());
+        // Node animate kéo theo mesh tĩnh gắn vào nó (instance + BVH cập nhật ở bước cull)
+        for (uint32_t node : m_Rig.AnimatedNodes()) m_Scene.SetLocalTransform(node, m_NodeLocal[node]);
+    }
+    Clock::time_point posed = Clock::now();
+    m_PoseMs = std::chrono::duration<double, std::milli>(posed - start).count();
+    if (m_SkinWeights.empty()) return;
+
+    if (m_CpuSkinning) {
+        PROFILE_SCOPE("CPU Skinning");
+        SkinVerticesParallel(m_SkinSource.data(), m_SkinWeights.data(), m_SkinWeights.size(), m_Palette.data(),
+                             m_SkinnedVertices.data());
+        // Orphan rồi ghi: không phải chờ GPU vẽ xong vertex của frame trước
+        const size_t bytes = m_SkinnedVertices.size() * sizeof(float);
+        glBindBuffer(GL_ARRAY_BUFFER, m_SkinnedVBO);
+        glBufferData(GL_ARRAY_BUFFER, bytes, nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, m_SkinnedVertices.data());
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    } else {
+        PROFILE_SCOPE("Upload Palette");
+        const size_t bytes = m_Palette.size() * sizeof(glm::mat4);
+        glBindBuffer(GL_TEXTURE_BUFFER, m_PaletteBuffer);
+        glBufferData(GL_TEXTURE_BUFFER, bytes, nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_TEXTURE_BUFFER, 0, bytes, m_Palette.data());
+        glBindBuffer(GL_TEXTURE_BUFFER, 0);
+    }
+    m_SkinMs = std::chrono::duration<double, std::milli>(Clock::now() - posed).count();
+}
+
+void Application::UploadMaterials() {
+    std::vector<float> rgba;
+    BuildMaterialBuffer(m_MeshParts.data(), m_MeshParts.size(), rgba);
+
+    if (m_MaterialBuffer == 0) glGenBuffers(1, &m_MaterialBuffer);
+    if (m_MaterialTexture == 0) glGenTextures(1, &m_MaterialTexture);
+
+    glBindBuffer(GL_TEXTURE_BUFFER, m_MaterialBuffer);
+    glBufferData(GL_TEXTURE_BUFFER, rgba.size() * sizeof(float), rgba.data(), GL_STATIC_DRAW);
+    glBindTexture(GL_TEXTURE_BUFFER, m_MaterialTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, m_MaterialBuffer);
+
+    // Cùng chỉ số draw ID: hằng số giải position của VBO quantized (bounds không đổi theo pose / instance)
+    std::vector<float> decode;
+    BuildPositionDecodeBuffer(m_MeshParts.data(), m_MeshParts.size(), decode);
+    if (m_PartDecodeBuffer == 0) glGenBuffers(1, &m_PartDecodeBuffer);
+    if (m_PartDecodeTexture == 0) glGenTextures(1, &m_PartDecodeTexture);
+    glBindBuffer(GL_TEXTURE_BUFFER, m_PartDecodeBuffer);
+    glBufferData(GL_TEXTURE_BUFFER, decode.size() * sizeof(float), decode.data(), GL_STATIC_DRAW);
+    glBindTexture(GL_TEXTURE_BUFFER, m_PartDecodeTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, m_PartDecodeBuffer);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+    BuildDrawList(m_MeshParts.data(), m_MeshParts.size(), nullptr, nullptr, m_DrawList);
+}
+
+void Application::UploadInstances(bool full) {
+    if (m_InstanceBuffer == 0) glGenBuffers(1, &m_InstanceBuffer);
+    if (m_InstanceTexture == 0) glGenTextures(1, &m_InstanceTexture);
+
+    const std::vector<glm::mat4>& instances = m_Scene.Instances();
+    glBindBuffer(GL_TEXTURE_BUFFER, m_InstanceBuffer);
+    if (full) {
+        glBufferData(GL_TEXTURE_BUFFER, instances.size() * sizeof(glm::mat4), instances.data(), GL_DYNAMIC_DRAW);
+        glBindTexture(GL_TEXTURE_BUFFER, m_InstanceTexture);
+        glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, m_InstanceBuffer);
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+    } else if (m_Scene.InstancesChanged()) {
+        // Chỉ ghi lại khoảng instance thuộc các subtree vừa dirty
+        size_t begin = m_Scene.ChangedBegin(), end = m_Scene.ChangedEnd();
+        glBufferSubData(GL_TEXTURE_BUFFER, begin * sizeof(glm::mat4), (end - begin) * sizeof(glm::mat4),
+                        instances.data() + begin);
+    }
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+    m_Scene.ClearInstanceChanges();
+}
+
+void Application::CullInstances(const glm::mat4& clip) {
+    const size_t total = m_Scene.TotalInstances();
+    if (m_FrustumCulling) {
+        m_VisibleCount = m_Culler.Cull(Frustum::FromMatrix(clip), m_InstanceVisible);
+        // Bounds của part skinned là của bind pose, pose hiện tại có thể ra ngoài: luôn vẽ
+        for (size_t p = 0; p < m_MeshParts.size(); p++) {
+            if (!m_MeshParts[p].skinned) continue;
+            for (unsigned int i = m_Scene.InstanceOffset(p); i < m_Scene.InstanceOffset(p) + m_Scene.InstanceCount(p); i++) {
+                m_VisibleCount += !m_InstanceVisible[i];
+                m_InstanceVisible[i] = 1;
+            }
+        }
+    } else {
+        m_InstanceVisible.assign(total, 1);
+        m_VisibleCount = total;
+    }
+}
+
+void Application::SelectLods(const glm::mat4& projection, const glm::mat4& modelView) {
+    // Camera trong không gian model, cùng hệ với InstanceBounds()
+    glm::vec3 cameraPos = glm::vec3(glm::inverse(modelView)[3]);
+    m_LodParams.pixelsPerUnit = projection[1][1] * 0.5f * (float)m_ViewportHeight;
+    SelectInstanceLods(m_MeshParts.data(), m_Scene, m_InstanceVisible.data(), cameraPos, m_LodParams, m_InstanceLod);
+}
+
+void Application::BuildVisibleLists() {
+    // Gom slot visible theo (part, LOD): nhóm g = p * kMaxMeshLods + lod vẽ [m_VisibleOffset[g], m_VisibleOffset[g + 1])
+    const size_t partCount = m_Scene.PartCount();
+    m_VisibleSlots.clear();
+    m_VisibleOffset.assign(partCount * kMaxMeshLods + 1, 0);
+    for (LodStats& stats : m_LodStats) stats.instances = stats.triangles = 0;
+    for (size_t p = 0; p < partCount; p++) {
+        const MeshPart& part = m_MeshParts[p];
+        unsigned int first = m_Scene.InstanceOffset(p), end = first + m_Scene.InstanceCount(p);
+        for (unsigned int lod = 0; lod < kMaxMeshLods; lod++) {
+            m_VisibleOffset[p * kMaxMeshLods + lod] = (unsigned int)m_VisibleSlots.size();
+            if (lod >= PartLodCount(part)) continue;
+            for (unsigned int i = first; i < end; i++)
+                if (m_InstanceVisible[i] && m_InstanceLod[i] == lod) m_VisibleSlots.push_back((int)i);
+            size_t instances = m_VisibleSlots.size() - m_VisibleOffset[p * kMaxMeshLods + lod];
+            m_LodStats[lod].instances += instances;
+            m_LodStats[lod].triangles += instances * (PartLod(part, lod).indexCount / 3);
+        }
+    }
+    m_VisibleOffset[partCount * kMaxMeshLods] = (unsigned int)m_VisibleSlots.size();
+
+    if (m_InstanceIndexBuffer == 0) {
+        glGenBuffers(1, &m_InstanceIndexBuffer);
+        glGenTextures(1, &m_InstanceIndexTexture);
+        glBindBuffer(GL_TEXTURE_BUFFER, m_InstanceIndexBuffer);
+        glBufferData(GL_TEXTURE_BUFFER, sizeof(int), nullptr, GL_STREAM_DRAW);
+        glBindTexture(GL_TEXTURE_BUFFER, m_InstanceIndexTexture);
+        glTexBuffer(GL_TEXTURE_BUFFER, GL_R32I, m_InstanceIndexBuffer);
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+    }
+    // Orphan rồi ghi: không phải chờ GPU dùng xong danh sách của frame trước
+    size_t bytes = std::max<size_t>(m_VisibleSlots.size(), 1) * sizeof(int);
+    glBindBuffer(GL_TEXTURE_BUFFER, m_InstanceIndexBuffer);
+    glBufferData(GL_TEXTURE_BUFFER, bytes, nullptr, GL_STREAM_DRAW);
+    if (!m_VisibleSlots.empty())
+        glBufferSubData(GL_TEXTURE_BUFFER, 0, m_VisibleSlots.size() * sizeof(int), m_VisibleSlots.data());
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+    // Flattened: slot == part nên visibility và LOD dùng thẳng cho multi-draw
+    if (m_Scene.IsFlattened())
+        BuildDrawList(m_MeshParts.data(), m_MeshParts.size(), m_InstanceVisible.data(), m_InstanceLod.data(), m_DrawList);
+}
+
+void Application::UpdateModelLoad() {
+    if (!m_PendingLoad.Valid() || !m_PendingLoad.IsDone()) return;
+
+    switch (m_PendingLoad.State()) {
+    case LoadState::Failed:
+        m_LoadStatus = "Failed: " + m_PendingLoad.Error();
+        m_PendingLoad.Reset();
         return;
+    case LoadState::Cancelled:
+        m_LoadStatus = "Cancelled";
+        m_PendingLoad.Reset();
+        return;
+    default:
+        break;
     }
 
-    std::vector<float> vertices;
-    std::vector<unsigned int> indices;
-    m_MeshParts.clear(); 
-    
-    unsigned int currentVertexOffset = 0;
-    unsigned int currentIndexOffset = 0;
-
-    for (unsigned int i = 0; i < scene->mNumMeshes; i++) {
-        aiMesh* mesh = scene->mMeshes[i];
-        aiMaterial* material = scene->mMaterials[mesh->mMaterialIndex];
-        aiColor4D color(0.8f, 0.8f, 0.8f, 1.0f);
-
-        if (AI_SUCCESS != aiGetMaterialColor(material, AI_MATKEY_BASE_COLOR, &color))
-            aiGetMaterialColor(material, AI_MATKEY_COLOR_DIFFUSE, &color);
-
-        MeshPart part;
-        part.indexOffset = currentIndexOffset;
-        part.indexCount = mesh->mNumFaces * 3;
-        part.color[0] = color.r; part.color[1] = color.g; part.color[2] = color.b; part.color[3] = color.a;
-        m_MeshParts.push_back(part);
-
-        for (unsigned int j = 0; j < mesh->mNumVertices; j++) {
-            vertices.push_back(mesh->mVertices[j].x);
-            vertices.push_back(mesh->mVertices[j].y);
-            vertices.push_back(mesh->mVertices[j].z);
+    ModelAsset& asset = m_PendingLoad.Asset();
+    if (!m_Uploader.IsActive()) {
+        std::cout << (m_PendingIsReload ? "Reloaded " : "Loaded ") << m_PendingLoad.Path()
+                  << (asset.fromCache ? " from mesh cache" : " via Assimp") << " in " << asset.loadMs << " ms" << std::endl;
+        if (!asset.optimizeStats.empty()) {
+            size_t before = 0, after = 0;
+            for (const MeshPartStats& s : asset.optimizeStats) {
+                before += s.vertexBytesBefore + s.indexBytesBefore;
+                after += s.vertexBytesAfter + s.indexBytesAfter;
+            }
+            std::cout << "  optimized " << asset.optimizeStats.size() << " parts: "
+                      << before / 1024 << " KiB -> " << after / 1024 << " KiB" << std::endl;
         }
-        for (unsigned int j = 0; j < mesh->mNumFaces; j++) {
-            aiFace face = mesh->mFaces[j];
-            for (unsigned int k = 0; k < face.mNumIndices; k++)
-                indices.push_back(face.mIndices[k] + currentVertexOffset);
+        if (m_PendingIsReload && TryIncrementalReload(asset)) {
+            FinishModelSwap(asset);
+            return;
         }
-        currentVertexOffset += mesh->mNumVertices;
-        currentIndexOffset += mesh->mNumFaces * 3;
+        // Có hot reload thì cấp dư để lần sửa sau ghi được vào chỗ trống
+        m_Uploader.Begin(asset.View(), m_HotReload ? kReloadHeadroom : 0.0f, m_VertexFormat);
     }
 
-    if (m_ModelVAO == 0) glGenVertexArrays(1, &m_ModelVAO);
-    if (m_ModelVBO == 0) glGenBuffers(1, &m_ModelVBO);
-    if (m_ModelEBO == 0) glGenBuffers(1, &m_ModelEBO);
+    if (m_Uploader.Step(m_UploadBudget)) {
+        // Swap cả bộ VAO/VBO/EBO + part table cùng lúc, giữa hai frame
+        ModelUploader::Result result;
+        m_Uploader.Release(result);
+        DeleteModelBuffers();
+        m_ModelVAO = result.vao;
+        m_ModelVBO = result.vbo;
+        m_ModelDrawIDVBO = result.drawIDVBO;
+        m_ModelSkinVBO = result.skinVBO;
+        m_ModelEBO = result.ebo;
+        m_MeshParts = std::move(result.parts);
+        m_ModelVertexFormat = result.vertexFormat;
+        ResetResidentMesh(asset.View(), asset.partHashes, result.vertexCapacity, result.indexCapacity,
+                          result.drawIDSize, VertexFormatStride(result.vertexFormat), m_Resident);
+        FinishModelSwap(asset);
+    }
+}
 
-    glBindVertexArray(m_ModelVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, m_ModelVBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ModelEBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+bool Application::TryIncrementalReload(const ModelAsset& asset) {
+    if (!m_ModelVBO) return false;
+    if (m_ModelVertexFormat != m_VertexFormat) {
+        m_ReloadStatus = "full upload: vertex format changed";
+        return false;
+    }
+    PROFILE_SCOPE("Incremental Reload");
+    const MeshView view = asset.View();
+    MeshReloadPlan plan;
+    if (!PlanMeshReload(view, asset.partHashes, m_MeshParts.data(), m_MeshParts.size(), m_Resident, plan)) {
+        m_ReloadStatus = "full upload: " + plan.fullReason;
+        std::cout << "  " << m_ReloadStatus << std::endl;
+        return false;
+    }
+    UploadReloadPlan(view, plan, m_Resident.drawIDSize, m_ModelVertexFormat, m_ModelVBO, m_ModelDrawIDVBO, m_ModelSkinVBO,
+                     m_ModelEBO);
+    m_MeshParts = std::move(plan.parts);
 
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    glBindVertexArray(0);
+    char status[160];
+    std::snprintf(status, sizeof(status), "kept %zu parts, rewrote %zu, removed %zu (%.1f KiB, %.0f%% free)",
+                  plan.reusedParts, plan.uploadedParts, plan.removedParts, plan.uploadBytes / 1024.0,
+                  100.0 * (double)m_Resident.indices.FreeBytes() / (double)std::max<size_t>(m_Resident.indices.Capacity(), 1));
+    m_ReloadStatus = status;
+    std::cout << "  " << m_ReloadStatus << std::endl;
+    return true;
+}
+
+void Application::FinishModelSwap(const ModelAsset& asset) {
+    const MeshView view = asset.View();
+    const bool reload = m_PendingIsReload;
+
+    // Reload giữ clip / thời gian đang phát nếu số clip không đổi (cache key của cursor phải dựng lại)
+    CharacterAnimation playback = m_Character;
+    const size_t clipCount = m_Rig.ClipCount();
+    SetupSkinning(view);
+    if (reload && clipCount == m_Rig.ClipCount()) {
+        m_Character = playback;
+        m_Character.base.cachedClip = m_Character.blend.cachedClip = -1;
+    }
+    // Texture nén không đổi (chỉ sửa mesh): giữ nguyên mip đang resident
+    if (!reload || asset.partHashes.empty() || asset.textureHash != m_TextureHash)
+        m_Textures.Load(view); // copy bản nén: cache sắp được unmap
+    m_TextureHash = asset.textureHash;
+    UploadMaterials();
+    m_Scene.Build(view);
+    UploadInstances(true);
+    m_Culler.Build(m_Scene.InstanceBounds());
+    m_InstanceLod.assign(m_Scene.TotalInstances(), 0);
+    for (unsigned int lod = 0; lod < kMaxMeshLods; lod++) {
+        m_LodStats[lod].meshTriangles = 0;
+        for (const MeshPart& part : m_MeshParts)
+            if (lod < PartLodCount(part)) m_LodStats[lod].meshTriangles += PartLod(part, lod).indexCount / 3;
+    }
+
+    m_LastLoadMs = (glfwGetTime() - m_LoadRequestTime) * 1000.0;
+    m_LastImportMs = asset.loadMs;
+    m_LastLoadFromCache = asset.fromCache;
+    std::cout << "  ready to draw " << m_LastLoadMs << " ms after request (upload included)" << std::endl;
+
+    m_ModelPath = m_PendingLoad.Path();
+    m_ModelImportFlags = m_PendingLoad.ImportFlags();
+    if (!reload) m_ReloadStatus.clear();
+    m_ModelDependencies.clear();
+    asset.DependencyFiles(m_ModelDependencies);
+    WatchFiles();
+    m_LoadStatus = (reload ? "Reloaded " : "Loaded ") + m_PendingLoad.Path();
+    m_PendingIsReload = false;
+    m_PendingLoad.Reset(); // unmap cache / giải phóng dữ liệu CPU
+}
+
+void Application::WatchFiles() {
+    m_Watcher.Clear();
+    if (!m_HotReload) return;
+    m_Watcher.Watch(m_Shader.VertexPath());
+    m_Watcher.Watch(m_Shader.FragmentPath());
+    if (m_ModelPath.empty()) return;
+    m_Watcher.Watch(m_ModelPath);
+    for (const std::string& path : m_ModelDependencies) m_Watcher.Watch(path);
+}
+
+void Application::PollFileChanges() {
+    if (m_HotReload) {
+        m_Watcher.Poll(glfwGetTime(), m_ChangedFiles);
+        bool reloadModel = false, reloadShader = false;
+        for (const std::string& path : m_ChangedFiles) {
+            if (path == m_Shader.VertexPath() || path == m_Shader.FragmentPath()) reloadShader = true;
+            else reloadModel = true;
+        }
+        if (reloadShader) m_Shader.Reload();
+        // Đang load model khác do người dùng chọn thì model đó sẽ thay model này, không reload
+        if (reloadModel && !m_ModelPath.empty() && (!m_PendingLoad.Valid() || m_PendingIsReload)) {
+            std::cout << "Hot reload: " << m_ModelPath << " changed" << std::endl;
+            const std::string path = m_ModelPath;
+            LoadModelRaw(path.c_str(), true);
+        }
+    }
+    // Program mới chỉ thay bản cũ khi link được và khớp layout; đang chờ driver thì vẫn cần frame để hỏi tiếp
+    if (m_Shader.Pending()) {
+        m_Scheduler.MarkDirty(kDirtyLoad);
+        std::string error;
+        if (m_Shader.Update()) m_ModelUniforms.Resolve(m_Shader.Reflection(), error);
+    }
 }
 // -------------------------------------------------------------
 
-void Application::HandleEvents() {
-    // GLFW đơn giản hơn SDL, chỉ cần poll
-    glfwPollEvents();
+void Application::HandleEvents(double waitTimeout) {
+    PROFILE_SCOPE("HandleEvents");
+    if (waitTimeout > 0.0) {
+        m_Scheduler.Stats().waits++;
+        // Null platform (headless) không có event để chờ, glfwWaitEventsTimeout trả về ngay: tự ngủ
+        if (m_Headless) {
+            SleepUntil(0.0, waitTimeout);
+            glfwPollEvents();
+        } else {
+            glfwWaitEventsTimeout(waitTimeout);
+        }
+    } else {
+        // GLFW đơn giản hơn SDL, chỉ cần poll
+        glfwPollEvents();
+    }
 
     // Check nút Escape
     if (glfwGetKey(m_Window, GLFW_KEY_ESCAPE) == GLFW_PRESS) {
@@ -225,8 +761,8 @@ void Application::HandleEvents() {
     // ta lấy FramebufferSize trực tiếp trong hàm Render
 }
 
-void Application::Render() {
-    // 1. Setup Frame UI (GLFW backend)
+void Application::BuildUI() {
+    // Setup Frame UI (GLFW backend)
     ImGui_ImplOpenGL3_NewFrame();
     ImGui_ImplGlfw_NewFrame(); // Thay SDL
     ImGui::NewFrame();
@@ -234,63 +770,164 @@ void Application::Render() {
     // UI Controls (Giữ nguyên)
     ImGui::Begin("OpenGL 4.1 Viewer");
     ImGui::DragFloat("Scale", &m_Scale, 0.01f, 0.01f, 10.0f);
+    ImGui::DragFloat("Camera Distance", &m_CameraDistance, 0.1f, 0.5f, 500.0f);
     ImGui::Checkbox("Auto Rotate", &m_AutoRotate);
     if (!m_AutoRotate) ImGui::SliderFloat("Rotation", &m_RotationAngle, 0.0f, 360.0f);
-    else m_RotationAngle += 0.5f;
+    FramePacing& pacing = m_Scheduler.Pacing();
+    int mode = (int)pacing.mode;
+    if (ImGui::Combo("Frame Pacing", &mode, "Continuous\0On Demand (idle)\0Low Latency\0")) pacing.mode = (FrameMode)mode;
+    float maxFps = (float)pacing.maxFps;
+    if (ImGui::SliderFloat("Max FPS", &maxFps, 0.0f, 240.0f, maxFps <= 0.0f ? "uncapped" : "%.0f")) pacing.maxFps = maxFps;
+    ImGui::Text("  %llu frames, %llu steps, %llu waits, slept %.1f s", (unsigned long long)m_Scheduler.Stats().framesRendered,
+                (unsigned long long)m_Scheduler.Stats().steps, (unsigned long long)m_Scheduler.Stats().waits,
+                m_Scheduler.Stats().sleptSeconds);
     ImGui::Checkbox("Wireframe", &m_Wireframe);
+    ImGui::Checkbox("Batched Draw", &m_BatchedDraw);
+    ImGui::SameLine();
+    ImGui::Text("(%d draw calls, %zu parts)", m_DrawCallCount, m_MeshParts.size());
+    ImGui::Text("  %u GL calls, %u redundant skipped", m_FrameGpuCalls.Total(), m_FrameGpuSkipped.Total());
+    ImGui::Checkbox("Frustum Culling", &m_FrustumCulling);
+    ImGui::SameLine();
+    ImGui::Text("(%zu drawn, %zu culled)", m_VisibleCount, m_Scene.TotalInstances() - m_VisibleCount);
+    ImGui::SliderInt("Force LOD", &m_LodParams.forcedLevel, -1, (int)kMaxMeshLods - 1,
+                     m_LodParams.forcedLevel < 0 ? "auto" : "%d");
+    if (m_LodParams.forcedLevel < 0) ImGui::SliderFloat("LOD Error (px)", &m_LodParams.threshold, 0.25f, 16.0f);
+    for (unsigned int lod = 0; lod < kMaxMeshLods; lod++) {
+        const LodStats& stats = m_LodStats[lod];
+        if (stats.meshTriangles == 0) continue;
+        ImGui::Text("  LOD %u: %zu tris/mesh set, drawn %zu x -> %zu tris", lod, stats.meshTriangles,
+                    stats.instances, stats.triangles);
+    }
+    if (m_Textures.Count() > 0) {
+        TextureResidencyParams& params = m_Textures.Params();
+        int budgetMiB = (int)(params.budgetBytes >> 20);
+        if (ImGui::SliderInt("Texture Budget (MiB)", &budgetMiB, 1, 1024)) params.budgetBytes = (size_t)budgetMiB << 20;
+        ImGui::Text("  %zu textures (%s): resident %.1f / wanted %.1f / all mips %.1f MiB", m_Textures.Count(),
+                    m_Textures.HardwareCompression() ? "BC" : "BC decoded on CPU", m_Textures.ResidentBytes() / 1048576.0,
+                    m_Textures.Residency().WantedBytes() / 1048576.0, m_Textures.TotalBytes() / 1048576.0);
+    }
+    if (m_Rig.ClipCount() > 0) {
+        auto ClipCombo = [this](const char* label, int& clip, bool allowNone) {
+            const char* preview = clip >= 0 ? m_Rig.Clip(clip).name : "none";
+            if (!ImGui::BeginCombo(label, preview)) return;
+            if (allowNone && ImGui::Selectable("none", clip < 0)) clip = -1;
+            for (int i = 0; i < (int)m_Rig.ClipCount(); i++) {
+                ImGui::PushID(i);
+                if (ImGui::Selectable(m_Rig.Clip(i).name, clip == i)) clip = i;
+                ImGui::PopID();
+            }
+            ImGui::EndCombo();
+        };
+        ImGui::Checkbox("Play Animation", &m_PlayAnimation);
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(120.0f);
+        ImGui::SliderFloat("Speed", &m_Character.speed, 0.0f, 3.0f);
+        ClipCombo("Clip", m_Character.base.clip, false);
+        ClipCombo("Blend Clip", m_Character.blend.clip, true);
+        if (m_Character.blend.clip >= 0) ImGui::SliderFloat("Blend Weight", &m_Character.blendWeight, 0.0f, 1.0f);
+    }
+    if (!m_SkinWeights.empty()) {
+        ImGui::Checkbox("CPU Skinning", &m_CpuSkinning);
+        ImGui::SameLine();
+        ImGui::Text("(%s, %zu joints, %zu vertices)", m_CpuSkinning ? SkinSimdName() : "GPU palette",
+                    m_Rig.JointCount(), m_SkinWeights.size());
+    }
+    if (m_Rig.ClipCount() > 0 || !m_SkinWeights.empty())
+        ImGui::Text("  pose %.3f ms, %s %.3f ms", m_PoseMs, m_CpuSkinning ? "skin + stream" : "palette upload", m_SkinMs);
     ImGui::Checkbox("Override Color", &m_UseOverrideColor);
     if (m_UseOverrideColor) ImGui::ColorEdit3("Color", m_OverrideColor);
     
+    if (!m_Scene.IsFlattened())
+        ImGui::Text("Scene: %zu nodes, %zu instances of %zu meshes", m_Scene.NodeCount(),
+                    m_Scene.TotalInstances(), m_MeshParts.size());
+
     static char pathBuf[128] = "res/chess_pieces.glb";
     ImGui::InputText("Path", pathBuf, IM_ARRAYSIZE(pathBuf));
+    ImGui::Checkbox("Keep Hierarchy (instancing)", &m_KeepHierarchy);
     if (ImGui::Button("Load Model")) LoadModelRaw(pathBuf);
+    // Đổi định dạng: upload lại model đang vẽ (dữ liệu float trên CPU / cache không đổi)
+    int format = (int)m_VertexFormat;
+    if (ImGui::Combo("Vertex Format", &format, "Float (20 B)\0Quantized (12 B)\0")) {
+        m_VertexFormat = (VertexFormat)format;
+        if (!m_ModelPath.empty() && m_VertexFormat != m_ModelVertexFormat) LoadModelRaw(m_ModelPath.c_str());
+    }
+
+    if (m_PendingLoad.Valid()) {
+        bool uploading = m_Uploader.IsActive();
+        float progress = uploading ? m_Uploader.Progress() : m_PendingLoad.Progress();
+        ImGui::ProgressBar(progress, ImVec2(-80.0f, 0.0f), uploading ? "Uploading" : "Importing");
+        ImGui::SameLine();
+        if (ImGui::Button("Cancel")) CancelModelLoad();
+    } else if (!m_LoadStatus.empty()) {
+        ImGui::TextUnformatted(m_LoadStatus.c_str());
+    }
+    if (ImGui::Checkbox("Hot Reload (watch files)", &m_HotReload)) WatchFiles();
+    if (m_HotReload) {
+        ImGui::Text("Watching %zu files (%s)", m_Watcher.Count(), m_Watcher.NativeEvents() ? "inotify" : "polling");
+        if (!m_ReloadStatus.empty()) ImGui::TextWrapped("Mesh: %s", m_ReloadStatus.c_str());
+        ImGui::TextWrapped("Shader: %s%s", m_Shader.Pending() ? "compiling... " : "", m_Shader.Status().c_str());
+    }
+#if APP_PROFILER
+    ImGui::Checkbox("Profiler", &m_ShowProfiler);
+#endif
     ImGui::End();
+#if APP_PROFILER
+    if (m_ShowProfiler) DrawProfilerOverlay();
+#endif
+}
+
+void Application::Render() {
+#if APP_PROFILER
+    m_GpuProfiler.BeginFrame(); // đọc kết quả GPU của frame cũ nếu đã xong
+#endif
+
+    // 1. UI
+    {
+        PROFILE_SCOPE("UI Build");
+        BuildUI();
+    }
+
+    {
+        PROFILE_SCOPE("Model Load Update");
+        UpdateModelLoad();
+    }
 
     // 2. Viewport & Retina Support
     int displayW, displayH;
     // GLFW thay SDL_GL_GetDrawableSize
     glfwGetFramebufferSize(m_Window, &displayW, &displayH);
     glViewport(0, 0, displayW, displayH);
+    m_ViewportHeight = displayH > 0 ? displayH : 1;
 
     glClearColor(0.1f, 0.1f, 0.15f, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
     if (!m_MeshParts.empty()) {
-        glUseProgram(m_ShaderProgram);
-        
+        PROFILE_SCOPE("Scene Draw");
+        PROFILE_GPU_SCOPE(m_GpuProfiler, "GPU Scene");
         float aspectRatio = (float)displayW / (float)displayH;
         // Nếu minimize window, aspect ratio có thể NaN, cần check
         if (displayH == 0) aspectRatio = 1.0f;
 
         glm::mat4 projection = glm::perspective(glm::radians(45.0f), aspectRatio, 0.1f, 1000.0f);
-        glm::mat4 view = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, -2.0f, -8.0f)); 
+        glm::mat4 view = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, -2.0f, -m_CameraDistance));
         glm::mat4 model = glm::mat4(1.0f);
-        model = glm::rotate(model, glm::radians(m_RotationAngle), glm::vec3(0.0f, 1.0f, 0.0f));
+        // Auto-rotate: nội suy giữa hai bước mô phỏng; slider / bench: dùng thẳng giá trị
+        float angle = m_RotationAngle;
+        if (m_AutoRotate) angle = m_PrevRotationAngle + (m_RotationAngle - m_PrevRotationAngle) * (float)m_Scheduler.Alpha();
+        model = glm::rotate(model, glm::radians(angle), glm::vec3(0.0f, 1.0f, 0.0f));
         model = glm::scale(model, glm::vec3(m_Scale));
 
-        glUniformMatrix4fv(glGetUniformLocation(m_ShaderProgram, "u_Projection"), 1, GL_FALSE, glm::value_ptr(projection));
-        glUniformMatrix4fv(glGetUniformLocation(m_ShaderProgram, "u_View"), 1, GL_FALSE, glm::value_ptr(view));
-        glUniformMatrix4fv(glGetUniformLocation(m_ShaderProgram, "u_Model"), 1, GL_FALSE, glm::value_ptr(model));
-
-        glBindVertexArray(m_ModelVAO);
-        glPolygonMode(GL_FRONT_AND_BACK, m_Wireframe ? GL_LINE : GL_FILL);
-
-        int colorLoc = glGetUniformLocation(m_ShaderProgram, "u_Color");
-        for (const auto& part : m_MeshParts) {
-            if (m_UseOverrideColor)
-                glUniform4f(colorLoc, m_OverrideColor[0], m_OverrideColor[1], m_OverrideColor[2], 1.0f);
-            else
-                glUniform4f(colorLoc, part.color[0], part.color[1], part.color[2], part.color[3]);
-
-            void* offsetPtr = (void*)(part.indexOffset * sizeof(unsigned int));
-            glDrawElements(GL_TRIANGLES, part.indexCount, GL_UNSIGNED_INT, offsetPtr);
-        }
-        glBindVertexArray(0);
+        DrawModel(projection, view, model);
     }
 
     // 3. Render ImGui
-    ImGui::Render();
-    ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    {
+        PROFILE_SCOPE("ImGui Render");
+        PROFILE_GPU_SCOPE(m_GpuProfiler, "GPU ImGui");
+        ImGui::Render();
+        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    }
     
     // Xử lý Viewports (Nếu bật)
     ImGuiIO& io = ImGui::GetIO();
@@ -300,16 +937,169 @@ void Application::Render() {
         ImGui::RenderPlatformWindowsDefault();
         glfwMakeContextCurrent(backup_current_context);
     }
+}
+
+void Application::Present() {
+    {
+        PROFILE_SCOPE("Swap");
+        glfwSwapBuffers(m_Window);
+    }
+#if APP_PROFILER
+    Profiler::Get().EndFrame();
+#endif
+}
+
+#if APP_PROFILER
+void Application::DrawProfilerOverlay() {
+    Profiler& profiler = Profiler::Get();
+    ImGui::SetNextWindowSize(ImVec2(480.0f, 460.0f), ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("Profiler", &m_ShowProfiler)) {
+        ImGui::End();
+        return;
+    }
+
+    // Slot HistoryCursor() là frame đang gom -> chỉ lấy các frame đã xong, cũ nhất trước
+    const size_t n = Profiler::kHistoryFrames;
+    const size_t cursor = profiler.HistoryCursor();
+    auto Ordered = [&](const float* history, float* out, float& avg, float& peak) {
+        avg = peak = 0.0f;
+        for (size_t i = 0; i + 1 < n; i++) {
+            out[i] = history[(cursor + 1 + i) % n];
+            avg += out[i];
+            peak = std::max(peak, out[i]);
+        }
+        avg /= (float)(n - 1);
+    };
+
+    float values[Profiler::kHistoryFrames];
+    float avg, peak;
+    char overlay[64];
+    Ordered(profiler.FrameHistory(), values, avg, peak);
+    std::snprintf(overlay, sizeof(overlay), "CPU frame avg %.2f ms, max %.2f", avg, peak);
+    ImGui::PlotLines("##frame", values, (int)n - 1, 0, overlay, 0.0f, std::max(peak, 1.0f), ImVec2(-1.0f, 60.0f));
+    Ordered(profiler.GpuHistory(), values, avg, peak);
+    std::snprintf(overlay, sizeof(overlay), "GPU avg %.2f ms, max %.2f", avg, peak);
+    ImGui::PlotLines("##gpu", values, (int)n - 1, 0, overlay, 0.0f, std::max(peak, 1.0f), ImVec2(-1.0f, 60.0f));
+
+    if (ImGui::BeginTable("zones", 5, ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_SizingStretchProp)) {
+        ImGui::TableSetupColumn("Zone");
+        ImGui::TableSetupColumn("Last ms");
+        ImGui::TableSetupColumn("Avg ms");
+        ImGui::TableSetupColumn("Max ms");
+        ImGui::TableSetupColumn("Calls");
+        ImGui::TableHeadersRow();
+        for (const Profiler::ZoneStats* zone : profiler.Zones()) {
+            Ordered(zone->history, values, avg, peak);
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            if (zone->gpu) ImGui::TextColored(ImVec4(0.5f, 0.8f, 1.0f, 1.0f), "%s", zone->name);
+            else ImGui::TextUnformatted(zone->name);
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", values[n - 2]);
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", avg);
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", peak);
+            ImGui::TableNextColumn(); ImGui::Text("%u", zone->lastCalls);
+        }
+        ImGui::EndTable();
+    }
+    if (profiler.DroppedEvents() || m_GpuProfiler.Dropped())
+        ImGui::Text("Dropped: %zu CPU events, %zu GPU queries (not ready)", profiler.DroppedEvents(),
+                    m_GpuProfiler.Dropped());
+
+    ImGui::SetNextItemWidth(100.0f);
+    ImGui::InputInt("Frames", &m_CaptureFrameCount);
+    m_CaptureFrameCount = std::max(1, std::min(m_CaptureFrameCount, 5000));
+    ImGui::SameLine();
+    if (profiler.IsCapturing()) ImGui::BeginDisabled();
+    if (ImGui::Button("Capture Chrome Trace")) profiler.StartCapture((unsigned int)m_CaptureFrameCount, "profile_trace.json");
+    if (profiler.IsCapturing()) ImGui::EndDisabled();
+    if (!profiler.CaptureStatus().empty()) ImGui::TextUnformatted(profiler.CaptureStatus().c_str());
+    ImGui::End();
+}
+#endif
+
+void Application::DrawModel(const glm::mat4& projection, const glm::mat4& view, const glm::mat4& model) {
+    UpdateAnimation();
+    {
+        PROFILE_SCOPE("Cull + LOD");
+        // Transform node thay đổi -> chỉ upload lại khoảng instance bị ảnh hưởng, refit BVH
+        if (m_Scene.UpdateWorldTransforms() > 0) {
+            UploadInstances(false);
+            m_Culler.Refit(m_Scene.InstanceBounds());
+        }
+        CullInstances(projection * view * model);
+        SelectLods(projection, view * model);
+        BuildVisibleLists();
+    }
+    if (m_Textures.Count() > 0) {
+        // Cùng camera / pixelsPerUnit với LOD: texture của part gần và lớn trên màn hình được giữ mip lớn
+        glm::vec3 cameraPos = glm::vec3(glm::inverse(view * model)[3]);
+        m_Textures.Residency().BeginFrame();
+        RequestInstanceTextures(m_MeshParts.data(), m_Scene, m_InstanceVisible.data(), cameraPos,
+                                m_LodParams.pixelsPerUnit, m_Textures.Residency());
+        if (m_Textures.Update(m_UploadBudget)) m_Scheduler.MarkDirty(kDirtyStreaming);
+    }
+    PROFILE_SCOPE("Submit");
+    const CameraBlock camera = { projection, view, model };
+    m_TextureHandles.resize(m_Textures.Count());
+    for (size_t i = 0; i < m_TextureHandles.size(); i++) m_TextureHandles[i] = m_Textures.Handle((int)i);
+
+    ModelSubmitInput input;
+    input.program = &m_Shader.Reflection();
+    input.uniforms = &m_ModelUniforms;
+    input.cameraBuffer = m_CameraUBO;
+    input.camera = &camera;
+    input.modelVAO = m_ModelVAO;
+    input.skinnedVAO = m_SkinnedVAO;
+    input.skinnedBase = m_SkinnedBase.data();
+    input.textureHandles = m_TextureHandles.data();
+    input.textureCount = m_TextureHandles.size();
+    input.materialTexture = m_MaterialTexture;
+    input.instanceTexture = m_InstanceTexture;
+    input.instanceIndexTexture = m_InstanceIndexTexture;
+    input.paletteTexture = m_PaletteTexture;
+    input.partDecodeTexture = m_PartDecodeTexture;
+    input.wireframe = m_Wireframe;
+    input.batched = m_BatchedDraw;
+    input.flattened = m_Scene.IsFlattened();
+    input.gpuSkinning = !m_CpuSkinning && !m_SkinWeights.empty();
+    input.cpuSkinning = m_CpuSkinning;
+    input.quantizedPositions = m_ModelVertexFormat == VertexFormat::Quantized;
+    input.useOverrideColor = m_UseOverrideColor;
+    for (int k = 0; k < 3; k++) input.overrideColor[k] = m_OverrideColor[k];
+    input.parts = m_MeshParts.data();
+    input.partCount = m_MeshParts.size();
+    input.visibleOffset = m_VisibleOffset.data();
+    input.drawList = &m_DrawList;
 
-    // Swap buffers (GLFW)
-    glfwSwapBuffers(m_Window);
+    // Uploader / texture streaming / ImGui đổi VAO và texture ngoài device: quên các binding đó mỗi frame
+    m_CallCounter.ResetCounts();
+    m_Device.ResetSkipped();
+    m_Device.BeginFrame();
+    m_DrawCallCount = SubmitModel(m_Device, input);
+    m_FrameGpuCalls = m_CallCounter.Counts();
+    m_FrameGpuSkipped = m_Device.Skipped();
 }
 
 void Application::Clean() {
-    glDeleteVertexArrays(1, &m_ModelVAO);
-    glDeleteBuffers(1, &m_ModelVBO);
-    glDeleteBuffers(1, &m_ModelEBO);
-    glDeleteProgram(m_ShaderProgram);
+    if (!m_Window) return; // Init thất bại: chưa có context GL / ImGui để dọn
+    CancelModelLoad();
+#if APP_PROFILER
+    m_GpuProfiler.Shutdown();
+#endif
+    DeleteModelBuffers();
+    m_Textures.Clear();
+    glDeleteBuffers(1, &m_MaterialBuffer);
+    glDeleteBuffers(1, &m_CameraUBO);
+    glDeleteTextures(1, &m_MaterialTexture);
+    glDeleteBuffers(1, &m_PartDecodeBuffer);
+    glDeleteTextures(1, &m_PartDecodeTexture);
+    glDeleteBuffers(1, &m_InstanceBuffer);
+    glDeleteTextures(1, &m_InstanceTexture);
+    glDeleteBuffers(1, &m_InstanceIndexBuffer);
+    glDeleteTextures(1, &m_InstanceIndexTexture);
+    glDeleteBuffers(1, &m_PaletteBuffer);
+    glDeleteTextures(1, &m_PaletteTexture);
+    m_Shader.Destroy();
 
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplGlfw_Shutdown(); // Shutdown GLFW backend
@@ -0,0 +1,77 @@
+#include "AsyncModelLoader.h"
+#include "MeshReload.h"
+#include "Profiler.h"
+
+AsyncModelLoader::AsyncModelLoader() {
+    m_Worker = std::thread(&AsyncModelLoader::WorkerLoop, this);
+}
+
+AsyncModelLoader::~AsyncModelLoader() {
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Quit = true;
+        for (auto& job : m_Queue) job->cancelRequested = true;
+    }
+    m_Wake.notify_one();
+    m_Worker.join();
+}
+
+ModelLoadHandle AsyncModelLoader::Request(const std::string& path, unsigned int importFlags, bool hashParts) {
+    auto job = std::make_shared<ModelLoadJob>();
+    job->path = path;
+    job->importFlags = importFlags;
+    job->hashParts = hashParts;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Queue.push_back(job);
+    }
+    m_Wake.notify_one();
+    return ModelLoadHandle(job);
+}
+
+void AsyncModelLoader::WorkerLoop() {
+    PROFILE_THREAD_NAME("Model Loader");
+    for (;;) {
+        std::shared_ptr<ModelLoadJob> job;
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_Wake.wait(lock, [this]() { return m_Quit || !m_Queue.empty(); });
+            if (m_Quit) return;
+            job = m_Queue.front();
+            m_Queue.pop_front();
+        }
+
+        if (job->cancelRequested) {
+            job->state.store(LoadState::Cancelled, std::memory_order_release);
+            continue;
+        }
+        job->state.store(LoadState::Loading, std::memory_order_release);
+
+        ModelLoadJob* raw = job.get();
+        auto progress = [raw](float value) {
+            if (value >= 0.0f) raw->progress.store(value, std::memory_order_relaxed);
+            return !raw->cancelRequested.load(std::memory_order_relaxed);
+        };
+
+        PROFILE_SCOPE("Load Model");
+        bool ok = LoadModelAsset(job->path.c_str(), job->importFlags, job->asset, true, progress, &job->error);
+
+        LoadState result = LoadState::Ready;
+        if (job->cancelRequested) {
+            job->asset = ModelAsset();
+            result = LoadState::Cancelled;
+        } else if (!ok) {
+            result = LoadState::Failed;
+        } else {
+            if (job->hashParts) {
+                // Hash ngay khi dữ liệu còn trên CPU: sau upload cache bị unmap, reload sau không còn gì để so
+                const MeshView view = job->asset.View();
+                HashMeshParts(view, job->asset.partHashes);
+                job->asset.textureHash = HashBytes(view.textures, view.textureCount * sizeof(TextureDesc),
+                                                   HashBytes(view.textureData, view.textureBytes));
+            }
+            job->progress.store(1.0f, std::memory_order_relaxed);
+        }
+        job->state.store(result, std::memory_order_release);
+    }
+}
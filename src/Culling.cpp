@@ -0,0 +1,271 @@
+#include "Culling.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__AVX__)
+    #include <immintrin.h>
+    #define HZ_CULL_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define HZ_CULL_SSE 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define HZ_CULL_NEON 1
+#endif
+
+AABB TransformAABB(const glm::mat4& m, const AABB& box) {
+    glm::vec3 center = (box.min + box.max) * 0.5f;
+    glm::vec3 extent = (box.max - box.min) * 0.5f;
+    glm::vec3 newCenter = glm::vec3(m * glm::vec4(center, 1.0f));
+    glm::vec3 newExtent;
+    for (int r = 0; r < 3; r++)
+        newExtent[r] = std::abs(m[0][r]) * extent.x + std::abs(m[1][r]) * extent.y + std::abs(m[2][r]) * extent.z;
+    return { newCenter - newExtent, newCenter + newExtent };
+}
+
+Frustum Frustum::FromMatrix(const glm::mat4& clip) {
+    // glm column-major: hàng i là (clip[0][i], clip[1][i], clip[2][i], clip[3][i])
+    glm::vec4 row[4];
+    for (int i = 0; i < 4; i++) row[i] = glm::vec4(clip[0][i], clip[1][i], clip[2][i], clip[3][i]);
+
+    Frustum f;
+    f.planes[0] = row[3] + row[0]; // left
+    f.planes[1] = row[3] - row[0]; // right
+    f.planes[2] = row[3] + row[1]; // bottom
+    f.planes[3] = row[3] - row[1]; // top
+    f.planes[4] = row[3] + row[2]; // near
+    f.planes[5] = row[3] - row[2]; // far
+    for (glm::vec4& plane : f.planes) {
+        float length = glm::length(glm::vec3(plane));
+        if (length > 0.0f) plane /= length;
+    }
+    return f;
+}
+
+CullResult TestAABB(const Frustum& frustum, const AABB& box) {
+    CullResult result = CullResult::Inside;
+    for (const glm::vec4& plane : frustum.planes) {
+        // p-vertex: góc xa nhất theo hướng pháp tuyến, n-vertex: góc đối diện
+        glm::vec3 p(plane.x >= 0.0f ? box.max.x : box.min.x,
+                    plane.y >= 0.0f ? box.max.y : box.min.y,
+                    plane.z >= 0.0f ? box.max.z : box.min.z);
+        glm::vec3 n(plane.x >= 0.0f ? box.min.x : box.max.x,
+                    plane.y >= 0.0f ? box.min.y : box.max.y,
+                    plane.z >= 0.0f ? box.min.z : box.max.z);
+        if (glm::dot(glm::vec3(plane), p) + plane.w < 0.0f) return CullResult::Outside;
+        if (glm::dot(glm::vec3(plane), n) + plane.w < 0.0f) result = CullResult::Intersect;
+    }
+    return result;
+}
+
+// --- SoA ---
+void BoundsSoA::Resize(size_t count) {
+    minX.resize(count); minY.resize(count); minZ.resize(count);
+    maxX.resize(count); maxY.resize(count); maxZ.resize(count);
+}
+
+void BoundsSoA::Set(size_t i, const AABB& box) {
+    minX[i] = box.min.x; minY[i] = box.min.y; minZ[i] = box.min.z;
+    maxX[i] = box.max.x; maxY[i] = box.max.y; maxZ[i] = box.max.z;
+}
+
+AABB BoundsSoA::Get(size_t i) const {
+    return { glm::vec3(minX[i], minY[i], minZ[i]), glm::vec3(maxX[i], maxY[i], maxZ[i]) };
+}
+
+// --- BOX TESTS ---
+void CullBoxesScalar(const Frustum& frustum, const BoundsSoA& boxes, size_t begin, size_t end, uint8_t* outVisible) {
+    for (size_t i = begin; i < end; i++) {
+        uint8_t visible = 1;
+        for (const glm::vec4& plane : frustum.planes) {
+            float px = plane.x >= 0.0f ? boxes.maxX[i] : boxes.minX[i];
+            float py = plane.y >= 0.0f ? boxes.maxY[i] : boxes.minY[i];
+            float pz = plane.z >= 0.0f ? boxes.maxZ[i] : boxes.minZ[i];
+            if (plane.x * px + plane.y * py + plane.z * pz + plane.w < 0.0f) {
+                visible = 0;
+                break;
+            }
+        }
+        outVisible[i] = visible;
+    }
+}
+
+// Dấu pháp tuyến cố định theo plane nên p-vertex chọn cả mảng, không cần blend theo lane
+#define HZ_PVERTEX_ARRAYS(plane) \
+    const float* px = (plane).x >= 0.0f ? boxes.maxX.data() : boxes.minX.data(); \
+    const float* py = (plane).y >= 0.0f ? boxes.maxY.data() : boxes.minY.data(); \
+    const float* pz = (plane).z >= 0.0f ? boxes.maxZ.data() : boxes.minZ.data();
+
+void CullBoxes(const Frustum& frustum, const BoundsSoA& boxes, size_t begin, size_t end, uint8_t* outVisible) {
+    size_t i = begin;
+#if defined(HZ_CULL_AVX)
+    for (; i + 8 <= end; i += 8) {
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (const glm::vec4& plane : frustum.planes) {
+            HZ_PVERTEX_ARRAYS(plane)
+            __m256 d = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.x), _mm256_loadu_ps(px + i)),
+                                     _mm256_mul_ps(_mm256_set1_ps(plane.y), _mm256_loadu_ps(py + i)));
+            d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_set1_ps(plane.z), _mm256_loadu_ps(pz + i)));
+            d = _mm256_add_ps(d, _mm256_set1_ps(plane.w));
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(d, _mm256_setzero_ps(), _CMP_GE_OQ));
+        }
+        int mask = _mm256_movemask_ps(inside);
+        for (int k = 0; k < 8; k++) outVisible[i + k] = (uint8_t)((mask >> k) & 1);
+    }
+#elif defined(HZ_CULL_SSE)
+    for (; i + 4 <= end; i += 4) {
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (const glm::vec4& plane : frustum.planes) {
+            HZ_PVERTEX_ARRAYS(plane)
+            __m128 d = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.x), _mm_loadu_ps(px + i)),
+                                  _mm_mul_ps(_mm_set1_ps(plane.y), _mm_loadu_ps(py + i)));
+            d = _mm_add_ps(d, _mm_mul_ps(_mm_set1_ps(plane.z), _mm_loadu_ps(pz + i)));
+            d = _mm_add_ps(d, _mm_set1_ps(plane.w));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(d, _mm_setzero_ps()));
+        }
+        int mask = _mm_movemask_ps(inside);
+        for (int k = 0; k < 4; k++) outVisible[i + k] = (uint8_t)((mask >> k) & 1);
+    }
+#elif defined(HZ_CULL_NEON)
+    for (; i + 4 <= end; i += 4) {
+        uint32x4_t inside = vdupq_n_u32(0xFFFFFFFFu);
+        for (const glm::vec4& plane : frustum.planes) {
+            HZ_PVERTEX_ARRAYS(plane)
+            float32x4_t d = vdupq_n_f32(plane.w);
+            d = vmlaq_n_f32(d, vld1q_f32(px + i), plane.x);
+            d = vmlaq_n_f32(d, vld1q_f32(py + i), plane.y);
+            d = vmlaq_n_f32(d, vld1q_f32(pz + i), plane.z);
+            inside = vandq_u32(inside, vcgeq_f32(d, vdupq_n_f32(0.0f)));
+        }
+        uint32_t lanes[4];
+        vst1q_u32(lanes, inside);
+        for (int k = 0; k < 4; k++) outVisible[i + k] = (uint8_t)(lanes[k] & 1);
+    }
+#endif
+    CullBoxesScalar(frustum, boxes, i, end, outVisible);
+}
+
+#undef HZ_PVERTEX_ARRAYS
+
+const char* CullSimdName() {
+#if defined(HZ_CULL_AVX)
+    return "AVX x8";
+#elif defined(HZ_CULL_SSE)
+    return "SSE x4";
+#elif defined(HZ_CULL_NEON)
+    return "NEON x4";
+#else
+    return "scalar";
+#endif
+}
+
+// --- BVH ---
+static AABB Union(const AABB& a, const AABB& b) {
+    return { glm::min(a.min, b.min), glm::max(a.max, b.max) };
+}
+
+void BoundsBVH::Build(const std::vector<AABB>& boxes) {
+    const unsigned int count = (unsigned int)boxes.size();
+    m_Nodes.clear();
+    m_ObjectIds.resize(count);
+    if (count == 0) {
+        m_Leaves.Resize(0);
+        return;
+    }
+
+    // Box + centroid nằm liền nhau và được hoán vị tại chỗ: nth_element không phải nhảy qua index
+    m_BuildPrims.resize(count);
+    for (unsigned int i = 0; i < count; i++)
+        m_BuildPrims[i] = { boxes[i], (boxes[i].min + boxes[i].max) * 0.5f, i };
+
+    m_Nodes.reserve(2 * (count / kLeafSize + 1));
+    m_Nodes.emplace_back();
+    BuildNode(0, 0, count);
+
+    m_Leaves.Resize(count);
+    for (unsigned int i = 0; i < count; i++) {
+        m_ObjectIds[i] = m_BuildPrims[i].id;
+        m_Leaves.Set(i, m_BuildPrims[i].box);
+    }
+}
+
+void BoundsBVH::BuildNode(unsigned int nodeIndex, unsigned int first, unsigned int count) {
+    BuildPrim* prims = m_BuildPrims.data() + first;
+    AABB bounds = prims[0].box;
+    AABB centroids = { prims[0].centroid, prims[0].centroid };
+    for (unsigned int i = 1; i < count; i++) {
+        bounds = Union(bounds, prims[i].box);
+        centroids.min = glm::min(centroids.min, prims[i].centroid);
+        centroids.max = glm::max(centroids.max, prims[i].centroid);
+    }
+
+    m_Nodes[nodeIndex].bounds = bounds;
+    m_Nodes[nodeIndex].primFirst = first;
+    m_Nodes[nodeIndex].primCount = count;
+    m_Nodes[nodeIndex].child = 0;
+    if (count <= kLeafSize) return;
+
+    // Median split theo trục centroid dài nhất
+    glm::vec3 extent = centroids.max - centroids.min;
+    int axis = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+    unsigned int half = count / 2;
+    std::nth_element(prims, prims + half, prims + count,
+                     [axis](const BuildPrim& a, const BuildPrim& b) { return a.centroid[axis] < b.centroid[axis]; });
+
+    unsigned int child = (unsigned int)m_Nodes.size();
+    m_Nodes.emplace_back();
+    m_Nodes.emplace_back();
+    m_Nodes[nodeIndex].child = child;
+    BuildNode(child, first, half);
+    BuildNode(child + 1, first + half, count - half);
+}
+
+void BoundsBVH::Refit(const std::vector<AABB>& boxes) {
+    for (size_t i = 0; i < m_ObjectIds.size(); i++) m_Leaves.Set(i, boxes[m_ObjectIds[i]]);
+
+    // Con luôn có index lớn hơn cha -> duyệt ngược là bottom-up
+    for (size_t n = m_Nodes.size(); n-- > 0;) {
+        Node& node = m_Nodes[n];
+        if (node.child) {
+            node.bounds = Union(m_Nodes[node.child].bounds, m_Nodes[node.child + 1].bounds);
+        } else {
+            AABB bounds = m_Leaves.Get(node.primFirst);
+            for (unsigned int i = node.primFirst + 1; i < node.primFirst + node.primCount; i++)
+                bounds = Union(bounds, m_Leaves.Get(i));
+            node.bounds = bounds;
+        }
+    }
+}
+
+size_t BoundsBVH::Cull(const Frustum& frustum, std::vector<uint8_t>& visible) {
+    const size_t count = m_ObjectIds.size();
+    visible.resize(count);
+    m_LeafVisible.resize(count);
+    if (count == 0) return 0;
+
+    m_Stack.clear();
+    m_Stack.push_back(0);
+    while (!m_Stack.empty()) {
+        const Node& node = m_Nodes[m_Stack.back()];
+        m_Stack.pop_back();
+
+        CullResult result = TestAABB(frustum, node.bounds);
+        if (result != CullResult::Intersect) {
+            std::memset(m_LeafVisible.data() + node.primFirst, result == CullResult::Inside ? 1 : 0, node.primCount);
+        } else if (node.child) {
+            m_Stack.push_back(node.child + 1);
+            m_Stack.push_back(node.child);
+        } else {
+            CullBoxes(frustum, m_Leaves, node.primFirst, node.primFirst + node.primCount, m_LeafVisible.data());
+        }
+    }
+
+    size_t visibleCount = 0;
+    for (size_t i = 0; i < count; i++) {
+        visible[m_ObjectIds[i]] = m_LeafVisible[i];
+        visibleCount += m_LeafVisible[i];
+    }
+    return visibleCount;
+}
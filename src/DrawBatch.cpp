@@ -0,0 +1,84 @@
+#include "DrawBatch.h"
+
+#include <algorithm>
+#include <cstring>
+
+size_t DrawList::CommandCount() const {
+    size_t count = 0;
+    for (size_t b = 0; b < batchCount; b++) count += batches[b].DrawCount();
+    return count;
+}
+
+void DrawList::Clear() {
+    batches.clear();
+    batchCount = 0;
+    partCount = 0;
+}
+
+void BuildDrawList(const MeshPart* parts, size_t partCount, const uint8_t* visible, const uint8_t* lods, DrawList& out) {
+    out.partCount = 0;
+
+    // Sort key: indexSize, texture (state) rồi indexOffset của level được chọn trong EBO
+    std::vector<unsigned int>& order = out.order;
+    order.clear();
+    for (size_t i = 0; i < partCount; i++)
+        if (!visible || visible[i]) order.push_back((unsigned int)i);
+    auto LodOf = [parts, lods](unsigned int i) { return PartLod(parts[i], lods ? lods[i] : 0); };
+    std::stable_sort(order.begin(), order.end(), [parts, &LodOf](unsigned int a, unsigned int b) {
+        if (parts[a].indexSize != parts[b].indexSize) return parts[a].indexSize < parts[b].indexSize;
+        if (parts[a].textureIndex != parts[b].textureIndex) return parts[a].textureIndex < parts[b].textureIndex;
+        return LodOf(a).indexOffset < LodOf(b).indexOffset;
+    });
+
+    // Batch cũ được dùng lại (clear chứ không giải phóng) để frame sau không cấp phát
+    size_t used = 0;
+    DrawBatch* batch = nullptr;
+    for (unsigned int index : order) {
+        const MeshPart& part = parts[index];
+        const MeshLod lod = LodOf(index);
+        if (lod.indexCount == 0) continue;
+        out.partCount++;
+
+        if (!batch || batch->indexSize != part.indexSize || batch->texture != part.textureIndex) {
+            if (used == out.batches.size()) out.batches.emplace_back();
+            batch = &out.batches[used++];
+            batch->counts.clear();
+            batch->offsets.clear();
+            batch->baseVertices.clear();
+            batch->indexSize = part.indexSize;
+            batch->texture = part.textureIndex;
+        }
+
+        // Mỗi part một command: index của part tính từ baseVertex riêng nên không nối được với part kề
+        batch->counts.push_back((int)lod.indexCount);
+        batch->offsets.push_back((const void*)(size_t)lod.indexOffset);
+        batch->baseVertices.push_back((int)part.baseVertex);
+    }
+    out.batchCount = used; // không thu nhỏ: frame sau nhiều batch hơn thì dùng lại vector cũ
+}
+
+void BuildMaterialBuffer(const MeshPart* parts, size_t partCount, std::vector<float>& outRGBA) {
+    outRGBA.resize(partCount * 4);
+    for (size_t i = 0; i < partCount; i++)
+        std::memcpy(&outRGBA[i * 4], parts[i].color, sizeof(parts[i].color));
+}
+
+unsigned int BuildVertexDrawIDs(const MeshPart* parts, size_t partCount, size_t vertexCount,
+                                std::vector<unsigned char>& outIDs) {
+    const unsigned int idSize = partCount <= 0x10000 ? 2 : 4;
+    outIDs.assign(vertexCount * idSize, 0);
+    for (size_t p = 0; p < partCount; p++) {
+        const MeshPart& part = parts[p];
+        size_t end = std::min<size_t>((size_t)part.baseVertex + part.vertexCount, vertexCount);
+        for (size_t v = part.baseVertex; v < end; v++) {
+            if (idSize == 2) {
+                uint16_t id = (uint16_t)p;
+                std::memcpy(&outIDs[v * 2], &id, 2);
+            } else {
+                uint32_t id = (uint32_t)p;
+                std::memcpy(&outIDs[v * 4], &id, 4);
+            }
+        }
+    }
+    return idSize;
+}
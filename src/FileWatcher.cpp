@@ -0,0 +1,139 @@
+#include "FileWatcher.h"
+
+#include <filesystem>
+#include <iostream>
+
+#if defined(__linux__)
+    #include <sys/inotify.h>
+    #include <unistd.h>
+    #include <cerrno>
+    #define HZ_WATCH_INOTIFY 1
+#endif
+
+namespace fs = std::filesystem;
+
+static bool StatPath(const std::string& path, uint64_t& outMtime, uint64_t& outSize) {
+    std::error_code ec;
+    outSize = fs::file_size(path, ec);
+    if (ec) return false;
+    auto mtime = fs::last_write_time(path, ec);
+    if (ec) return false;
+    outMtime = (uint64_t)mtime.time_since_epoch().count();
+    return true;
+}
+
+FileWatcher::FileWatcher() {
+#if HZ_WATCH_INOTIFY
+    m_Inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_Inotify < 0) std::cerr << "FileWatcher: inotify unavailable, polling instead" << std::endl;
+#endif
+}
+
+FileWatcher::~FileWatcher() {
+    Clear();
+#if HZ_WATCH_INOTIFY
+    if (m_Inotify >= 0) close(m_Inotify);
+#endif
+}
+
+void FileWatcher::Watch(const std::string& path) {
+    for (const File& file : m_Files)
+        if (file.path == path) return;
+
+    std::error_code ec;
+    fs::path absolute = fs::absolute(path, ec).lexically_normal();
+    if (ec) absolute = fs::path(path);
+    File file;
+    file.path = path;
+    file.directory = absolute.parent_path().string();
+    file.name = absolute.filename().string();
+    file.exists = StatPath(path, file.mtime, file.size);
+    m_Files.push_back(file);
+
+#if HZ_WATCH_INOTIFY
+    if (m_Inotify < 0) return;
+    for (const DirectoryWatch& watch : m_Directories)
+        if (watch.directory == file.directory) return;
+    // Ghi xong (close) / rename vào / tạo mới / xoá: đủ cho cả lưu tại chỗ lẫn lưu kiểu file tạm + rename
+    int handle = inotify_add_watch(m_Inotify, file.directory.c_str(),
+                                   IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE | IN_ATTRIB);
+    if (handle < 0) {
+        // Thư mục không watch được (không tồn tại, hết giới hạn watch): file này rơi về stat
+        std::cerr << "FileWatcher: cannot watch " << file.directory << ", polling it" << std::endl;
+        return;
+    }
+    m_Directories.push_back({ handle, file.directory });
+#endif
+}
+
+void FileWatcher::Clear() {
+#if HZ_WATCH_INOTIFY
+    for (const DirectoryWatch& watch : m_Directories) inotify_rm_watch(m_Inotify, watch.handle);
+#endif
+    m_Directories.clear();
+    m_Files.clear();
+}
+
+void FileWatcher::ReadEvents(double now) {
+#if HZ_WATCH_INOTIFY
+    alignas(inotify_event) char buffer[4096];
+    for (;;) {
+        ssize_t length = read(m_Inotify, buffer, sizeof(buffer));
+        if (length <= 0) break; // EAGAIN: hết event
+        for (ssize_t offset = 0; offset < length;) {
+            const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            offset += sizeof(inotify_event) + event->len;
+            if (event->len == 0) continue;
+            const std::string* directory = nullptr;
+            for (const DirectoryWatch& watch : m_Directories)
+                if (watch.handle == event->wd) directory = &watch.directory;
+            if (!directory) continue;
+            for (File& file : m_Files)
+                if (file.name == event->name && file.directory == *directory) file.changedAt = now;
+        }
+    }
+#else
+    (void)now;
+#endif
+}
+
+void FileWatcher::StatFiles(double now) {
+    for (File& file : m_Files) {
+#if HZ_WATCH_INOTIFY
+        // File nằm trong thư mục đã có inotify thì không cần stat
+        bool watched = false;
+        for (const DirectoryWatch& watch : m_Directories) watched |= watch.directory == file.directory;
+        if (watched) continue;
+#endif
+        uint64_t mtime = 0, size = 0;
+        bool exists = StatPath(file.path, mtime, size);
+        if (exists != file.exists || mtime != file.mtime || size != file.size) {
+            file.exists = exists;
+            file.mtime = mtime;
+            file.size = size;
+            file.changedAt = now;
+        }
+    }
+}
+
+void FileWatcher::Poll(double now, std::vector<std::string>& outChanged) {
+    outChanged.clear();
+    if (m_Files.empty()) return;
+    if (m_Inotify >= 0) ReadEvents(now);
+    if (m_LastStat < 0.0 || now - m_LastStat >= m_PollInterval) {
+        StatFiles(now);
+        m_LastStat = now;
+    }
+
+    for (File& file : m_Files) {
+        if (file.changedAt < 0.0 || now - file.changedAt < m_Settle) continue;
+        file.changedAt = -1.0;
+        uint64_t mtime = 0, size = 0;
+        file.exists = StatPath(file.path, mtime, size);
+        // Bị xoá (đang lưu kiểu xoá rồi ghi lại): chờ event tạo file
+        if (!file.exists) continue;
+        file.mtime = mtime;
+        file.size = size;
+        outChanged.push_back(file.path);
+    }
+}
@@ -0,0 +1,179 @@
+#include "FrameBenchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+CameraScript CameraScript::Default() {
+    CameraScript script;
+    script.m_Keys = {
+        { 0.00f,   0.0f, 1.0f,  8.0f },
+        { 0.50f, 360.0f, 1.0f,  8.0f },
+        { 0.75f, 450.0f, 1.0f, 40.0f },
+        { 1.00f, 540.0f, 1.0f,  3.0f },
+    };
+    return script;
+}
+
+bool CameraScript::Load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "Camera script: cannot open " << path << std::endl;
+        return false;
+    }
+
+    std::vector<CameraKey> keys;
+    std::string line;
+    for (int lineNumber = 1; std::getline(file, line); lineNumber++) {
+        line = line.substr(0, line.find('#'));
+        if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+
+        std::istringstream in(line);
+        CameraKey key;
+        if (!(in >> key.time >> key.rotation >> key.scale >> key.distance)) {
+            std::cerr << "Camera script " << path << ":" << lineNumber
+                      << ": expected 'time rotation scale distance'" << std::endl;
+            return false;
+        }
+        if (!keys.empty() && key.time < keys.back().time) {
+            std::cerr << "Camera script " << path << ":" << lineNumber << ": time must not decrease" << std::endl;
+            return false;
+        }
+        keys.push_back(key);
+    }
+    if (keys.empty()) {
+        std::cerr << "Camera script " << path << ": no keys" << std::endl;
+        return false;
+    }
+    m_Keys = std::move(keys);
+    return true;
+}
+
+CameraKey CameraScript::Sample(float time) const {
+    if (time <= m_Keys.front().time) return m_Keys.front();
+    if (time >= m_Keys.back().time) return m_Keys.back();
+
+    size_t next = 1;
+    while (m_Keys[next].time < time) next++;
+    const CameraKey& a = m_Keys[next - 1];
+    const CameraKey& b = m_Keys[next];
+    float t = b.time > a.time ? (time - a.time) / (b.time - a.time) : 1.0f;
+    auto Lerp = [t](float x, float y) { return x + (y - x) * t; };
+    return { time, Lerp(a.rotation, b.rotation), Lerp(a.scale, b.scale), Lerp(a.distance, b.distance) };
+}
+
+double Percentile(std::vector<double> values, double p) {
+    if (values.empty()) return 0.0;
+    std::sort(values.begin(), values.end());
+    double rank = std::min(std::max(p, 0.0), 100.0) / 100.0 * (double)(values.size() - 1);
+    size_t lower = (size_t)rank;
+    size_t upper = std::min(lower + 1, values.size() - 1);
+    return values[lower] + (values[upper] - values[lower]) * (rank - (double)lower);
+}
+
+static std::string EscapeJson(const std::string& s) {
+    std::string out;
+    for (char c : s) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if ((unsigned char)c < 0x20) {
+            char buf[8];
+            std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+            out += buf;
+        } else {
+            out += c;
+        }
+    }
+    return out;
+}
+
+static void WriteStats(FILE* f, const char* name, const std::vector<double>& values) {
+    double sum = 0.0, maxValue = 0.0;
+    for (double v : values) {
+        sum += v;
+        maxValue = std::max(maxValue, v);
+    }
+    double mean = values.empty() ? 0.0 : sum / (double)values.size();
+    std::fprintf(f, "  \"%s\": { \"mean\": %.4f, \"p50\": %.4f, \"p95\": %.4f, \"p99\": %.4f, \"max\": %.4f },\n", name,
+                 mean, Percentile(values, 50.0), Percentile(values, 95.0), Percentile(values, 99.0), maxValue);
+}
+
+bool WriteBenchReport(const BenchConfig& config, const BenchResult& result) {
+    FILE* f = std::fopen(config.outputPath.c_str(), "w");
+    if (!f) {
+        std::cerr << "Benchmark: cannot write " << config.outputPath << std::endl;
+        return false;
+    }
+
+    std::vector<double> cpuMs, frameMs;
+    for (const FrameSample& s : result.frames) {
+        cpuMs.push_back(s.cpuMs);
+        frameMs.push_back(s.frameMs);
+    }
+
+    std::fprintf(f, "{\n");
+    std::fprintf(f, "  \"model\": \"%s\",\n", EscapeJson(config.modelPath).c_str());
+    std::fprintf(f, "  \"cameraScript\": \"%s\",\n",
+                 config.cameraScriptPath.empty() ? "default" : EscapeJson(config.cameraScriptPath).c_str());
+    std::fprintf(f, "  \"renderer\": \"%s\",\n", EscapeJson(result.renderer).c_str());
+    std::fprintf(f, "  \"width\": %d,\n  \"height\": %d,\n", result.width, result.height);
+    std::fprintf(f, "  \"keepHierarchy\": %s,\n", config.keepHierarchy ? "true" : "false");
+    std::fprintf(f, "  \"parts\": %zu,\n  \"instances\": %zu,\n", result.parts, result.instances);
+    std::fprintf(f, "  \"vertexFormat\": \"%s\",\n  \"vertexBytes\": %zu,\n", result.vertexFormat.c_str(),
+                 result.vertexBytes);
+    std::fprintf(f, "  \"frames\": %zu,\n  \"warmupFrames\": %u,\n", result.frames.size(), config.warmupFrames);
+    std::fprintf(f, "  \"load\": { \"totalMs\": %.3f, \"importMs\": %.3f, \"fromCache\": %s },\n", result.loadMs,
+                 result.importMs, result.fromCache ? "true" : "false");
+    std::fprintf(f, "  \"process\": { \"cpuSeconds\": %.4f, \"wallSeconds\": %.4f },\n", result.cpuSeconds,
+                 result.wallSeconds);
+    WriteStats(f, "cpuMs", cpuMs);
+    WriteStats(f, "frameMs", frameMs);
+    const GpuCallCounts* callTables[2] = { &result.gpuCalls, &result.gpuSkipped };
+    const char* callTableNames[2] = { "gpuCalls", "gpuCallsSkipped" };
+    for (int t = 0; t < 2; t++) {
+        std::fprintf(f, "  \"%s\": { \"total\": %u", callTableNames[t], callTables[t]->Total());
+        for (uint32_t c = 0; c < kCallCount; c++)
+            std::fprintf(f, ", \"%s\": %u", GpuCallName((GpuCall)c), callTables[t]->calls[c]);
+        std::fprintf(f, " },\n");
+    }
+
+    std::fprintf(f, "  \"perFrame\": [\n");
+    for (size_t i = 0; i < result.frames.size(); i++) {
+        const FrameSample& s = result.frames[i];
+        std::fprintf(f, "    { \"cpuMs\": %.4f, \"frameMs\": %.4f, \"drawCalls\": %d, \"visible\": %zu }%s\n", s.cpuMs,
+                     s.frameMs, s.drawCalls, s.visibleInstances, i + 1 < result.frames.size() ? "," : "");
+    }
+    std::fprintf(f, "  ]\n}\n");
+
+    bool ok = std::fclose(f) == 0;
+    if (!ok) std::cerr << "Benchmark: error writing " << config.outputPath << std::endl;
+    return ok;
+}
+
+bool WritePacingReport(const std::string& path, const FramePacing& pacing, const FramePacingStats& stats,
+                       double wallSeconds, double cpuSeconds) {
+    FILE* f = std::fopen(path.c_str(), "w");
+    if (!f) {
+        std::cerr << "Pacing: cannot write " << path << std::endl;
+        return false;
+    }
+    const double wall = std::max(wallSeconds, 1e-9);
+    std::fprintf(f, "{\n");
+    std::fprintf(f, "  \"mode\": \"%s\",\n", FrameModeName(pacing.mode));
+    std::fprintf(f, "  \"maxFps\": %.2f,\n  \"fixedStep\": %.6f,\n", pacing.maxFps, pacing.fixedStep);
+    std::fprintf(f, "  \"wallSeconds\": %.4f,\n  \"cpuSeconds\": %.4f,\n  \"cpuPercent\": %.2f,\n", wallSeconds,
+                 cpuSeconds, 100.0 * cpuSeconds / wall);
+    std::fprintf(f, "  \"framesRendered\": %llu,\n  \"fps\": %.2f,\n", (unsigned long long)stats.framesRendered,
+                 (double)stats.framesRendered / wall);
+    std::fprintf(f, "  \"loops\": %llu,\n  \"steps\": %llu,\n  \"droppedSteps\": %llu,\n",
+                 (unsigned long long)stats.loops, (unsigned long long)stats.steps, (unsigned long long)stats.droppedSteps);
+    std::fprintf(f, "  \"waits\": %llu,\n  \"sleptSeconds\": %.4f\n}\n", (unsigned long long)stats.waits,
+                 stats.sleptSeconds);
+    bool ok = std::fclose(f) == 0;
+    if (!ok) std::cerr << "Pacing: error writing " << path << std::endl;
+    return ok;
+}
@@ -0,0 +1,132 @@
+#include "FrameScheduler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <sys/resource.h>
+#endif
+
+void FrameScheduler::Reset(double now) {
+    m_LastTime = now;
+    m_Accumulator = 0.0;
+    m_LastFrameStart = -1.0;
+    m_LastFrameEnd = -1.0;
+    m_WorkEstimate = 0.0;
+    m_Dirty = kDirtyWindow;
+    m_InputFrames = 0;
+    m_Stats = FramePacingStats();
+}
+
+unsigned int FrameScheduler::Advance(double now) {
+    m_Stats.loops++;
+    m_Accumulator += std::max(now - m_LastTime, 0.0);
+    m_LastTime = now;
+
+    const double step = m_Pacing.fixedStep;
+    unsigned int steps = (unsigned int)(m_Accumulator / step);
+    if (steps > m_Pacing.maxSteps) {
+        // Treo lâu (kéo cửa sổ, breakpoint...): bỏ phần thời gian dư thay vì đuổi theo mãi
+        m_Stats.droppedSteps += steps - m_Pacing.maxSteps;
+        m_Accumulator -= (double)(steps - m_Pacing.maxSteps) * step;
+        steps = m_Pacing.maxSteps;
+    }
+    m_Accumulator = std::max(m_Accumulator - (double)steps * step, 0.0);
+    m_Stats.steps += steps;
+    return steps;
+}
+
+void FrameScheduler::MarkDirty(uint32_t flags) {
+    if (flags & kDirtyInput) m_InputFrames = m_Pacing.inputFrames;
+    m_Dirty |= flags;
+}
+
+bool FrameScheduler::ShouldRender() const {
+    return m_Pacing.mode != FrameMode::OnDemand || m_Dirty != 0 || m_InputFrames > 0;
+}
+
+uint32_t FrameScheduler::BeginFrame() {
+    const uint32_t dirty = m_Dirty;
+    m_Dirty = 0;
+    if (m_InputFrames > 0) m_InputFrames--;
+    return dirty;
+}
+
+void FrameScheduler::FrameRendered(double frameStart, double frameEnd) {
+    const double work = std::max(frameEnd - frameStart, 0.0);
+    m_WorkEstimate = m_WorkEstimate > 0.0 ? m_WorkEstimate * 0.9 + work * 0.1 : work;
+    m_LastFrameStart = frameStart;
+    m_LastFrameEnd = frameEnd;
+    m_Stats.framesRendered++;
+}
+
+double FrameScheduler::WaitTimeout(double now) const {
+    if (m_Pacing.mode != FrameMode::OnDemand || ShouldRender()) return 0.0;
+    double timeout = m_Pacing.idleTimeout;
+    // Đang animate: thức dậy khi bước mô phỏng kế tới hạn (vẽ theo nhịp mô phỏng, không nhanh hơn)
+    if (m_Animating) timeout = std::min(timeout, m_LastTime + m_Pacing.fixedStep - m_Accumulator - now);
+    return std::max(timeout, 0.0);
+}
+
+double FrameScheduler::NextFrameStart(double now) const {
+    if (m_LastFrameStart < 0.0) return now;
+    if (m_Pacing.mode == FrameMode::LowLatency) {
+        // Hạn của frame kế = frame trước xong + một chu kỳ; bắt đầu sớm hơn hạn đúng bằng thời gian làm frame
+        // (+ chút dư) để input được đọc sát lúc hiển thị nhất
+        const double period = m_Pacing.maxFps > 0.0 ? 1.0 / m_Pacing.maxFps : 1.0 / std::max(m_Pacing.refreshRate, 1.0);
+        const double kMargin = 0.001;
+        return m_LastFrameEnd + period - m_WorkEstimate - kMargin;
+    }
+    if (m_Pacing.maxFps <= 0.0) return now;
+    return m_LastFrameStart + 1.0 / m_Pacing.maxFps;
+}
+
+double SleepUntil(double now, double target) {
+    using Clock = std::chrono::steady_clock;
+    const double remaining = target - now;
+    if (remaining <= 0.0) return 0.0;
+    const Clock::time_point start = Clock::now();
+    const Clock::time_point end = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(remaining));
+    // Timer của OS thường trễ ~1 ms: ngủ tới gần hạn, phần cuối nhường CPU từng chút
+    const double kSpin = 0.0015;
+    if (remaining > kSpin) std::this_thread::sleep_for(std::chrono::duration<double>(remaining - kSpin));
+    while (Clock::now() < end) std::this_thread::yield();
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+double ProcessCpuSeconds() {
+#ifdef _WIN32
+    FILETIME creation, exit, kernel, user;
+    if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user)) return 0.0;
+    auto Seconds = [](const FILETIME& t) {
+        return (double)(((unsigned long long)t.dwHighDateTime << 32) | t.dwLowDateTime) * 1e-7; // đơn vị 100 ns
+    };
+    return Seconds(kernel) + Seconds(user);
+#else
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0.0;
+    return (double)(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec)
+         + (double)(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1e-6;
+#endif
+}
+
+const char* FrameModeName(FrameMode mode) {
+    switch (mode) {
+    case FrameMode::OnDemand: return "on-demand";
+    case FrameMode::LowLatency: return "low-latency";
+    default: return "continuous";
+    }
+}
+
+bool ParseFrameMode(const std::string& name, FrameMode& outMode) {
+    if (name == "continuous") outMode = FrameMode::Continuous;
+    else if (name == "on-demand" || name == "idle") outMode = FrameMode::OnDemand;
+    else if (name == "low-latency") outMode = FrameMode::LowLatency;
+    else return false;
+    return true;
+}
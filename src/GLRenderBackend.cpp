@@ -0,0 +1,52 @@
+#include "GLRenderBackend.h"
+
+#include <glad/glad.h>
+
+static GLenum IndexType(unsigned int indexSize) { return indexSize == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT; }
+
+void GLRenderBackend::UseProgram(unsigned int program) { glUseProgram(program); }
+
+void GLRenderBackend::BindVertexArray(unsigned int vao) { glBindVertexArray(vao); }
+
+void GLRenderBackend::SetPolygonMode(PolygonMode mode) {
+    glPolygonMode(GL_FRONT_AND_BACK, mode == PolygonMode::Line ? GL_LINE : GL_FILL);
+}
+
+void GLRenderBackend::ActiveTexture(unsigned int unit) { glActiveTexture(GL_TEXTURE0 + unit); }
+
+void GLRenderBackend::BindTexture(TextureTarget target, unsigned int texture) {
+    glBindTexture(target == TextureTarget::Buffer ? GL_TEXTURE_BUFFER : GL_TEXTURE_2D, texture);
+}
+
+void GLRenderBackend::Uniform1i(int location, int value) { glUniform1i(location, value); }
+
+void GLRenderBackend::Uniform4f(int location, const float value[4]) { glUniform4fv(location, 1, value); }
+
+void GLRenderBackend::BindUniformBufferBase(unsigned int binding, unsigned int buffer) {
+    glBindBufferBase(GL_UNIFORM_BUFFER, binding, buffer);
+}
+
+void GLRenderBackend::BindUniformBuffer(unsigned int buffer) { glBindBuffer(GL_UNIFORM_BUFFER, buffer); }
+
+void GLRenderBackend::UniformBufferData(size_t size, const void* data) {
+    glBufferData(GL_UNIFORM_BUFFER, (GLsizeiptr)size, data, GL_STREAM_DRAW);
+}
+
+void GLRenderBackend::UniformBufferSubData(size_t offset, size_t size, const void* data) {
+    glBufferSubData(GL_UNIFORM_BUFFER, (GLintptr)offset, (GLsizeiptr)size, data);
+}
+
+void GLRenderBackend::DrawElements(unsigned int indexSize, int count, size_t indexOffset, int baseVertex,
+                                   unsigned int instanceCount) {
+    void* offset = (void*)indexOffset;
+    if (instanceCount > 0)
+        glDrawElementsInstancedBaseVertex(GL_TRIANGLES, count, IndexType(indexSize), offset, (GLsizei)instanceCount,
+                                          baseVertex);
+    else
+        glDrawElementsBaseVertex(GL_TRIANGLES, count, IndexType(indexSize), offset, baseVertex);
+}
+
+void GLRenderBackend::MultiDrawElements(unsigned int indexSize, const int* counts, const void* const* offsets,
+                                        const int* baseVertices, int drawCount) {
+    glMultiDrawElementsBaseVertex(GL_TRIANGLES, counts, IndexType(indexSize), offsets, drawCount, baseVertices);
+}
@@ -0,0 +1,67 @@
+#include "GpuProfiler.h"
+
+#if APP_PROFILER
+
+#include <iostream>
+
+void GpuProfiler::Init() {
+    for (FrameQueries& frame : m_Frames) glGenQueries(kMaxZones, frame.queries);
+    m_Initialized = true;
+}
+
+void GpuProfiler::Shutdown() {
+    if (!m_Initialized) return;
+    for (FrameQueries& frame : m_Frames) {
+        glDeleteQueries(kMaxZones, frame.queries);
+        frame.count = 0;
+    }
+    m_Initialized = false;
+}
+
+void GpuProfiler::BeginFrame() {
+    if (!m_Initialized) return;
+    m_Current = (m_Current + 1) % kBufferedFrames;
+    FrameQueries& frame = m_Frames[m_Current];
+
+    // Query kết thúc theo thứ tự: query cuối xong nghĩa là cả bộ đã có kết quả
+    if (frame.count > 0) {
+        GLint available = 0;
+        glGetQueryObjectiv(frame.queries[frame.count - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available) {
+            for (unsigned int i = 0; i < frame.count; i++) {
+                GLuint64 ns = 0;
+                glGetQueryObjectui64v(frame.queries[i], GL_QUERY_RESULT, &ns);
+                Profiler::Get().AddGpuZone(frame.names[i], frame.cpuStartNs[i], (double)ns * 1e-6);
+            }
+        } else {
+            m_Dropped += frame.count;
+        }
+    }
+    frame.count = 0;
+}
+
+bool GpuProfiler::BeginZone(const char* name) {
+    FrameQueries& frame = m_Frames[m_Current];
+    if (!m_Initialized || m_InZone || frame.count == kMaxZones) {
+        static bool warned = false;
+        if (m_Initialized && !warned) {
+            std::cerr << "GpuProfiler: zone '" << name << "' ignored (nested or too many zones per frame)" << std::endl;
+            warned = true;
+        }
+        return false;
+    }
+    frame.names[frame.count] = name;
+    frame.cpuStartNs[frame.count] = Profiler::NowNs();
+    glBeginQuery(GL_TIME_ELAPSED, frame.queries[frame.count]);
+    m_InZone = true;
+    return true;
+}
+
+void GpuProfiler::EndZone() {
+    if (!m_InZone) return;
+    glEndQuery(GL_TIME_ELAPSED);
+    m_Frames[m_Current].count++;
+    m_InZone = false;
+}
+
+#endif
@@ -0,0 +1,148 @@
+#include "JobSystem.h"
+#include "Profiler.h"
+
+#include <algorithm>
+#include <string>
+
+namespace {
+    // Worker biết mình thuộc pool nào và deque nào; thread ngoài có t_Owner == nullptr
+    thread_local const JobSystem* t_Owner = nullptr;
+    thread_local unsigned int t_QueueIndex = 0;
+}
+
+JobSystem::JobSystem(unsigned int threadCount) {
+    if (threadCount == 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+    const unsigned int workerCount = threadCount - 1;
+
+    for (unsigned int i = 0; i <= workerCount; i++) m_Queues.push_back(std::make_unique<Queue>());
+    for (unsigned int i = 0; i < workerCount; i++) m_Workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(m_SleepMutex);
+        m_Quit = true;
+    }
+    m_Wake.notify_all();
+    for (std::thread& worker : m_Workers) worker.join();
+}
+
+JobSystem& JobSystem::Global() {
+    static JobSystem instance;
+    return instance;
+}
+
+unsigned int JobSystem::CurrentQueue() const {
+    return t_Owner == this ? t_QueueIndex : (unsigned int)m_Workers.size();
+}
+
+void JobSystem::Submit(JobCounter& counter, std::function<void()> job) {
+    counter.m_Pending.fetch_add(1, std::memory_order_relaxed);
+    if (m_Workers.empty()) {
+        // Pool 1 thread: chạy luôn, không xếp hàng
+        job();
+        Complete(counter);
+        return;
+    }
+
+    // Tăng trước khi đẩy: m_Queued không bao giờ nhỏ hơn số job thật sự đang nằm trong deque
+    m_Queued.fetch_add(1, std::memory_order_release);
+    Queue& queue = *m_Queues[CurrentQueue()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back({ std::move(job), &counter });
+    }
+    {
+        // Lock rỗng để không lỡ mất notify khi worker vừa kiểm tra m_Queued xong
+        std::lock_guard<std::mutex> lock(m_SleepMutex);
+    }
+    m_Wake.notify_one();
+}
+
+bool JobSystem::TryRun(unsigned int self, const JobCounter* only) {
+    Job job;
+    bool found = false;
+    // only != nullptr: chỉ nhận job của counter đó (lấy job gần đầu / cuối nhất khớp)
+    auto Take = [&](Queue& queue, bool fromBack) {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        const size_t count = queue.jobs.size();
+        for (size_t k = 0; k < count; k++) {
+            const size_t i = fromBack ? count - 1 - k : k;
+            if (only && queue.jobs[i].counter != only) continue;
+            job = std::move(queue.jobs[i]);
+            queue.jobs.erase(queue.jobs.begin() + (std::ptrdiff_t)i);
+            found = true;
+            return;
+        }
+    };
+
+    // Deque của mình: lấy ở cuối
+    Take(*m_Queues[self], true);
+    // Lấy trộm ở đầu deque khác, bắt đầu từ hàng xóm để các thread không dồn vào cùng một deque
+    const unsigned int queueCount = (unsigned int)m_Queues.size();
+    for (unsigned int k = 1; !found && k < queueCount; k++) Take(*m_Queues[(self + k) % queueCount], false);
+    if (!found) return false;
+
+    m_Queued.fetch_sub(1, std::memory_order_relaxed);
+    {
+        PROFILE_SCOPE("Job");
+        job.fn();
+    }
+    Complete(*job.counter);
+    return true;
+}
+
+void JobSystem::Complete(JobCounter& counter) {
+    // Sau fetch_sub không chạm vào counter nữa: thread Wait có thể thấy Done() và huỷ nó ngay
+    if (counter.m_Pending.fetch_sub(1, std::memory_order_release) != 1) return;
+    {
+        // Lock rỗng như Submit: thread Wait vừa kiểm tra Done() xong chưa kịp ngủ vẫn nhận được notify
+        std::lock_guard<std::mutex> lock(m_SleepMutex);
+    }
+    m_Finished.notify_all();
+}
+
+void JobSystem::Wait(JobCounter& counter) {
+    const unsigned int self = CurrentQueue();
+    while (!counter.Done()) {
+        // Chỉ giúp job của chính counter này: render thread chờ ParallelFor của frame không được
+        // nhặt job dài của loader (OptimizePart...) rồi trễ cả frame.
+        if (TryRun(self, &counter)) continue;
+        // Không còn job nào của nó trong deque: các job còn lại đang chạy trên thread khác, thread chạy
+        // xong job cuối sẽ notify. Job mới của counter (chỉ do job của nó đẩy) do chính thread đó nhặt tiếp.
+        std::unique_lock<std::mutex> lock(m_SleepMutex);
+        m_Finished.wait(lock, [&counter]() { return counter.Done(); });
+    }
+}
+
+void JobSystem::WorkerLoop(unsigned int index) {
+    t_Owner = this;
+    t_QueueIndex = index;
+    PROFILE_THREAD_NAME(("Job Worker " + std::to_string(index)).c_str());
+    for (;;) {
+        if (TryRun(index, nullptr)) continue;
+
+        std::unique_lock<std::mutex> lock(m_SleepMutex);
+        m_Wake.wait(lock, [this]() { return m_Quit || m_Queued.load(std::memory_order_acquire) > 0; });
+        if (m_Quit) return;
+    }
+}
+
+void JobSystem::ParallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& body) {
+    if (count == 0) return;
+    grain = std::max<size_t>(grain, 1);
+    // ~4 chunk mỗi thread để cân tải khi các phần tử nặng nhẹ khác nhau
+    size_t chunk = std::max(grain, (count + ThreadCount() * 4 - 1) / (ThreadCount() * 4));
+    if (m_Workers.empty() || chunk >= count) {
+        body(0, count);
+        return;
+    }
+
+    JobCounter counter;
+    for (size_t begin = chunk; begin < count; begin += chunk) {
+        size_t end = std::min(count, begin + chunk);
+        Submit(counter, [&body, begin, end]() { body(begin, end); });
+    }
+    body(0, chunk); // thread gọi làm chunk đầu luôn
+    Wait(counter);
+}
@@ -0,0 +1,48 @@
+#include "LodSelection.h"
+
+#include <algorithm>
+#include <cmath>
+
+float ProjectedError(float error, float distance, float pixelsPerUnit) {
+    return error * pixelsPerUnit / std::max(distance, 1e-4f);
+}
+
+unsigned int SelectLod(const MeshPart& part, float scale, float distance, unsigned int current, const LodParams& params) {
+    const unsigned int lodCount = PartLodCount(part);
+    if (params.forcedLevel >= 0) return std::min((unsigned int)params.forcedLevel, lodCount - 1);
+
+    auto Pixels = [&](unsigned int level) {
+        return ProjectedError(PartLod(part, level).error * scale, distance, params.pixelsPerUnit);
+    };
+    // Error tăng dần theo level -> level thô nhất dưới ngưỡng
+    auto Coarsest = [&](float limit) {
+        unsigned int level = 0;
+        while (level + 1 < lodCount && Pixels(level + 1) <= limit) level++;
+        return level;
+    };
+
+    current = std::min(current, lodCount - 1);
+    if (Pixels(current) > params.threshold) return Coarsest(params.threshold);
+    return std::max(current, Coarsest(params.threshold * params.hysteresis));
+}
+
+void SelectInstanceLods(const MeshPart* parts, const SceneGraph& scene, const uint8_t* visible,
+                        const glm::vec3& cameraPos, const LodParams& params, std::vector<uint8_t>& inOutLods) {
+    const std::vector<glm::mat4>& instances = scene.Instances();
+    const std::vector<AABB>& bounds = scene.InstanceBounds();
+    inOutLods.resize(instances.size(), 0);
+
+    for (size_t p = 0; p < scene.PartCount(); p++) {
+        const MeshPart& part = parts[p];
+        const unsigned int first = scene.InstanceOffset(p), end = first + scene.InstanceCount(p);
+        for (unsigned int i = first; i < end; i++) {
+            if (!visible[i]) continue;
+            const glm::mat4& m = instances[i];
+            float scale = std::sqrt(std::max({ glm::dot(glm::vec3(m[0]), glm::vec3(m[0])),
+                                               glm::dot(glm::vec3(m[1]), glm::vec3(m[1])),
+                                               glm::dot(glm::vec3(m[2]), glm::vec3(m[2])) }));
+            glm::vec3 outside = glm::max(glm::max(bounds[i].min - cameraPos, cameraPos - bounds[i].max), glm::vec3(0.0f));
+            inOutLods[i] = (uint8_t)SelectLod(part, scale, glm::length(outside), inOutLods[i], params);
+        }
+    }
+}
@@ -0,0 +1,433 @@
+#include "MeshCache.h"
+#include "TextureCodec.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+static uint64_t HashFNV1a(const void* data, size_t size, uint64_t hash = 1469598103934665603ull) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+static uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+static bool StatFile(const fs::path& path, uint64_t& outMtime, uint64_t& outSize) {
+    std::error_code ec;
+    outSize = fs::file_size(path, ec);
+    if (ec) return false;
+    auto mtime = fs::last_write_time(path, ec);
+    if (ec) return false;
+    outMtime = (uint64_t)mtime.time_since_epoch().count();
+    return true;
+}
+
+bool MakeMeshCacheKey(const char* sourcePath, unsigned int importFlags, MeshCacheKey& outKey) {
+    fs::path path(sourcePath);
+    uint64_t mtime = 0, size = 0;
+    if (!StatFile(path, mtime, size)) return false;
+
+    std::error_code ec;
+    std::string normalized = fs::absolute(path, ec).lexically_normal().generic_string();
+    if (ec) normalized = path.generic_string();
+
+    outKey.pathHash = HashFNV1a(normalized.data(), normalized.size());
+    outKey.sourceMtime = mtime;
+    outKey.sourceSize = size;
+    outKey.importFlags = importFlags;
+    return true;
+}
+
+std::string MeshCachePath(const char* sourcePath, unsigned int importFlags) {
+    char suffix[32];
+    std::snprintf(suffix, sizeof(suffix), ".%08x.meshcache", importFlags);
+    return std::string(sourcePath) + suffix;
+}
+
+bool WriteMeshCache(const std::string& cachePath, const MeshCacheKey& key, const MeshView& mesh,
+                    const std::vector<std::string>& dependencies) {
+    std::vector<MeshCacheDependency> records;
+    std::string paths;
+    for (const std::string& path : dependencies) {
+        MeshCacheDependency record = {};
+        if (!StatFile(path, record.mtime, record.size)) {
+            std::cerr << "MeshCache: cannot stat dependency " << path << std::endl;
+            return false;
+        }
+        record.pathOffset = (uint32_t)paths.size();
+        record.pathLength = (uint32_t)path.size();
+        paths += path;
+        records.push_back(record);
+    }
+
+    MeshCacheHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, "HZMC", 4);
+    header.version = kMeshCacheVersion;
+    header.pathHash = key.pathHash;
+    header.sourceMtime = key.sourceMtime;
+    header.sourceSize = key.sourceSize;
+    header.importFlags = key.importFlags;
+    header.partCount = (uint32_t)mesh.partCount;
+    header.vertexCount = mesh.vertexCount;
+    header.indexBytes = mesh.indexBytes;
+
+    header.partsOffset = AlignUp(sizeof(MeshCacheHeader), kMeshCacheAlignment);
+    header.verticesOffset = AlignUp(header.partsOffset + mesh.partCount * sizeof(MeshPart), kMeshCacheAlignment);
+    header.indicesOffset = AlignUp(header.verticesOffset + mesh.VertexBytes(), kMeshCacheAlignment);
+    header.nodeCount = mesh.nodeCount;
+    header.nodesOffset = AlignUp(header.indicesOffset + mesh.IndexBytes(), kMeshCacheAlignment);
+    header.meshRefCount = mesh.meshRefCount;
+    header.meshRefsOffset = AlignUp(header.nodesOffset + mesh.nodeCount * sizeof(SceneNode), kMeshCacheAlignment);
+    header.textureCount = mesh.textureCount;
+    header.texturesOffset = AlignUp(header.meshRefsOffset + mesh.meshRefCount * sizeof(unsigned int), kMeshCacheAlignment);
+    header.textureBytes = mesh.textureBytes;
+    header.textureDataOffset = AlignUp(header.texturesOffset + mesh.textureCount * sizeof(TextureDesc), kMeshCacheAlignment);
+    header.skinCount = mesh.skin ? mesh.vertexCount : 0;
+    header.skinOffset = AlignUp(header.textureDataOffset + mesh.textureBytes, kMeshCacheAlignment);
+    header.jointCount = mesh.jointCount;
+    header.jointsOffset = AlignUp(header.skinOffset + header.skinCount * sizeof(VertexSkin), kMeshCacheAlignment);
+    header.clipCount = mesh.clipCount;
+    header.clipsOffset = AlignUp(header.jointsOffset + mesh.jointCount * sizeof(SkinJoint), kMeshCacheAlignment);
+    header.channelCount = mesh.channelCount;
+    header.channelsOffset = AlignUp(header.clipsOffset + mesh.clipCount * sizeof(AnimationClip), kMeshCacheAlignment);
+    header.keyCount = mesh.keyCount;
+    header.keysOffset = AlignUp(header.channelsOffset + mesh.channelCount * sizeof(AnimationChannel), kMeshCacheAlignment);
+    header.dependencyCount = records.size();
+    header.dependenciesOffset = AlignUp(header.keysOffset + mesh.keyCount * sizeof(AnimationKey), kMeshCacheAlignment);
+    header.dependencyBytes = records.size() * sizeof(MeshCacheDependency) + paths.size();
+    header.fileSize = header.dependenciesOffset + header.dependencyBytes;
+
+    // Ghi ra file tạm rồi rename để không bao giờ để lại cache ghi dở
+    std::string tmpPath = cachePath + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            std::cerr << "MeshCache: cannot write " << tmpPath << std::endl;
+            return false;
+        }
+
+        auto writeAt = [&out](uint64_t offset, const void* data, size_t size) {
+            static const char zeros[kMeshCacheAlignment] = {};
+            uint64_t pos = (uint64_t)out.tellp();
+            if (offset > pos) out.write(zeros, (std::streamsize)(offset - pos));
+            if (size) out.write(static_cast<const char*>(data), (std::streamsize)size);
+        };
+
+        writeAt(0, &header, sizeof(header));
+        writeAt(header.partsOffset, mesh.parts, mesh.partCount * sizeof(MeshPart));
+        writeAt(header.verticesOffset, mesh.vertexData, mesh.VertexBytes());
+        writeAt(header.indicesOffset, mesh.indexData, mesh.IndexBytes());
+        writeAt(header.nodesOffset, mesh.nodes, mesh.nodeCount * sizeof(SceneNode));
+        writeAt(header.meshRefsOffset, mesh.meshRefs, mesh.meshRefCount * sizeof(unsigned int));
+        writeAt(header.texturesOffset, mesh.textures, mesh.textureCount * sizeof(TextureDesc));
+        writeAt(header.textureDataOffset, mesh.textureData, mesh.textureBytes);
+        writeAt(header.skinOffset, mesh.skin, header.skinCount * sizeof(VertexSkin));
+        writeAt(header.jointsOffset, mesh.joints, mesh.jointCount * sizeof(SkinJoint));
+        writeAt(header.clipsOffset, mesh.clips, mesh.clipCount * sizeof(AnimationClip));
+        writeAt(header.channelsOffset, mesh.channels, mesh.channelCount * sizeof(AnimationChannel));
+        writeAt(header.keysOffset, mesh.keys, mesh.keyCount * sizeof(AnimationKey));
+        writeAt(header.dependenciesOffset, records.data(), records.size() * sizeof(MeshCacheDependency));
+        writeAt(header.dependenciesOffset + records.size() * sizeof(MeshCacheDependency), paths.data(), paths.size());
+
+        if (!out) {
+            std::cerr << "MeshCache: write failed " << tmpPath << std::endl;
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    fs::rename(tmpPath, cachePath, ec);
+    if (ec) {
+        std::cerr << "MeshCache: cannot rename to " << cachePath << ": " << ec.message() << std::endl;
+        fs::remove(tmpPath, ec);
+        return false;
+    }
+    return true;
+}
+
+// --- MAPPED FILE ---
+MappedFile::~MappedFile() { Close(); }
+
+MappedFile::MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        Close();
+        m_Data = other.m_Data; other.m_Data = nullptr;
+        m_Size = other.m_Size; other.m_Size = 0;
+#ifdef _WIN32
+        m_File = other.m_File; other.m_File = nullptr;
+        m_Mapping = other.m_Mapping; other.m_Mapping = nullptr;
+#endif
+    }
+    return *this;
+}
+
+#ifdef _WIN32
+bool MappedFile::Open(const std::string& path) {
+    Close();
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+
+    void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!data) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    m_File = file;
+    m_Mapping = mapping;
+    m_Data = static_cast<const unsigned char*>(data);
+    m_Size = (size_t)size.QuadPart;
+    return true;
+}
+
+void MappedFile::Close() {
+    if (m_Data) UnmapViewOfFile(m_Data);
+    if (m_Mapping) CloseHandle((HANDLE)m_Mapping);
+    if (m_File) CloseHandle((HANDLE)m_File);
+    m_Data = nullptr; m_Mapping = nullptr; m_File = nullptr;
+    m_Size = 0;
+}
+#else
+bool MappedFile::Open(const std::string& path) {
+    Close();
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        return false;
+    }
+
+    void* data = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // mapping vẫn giữ file
+    if (data == MAP_FAILED) return false;
+
+    m_Data = static_cast<const unsigned char*>(data);
+    m_Size = (size_t)st.st_size;
+    return true;
+}
+
+void MappedFile::Close() {
+    if (m_Data) munmap(const_cast<unsigned char*>(m_Data), m_Size);
+    m_Data = nullptr;
+    m_Size = 0;
+}
+#endif
+
+// --- READER ---
+// Header chỉ bảo đảm các bảng nằm trong file; giá trị bên trong được dùng làm index nên cũng phải kiểm
+
+// Bảng count phần tử elementSize byte tại offset: căn lề như lúc ghi (để reinterpret_cast) và nằm trong file.
+// Viết dạng chia để offset / count hỏng không làm tràn uint64
+static bool TableFits(uint64_t offset, uint64_t count, uint64_t elementSize, uint64_t fileSize) {
+    return offset % kMeshCacheAlignment == 0 && offset <= fileSize && count <= (fileSize - offset) / elementSize;
+}
+
+// Khoảng index [offset, offset + count * indexSize) nằm trong index buffer
+static bool ValidIndexRange(uint64_t offset, uint64_t count, unsigned int indexSize, size_t indexBytes) {
+    return offset % indexSize == 0 && offset <= indexBytes && count <= (indexBytes - offset) / indexSize;
+}
+
+// Draw, HashPart, QuantizeMesh, skinning đọc index / vertex của part theo các trường này không kiểm
+static bool ValidParts(const MeshView& view) {
+    for (size_t p = 0; p < view.partCount; p++) {
+        const MeshPart& part = view.parts[p];
+        if (part.indexSize != 2 && part.indexSize != 4) return false;
+        if (!ValidIndexRange(part.indexOffset, part.indexCount, part.indexSize, view.indexBytes)) return false;
+        if ((uint64_t)part.baseVertex + part.vertexCount > view.vertexCount) return false;
+        if (part.lodCount > kMaxMeshLods) return false;
+        for (unsigned int l = 0; l < part.lodCount; l++)
+            if (!ValidIndexRange(part.lods[l].indexOffset, part.lods[l].indexCount, part.indexSize, view.indexBytes))
+                return false;
+    }
+    return true;
+}
+
+// DFS pre-order: parent đứng trước và subtree của parent chứa node; khoảng mesh ref nằm trong bảng
+static bool ValidSceneNodes(const MeshView& view) {
+    for (size_t n = 0; n < view.nodeCount; n++) {
+        const SceneNode& node = view.nodes[n];
+        if (node.subtreeSize == 0 || n + node.subtreeSize > view.nodeCount) return false;
+        if (node.parent >= 0 && ((size_t)node.parent >= n
+                                 || (size_t)node.parent + view.nodes[node.parent].subtreeSize <= n))
+            return false;
+        if ((uint64_t)node.firstMeshRef + node.meshRefCount > view.meshRefCount) return false;
+    }
+    return true;
+}
+
+// TextureManager đọc thẳng m_Data + mips[l].offset theo kích thước của level, part index vào bảng texture
+static bool ValidTextures(const MeshView& view) {
+    for (size_t t = 0; t < view.textureCount; t++) {
+        const TextureDesc& desc = view.textures[t];
+        if (desc.format > TextureFormat::BC3 || desc.width == 0 || desc.height == 0) return false;
+        if (desc.mipCount == 0 || desc.mipCount > kMaxTextureMips) return false;
+        for (unsigned int l = 0; l < desc.mipCount; l++) {
+            const TextureMip& mip = desc.mips[l];
+            if (mip.offset > view.textureBytes || mip.size > view.textureBytes - mip.offset) return false;
+            if (mip.size < TextureLevelBytes(desc.format, MipExtent(desc.width, l), MipExtent(desc.height, l)))
+                return false;
+        }
+    }
+    for (size_t p = 0; p < view.partCount; p++) {
+        const int texture = view.parts[p].textureIndex;
+        if (texture >= 0 && (size_t)texture >= view.textureCount) return false;
+    }
+    return true;
+}
+
+// Skinning (CPU và shader) tra palette[joints[k]] không kiểm; shader fetch cả 4 joint kể cả weight 0
+static bool ValidSkin(const MeshView& view) {
+    if (!view.skin) return true;
+    for (size_t v = 0; v < view.vertexCount; v++) {
+        const VertexSkin& s = view.skin[v];
+        for (unsigned int k = 0; k < kMaxVertexInfluences; k++)
+            if (view.jointCount == 0 ? s.weights[k] != 0.0f : s.joints[k] >= view.jointCount) return false;
+    }
+    return true;
+}
+
+bool MeshCacheReader::Open(const std::string& cachePath, const MeshCacheKey* expectedKey) {
+    Close();
+    if (!m_File.Open(cachePath)) return false;
+
+    const MeshCacheHeader* header = reinterpret_cast<const MeshCacheHeader*>(m_File.Data());
+    bool valid = m_File.Size() >= sizeof(MeshCacheHeader)
+        && std::memcmp(header->magic, "HZMC", 4) == 0
+        && header->version == kMeshCacheVersion
+        && header->fileSize == m_File.Size()
+        && TableFits(header->partsOffset, header->partCount, sizeof(MeshPart), header->fileSize)
+        && TableFits(header->verticesOffset, header->vertexCount, kVertexStride, header->fileSize)
+        && TableFits(header->indicesOffset, header->indexBytes, 1, header->fileSize)
+        && TableFits(header->nodesOffset, header->nodeCount, sizeof(SceneNode), header->fileSize)
+        && TableFits(header->meshRefsOffset, header->meshRefCount, sizeof(unsigned int), header->fileSize)
+        && TableFits(header->texturesOffset, header->textureCount, sizeof(TextureDesc), header->fileSize)
+        && TableFits(header->textureDataOffset, header->textureBytes, 1, header->fileSize)
+        && (header->skinCount == 0 || header->skinCount == header->vertexCount)
+        && TableFits(header->skinOffset, header->skinCount, sizeof(VertexSkin), header->fileSize)
+        && TableFits(header->jointsOffset, header->jointCount, sizeof(SkinJoint), header->fileSize)
+        && TableFits(header->clipsOffset, header->clipCount, sizeof(AnimationClip), header->fileSize)
+        && TableFits(header->channelsOffset, header->channelCount, sizeof(AnimationChannel), header->fileSize)
+        && TableFits(header->keysOffset, header->keyCount, sizeof(AnimationKey), header->fileSize)
+        && header->dependencyCount <= header->dependencyBytes / sizeof(MeshCacheDependency)
+        && TableFits(header->dependenciesOffset, header->dependencyBytes, 1, header->fileSize);
+
+    if (valid && expectedKey) {
+        valid = header->pathHash == expectedKey->pathHash
+            && header->sourceMtime == expectedKey->sourceMtime
+            && header->sourceSize == expectedKey->sourceSize
+            && header->importFlags == expectedKey->importFlags;
+    }
+
+    // Texture ngoài model đổi (hoặc mất) thì cache cũ không dùng được nữa
+    if (valid && expectedKey) {
+        const unsigned char* records = m_File.Data() + header->dependenciesOffset;
+        const uint64_t tableBytes = header->dependencyCount * sizeof(MeshCacheDependency);
+        const char* paths = reinterpret_cast<const char*>(records + tableBytes);
+        for (uint64_t i = 0; valid && i < header->dependencyCount; i++) {
+            MeshCacheDependency record;
+            std::memcpy(&record, records + i * sizeof(MeshCacheDependency), sizeof(record));
+            uint64_t mtime = 0, size = 0;
+            valid = (uint64_t)record.pathOffset + record.pathLength <= header->dependencyBytes - tableBytes
+                && StatFile(std::string(paths + record.pathOffset, record.pathLength), mtime, size)
+                && mtime == record.mtime && size == record.size;
+        }
+    }
+
+    if (!valid) {
+        m_File.Close();
+        return false;
+    }
+
+    const unsigned char* base = m_File.Data();
+    m_Header = header;
+    m_View.parts = reinterpret_cast<const MeshPart*>(base + header->partsOffset);
+    m_View.partCount = header->partCount;
+    m_View.vertexData = base + header->verticesOffset;
+    m_View.vertexCount = (size_t)header->vertexCount;
+    m_View.indexData = base + header->indicesOffset;
+    m_View.indexBytes = (size_t)header->indexBytes;
+    m_View.nodes = reinterpret_cast<const SceneNode*>(base + header->nodesOffset);
+    m_View.nodeCount = (size_t)header->nodeCount;
+    m_View.meshRefs = reinterpret_cast<const unsigned int*>(base + header->meshRefsOffset);
+    m_View.meshRefCount = (size_t)header->meshRefCount;
+    m_View.textures = reinterpret_cast<const TextureDesc*>(base + header->texturesOffset);
+    m_View.textureCount = (size_t)header->textureCount;
+    m_View.textureData = base + header->textureDataOffset;
+    m_View.textureBytes = (size_t)header->textureBytes;
+    m_View.skin = header->skinCount ? reinterpret_cast<const VertexSkin*>(base + header->skinOffset) : nullptr;
+    m_View.joints = reinterpret_cast<const SkinJoint*>(base + header->jointsOffset);
+    m_View.jointCount = (size_t)header->jointCount;
+    m_View.clips = reinterpret_cast<const AnimationClip*>(base + header->clipsOffset);
+    m_View.clipCount = (size_t)header->clipCount;
+    m_View.channels = reinterpret_cast<const AnimationChannel*>(base + header->channelsOffset);
+    m_View.channelCount = (size_t)header->channelCount;
+    m_View.keys = reinterpret_cast<const AnimationKey*>(base + header->keysOffset);
+    m_View.keyCount = (size_t)header->keyCount;
+
+    if (!ValidParts(m_View) || !ValidSceneNodes(m_View) || !ValidTextures(m_View) || !ValidSkin(m_View)) {
+        std::cerr << "MeshCache: " << cachePath << " has invalid contents, ignoring it" << std::endl;
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void MeshCacheReader::Close() {
+    m_File.Close();
+    m_Header = nullptr;
+    m_View = MeshView();
+}
+
+void MeshCacheReader::Dependencies(std::vector<std::string>& out) const {
+    out.clear();
+    if (!m_Header) return;
+    const unsigned char* records = m_File.Data() + m_Header->dependenciesOffset;
+    const uint64_t tableBytes = m_Header->dependencyCount * sizeof(MeshCacheDependency);
+    const char* paths = reinterpret_cast<const char*>(records + tableBytes);
+    for (uint64_t i = 0; i < m_Header->dependencyCount; i++) {
+        MeshCacheDependency record;
+        std::memcpy(&record, records + i * sizeof(MeshCacheDependency), sizeof(record));
+        if ((uint64_t)record.pathOffset + record.pathLength > m_Header->dependencyBytes - tableBytes) continue;
+        out.emplace_back(paths + record.pathOffset, record.pathLength);
+    }
+}
@@ -0,0 +1,435 @@
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+
+// --- WELD ---
+static uint32_t HashVertex(const float* v, size_t floatStride) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < floatStride; i++) {
+        uint32_t bits;
+        float f = v[i] == 0.0f ? 0.0f : v[i]; // -0 và +0 coi như một
+        std::memcpy(&bits, &f, sizeof(bits));
+        h = (h ^ bits) * 16777619u;
+    }
+    return h ^ (h >> 15);
+}
+
+static bool VertexEqual(const float* a, const float* b, size_t floatStride) {
+    for (size_t i = 0; i < floatStride; i++)
+        if (a[i] != b[i]) return false;
+    return true;
+}
+
+size_t WeldVertices(const float* vertices, size_t vertexCount, size_t floatStride, std::vector<unsigned int>& remap) {
+    remap.assign(vertexCount, 0);
+
+    // Open addressing, lưu index của vertex đại diện đầu tiên
+    size_t tableSize = 1;
+    while (tableSize < vertexCount * 2) tableSize <<= 1;
+    const unsigned int kEmpty = ~0u;
+    std::vector<unsigned int> table(tableSize, kEmpty);
+
+    size_t unique = 0;
+    for (size_t i = 0; i < vertexCount; i++) {
+        const float* v = vertices + i * floatStride;
+        size_t slot = HashVertex(v, floatStride) & (tableSize - 1);
+        for (;;) {
+            unsigned int existing = table[slot];
+            if (existing == kEmpty) {
+                table[slot] = (unsigned int)i;
+                remap[i] = (unsigned int)unique++;
+                break;
+            }
+            if (VertexEqual(vertices + existing * floatStride, v, floatStride)) {
+                remap[i] = remap[existing];
+                break;
+            }
+            slot = (slot + 1) & (tableSize - 1);
+        }
+    }
+    return unique;
+}
+
+// --- FORSYTH VERTEX CACHE OPTIMIZATION ---
+// Tom Forsyth, "Linear-Speed Vertex Cache Optimisation" (LRU 32 entry)
+namespace {
+    const int kForsythCacheSize = 32;
+    const float kCacheDecayPower = 1.5f;
+    const float kLastTriScore = 0.75f;
+    const float kValenceBoostScale = 2.0f;
+    const float kValenceBoostPower = 0.5f;
+    const size_t kFallbackWindow = 64; // số tam giác xét khi cache cạn
+
+    float ForsythScore(int cachePosition, unsigned int activeTris) {
+        if (activeTris == 0) return -1.0f; // không còn tam giác nào cần vertex này
+
+        float score = 0.0f;
+        if (cachePosition >= 0) {
+            if (cachePosition < 3) {
+                score = kLastTriScore;
+            } else {
+                const float scaler = 1.0f / (kForsythCacheSize - 3);
+                score = std::pow(1.0f - (cachePosition - 3) * scaler, kCacheDecayPower);
+            }
+        }
+        score += kValenceBoostScale * std::pow((float)activeTris, -kValenceBoostPower);
+        return score;
+    }
+}
+
+void OptimizeVertexCache(unsigned int* indices, size_t indexCount, size_t vertexCount) {
+    const size_t triCount = indexCount / 3;
+    if (triCount == 0) return;
+
+    // Adjacency vertex -> tam giác (CSR)
+    std::vector<unsigned int> activeTris(vertexCount, 0);
+    for (size_t i = 0; i < triCount * 3; i++) activeTris[indices[i]]++;
+
+    std::vector<unsigned int> adjOffset(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; v++) adjOffset[v + 1] = adjOffset[v] + activeTris[v];
+    std::vector<unsigned int> adjTris(adjOffset[vertexCount]);
+    {
+        std::vector<unsigned int> fill(adjOffset.begin(), adjOffset.end() - 1);
+        for (size_t t = 0; t < triCount; t++)
+            for (int k = 0; k < 3; k++) adjTris[fill[indices[t * 3 + k]]++] = (unsigned int)t;
+    }
+
+    std::vector<float> vertexScore(vertexCount);
+    for (size_t v = 0; v < vertexCount; v++) vertexScore[v] = ForsythScore(-1, activeTris[v]);
+
+    std::vector<float> triScore(triCount);
+    std::vector<char> triEmitted(triCount, 0);
+    for (size_t t = 0; t < triCount; t++)
+        triScore[t] = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+
+    std::vector<unsigned int> output;
+    output.reserve(triCount * 3);
+
+    // +3 chỗ cho tam giác vừa đẩy vào trước khi cắt bớt
+    unsigned int cache[kForsythCacheSize + 3];
+    int cacheCount = 0;
+    size_t scanCursor = 0;
+
+    for (size_t emitted = 0; emitted < triCount; emitted++) {
+        // Ứng viên: tam giác kề các vertex đang nằm trong cache
+        long best = -1;
+        float bestScore = -1.0f;
+        for (int c = 0; c < cacheCount; c++) {
+            unsigned int v = cache[c];
+            for (unsigned int a = adjOffset[v]; a < adjOffset[v] + activeTris[v]; a++) {
+                unsigned int t = adjTris[a];
+                if (triScore[t] > bestScore) {
+                    bestScore = triScore[t];
+                    best = (long)t;
+                }
+            }
+        }
+        // Cache không có gì dùng được -> tam giác chưa emit có score cao nhất trong cửa sổ sau con trỏ.
+        // Cửa sổ cố định để mesh rời rạc (triangle soup, foliage card) vẫn tuyến tính
+        if (best < 0) {
+            while (triEmitted[scanCursor]) scanCursor++;
+            const size_t windowEnd = std::min(triCount, scanCursor + kFallbackWindow);
+            for (size_t t = scanCursor; t < windowEnd; t++) {
+                if (!triEmitted[t] && triScore[t] > bestScore) {
+                    bestScore = triScore[t];
+                    best = (long)t;
+                }
+            }
+        }
+
+        const unsigned int* tri = indices + best * 3;
+        triEmitted[best] = 1;
+        output.insert(output.end(), tri, tri + 3);
+
+        // Bỏ tam giác khỏi adjacency của 3 vertex
+        for (int k = 0; k < 3; k++) {
+            unsigned int v = tri[k];
+            unsigned int* begin = adjTris.data() + adjOffset[v];
+            unsigned int* end = begin + activeTris[v];
+            unsigned int* it = std::find(begin, end, (unsigned int)best);
+            if (it != end) {
+                *it = *(end - 1);
+                activeTris[v]--;
+            }
+        }
+
+        // Đưa 3 vertex lên đầu LRU
+        unsigned int newCache[kForsythCacheSize + 3];
+        int newCount = 0;
+        for (int k = 0; k < 3; k++) newCache[newCount++] = tri[k];
+        for (int c = 0; c < cacheCount; c++) {
+            unsigned int v = cache[c];
+            if (v != tri[0] && v != tri[1] && v != tri[2]) newCache[newCount++] = v;
+        }
+        cacheCount = std::min(newCount, kForsythCacheSize);
+        std::memcpy(cache, newCache, cacheCount * sizeof(unsigned int));
+
+        // Cập nhật score cho vertex trong cache và tam giác kề chúng
+        for (int c = 0; c < cacheCount; c++) vertexScore[cache[c]] = ForsythScore(c, activeTris[cache[c]]);
+        for (int c = kForsythCacheSize; c < newCount; c++) {
+            unsigned int v = newCache[c];
+            vertexScore[v] = ForsythScore(-1, activeTris[v]);
+        }
+        for (int c = 0; c < newCount; c++) {
+            unsigned int v = newCache[c];
+            for (unsigned int a = adjOffset[v]; a < adjOffset[v] + activeTris[v]; a++) {
+                unsigned int t = adjTris[a];
+                triScore[t] = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+            }
+        }
+    }
+
+    std::memcpy(indices, output.data(), output.size() * sizeof(unsigned int));
+}
+
+// --- VERTEX FETCH ---
+size_t OptimizeVertexFetch(float* vertices, size_t vertexCount, size_t floatStride,
+                           unsigned int* indices, size_t indexCount) {
+    const unsigned int kUnused = ~0u;
+    std::vector<unsigned int> remap(vertexCount, kUnused);
+    std::vector<float> reordered(vertexCount * floatStride);
+
+    unsigned int next = 0;
+    for (size_t i = 0; i < indexCount; i++) {
+        unsigned int v = indices[i];
+        if (remap[v] == kUnused) {
+            remap[v] = next;
+            std::memcpy(&reordered[next * floatStride], vertices + v * floatStride, floatStride * sizeof(float));
+            next++;
+        }
+        indices[i] = remap[v];
+    }
+
+    std::memcpy(vertices, reordered.data(), next * floatStride * sizeof(float));
+    return next;
+}
+
+// --- ACMR ---
+float ComputeACMR(const unsigned int* indices, size_t indexCount, size_t vertexCount, unsigned int cacheSize) {
+    if (indexCount < 3) return 0.0f;
+
+    // FIFO: vertex còn trong cache nếu được đẩy vào trong cacheSize lần miss gần nhất
+    std::vector<size_t> insertedAt(vertexCount, 0);
+    size_t misses = 0;
+    for (size_t i = 0; i < indexCount; i++) {
+        unsigned int v = indices[i];
+        if (insertedAt[v] == 0 || misses - insertedAt[v] >= cacheSize) {
+            misses++;
+            insertedAt[v] = misses;
+        }
+    }
+    return (float)misses / (float)(indexCount / 3);
+}
+
+// --- BOUNDS ---
+void ComputePartBounds(const float* vertices, size_t vertexCount, size_t floatStride, MeshPart& part) {
+    if (vertexCount == 0) {
+        for (int k = 0; k < 3; k++) part.boundsMin[k] = part.boundsMax[k] = part.sphere[k] = 0.0f;
+        part.sphere[3] = 0.0f;
+        return;
+    }
+
+    for (int k = 0; k < 3; k++) part.boundsMin[k] = part.boundsMax[k] = vertices[k];
+    for (size_t v = 1; v < vertexCount; v++) {
+        const float* p = vertices + v * floatStride;
+        for (int k = 0; k < 3; k++) {
+            part.boundsMin[k] = std::min(part.boundsMin[k], p[k]);
+            part.boundsMax[k] = std::max(part.boundsMax[k], p[k]);
+        }
+    }
+
+    float radiusSq = 0.0f;
+    for (int k = 0; k < 3; k++) part.sphere[k] = (part.boundsMin[k] + part.boundsMax[k]) * 0.5f;
+    for (size_t v = 0; v < vertexCount; v++) {
+        const float* p = vertices + v * floatStride;
+        float dx = p[0] - part.sphere[0], dy = p[1] - part.sphere[1], dz = p[2] - part.sphere[2];
+        radiusSq = std::max(radiusSq, dx * dx + dy * dy + dz * dz);
+    }
+    part.sphere[3] = std::sqrt(radiusSq);
+}
+
+// --- FULL PIPELINE ---
+static void AppendIndices(const std::vector<unsigned int>& local, unsigned int indexSize, std::vector<unsigned char>& out,
+                          unsigned int& outOffset) {
+    size_t offset = out.size();
+    offset = (offset + indexSize - 1) / indexSize * indexSize; // căn lề cho GL
+    outOffset = (unsigned int)offset;
+    out.resize(offset + local.size() * indexSize, 0);
+    if (indexSize == 2) {
+        uint16_t* idx16 = reinterpret_cast<uint16_t*>(out.data() + offset);
+        for (size_t i = 0; i < local.size(); i++) idx16[i] = (uint16_t)local[i];
+    } else {
+        std::memcpy(out.data() + offset, local.data(), local.size() * sizeof(unsigned int));
+    }
+}
+
+void ReadLodIndices(const MeshData& mesh, const MeshPart& part, const MeshLod& lod, std::vector<unsigned int>& out) {
+    out.resize(lod.indexCount);
+    for (size_t i = 0; i < lod.indexCount; i++) {
+        if (part.indexSize == 2) {
+            uint16_t v;
+            std::memcpy(&v, mesh.indices.data() + lod.indexOffset + i * 2, 2);
+            out[i] = v;
+        } else {
+            std::memcpy(&out[i], mesh.indices.data() + lod.indexOffset + i * 4, 4);
+        }
+    }
+}
+
+// Mỗi part độc lập hoàn toàn -> tối ưu song song vào buffer riêng, ghép lại tuần tự sau
+struct OptimizedPart {
+    MeshPart part;
+    std::vector<float> vertices;
+    std::vector<VertexSkin> skin;   // chỉ với part skinned
+    std::vector<std::vector<unsigned int>> lods;
+    MeshPartStats stats;
+};
+
+// Part skinned: joint (đổi sang float, chính xác với uint16) + weight nối sau mỗi vertex,
+// để weld / reorder / LOD mang skin theo mà không gộp nhầm vertex khác weight
+constexpr unsigned int kSkinnedFloatCount = kVertexFloatCount + 2 * kMaxVertexInfluences;
+
+static void OptimizePart(const MeshData& in, const MeshPart& src, const LodSettings& lodSettings, OptimizedPart& result) {
+    const bool skinned = src.skinned && !in.skin.empty();
+    const size_t stride = skinned ? kSkinnedFloatCount : kVertexFloatCount;
+    const float* srcVertices = in.vertices.data() + (size_t)src.baseVertex * kVertexFloatCount;
+    std::vector<float> packed;
+    if (skinned) {
+        packed.resize((size_t)src.vertexCount * stride);
+        for (size_t v = 0; v < src.vertexCount; v++) {
+            float* dst = &packed[v * stride];
+            const VertexSkin& skin = in.skin[src.baseVertex + v];
+            std::memcpy(dst, srcVertices + v * kVertexFloatCount, kVertexStride);
+            for (unsigned int k = 0; k < kMaxVertexInfluences; k++) {
+                dst[kVertexFloatCount + k] = (float)skin.joints[k];
+                dst[kVertexFloatCount + kMaxVertexInfluences + k] = skin.weights[k];
+            }
+        }
+        srcVertices = packed.data();
+    }
+
+    std::vector<unsigned int> localIndices;
+    ReadLodIndices(in, src, { src.indexOffset, src.indexCount, 0.0f }, localIndices);
+
+    float acmrBefore = ComputeACMR(localIndices.data(), localIndices.size(), src.vertexCount);
+
+    // 1. Weld
+    std::vector<unsigned int> remap;
+    std::vector<float>& localVertices = result.vertices;
+    size_t vertexCount = WeldVertices(srcVertices, src.vertexCount, stride, remap);
+    localVertices.resize(vertexCount * stride);
+    for (size_t v = 0; v < src.vertexCount; v++)
+        std::memcpy(&localVertices[remap[v] * stride], srcVertices + v * stride, stride * sizeof(float));
+    for (unsigned int& index : localIndices) index = remap[index];
+
+    // 2. Tam giác, 3. Vertex
+    OptimizeVertexCache(localIndices.data(), localIndices.size(), vertexCount);
+    vertexCount = OptimizeVertexFetch(localVertices.data(), vertexCount, stride,
+                                      localIndices.data(), localIndices.size());
+    localVertices.resize(vertexCount * stride);
+
+    // 4. Bounds + chọn kích thước index
+    MeshPart& dst = result.part;
+    dst = src;
+    dst.vertexCount = (unsigned int)vertexCount;
+    dst.indexSize = vertexCount <= 0x10000 ? 2 : 4;
+    ComputePartBounds(localVertices.data(), vertexCount, stride, dst);
+
+    // 5. Chuỗi LOD trên cùng tập vertex, mỗi level tự tối ưu cache
+    std::vector<float> lodErrors;
+    BuildLodChain(localVertices.data(), vertexCount, stride, localIndices, dst.sphere[3],
+                  lodSettings, result.lods, lodErrors);
+    dst.lodCount = (unsigned int)result.lods.size();
+    for (size_t l = 0; l < result.lods.size(); l++) {
+        if (l > 0) OptimizeVertexCache(result.lods[l].data(), result.lods[l].size(), vertexCount);
+        dst.lods[l].indexCount = (unsigned int)result.lods[l].size();
+        dst.lods[l].error = lodErrors[l];
+    }
+
+    // Tách skin ra lại khỏi vertex
+    if (skinned) {
+        result.skin.resize(vertexCount);
+        for (size_t v = 0; v < vertexCount; v++) {
+            const float* p = &localVertices[v * stride];
+            for (unsigned int k = 0; k < kMaxVertexInfluences; k++) {
+                result.skin[v].joints[k] = (uint16_t)p[kVertexFloatCount + k];
+                result.skin[v].weights[k] = p[kVertexFloatCount + kMaxVertexInfluences + k];
+            }
+            std::memmove(&localVertices[v * kVertexFloatCount], p, kVertexStride);
+        }
+        localVertices.resize(vertexCount * kVertexFloatCount);
+    }
+
+    MeshPartStats& s = result.stats;
+    s.vertexCountBefore = src.vertexCount;
+    s.vertexCountAfter = vertexCount;
+    s.triangleCount = src.indexCount / 3;
+    s.acmrBefore = acmrBefore;
+    s.acmrAfter = ComputeACMR(localIndices.data(), localIndices.size(), vertexCount);
+    s.vertexBytesBefore = (size_t)src.vertexCount * kVertexStride;
+    s.vertexBytesAfter = vertexCount * kVertexStride;
+    s.indexBytesBefore = (size_t)src.indexCount * src.indexSize;
+    s.indexBytesAfter = (size_t)dst.indexCount * dst.indexSize;
+    for (size_t l = 1; l < result.lods.size(); l++) s.lodIndexBytes += result.lods[l].size() * dst.indexSize;
+}
+
+bool OptimizeMesh(const MeshData& in, MeshData& out, std::vector<MeshPartStats>* outStats, const LodSettings& lodSettings,
+                  JobSystem& jobs, const std::function<bool()>& cancelled) {
+    std::vector<OptimizedPart> optimized(in.parts.size());
+    std::atomic<bool> stop{ false };
+    jobs.ParallelFor(in.parts.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t p = begin; p < end; p++) {
+            if (stop.load(std::memory_order_relaxed) || (cancelled && cancelled())) {
+                stop.store(true, std::memory_order_relaxed);
+                return;
+            }
+            OptimizePart(in, in.parts[p], lodSettings, optimized[p]);
+        }
+    });
+    if (stop.load()) return false;
+
+    out.vertices.clear();
+    out.indices.clear();
+    out.parts.clear();
+    out.nodes = in.nodes;       // part giữ nguyên thứ tự nên meshRefs vẫn đúng
+    out.meshRefs = in.meshRefs;
+    out.textures = in.textures; // texture đã nén xong lúc import, không đổi
+    out.textureData = in.textureData;
+    out.textureFiles = in.textureFiles;
+    out.skin.clear();
+    out.joints = in.joints;     // joint / animation tham chiếu node, không tham chiếu vertex
+    out.clips = in.clips;
+    out.channels = in.channels;
+    out.keys = in.keys;
+    out.vertices.reserve(in.vertices.size());
+    out.indices.reserve(in.indices.size());
+    out.parts.reserve(in.parts.size());
+    if (outStats) outStats->resize(in.parts.size());
+
+    for (size_t p = 0; p < optimized.size(); p++) {
+        MeshPart dst = optimized[p].part;
+        dst.baseVertex = (unsigned int)(out.vertices.size() / kVertexFloatCount);
+        out.vertices.insert(out.vertices.end(), optimized[p].vertices.begin(), optimized[p].vertices.end());
+        if (!in.skin.empty()) {
+            // Part không skinned: weight 0 cho mọi vertex
+            if (optimized[p].skin.empty()) out.skin.resize(out.vertices.size() / kVertexFloatCount, VertexSkin());
+            else out.skin.insert(out.skin.end(), optimized[p].skin.begin(), optimized[p].skin.end());
+        }
+        out.parts.push_back(dst);
+        if (outStats) (*outStats)[p] = optimized[p].stats;
+    }
+
+    // 6. Ghi index theo level: LOD 0 của mọi part liền nhau, rồi LOD 1, ...
+    for (unsigned int level = 0; level < kMaxMeshLods; level++) {
+        for (size_t p = 0; p < out.parts.size(); p++) {
+            MeshPart& dst = out.parts[p];
+            if (level >= dst.lodCount) continue;
+            AppendIndices(optimized[p].lods[level], dst.indexSize, out.indices, dst.lods[level].indexOffset);
+            if (level == 0) dst.indexOffset = dst.lods[0].indexOffset;
+        }
+    }
+    return true;
+}
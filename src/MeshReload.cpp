@@ -0,0 +1,236 @@
+#include "MeshReload.h"
+#include "Profiler.h"
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+void BufferArena::Reset(size_t capacity, size_t used) {
+    m_Capacity = capacity;
+    used = std::min(used, capacity);
+    m_Free.clear();
+    if (used < capacity) m_Free.push_back({ used, capacity - used });
+    m_FreeBytes = capacity - used;
+}
+
+bool BufferArena::Allocate(size_t size, size_t alignment, size_t& outOffset) {
+    if (size == 0) {
+        outOffset = 0;
+        return true;
+    }
+    for (size_t i = 0; i < m_Free.size(); i++) {
+        Range& range = m_Free[i];
+        const size_t start = (range.offset + alignment - 1) / alignment * alignment;
+        const size_t end = range.offset + range.size;
+        if (start + size > end) continue;
+        outOffset = start;
+        // Phần đệm căn lề phía trước giữ lại làm vùng trống riêng
+        Range before = { range.offset, start - range.offset };
+        Range after = { start + size, end - start - size };
+        m_FreeBytes -= size;
+        if (before.size > 0 && after.size > 0) {
+            range = before;
+            m_Free.insert(m_Free.begin() + i + 1, after);
+        } else if (before.size > 0) {
+            range = before;
+        } else if (after.size > 0) {
+            range = after;
+        } else {
+            m_Free.erase(m_Free.begin() + i);
+        }
+        return true;
+    }
+    return false;
+}
+
+void BufferArena::Free(size_t offset, size_t size) {
+    if (size == 0) return;
+    auto it = std::lower_bound(m_Free.begin(), m_Free.end(), offset,
+                               [](const Range& r, size_t value) { return r.offset < value; });
+    it = m_Free.insert(it, { offset, size });
+    m_FreeBytes += size;
+    // Gộp với vùng sau rồi vùng trước
+    auto next = it + 1;
+    if (next != m_Free.end() && it->offset + it->size == next->offset) {
+        it->size += next->size;
+        m_Free.erase(next);
+    }
+    if (it != m_Free.begin()) {
+        auto prev = it - 1;
+        if (prev->offset + prev->size == it->offset) {
+            prev->size += it->size;
+            m_Free.erase(it);
+        }
+    }
+}
+
+uint64_t HashBytes(const void* data, size_t size, uint64_t seed) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    uint64_t hash = seed ^ (size * 0xBF58476D1CE4E5B9ull);
+    auto Mix = [&hash](uint64_t word) {
+        word *= 0x9E3779B97F4A7C15ull;
+        word ^= word >> 29;
+        hash = (hash ^ word) * 0x94D049BB133111EBull;
+        hash = (hash << 27) | (hash >> 37);
+    };
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, bytes + i, 8);
+        Mix(word);
+    }
+    if (i < size) {
+        uint64_t word = 0;
+        std::memcpy(&word, bytes + i, size - i);
+        Mix(word);
+    }
+    // Trộn cuối (splitmix64)
+    hash ^= hash >> 30;
+    hash *= 0xBF58476D1CE4E5B9ull;
+    hash ^= hash >> 27;
+    hash *= 0x94D049BB133111EBull;
+    return hash ^ (hash >> 31);
+}
+
+static uint64_t HashPart(const MeshView& mesh, const MeshPart& part) {
+    const unsigned char* vertices = static_cast<const unsigned char*>(mesh.vertexData);
+    const unsigned char* indices = static_cast<const unsigned char*>(mesh.indexData);
+    const uint32_t shape[4] = { part.vertexCount, part.indexSize, part.lodCount, part.skinned };
+    uint64_t hash = HashBytes(shape, sizeof(shape));
+    hash = HashBytes(vertices + (size_t)part.baseVertex * kVertexStride, (size_t)part.vertexCount * kVertexStride, hash);
+    if (mesh.skin) hash = HashBytes(mesh.skin + part.baseVertex, (size_t)part.vertexCount * sizeof(VertexSkin), hash);
+    for (unsigned int l = 0; l < PartLodCount(part); l++) {
+        const MeshLod lod = PartLod(part, l);
+        hash = HashBytes(&lod.indexCount, sizeof(lod.indexCount), hash);
+        hash = HashBytes(indices + lod.indexOffset, (size_t)lod.indexCount * part.indexSize, hash);
+    }
+    return hash;
+}
+
+void HashMeshParts(const MeshView& mesh, std::vector<uint64_t>& outHashes, JobSystem& jobs) {
+    PROFILE_SCOPE("Hash Mesh Parts");
+    outHashes.resize(mesh.partCount);
+    jobs.ParallelFor(mesh.partCount, 16, [&](size_t begin, size_t end) {
+        for (size_t p = begin; p < end; p++) outHashes[p] = HashPart(mesh, mesh.parts[p]);
+    });
+}
+
+static size_t IndexBytes(const MeshView& mesh) {
+    return (mesh.IndexBytes() + 3) / 4 * 4;
+}
+
+void ResetResidentMesh(const MeshView& mesh, std::vector<uint64_t> hashes, size_t vertexCapacity, size_t indexCapacity,
+                       unsigned int drawIDSize, unsigned int vertexStride, ResidentMesh& out) {
+    out.hashes = std::move(hashes);
+    out.vertices.Reset(vertexCapacity, mesh.vertexCount);
+    out.indices.Reset(indexCapacity, IndexBytes(mesh));
+    out.drawIDSize = drawIDSize;
+    out.vertexStride = vertexStride;
+    out.hasSkin = mesh.skin != nullptr;
+}
+
+bool PlanMeshReload(const MeshView& mesh, const std::vector<uint64_t>& hashes, const MeshPart* residentParts,
+                    size_t residentCount, ResidentMesh& resident, MeshReloadPlan& outPlan, float compactThreshold) {
+    outPlan = MeshReloadPlan();
+    const unsigned int drawIDSize = mesh.partCount <= 0x10000 ? 2 : 4; // cùng quy tắc với BuildVertexDrawIDs
+    if (resident.hashes.size() != residentCount || hashes.size() != mesh.partCount) {
+        outPlan.fullReason = "no part hashes";
+        return false;
+    }
+    if ((mesh.skin != nullptr) != resident.hasSkin) {
+        outPlan.fullReason = "skin stream added or removed";
+        return false;
+    }
+    if (drawIDSize != resident.drawIDSize) {
+        outPlan.fullReason = "draw ID size changed";
+        return false;
+    }
+
+    // 1. Ghép part mới với part resident cùng hash (mỗi part resident dùng một lần)
+    std::unordered_multimap<uint64_t, unsigned int> byHash;
+    byHash.reserve(residentCount);
+    for (unsigned int r = 0; r < (unsigned int)residentCount; r++) byHash.emplace(resident.hashes[r], r);
+    std::vector<int> match(mesh.partCount, -1);
+    std::vector<uint8_t> kept(residentCount, 0);
+    for (size_t p = 0; p < mesh.partCount; p++) {
+        const MeshPart& part = mesh.parts[p];
+        auto range = byHash.equal_range(hashes[p]);
+        for (auto it = range.first; it != range.second; ++it) {
+            const MeshPart& old = residentParts[it->second];
+            if (kept[it->second] || old.vertexCount != part.vertexCount || old.indexSize != part.indexSize
+                || old.lodCount != part.lodCount)
+                continue;
+            match[p] = (int)it->second;
+            kept[it->second] = 1;
+            break;
+        }
+    }
+
+    // 2. Trên bản sao arena: trả vùng của part bị bỏ, cấp vùng cho part mới
+    BufferArena vertices = resident.vertices;
+    BufferArena indices = resident.indices;
+    for (size_t r = 0; r < residentCount; r++) {
+        if (kept[r]) continue;
+        const MeshPart& old = residentParts[r];
+        vertices.Free(old.baseVertex, old.vertexCount);
+        for (unsigned int l = 0; l < PartLodCount(old); l++) {
+            const MeshLod lod = PartLod(old, l);
+            indices.Free(lod.indexOffset, (size_t)lod.indexCount * old.indexSize);
+        }
+        outPlan.removedParts++;
+    }
+
+    outPlan.parts.resize(mesh.partCount);
+    for (size_t p = 0; p < mesh.partCount; p++) {
+        const MeshPart& src = mesh.parts[p];
+        MeshPart& dst = outPlan.parts[p];
+        dst = src;
+        if (match[p] >= 0) {
+            const MeshPart& old = residentParts[match[p]];
+            dst.baseVertex = old.baseVertex;
+            dst.indexOffset = old.indexOffset;
+            std::memcpy(dst.lods, old.lods, sizeof(dst.lods));
+            if ((size_t)match[p] != p) outPlan.drawIDParts.push_back((unsigned int)p);
+            outPlan.reusedParts++;
+            continue;
+        }
+
+        size_t baseVertex = 0;
+        if (!vertices.Allocate(src.vertexCount, 1, baseVertex)) {
+            outPlan.fullReason = "vertex buffer full";
+            return false;
+        }
+        dst.baseVertex = (unsigned int)baseVertex;
+        outPlan.vertexCopies.push_back({ src.baseVertex, baseVertex, src.vertexCount, (unsigned int)p });
+        for (unsigned int l = 0; l < PartLodCount(src); l++) {
+            const MeshLod lod = PartLod(src, l);
+            const size_t bytes = (size_t)lod.indexCount * src.indexSize;
+            size_t offset = 0;
+            if (!indices.Allocate(bytes, 4, offset)) {
+                outPlan.fullReason = "index buffer full";
+                return false;
+            }
+            if (src.lodCount > 0) dst.lods[l].indexOffset = (unsigned int)offset;
+            if (l == 0) dst.indexOffset = (unsigned int)offset;
+            outPlan.indexCopies.push_back({ lod.indexOffset, offset, bytes, (unsigned int)p });
+            outPlan.uploadBytes += bytes;
+        }
+        outPlan.uploadBytes += (size_t)src.vertexCount * (resident.vertexStride + (mesh.skin ? sizeof(VertexSkin) : 0));
+        outPlan.drawIDParts.push_back((unsigned int)p);
+        outPlan.uploadedParts++;
+    }
+    for (unsigned int p : outPlan.drawIDParts) outPlan.uploadBytes += (size_t)mesh.parts[p].vertexCount * drawIDSize;
+
+    // 3. Quá nhiều lỗ: nén lại bằng upload toàn bộ thay vì để buffer phình mãi
+    const double freeBytes = (double)vertices.FreeBytes() * resident.vertexStride + (double)indices.FreeBytes();
+    const double usedBytes = (double)vertices.UsedBytes() * resident.vertexStride + (double)indices.UsedBytes();
+    if (freeBytes > compactThreshold * usedBytes) {
+        outPlan.fullReason = "compacting fragmented buffers";
+        return false;
+    }
+
+    resident.vertices = vertices;
+    resident.indices = indices;
+    resident.hashes = hashes;
+    return true;
+}
@@ -0,0 +1,326 @@
+#include "MeshSimplifier.h"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+
+namespace {
+    // Cạnh biên được giữ bằng một mặt phẳng vuông góc với tam giác, nặng hơn mặt thường
+    const double kBorderWeight = 10.0;
+
+    // Q(p) = p^T A p + 2 b^T p + c, lưu đối xứng
+    struct Quadric {
+        double a00 = 0, a11 = 0, a22 = 0, a01 = 0, a02 = 0, a12 = 0;
+        double b0 = 0, b1 = 0, b2 = 0, c = 0;
+        double w = 0;
+
+        void AddPlane(const double n[3], double d, double weight) {
+            a00 += weight * n[0] * n[0]; a11 += weight * n[1] * n[1]; a22 += weight * n[2] * n[2];
+            a01 += weight * n[0] * n[1]; a02 += weight * n[0] * n[2]; a12 += weight * n[1] * n[2];
+            b0 += weight * n[0] * d; b1 += weight * n[1] * d; b2 += weight * n[2] * d;
+            c += weight * d * d;
+            w += weight;
+        }
+
+        void Add(const Quadric& q) {
+            a00 += q.a00; a11 += q.a11; a22 += q.a22; a01 += q.a01; a02 += q.a02; a12 += q.a12;
+            b0 += q.b0; b1 += q.b1; b2 += q.b2; c += q.c;
+            w += q.w;
+        }
+
+        double Eval(const double p[3]) const {
+            double x = p[0], y = p[1], z = p[2];
+            double r = a00 * x * x + a11 * y * y + a22 * z * z
+                     + 2.0 * (a01 * x * y + a02 * x * z + a12 * y * z)
+                     + 2.0 * (b0 * x + b1 * y + b2 * z) + c;
+            return r > 0.0 ? r : 0.0;
+        }
+    };
+
+    enum VertexKind : uint8_t { kManifold, kBorder, kLocked };
+
+    struct Collapse {
+        double cost;
+        unsigned int from, to;
+    };
+
+    uint64_t EdgeKey(unsigned int a, unsigned int b) { return ((uint64_t)a << 32) | b; }
+
+    void Sub(const double a[3], const double b[3], double out[3]) {
+        out[0] = a[0] - b[0]; out[1] = a[1] - b[1]; out[2] = a[2] - b[2];
+    }
+
+    void Cross(const double a[3], const double b[3], double out[3]) {
+        out[0] = a[1] * b[2] - a[2] * b[1];
+        out[1] = a[2] * b[0] - a[0] * b[2];
+        out[2] = a[0] * b[1] - a[1] * b[0];
+    }
+
+    double Dot(const double a[3], const double b[3]) { return a[0] * b[0] + a[1] * b[1] + a[2] * b[2]; }
+
+    void TriangleNormal(const double* p0, const double* p1, const double* p2, double out[3]) {
+        double e1[3], e2[3];
+        Sub(p1, p0, e1);
+        Sub(p2, p0, e2);
+        Cross(e1, e2, out);
+    }
+}
+
+size_t SimplifyMesh(const float* vertices, size_t vertexCount, size_t floatStride,
+                    const unsigned int* indices, size_t indexCount,
+                    size_t targetIndexCount, float maxError,
+                    unsigned int* outIndices, float* outError) {
+    std::vector<unsigned int> current(indices, indices + indexCount);
+    if (outError) *outError = 0.0f;
+    if (indexCount <= targetIndexCount || vertexCount == 0) {
+        std::copy(current.begin(), current.end(), outIndices);
+        return indexCount;
+    }
+
+    std::vector<double> positions(vertexCount * 3);
+    for (size_t v = 0; v < vertexCount; v++)
+        for (int k = 0; k < 3; k++) positions[v * 3 + k] = vertices[v * floatStride + k];
+    auto P = [&positions](unsigned int v) { return &positions[(size_t)v * 3]; };
+
+    std::vector<uint64_t> halfEdges;
+    auto BuildHalfEdges = [&halfEdges, &current]() {
+        halfEdges.clear();
+        for (size_t i = 0; i < current.size(); i += 3)
+            for (int k = 0; k < 3; k++) halfEdges.push_back(EdgeKey(current[i + k], current[i + (k + 1) % 3]));
+        std::sort(halfEdges.begin(), halfEdges.end());
+    };
+    auto HasHalfEdge = [&halfEdges](unsigned int a, unsigned int b) {
+        return std::binary_search(halfEdges.begin(), halfEdges.end(), EdgeKey(a, b));
+    };
+
+    // --- Phân loại vertex (một lần, theo mesh gốc) ---
+    std::vector<uint8_t> kind(vertexCount, kManifold);
+
+    // Vertex trùng vị trí với vertex khác (seam UV/normal): di chuyển sẽ xé mesh
+    std::vector<unsigned int> order(vertexCount);
+    std::iota(order.begin(), order.end(), 0u);
+    auto PositionLess = [&P](unsigned int a, unsigned int b) {
+        const double* pa = P(a);
+        const double* pb = P(b);
+        if (pa[0] != pb[0]) return pa[0] < pb[0];
+        if (pa[1] != pb[1]) return pa[1] < pb[1];
+        if (pa[2] != pb[2]) return pa[2] < pb[2];
+        return a < b;
+    };
+    std::sort(order.begin(), order.end(), PositionLess);
+    for (size_t i = 1; i < vertexCount; i++) {
+        const double* pa = P(order[i - 1]);
+        const double* pb = P(order[i]);
+        if (pa[0] == pb[0] && pa[1] == pb[1] && pa[2] == pb[2]) kind[order[i - 1]] = kind[order[i]] = kLocked;
+    }
+
+    BuildHalfEdges();
+    for (size_t i = 0; i < halfEdges.size(); i++) {
+        unsigned int a = (unsigned int)(halfEdges[i] >> 32), b = (unsigned int)halfEdges[i];
+        bool duplicate = (i > 0 && halfEdges[i - 1] == halfEdges[i]) ||
+                         (i + 1 < halfEdges.size() && halfEdges[i + 1] == halfEdges[i]);
+        if (duplicate) {
+            kind[a] = kind[b] = kLocked; // cạnh non-manifold
+        } else if (!HasHalfEdge(b, a)) {
+            if (kind[a] == kManifold) kind[a] = kBorder;
+            if (kind[b] == kManifold) kind[b] = kBorder;
+        }
+    }
+
+    // --- Quadric theo vertex ---
+    std::vector<Quadric> quadrics(vertexCount);
+    for (size_t i = 0; i < current.size(); i += 3) {
+        const double* p[3] = { P(current[i]), P(current[i + 1]), P(current[i + 2]) };
+        double n[3];
+        TriangleNormal(p[0], p[1], p[2], n);
+        double length = std::sqrt(Dot(n, n));
+        if (length == 0.0) continue;
+        for (double& x : n) x /= length;
+        double area = length * 0.5;
+        double d = -Dot(n, p[0]);
+        for (int k = 0; k < 3; k++) quadrics[current[i + k]].AddPlane(n, d, area);
+
+        for (int k = 0; k < 3; k++) {
+            unsigned int a = current[i + k], b = current[i + (k + 1) % 3];
+            if (HasHalfEdge(b, a)) continue;
+            double edge[3], en[3];
+            Sub(p[(k + 1) % 3], p[k], edge);
+            Cross(edge, n, en);
+            double enLength = std::sqrt(Dot(en, en));
+            if (enLength == 0.0) continue;
+            for (double& x : en) x /= enLength;
+            double weight = Dot(edge, edge) * kBorderWeight;
+            double ed = -Dot(en, p[k]);
+            quadrics[a].AddPlane(en, ed, weight);
+            quadrics[b].AddPlane(en, ed, weight);
+        }
+    }
+
+    // --- Các pass collapse ---
+    const double maxErrorSq = (double)maxError * (double)maxError;
+    double resultErrorSq = 0.0;
+    std::vector<unsigned int> triOffset(vertexCount + 1), triList, cursor;
+    std::vector<unsigned int> remap(vertexCount);
+    std::vector<uint8_t> touched(vertexCount);
+    std::vector<Collapse> candidates;
+
+    while (current.size() > targetIndexCount) {
+        const size_t triCount = current.size() / 3;
+
+        // Vertex -> tam giác (CSR)
+        std::fill(triOffset.begin(), triOffset.end(), 0u);
+        for (unsigned int v : current) triOffset[v + 1]++;
+        for (size_t v = 0; v < vertexCount; v++) triOffset[v + 1] += triOffset[v];
+        triList.resize(current.size());
+        cursor.assign(triOffset.begin(), triOffset.end() - 1);
+        for (size_t i = 0; i < current.size(); i++) triList[cursor[current[i]]++] = (unsigned int)(i / 3);
+
+        BuildHalfEdges();
+
+        candidates.clear();
+        auto Consider = [&](unsigned int from, unsigned int to, bool borderEdge) {
+            if (kind[from] == kLocked) return;
+            if (kind[from] == kBorder && (!borderEdge || kind[to] == kManifold)) return;
+            Quadric q = quadrics[from];
+            q.Add(quadrics[to]);
+            double cost = q.w > 0.0 ? q.Eval(P(to)) / q.w : 0.0;
+            candidates.push_back({ cost, from, to });
+        };
+        for (size_t i = 0; i < current.size(); i += 3)
+            for (int k = 0; k < 3; k++) {
+                unsigned int a = current[i + k], b = current[i + (k + 1) % 3];
+                bool borderEdge = !HasHalfEdge(b, a);
+                Consider(a, b, borderEdge);
+                if (borderEdge) Consider(b, a, borderEdge);
+            }
+        std::sort(candidates.begin(), candidates.end(), [](const Collapse& x, const Collapse& y) {
+            if (x.cost != y.cost) return x.cost < y.cost;
+            if (x.from != y.from) return x.from < y.from;
+            return x.to < y.to;
+        });
+
+        // Collapse làm tam giác quanh `from` bị lật thì bỏ qua
+        auto Flips = [&](unsigned int from, unsigned int to) {
+            for (unsigned int t = triOffset[from]; t < triOffset[from + 1]; t++) {
+                const unsigned int* tri = &current[(size_t)triList[t] * 3];
+                if (tri[0] == to || tri[1] == to || tri[2] == to) continue;
+                const double* p[3] = { P(tri[0]), P(tri[1]), P(tri[2]) };
+                double before[3], after[3];
+                TriangleNormal(p[0], p[1], p[2], before);
+                for (int k = 0; k < 3; k++)
+                    if (tri[k] == from) p[k] = P(to);
+                TriangleNormal(p[0], p[1], p[2], after);
+                if (Dot(before, after) <= 0.0) return true;
+            }
+            return false;
+        };
+
+        std::iota(remap.begin(), remap.end(), 0u);
+        std::fill(touched.begin(), touched.end(), (uint8_t)0);
+        size_t trianglesLeft = triCount;
+        const size_t targetTriangles = targetIndexCount / 3;
+        size_t collapses = 0;
+        for (const Collapse& c : candidates) {
+            if (trianglesLeft <= targetTriangles || c.cost > maxErrorSq) break;
+            if (touched[c.from] || touched[c.to] || Flips(c.from, c.to)) continue;
+
+            remap[c.from] = c.to;
+            quadrics[c.to].Add(quadrics[c.from]);
+            resultErrorSq = std::max(resultErrorSq, c.cost);
+            collapses++;
+
+            // Khoá cả one-ring để các collapse trong cùng pass không chồng lên nhau
+            for (unsigned int t = triOffset[c.from]; t < triOffset[c.from + 1]; t++) {
+                const unsigned int* tri = &current[(size_t)triList[t] * 3];
+                if (tri[0] == c.to || tri[1] == c.to || tri[2] == c.to) trianglesLeft--;
+                touched[tri[0]] = touched[tri[1]] = touched[tri[2]] = 1;
+            }
+        }
+        if (collapses == 0) break;
+
+        size_t write = 0;
+        for (size_t i = 0; i < current.size(); i += 3) {
+            unsigned int a = remap[current[i]], b = remap[current[i + 1]], c = remap[current[i + 2]];
+            if (a == b || b == c || a == c) continue;
+            current[write++] = a;
+            current[write++] = b;
+            current[write++] = c;
+        }
+        current.resize(write);
+    }
+
+    std::copy(current.begin(), current.end(), outIndices);
+    if (outError) *outError = (float)std::sqrt(resultErrorSq);
+    return current.size();
+}
+
+void BuildLodChain(const float* vertices, size_t vertexCount, size_t floatStride,
+                   const std::vector<unsigned int>& lod0, float partRadius, const LodSettings& settings,
+                   std::vector<std::vector<unsigned int>>& outLods, std::vector<float>& outErrors) {
+    outLods.assign(1, lod0);
+    outErrors.assign(1, 0.0f);
+    if (lod0.size() / 3 < settings.minTriangles) return;
+
+    const float errorBudget = settings.maxRelativeError * partRadius;
+    std::vector<unsigned int> scratch;
+    while (outLods.size() < settings.maxLevels) {
+        const std::vector<unsigned int>& prev = outLods.back();
+        size_t target = (size_t)((float)(prev.size() / 3) * settings.reduction) * 3;
+        float remaining = errorBudget - outErrors.back();
+        if (target == 0 || remaining <= 0.0f) break;
+
+        float error = 0.0f;
+        scratch.resize(prev.size());
+        size_t count = SimplifyMesh(vertices, vertexCount, floatStride, prev.data(), prev.size(),
+                                    target, remaining, scratch.data(), &error);
+        if (count == 0 || (float)count > (float)prev.size() * settings.minGain) break;
+
+        scratch.resize(count);
+        outErrors.push_back(outErrors.back() + error);
+        outLods.push_back(scratch);
+    }
+}
+
+// --- ĐO SAI SỐ ---
+// Ericson, Real-Time Collision Detection 5.1.5
+static glm::vec3 ClosestPointOnTriangle(const glm::vec3& p, const glm::vec3& a, const glm::vec3& b, const glm::vec3& c) {
+    glm::vec3 ab = b - a, ac = c - a, ap = p - a;
+    float d1 = glm::dot(ab, ap), d2 = glm::dot(ac, ap);
+    if (d1 <= 0.0f && d2 <= 0.0f) return a;
+    glm::vec3 bp = p - b;
+    float d3 = glm::dot(ab, bp), d4 = glm::dot(ac, bp);
+    if (d3 >= 0.0f && d4 <= d3) return b;
+    float vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) return a + ab * (d1 / (d1 - d3));
+    glm::vec3 cp = p - c;
+    float d5 = glm::dot(ab, cp), d6 = glm::dot(ac, cp);
+    if (d6 >= 0.0f && d5 <= d6) return c;
+    float vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) return a + ac * (d2 / (d2 - d6));
+    float va = d3 * d6 - d5 * d4;
+    if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f) return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+    float denom = 1.0f / (va + vb + vc);
+    return a + ab * (vb * denom) + ac * (vc * denom);
+}
+
+float MeasureDeviation(const float* vertices, size_t vertexCount, size_t floatStride, const std::vector<unsigned int>& indices,
+                       size_t maxSamples) {
+    size_t step = std::max<size_t>(1, vertexCount / maxSamples);
+    auto V = [vertices, floatStride](unsigned int i) { return glm::make_vec3(vertices + (size_t)i * floatStride); };
+    float worst = 0.0f;
+    for (size_t v = 0; v < vertexCount; v += step) {
+        glm::vec3 p = V((unsigned int)v);
+        float best = FLT_MAX;
+        for (size_t t = 0; t < indices.size(); t += 3) {
+            glm::vec3 q = ClosestPointOnTriangle(p, V(indices[t]), V(indices[t + 1]), V(indices[t + 2]));
+            best = std::min(best, glm::dot(p - q, p - q));
+        }
+        worst = std::max(worst, best);
+    }
+    return std::sqrt(worst);
+}
@@ -0,0 +1,483 @@
+#include "ModelImporter.h"
+#include "MeshOptimizer.h"
+#include "Profiler.h"
+#include "TextureCodec.h"
+
+#include <assimp/Importer.hpp>
+#include <assimp/ProgressHandler.hpp>
+#include <assimp/scene.h>
+#include <assimp/postprocess.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <unordered_map>
+
+const unsigned int kDefaultImportFlags =
+    aiProcess_Triangulate | aiProcess_FlipUVs | aiProcess_LimitBoneWeights | aiProcess_PreTransformVertices;
+const unsigned int kInstancedImportFlags =
+    aiProcess_Triangulate | aiProcess_FlipUVs | aiProcess_LimitBoneWeights;
+
+static void ToColumnMajor(const aiMatrix4x4& m, float* out) {
+    // aiMatrix4x4 là row-major, glm column-major -> chuyển vị
+    for (int c = 0; c < 4; c++)
+        for (int r = 0; r < 4; r++) out[c * 4 + r] = m[r][c];
+}
+
+using NodeNameMap = std::unordered_map<std::string, unsigned int>;
+
+// DFS pre-order: parent đứng trước con, subtree liền một khối
+static void AppendSceneNode(const aiNode* node, int parent, MeshData& outMesh, NodeNameMap& outNames) {
+    unsigned int index = (unsigned int)outMesh.nodes.size();
+    outMesh.nodes.emplace_back();
+    outNames.emplace(node->mName.C_Str(), index); // tên trùng: giữ node đầu tiên
+
+    SceneNode& dst = outMesh.nodes.back();
+    dst.parent = parent;
+    dst.firstMeshRef = (unsigned int)outMesh.meshRefs.size();
+    dst.meshRefCount = node->mNumMeshes;
+    ToColumnMajor(node->mTransformation, dst.local);
+    outMesh.meshRefs.insert(outMesh.meshRefs.end(), node->mMeshes, node->mMeshes + node->mNumMeshes);
+
+    for (unsigned int i = 0; i < node->mNumChildren; i++)
+        AppendSceneNode(node->mChildren[i], (int)index, outMesh, outNames);
+
+    outMesh.nodes[index].subtreeSize = (unsigned int)(outMesh.nodes.size() - index);
+}
+
+// Nguồn của một texture: ảnh nhúng trong model (glb, "*N") hoặc file nằm cạnh model
+struct TextureSource {
+    const aiTexture* embedded = nullptr;
+    std::string file;
+};
+
+static bool FindBaseColorTexture(const aiMaterial* material, aiString& outPath) {
+    return aiGetMaterialTexture(material, aiTextureType_BASE_COLOR, 0, &outPath) == AI_SUCCESS
+        || aiGetMaterialTexture(material, aiTextureType_DIFFUSE, 0, &outPath) == AI_SUCCESS;
+}
+
+static bool DecodeTextureSource(const TextureSource& source, Image& outImage, std::string* outError) {
+    if (!source.embedded) return DecodeImageFile(source.file.c_str(), outImage, outError);
+
+    const aiTexture* texture = source.embedded;
+    // mHeight == 0: pcData là file nén (png/jpg...) dài mWidth byte
+    if (texture->mHeight == 0) return DecodeImage(texture->pcData, texture->mWidth, outImage, outError);
+
+    // Ngược lại: texel thô BGRA
+    outImage.width = texture->mWidth;
+    outImage.height = texture->mHeight;
+    outImage.rgba.resize((size_t)texture->mWidth * texture->mHeight * 4);
+    for (size_t i = 0; i < (size_t)texture->mWidth * texture->mHeight; i++) {
+        const aiTexel& texel = texture->pcData[i];
+        unsigned char* dst = &outImage.rgba[i * 4];
+        dst[0] = texel.r; dst[1] = texel.g; dst[2] = texel.b; dst[3] = texel.a;
+    }
+    return true;
+}
+
+// Base color texture của mọi material: gom nguồn trùng nhau, decode + sinh mip + nén song song
+// (mỗi texture một job, bên trong lại chia theo hàng block), rồi nối vào texture blob theo thứ tự.
+static void ImportTextures(const aiScene* scene, const char* modelPath, MeshData& outMesh, JobSystem& jobs) {
+    PROFILE_SCOPE("Import Textures");
+    namespace fs = std::filesystem;
+    const fs::path modelDir = fs::path(modelPath).parent_path();
+
+    std::vector<TextureSource> sources;
+    std::unordered_map<std::string, int> sourceIndex;
+    std::vector<int> materialTexture(scene->mNumMaterials, -1);
+    for (unsigned int m = 0; m < scene->mNumMaterials; m++) {
+        aiString path;
+        if (!FindBaseColorTexture(scene->mMaterials[m], path) || path.length == 0) continue;
+
+        TextureSource source;
+        std::string key;
+        std::pair<const aiTexture*, int> embedded = scene->GetEmbeddedTextureAndIndex(path.C_Str());
+        if (embedded.first) {
+            source.embedded = embedded.first;
+            key = "*" + std::to_string(embedded.second);
+        } else {
+            std::error_code ec;
+            fs::path file = fs::absolute(modelDir / fs::path(path.C_Str()), ec).lexically_normal();
+            source.file = file.string();
+            key = source.file;
+        }
+
+        auto inserted = sourceIndex.emplace(key, (int)sources.size());
+        if (inserted.second) sources.push_back(source);
+        materialTexture[m] = inserted.first->second;
+    }
+    if (sources.empty()) return;
+
+    std::vector<TextureDesc> descs(sources.size());
+    std::vector<std::vector<unsigned char>> blobs(sources.size());
+    std::vector<std::string> errors(sources.size());
+    jobs.ParallelFor(sources.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            Image image;
+            if (DecodeTextureSource(sources[i], image, &errors[i])) CookTexture(image, descs[i], blobs[i], true, jobs);
+            else if (errors[i].empty()) errors[i] = "decode failed";
+        }
+    });
+
+    // Texture lỗi bị bỏ (part dùng nó vẽ màu phẳng), index được đánh lại liên tục
+    std::vector<int> remap(sources.size(), -1);
+    for (size_t i = 0; i < sources.size(); i++) {
+        const std::string name = sources[i].embedded ? "embedded texture " + std::to_string(i) : sources[i].file;
+        if (!errors[i].empty()) {
+            std::cerr << "Texture: cannot load " << name << ": " << errors[i] << std::endl;
+            continue;
+        }
+        size_t base = (outMesh.textureData.size() + kTextureAlignment - 1) & ~(kTextureAlignment - 1);
+        outMesh.textureData.resize(base);
+        outMesh.textureData.insert(outMesh.textureData.end(), blobs[i].begin(), blobs[i].end());
+        for (unsigned int l = 0; l < descs[i].mipCount; l++) descs[i].mips[l].offset += base;
+
+        remap[i] = (int)outMesh.textures.size();
+        outMesh.textures.push_back(descs[i]);
+        if (!sources[i].embedded) outMesh.textureFiles.push_back(sources[i].file);
+    }
+
+    for (unsigned int i = 0; i < scene->mNumMeshes; i++) {
+        const aiMesh* mesh = scene->mMeshes[i];
+        int texture = materialTexture[mesh->mMaterialIndex];
+        // Không có UV thì texture vô nghĩa
+        if (texture >= 0 && mesh->HasTextureCoords(0)) outMesh.parts[i].textureIndex = remap[texture];
+    }
+}
+
+// aiBone -> skin stream + bảng joint (dùng chung giữa các mesh nếu cùng xương, cùng bind, cùng node chứa).
+// Chỉ có ở chế độ giữ hierarchy: xương tham chiếu node theo tên.
+static void ImportSkins(const aiScene* scene, const NodeNameMap& names, MeshData& outMesh) {
+    bool anySkin = false;
+    for (unsigned int i = 0; i < scene->mNumMeshes; i++) anySkin |= scene->mMeshes[i]->mNumBones > 0;
+    if (!anySkin || outMesh.nodes.empty()) return;
+
+    // Mesh -> node đầu tiên tham chiếu nó (pre-order)
+    std::vector<unsigned int> meshNode(scene->mNumMeshes, 0);
+    std::vector<uint8_t> meshNodeFound(scene->mNumMeshes, 0);
+    for (unsigned int n = 0; n < (unsigned int)outMesh.nodes.size(); n++) {
+        const SceneNode& node = outMesh.nodes[n];
+        for (unsigned int r = 0; r < node.meshRefCount; r++) {
+            unsigned int mesh = outMesh.meshRefs[node.firstMeshRef + r];
+            if (mesh < scene->mNumMeshes && !meshNodeFound[mesh]) {
+                meshNode[mesh] = n;
+                meshNodeFound[mesh] = 1;
+            }
+        }
+    }
+
+    outMesh.skin.assign(outMesh.vertices.size() / kVertexFloatCount, VertexSkin());
+    for (unsigned int i = 0; i < scene->mNumMeshes; i++) {
+        const aiMesh* mesh = scene->mMeshes[i];
+        if (mesh->mNumBones == 0) continue;
+        MeshPart& part = outMesh.parts[i];
+
+        for (unsigned int b = 0; b < mesh->mNumBones; b++) {
+            const aiBone* bone = mesh->mBones[b];
+            auto found = names.find(bone->mName.C_Str());
+            if (found == names.end()) {
+                std::cerr << "Skin: bone " << bone->mName.C_Str() << " has no node, ignored" << std::endl;
+                continue;
+            }
+
+            SkinJoint joint;
+            joint.node = found->second;
+            joint.skinNode = meshNode[i];
+            ToColumnMajor(bone->mOffsetMatrix, joint.inverseBind);
+            size_t index = 0;
+            while (index < outMesh.joints.size()
+                   && std::memcmp(&outMesh.joints[index], &joint, sizeof(SkinJoint)) != 0) index++;
+            if (index == outMesh.joints.size()) {
+                if (index > 0xFFFF) continue; // joint index là uint16
+                outMesh.joints.push_back(joint);
+            }
+
+            for (unsigned int w = 0; w < bone->mNumWeights; w++) {
+                const aiVertexWeight& weight = bone->mWeights[w];
+                if (weight.mVertexId >= part.vertexCount || weight.mWeight <= 0.0f) continue;
+                VertexSkin& skin = outMesh.skin[part.baseVertex + weight.mVertexId];
+                // LimitBoneWeights đã cắt còn 4; phòng hờ thì thay influence nhỏ nhất
+                unsigned int slot = 0;
+                for (unsigned int k = 1; k < kMaxVertexInfluences; k++)
+                    if (skin.weights[k] < skin.weights[slot]) slot = k;
+                if (skin.weights[slot] >= weight.mWeight) continue;
+                skin.joints[slot] = (uint16_t)index;
+                skin.weights[slot] = weight.mWeight;
+            }
+        }
+
+        for (unsigned int v = 0; v < part.vertexCount; v++) {
+            VertexSkin& skin = outMesh.skin[part.baseVertex + v];
+            float sum = skin.weights[0] + skin.weights[1] + skin.weights[2] + skin.weights[3];
+            if (sum > 0.0f)
+                for (float& weight : skin.weights) weight /= sum;
+        }
+        part.skinned = 1;
+    }
+}
+
+// aiAnimation -> clip / channel / key; thời gian đổi từ tick sang giây.
+// Channel trỏ tới node không có trong hierarchy bị bỏ.
+static void ImportAnimations(const aiScene* scene, const NodeNameMap& names, MeshData& outMesh) {
+    if (outMesh.nodes.empty()) return;
+    for (unsigned int a = 0; a < scene->mNumAnimations; a++) {
+        const aiAnimation* animation = scene->mAnimations[a];
+        const double ticksPerSecond = animation->mTicksPerSecond > 0.0 ? animation->mTicksPerSecond : 25.0;
+
+        AnimationClip clip;
+        std::memset(&clip, 0, sizeof(clip));
+        std::snprintf(clip.name, sizeof(clip.name), "%.*s", (int)sizeof(clip.name) - 1,
+                      animation->mName.length ? animation->mName.C_Str() : ("clip " + std::to_string(a)).c_str());
+        clip.duration = (float)(animation->mDuration / ticksPerSecond);
+        clip.firstChannel = (uint32_t)outMesh.channels.size();
+
+        for (unsigned int c = 0; c < animation->mNumChannels; c++) {
+            const aiNodeAnim* source = animation->mChannels[c];
+            auto found = names.find(source->mNodeName.C_Str());
+            if (found == names.end()) continue;
+
+            AnimationChannel channel;
+            channel.node = found->second;
+            auto appendKey = [&](double time, float x, float y, float z, float w) {
+                AnimationKey key;
+                key.time = (float)(time / ticksPerSecond);
+                key.value[0] = x; key.value[1] = y; key.value[2] = z; key.value[3] = w;
+                outMesh.keys.push_back(key);
+            };
+
+            channel.firstKey[kTrackTranslation] = (uint32_t)outMesh.keys.size();
+            channel.keyCount[kTrackTranslation] = source->mNumPositionKeys;
+            for (unsigned int k = 0; k < source->mNumPositionKeys; k++) {
+                const aiVectorKey& key = source->mPositionKeys[k];
+                appendKey(key.mTime, key.mValue.x, key.mValue.y, key.mValue.z, 0.0f);
+            }
+            channel.firstKey[kTrackRotation] = (uint32_t)outMesh.keys.size();
+            channel.keyCount[kTrackRotation] = source->mNumRotationKeys;
+            for (unsigned int k = 0; k < source->mNumRotationKeys; k++) {
+                const aiQuatKey& key = source->mRotationKeys[k];
+                appendKey(key.mTime, key.mValue.x, key.mValue.y, key.mValue.z, key.mValue.w);
+            }
+            channel.firstKey[kTrackScale] = (uint32_t)outMesh.keys.size();
+            channel.keyCount[kTrackScale] = source->mNumScalingKeys;
+            for (unsigned int k = 0; k < source->mNumScalingKeys; k++) {
+                const aiVectorKey& key = source->mScalingKeys[k];
+                appendKey(key.mTime, key.mValue.x, key.mValue.y, key.mValue.z, 0.0f);
+            }
+            outMesh.channels.push_back(channel);
+        }
+
+        clip.channelCount = (uint32_t)outMesh.channels.size() - clip.firstChannel;
+        if (clip.channelCount > 0) outMesh.clips.push_back(clip);
+    }
+}
+
+// ReadFile chiếm phần lớn thời gian, phần chuyển đổi mesh là 10% cuối
+static const float kReadFileProgress = 0.9f;
+
+class ImportProgressHandler : public Assimp::ProgressHandler {
+public:
+    explicit ImportProgressHandler(const ImportProgressFn& fn) : m_Fn(fn) {}
+    bool Update(float percentage) override {
+        return percentage < 0.0f ? m_Fn(-1.0f) : m_Fn(percentage * kReadFileProgress);
+    }
+private:
+    ImportProgressFn m_Fn;
+};
+
+bool ImportModel(const char* path, unsigned int importFlags, MeshData& outMesh, std::string* outError,
+                 const ImportProgressFn& progress) {
+    Assimp::Importer importer;
+    // Importer sở hữu và tự delete handler
+    if (progress) importer.SetProgressHandler(new ImportProgressHandler(progress));
+    const aiScene* scene = nullptr;
+    bool flattened = false;
+    {
+        // PreTransformVertices bỏ mất xương và animation: chỉ áp dụng sau khi biết scene tĩnh,
+        // model có animation luôn giữ hierarchy (cùng flags -> cùng kết quả, cache key vẫn đúng)
+        PROFILE_SCOPE("Assimp ReadFile");
+        scene = importer.ReadFile(path, importFlags & ~aiProcess_PreTransformVertices);
+        if (scene && (importFlags & aiProcess_PreTransformVertices)) {
+            bool animated = scene->mNumAnimations > 0;
+            for (unsigned int i = 0; i < scene->mNumMeshes && !animated; i++) animated = scene->mMeshes[i]->mNumBones > 0;
+            if (!animated) {
+                scene = importer.ApplyPostProcessing(aiProcess_PreTransformVertices);
+                flattened = true;
+            }
+        }
+    }
+
+    if(!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) {
+        if (outError) *outError = importer.GetErrorString();
+        return false;
+    }
+
+    outMesh.nodes.clear();
+    outMesh.meshRefs.clear();
+    outMesh.textures.clear();
+    outMesh.textureData.clear();
+    outMesh.textureFiles.clear();
+    outMesh.skin.clear();
+    outMesh.joints.clear();
+    outMesh.clips.clear();
+    outMesh.channels.clear();
+    outMesh.keys.clear();
+
+    // Scene chưa bị PreTransformVertices: mỗi aiMesh giữ một bản, node graph quyết định instance
+    NodeNameMap nodeNames;
+    if (!flattened) AppendSceneNode(scene->mRootNode, -1, outMesh, nodeNames);
+
+    if (progress && !progress(kReadFileProgress)) {
+        if (outError) *outError = "Import cancelled";
+        return false;
+    }
+
+    if (!ConvertMeshes(scene->mMeshes, scene->mNumMeshes, outMesh, JobSystem::Global(), progress)) {
+        if (outError) *outError = "Import cancelled";
+        return false;
+    }
+
+    for (unsigned int i = 0; i < scene->mNumMeshes; i++) {
+        aiMaterial* material = scene->mMaterials[scene->mMeshes[i]->mMaterialIndex];
+        aiColor4D color(0.8f, 0.8f, 0.8f, 1.0f);
+        if (AI_SUCCESS != aiGetMaterialColor(material, AI_MATKEY_BASE_COLOR, &color))
+            aiGetMaterialColor(material, AI_MATKEY_COLOR_DIFFUSE, &color);
+
+        MeshPart& part = outMesh.parts[i];
+        part.color[0] = color.r; part.color[1] = color.g; part.color[2] = color.b; part.color[3] = color.a;
+    }
+
+    ImportSkins(scene, nodeNames, outMesh);
+    ImportAnimations(scene, nodeNames, outMesh);
+    ImportTextures(scene, path, outMesh, JobSystem::Global());
+    return true;
+}
+
+bool ConvertMeshes(const aiMesh* const* meshes, unsigned int meshCount, MeshData& outMesh, JobSystem& jobs,
+                   const ImportProgressFn& progress) {
+    PROFILE_SCOPE("Convert Meshes");
+    // 1. Đếm tam giác hợp lệ (bỏ point/line còn sót sau Triangulate), song song theo mesh
+    std::vector<size_t> vertexOffsets(meshCount + 1, 0), indexOffsets(meshCount + 1, 0);
+    jobs.ParallelFor(meshCount, 64, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            const aiMesh* mesh = meshes[i];
+            size_t triangles = 0;
+            for (unsigned int j = 0; j < mesh->mNumFaces; j++) triangles += mesh->mFaces[j].mNumIndices == 3;
+            vertexOffsets[i + 1] = mesh->mNumVertices;
+            indexOffsets[i + 1] = triangles * 3;
+        }
+    });
+
+    // 2. Prefix sum -> vị trí của từng mesh trong buffer chung
+    for (unsigned int i = 0; i < meshCount; i++) {
+        vertexOffsets[i + 1] += vertexOffsets[i];
+        indexOffsets[i + 1] += indexOffsets[i];
+    }
+
+    // 3. Cấp phát một lần, mỗi mesh điền đúng khoảng của mình
+    outMesh.vertices.resize(vertexOffsets[meshCount] * kVertexFloatCount);
+    outMesh.indices.resize(indexOffsets[meshCount] * sizeof(unsigned int));
+    outMesh.parts.assign(meshCount, MeshPart());
+    float* vertices = outMesh.vertices.data();
+    unsigned char* indexBytes = outMesh.indices.data();
+
+    // Tiến độ + huỷ hỏi sau mỗi mesh (callback của loader an toàn khi gọi từ nhiều thread)
+    std::atomic<bool> cancelled{ false };
+    std::atomic<unsigned int> converted{ 0 };
+    jobs.ParallelFor(meshCount, 16, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            if (cancelled.load(std::memory_order_relaxed)) return;
+            const aiMesh* mesh = meshes[i];
+            float* dstVertices = vertices + vertexOffsets[i] * kVertexFloatCount;
+            const aiVector3D* uvs = mesh->mTextureCoords[0]; // không có UV -> (0, 0)
+            for (unsigned int j = 0; j < mesh->mNumVertices; j++) {
+                dstVertices[j * kVertexFloatCount + 0] = mesh->mVertices[j].x;
+                dstVertices[j * kVertexFloatCount + 1] = mesh->mVertices[j].y;
+                dstVertices[j * kVertexFloatCount + 2] = mesh->mVertices[j].z;
+                dstVertices[j * kVertexFloatCount + 3] = uvs ? uvs[j].x : 0.0f;
+                dstVertices[j * kVertexFloatCount + 4] = uvs ? uvs[j].y : 0.0f;
+            }
+
+            unsigned char* dstIndices = indexBytes + indexOffsets[i] * sizeof(unsigned int);
+            for (unsigned int j = 0; j < mesh->mNumFaces; j++) {
+                const aiFace& face = mesh->mFaces[j];
+                if (face.mNumIndices != 3) continue;
+                std::memcpy(dstIndices, face.mIndices, 3 * sizeof(unsigned int));
+                dstIndices += 3 * sizeof(unsigned int);
+            }
+
+            // Index local theo part, 32-bit; MeshOptimizer sẽ thu gọn sau
+            MeshPart& part = outMesh.parts[i];
+            part.indexOffset = (unsigned int)(indexOffsets[i] * sizeof(unsigned int));
+            part.indexCount = (unsigned int)(indexOffsets[i + 1] - indexOffsets[i]);
+            part.baseVertex = (unsigned int)vertexOffsets[i];
+            part.vertexCount = mesh->mNumVertices;
+            part.indexSize = sizeof(unsigned int);
+            part.color[0] = part.color[1] = part.color[2] = 0.8f;
+            part.color[3] = 1.0f;
+            part.textureIndex = -1;
+            part.skinned = 0;
+
+            const unsigned int done = converted.fetch_add(1, std::memory_order_relaxed) + 1;
+            if (progress && !progress(kReadFileProgress + (1.0f - kReadFileProgress) * (float)done / (float)meshCount))
+                cancelled.store(true, std::memory_order_relaxed);
+        }
+    });
+    return !cancelled.load();
+}
+
+bool LoadModelAsset(const char* path, unsigned int importFlags, ModelAsset& outAsset, bool useCache,
+                    const ImportProgressFn& progress, std::string* outError) {
+    auto start = std::chrono::steady_clock::now();
+    auto elapsedMs = [&start]() {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    outAsset.cache.Close();
+    outAsset.imported = MeshData();
+    outAsset.optimizeStats.clear();
+    outAsset.fromCache = false;
+
+    MeshCacheKey key;
+    bool hasKey = useCache && MakeMeshCacheKey(path, importFlags, key);
+    std::string cachePath = MeshCachePath(path, importFlags);
+
+    bool cached = false;
+    {
+        PROFILE_SCOPE("Map Mesh Cache");
+        cached = hasKey && outAsset.cache.Open(cachePath, &key);
+    }
+    if (cached) {
+        outAsset.fromCache = true;
+        outAsset.loadMs = elapsedMs();
+        return true;
+    }
+
+    std::string error;
+    MeshData raw;
+    if (!ImportModel(path, importFlags, raw, &error, progress)) {
+        std::cerr << "ERROR::ASSIMP::" << error << std::endl;
+        if (outError) *outError = error;
+        return false;
+    }
+    {
+        PROFILE_SCOPE("Optimize Mesh");
+        auto cancelled = [&progress]() { return progress && !progress(-1.0f); };
+        if (!OptimizeMesh(raw, outAsset.imported, &outAsset.optimizeStats, LodSettings(), JobSystem::Global(),
+                          cancelled)) {
+            outAsset.imported = MeshData();
+            if (outError) *outError = "Import cancelled";
+            return false;
+        }
+    }
+    outAsset.loadMs = elapsedMs();
+
+    // Cache hỏng/không ghi được thì vẫn dùng dữ liệu vừa import
+    if (hasKey) {
+        PROFILE_SCOPE("Write Mesh Cache");
+        WriteMeshCache(cachePath, key, outAsset.imported.View(), outAsset.imported.textureFiles);
+    }
+    return true;
+}
@@ -0,0 +1,130 @@
+#include "ModelSubmit.h"
+
+#include <cstddef>
+
+ProgramBindings ModelProgramBindings() {
+    ProgramBindings bindings;
+    bindings.samplers = {
+        { "u_Materials", (int)kUnitMaterials },
+        { "u_Instances", (int)kUnitInstances },
+        { "u_InstanceIndices", (int)kUnitInstanceIndices },
+        { "u_BaseColor", (int)kUnitBaseColor },
+        { "u_Palette", (int)kUnitPalette },
+        { "u_PartDecode", (int)kUnitPartDecode },
+    };
+    bindings.blocks = { { "Camera", kCameraBlockBinding } };
+    return bindings;
+}
+
+bool ModelUniforms::Resolve(const ProgramReflection& program, std::string& error) {
+    static const UniformBlockMember kCameraLayout[] = {
+        { "u_Projection", (int)offsetof(CameraBlock, projection) },
+        { "u_View", (int)offsetof(CameraBlock, view) },
+        { "u_Model", (int)offsetof(CameraBlock, model) },
+    };
+    *this = ModelUniforms();
+    if (!ValidateBlockLayout(program, "Camera", kCameraLayout, 3, sizeof(CameraBlock), error)) return false;
+    serial = program.serial;
+    color = program.Location("u_Color");
+    useMaterials = program.Location("u_UseMaterials");
+    instanceBase = program.Location("u_InstanceBase");
+    hasTexture = program.Location("u_HasTexture");
+    gpuSkinning = program.Location("u_GpuSkinning");
+    quantizedPositions = program.Location("u_QuantizedPositions");
+    return true;
+}
+
+int SubmitModel(RenderDevice& device, const ModelSubmitInput& in) {
+    const ModelUniforms& u = *in.uniforms;
+    device.UseProgram(*in.program);
+    device.BindUniformBuffer(kCameraBlockBinding, in.cameraBuffer);
+    device.UpdateUniformBuffer(in.cameraBuffer, in.camera, sizeof(CameraBlock));
+
+    device.BindVertexArray(in.modelVAO);
+    device.SetPolygonMode(in.wireframe ? PolygonMode::Line : PolygonMode::Fill);
+    device.BindTexture(kUnitMaterials, TextureTarget::Buffer, in.materialTexture);
+    device.BindTexture(kUnitInstances, TextureTarget::Buffer, in.instanceTexture);
+    device.BindTexture(kUnitInstanceIndices, TextureTarget::Buffer, in.instanceIndexTexture);
+    device.BindTexture(kUnitPalette, TextureTarget::Buffer, in.gpuSkinning ? in.paletteTexture : 0);
+    device.BindTexture(kUnitPartDecode, TextureTarget::Buffer, in.partDecodeTexture);
+    device.SetUniform(u.gpuSkinning, in.gpuSkinning ? 1 : 0);
+    device.SetUniform(u.quantizedPositions, in.quantizedPositions ? 1 : 0);
+    int drawCalls = 0;
+
+    // Texture ở unit 3; device bỏ bind trùng, u_HasTexture theo sau. Override color bỏ qua texture.
+    auto BindTexture = [&](int texture) {
+        unsigned int handle = 0;
+        if (!in.useOverrideColor && texture >= 0 && (size_t)texture < in.textureCount) handle = in.textureHandles[texture];
+        device.BindTexture(kUnitBaseColor, TextureTarget::Texture2D, handle);
+        device.SetUniform(u.hasTexture, handle != 0 ? 1 : 0);
+    };
+    // CPU skinning: part skinned đọc VAO stream riêng, base vertex theo mảng đã gom
+    auto BindPartVertices = [&](size_t p) -> int {
+        const bool streamed = in.cpuSkinning && in.skinnedVAO && in.skinnedBase[p] != ~0u;
+        device.BindVertexArray(streamed ? in.skinnedVAO : in.modelVAO);
+        // Stream CPU skinning luôn là float (vị trí đã skin có thể ra ngoài AABB bind pose)
+        device.SetUniform(u.quantizedPositions, !streamed && in.quantizedPositions ? 1 : 0);
+        return (int)(streamed ? in.skinnedBase[p] : in.parts[p].baseVertex);
+    };
+    const float overrideColor[4] = { in.overrideColor[0], in.overrideColor[1], in.overrideColor[2], 1.0f };
+
+    if (in.batched) {
+        device.SetUniform(u.useMaterials, in.useOverrideColor ? 0 : 1);
+        device.SetUniform(u.color, overrideColor);
+
+        if (in.flattened) {
+            // Mỗi state (kiểu index) một lần gọi, chỉ chứa part visible; mọi instance đều identity
+            device.SetUniform(u.instanceBase, 0);
+            for (size_t b = 0; b < in.drawList->CallCount(); b++) {
+                const DrawBatch& batch = in.drawList->batches[b];
+                BindTexture(batch.texture);
+                device.MultiDrawElements(batch.indexSize, batch.counts.data(), batch.offsets.data(),
+                                         batch.baseVertices.data(), (int)batch.DrawCount());
+                drawCalls++;
+            }
+        } else {
+            // Mỗi (mesh, LOD) một lần gọi instanced, chỉ gồm instance visible
+            for (size_t p = 0; p < in.partCount; p++) {
+                const MeshPart& part = in.parts[p];
+                for (unsigned int lod = 0; lod < PartLodCount(part); lod++) {
+                    const size_t group = p * kMaxMeshLods + lod;
+                    unsigned int instanceCount = in.visibleOffset[group + 1] - in.visibleOffset[group];
+                    MeshLod level = PartLod(part, lod);
+                    if (instanceCount == 0 || level.indexCount == 0) continue;
+
+                    BindTexture(part.textureIndex);
+                    int baseVertex = BindPartVertices(p);
+                    device.SetUniform(u.instanceBase, (int)in.visibleOffset[group]);
+                    device.DrawElements(part.indexSize, (int)level.indexCount, level.indexOffset, baseVertex,
+                                        instanceCount);
+                    drawCalls++;
+                }
+            }
+        }
+    } else {
+        // Path cũ: một uniform + một draw call cho mỗi part / instance (để so sánh A/B)
+        device.SetUniform(u.useMaterials, 0);
+        for (size_t p = 0; p < in.partCount; p++) {
+            const MeshPart& part = in.parts[p];
+            const size_t first = in.visibleOffset[p * kMaxMeshLods], end = in.visibleOffset[(p + 1) * kMaxMeshLods];
+            if (first == end) continue;
+            device.SetUniform(u.color, in.useOverrideColor ? overrideColor : part.color);
+            BindTexture(part.textureIndex);
+            int baseVertex = BindPartVertices(p);
+
+            for (unsigned int lod = 0; lod < PartLodCount(part); lod++) {
+                const size_t group = p * kMaxMeshLods + lod;
+                MeshLod level = PartLod(part, lod);
+                for (unsigned int i = in.visibleOffset[group]; i < in.visibleOffset[group + 1]; i++) {
+                    device.SetUniform(u.instanceBase, (int)i);
+                    device.DrawElements(part.indexSize, (int)level.indexCount, level.indexOffset, baseVertex);
+                    drawCalls++;
+                }
+            }
+        }
+    }
+    device.BindTexture(kUnitBaseColor, TextureTarget::Texture2D, 0);
+    device.BindTexture(kUnitPalette, TextureTarget::Buffer, 0);
+    device.EndFrame();
+    return drawCalls;
+}
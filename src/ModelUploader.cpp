@@ -0,0 +1,200 @@
+#include "ModelUploader.h"
+#include "DrawBatch.h"
+#include "Profiler.h"
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+ModelUploader::~ModelUploader() { Abort(); }
+
+void ModelUploader::Begin(const MeshView& mesh, float headroom, VertexFormat format) {
+    Abort();
+    m_Mesh = mesh;
+    m_Headroom = headroom;
+    m_Format = format;
+    m_Uploaded = 0;
+    m_Active = true;
+
+    m_DrawIDSize = BuildVertexDrawIDs(mesh.parts, mesh.partCount, mesh.vertexCount, m_DrawIDs);
+    const unsigned char* vertexData = static_cast<const unsigned char*>(mesh.vertexData);
+    if (format == VertexFormat::Quantized) {
+        QuantizeMesh(mesh, m_Quantized);
+        vertexData = reinterpret_cast<const unsigned char*>(m_Quantized.data());
+    }
+    const unsigned int stride = VertexFormatStride(format);
+
+    glGenVertexArrays(1, &m_VAO);
+    glGenBuffers(1, &m_VBO);
+    glGenBuffers(1, &m_DrawIDVBO);
+    glGenBuffers(1, &m_EBO);
+
+    // Cùng số vertex dư cho mọi stream theo vertex; index dư tính theo byte, căn 4
+    const size_t vertexCapacity = mesh.vertexCount + (size_t)((double)mesh.vertexCount * headroom);
+    const size_t indexCapacity = ((mesh.IndexBytes() + (size_t)((double)mesh.IndexBytes() * headroom)) + 3) / 4 * 4;
+    m_Segments = {
+        { GL_ARRAY_BUFFER, m_VBO, vertexData, mesh.vertexCount * stride, vertexCapacity * stride },
+        { GL_ARRAY_BUFFER, m_DrawIDVBO, m_DrawIDs.data(), m_DrawIDs.size(), vertexCapacity * m_DrawIDSize },
+        { GL_ELEMENT_ARRAY_BUFFER, m_EBO, static_cast<const unsigned char*>(mesh.indexData), mesh.IndexBytes(),
+          indexCapacity },
+    };
+    if (mesh.skin) {
+        glGenBuffers(1, &m_SkinVBO);
+        m_Segments.push_back({ GL_ARRAY_BUFFER, m_SkinVBO, reinterpret_cast<const unsigned char*>(mesh.skin),
+                               mesh.vertexCount * sizeof(VertexSkin), vertexCapacity * sizeof(VertexSkin) });
+    }
+
+    // Chỉ cấp phát, dữ liệu đổ dần bằng glBufferSubData.
+    // EBO gắn với VAO nên bind VAO mới trước, tránh đè lên EBO của model đang vẽ.
+    glBindVertexArray(m_VAO);
+    m_TotalBytes = 0;
+    for (const Segment& segment : m_Segments) {
+        glBindBuffer(segment.target, segment.buffer);
+        glBufferData(segment.target, segment.capacity, nullptr, GL_STATIC_DRAW);
+        m_TotalBytes += segment.size;
+    }
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+bool ModelUploader::Step(size_t byteBudget) {
+    if (!m_Active) return false;
+    PROFILE_SCOPE("Upload Step");
+
+    size_t budget = std::max<size_t>(byteBudget, 1);
+    size_t segmentStart = 0;
+
+    glBindVertexArray(m_VAO);
+    for (const Segment& segment : m_Segments) {
+        size_t segmentEnd = segmentStart + segment.size;
+        if (budget > 0 && m_Uploaded < segmentEnd) {
+            size_t offset = m_Uploaded - segmentStart;
+            size_t chunk = std::min(budget, segment.size - offset);
+            glBindBuffer(segment.target, segment.buffer);
+            glBufferSubData(segment.target, offset, chunk, segment.data + offset);
+            m_Uploaded += chunk;
+            budget -= chunk;
+        }
+        segmentStart = segmentEnd;
+    }
+
+    bool complete = m_Uploaded == m_TotalBytes;
+    if (complete) {
+        glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+        if (m_Format == VertexFormat::Quantized) {
+            // unorm16 -> [0, 1], shader nhân với extent của part; UV half đọc thẳng thành float
+            glVertexAttribPointer(0, 3, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(QuantizedVertex),
+                                  (void*)offsetof(QuantizedVertex, position));
+            glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, sizeof(QuantizedVertex), (void*)offsetof(QuantizedVertex, uv));
+        } else {
+            glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, kVertexStride, (void*)0);
+            glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, kVertexStride, (void*)(3 * sizeof(float)));
+        }
+        glEnableVertexAttribArray(0);
+        glEnableVertexAttribArray(2);
+
+        glBindBuffer(GL_ARRAY_BUFFER, m_DrawIDVBO);
+        glVertexAttribIPointer(1, 1, m_DrawIDSize == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, m_DrawIDSize, (void*)0);
+        glEnableVertexAttribArray(1);
+
+        // Không có skin: attrib 3/4 tắt, shader đọc giá trị mặc định (weight 0 do app đặt)
+        if (m_SkinVBO) {
+            glBindBuffer(GL_ARRAY_BUFFER, m_SkinVBO);
+            glVertexAttribIPointer(3, 4, GL_UNSIGNED_SHORT, sizeof(VertexSkin), (void*)offsetof(VertexSkin, joints));
+            glEnableVertexAttribArray(3);
+            glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, sizeof(VertexSkin), (void*)offsetof(VertexSkin, weights));
+            glEnableVertexAttribArray(4);
+        }
+    }
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return complete;
+}
+
+void ModelUploader::DeleteObjects() {
+    if (m_VAO) glDeleteVertexArrays(1, &m_VAO);
+    if (m_VBO) glDeleteBuffers(1, &m_VBO);
+    if (m_DrawIDVBO) glDeleteBuffers(1, &m_DrawIDVBO);
+    if (m_SkinVBO) glDeleteBuffers(1, &m_SkinVBO);
+    if (m_EBO) glDeleteBuffers(1, &m_EBO);
+    m_VAO = m_VBO = m_DrawIDVBO = m_SkinVBO = m_EBO = 0;
+}
+
+void ModelUploader::Abort() {
+    DeleteObjects();
+    m_Mesh = MeshView();
+    m_Segments.clear();
+    m_DrawIDs.clear();
+    m_Quantized.clear();
+    m_Uploaded = m_TotalBytes = 0;
+    m_Active = false;
+}
+
+void ModelUploader::Release(Result& out) {
+    out.vao = m_VAO;
+    out.vbo = m_VBO;
+    out.drawIDVBO = m_DrawIDVBO;
+    out.skinVBO = m_SkinVBO;
+    out.ebo = m_EBO;
+    out.parts.assign(m_Mesh.parts, m_Mesh.parts + m_Mesh.partCount);
+    out.vertexCapacity = m_Segments.empty() ? 0 : m_Segments[0].capacity / VertexFormatStride(m_Format);
+    out.indexCapacity = m_Segments.size() < 3 ? 0 : m_Segments[2].capacity;
+    out.drawIDSize = m_DrawIDSize;
+    out.vertexFormat = m_Format;
+    m_VAO = m_VBO = m_DrawIDVBO = m_SkinVBO = m_EBO = 0;
+    Abort();
+}
+
+void UploadReloadPlan(const MeshView& mesh, const MeshReloadPlan& plan, unsigned int drawIDSize, VertexFormat format,
+                      unsigned int vbo, unsigned int drawIDVBO, unsigned int skinVBO, unsigned int ebo) {
+    PROFILE_SCOPE("Upload Reload Ranges");
+    const unsigned char* vertices = static_cast<const unsigned char*>(mesh.vertexData);
+    const unsigned char* indices = static_cast<const unsigned char*>(mesh.indexData);
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, vbo);
+    std::vector<QuantizedVertex> quantized;
+    for (const MeshReloadPlan::Copy& copy : plan.vertexCopies) {
+        if (format == VertexFormat::Quantized) {
+            // Bounds của part mới = bounds của chính các vertex này (hằng số giải cũng lấy từ bảng part mới)
+            quantized.resize(copy.count);
+            QuantizeVertices(reinterpret_cast<const float*>(vertices + copy.source * kVertexStride), copy.count,
+                             plan.parts[copy.part], quantized.data());
+            glBufferSubData(GL_COPY_WRITE_BUFFER, copy.dest * sizeof(QuantizedVertex), copy.count * sizeof(QuantizedVertex),
+                            quantized.data());
+        } else {
+            glBufferSubData(GL_COPY_WRITE_BUFFER, copy.dest * kVertexStride, copy.count * kVertexStride,
+                            vertices + copy.source * kVertexStride);
+        }
+    }
+    if (skinVBO && mesh.skin) {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, skinVBO);
+        for (const MeshReloadPlan::Copy& copy : plan.vertexCopies)
+            glBufferSubData(GL_COPY_WRITE_BUFFER, copy.dest * sizeof(VertexSkin), copy.count * sizeof(VertexSkin),
+                            mesh.skin + copy.source);
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, ebo);
+    for (const MeshReloadPlan::Copy& copy : plan.indexCopies)
+        glBufferSubData(GL_COPY_WRITE_BUFFER, copy.dest, copy.count, indices + copy.source);
+
+    // Draw ID = chỉ số part mới, ghi cho part mới / dời chỗ / đổi chỉ số
+    std::vector<unsigned char> ids;
+    glBindBuffer(GL_COPY_WRITE_BUFFER, drawIDVBO);
+    for (unsigned int p : plan.drawIDParts) {
+        const MeshPart& part = plan.parts[p];
+        ids.resize((size_t)part.vertexCount * drawIDSize);
+        for (size_t v = 0; v < part.vertexCount; v++) {
+            if (drawIDSize == 2) {
+                uint16_t id = (uint16_t)p;
+                std::memcpy(&ids[v * 2], &id, 2);
+            } else {
+                uint32_t id = p;
+                std::memcpy(&ids[v * 4], &id, 4);
+            }
+        }
+        glBufferSubData(GL_COPY_WRITE_BUFFER, (size_t)part.baseVertex * drawIDSize, ids.size(), ids.data());
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
@@ -0,0 +1,217 @@
+#include "Profiler.h"
+
+#if APP_PROFILER
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+
+// Track riêng cho zone GPU trên trace; thread CPU đánh số từ 1
+static const unsigned int kGpuTrack = 0;
+
+Profiler& Profiler::Get() {
+    static Profiler* instance = new Profiler();
+    return *instance;
+}
+
+uint64_t Profiler::NowNs() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+Profiler::ThreadLogHandle::~ThreadLogHandle() {
+    if (log) log->retired.store(true, std::memory_order_release);
+}
+
+Profiler::ThreadLog& Profiler::CurrentLog() {
+    static thread_local ThreadLogHandle handle;
+    if (!handle.log) {
+        Profiler& profiler = Get();
+        std::lock_guard<std::mutex> lock(profiler.m_ThreadsMutex);
+        profiler.m_Threads.push_back(std::make_unique<ThreadLog>());
+        ThreadLog* log = profiler.m_Threads.back().get();
+        log->id = profiler.m_NextThreadId++;
+        log->name = "Thread " + std::to_string(log->id);
+        handle.log = log;
+    }
+    return *handle.log;
+}
+
+void Profiler::SetThreadName(const char* name) {
+    ThreadLog& log = CurrentLog();
+    std::lock_guard<std::mutex> lock(Get().m_ThreadsMutex);
+    log.name = name;
+}
+
+void Profiler::BeginZone() {
+    CurrentLog().depth++;
+}
+
+void Profiler::EndZone(const char* name, uint64_t startNs) {
+    ThreadLog& log = CurrentLog();
+    log.depth--;
+    // Chỉ thread này ghi ring của nó: đánh dấu slot đang ghi, ghi, đóng sequence rồi mới công bố index
+    uint64_t index = log.writeIndex.load(std::memory_order_relaxed);
+    Slot& entry = log.slots[index % kRingSize];
+    entry.sequence.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    entry.event = { name, startNs, NowNs(), log.depth };
+    entry.sequence.store(2 * index + 2, std::memory_order_release);
+    log.writeIndex.store(index + 1, std::memory_order_release);
+}
+
+Profiler::ZoneStats& Profiler::Zone(const char* name, bool gpu) {
+    std::unique_ptr<ZoneStats>& zone = m_ZoneMap[name];
+    if (!zone) {
+        zone = std::make_unique<ZoneStats>();
+        zone->name = name;
+        zone->gpu = gpu;
+        m_ZoneOrder.push_back(zone.get());
+    }
+    return *zone;
+}
+
+void Profiler::AddGpuZone(const char* name, uint64_t cpuStartNs, double ms) {
+    // Zone tra theo con trỏ tên chung với CPU: đặt tên khác zone CPU (vd. "GPU Scene")
+    ZoneStats& zone = Zone(name, true);
+    zone.history[m_HistoryCursor] += (float)ms;
+    zone.pendingCalls++;
+    m_GpuMs[m_HistoryCursor] += (float)ms;
+
+    if (IsCapturing()) {
+        Event event = { name, cpuStartNs, cpuStartNs + (uint64_t)(ms * 1e6), 0 };
+        m_CaptureEvents.push_back({ event, kGpuTrack });
+    }
+}
+
+void Profiler::EndFrame() {
+    const size_t slot = m_HistoryCursor;
+    uint64_t now = NowNs();
+    m_FrameMs[slot] = m_LastFrameNs ? (float)((double)(now - m_LastFrameNs) * 1e-6) : 0.0f;
+    m_LastFrameNs = now;
+
+    {
+        std::lock_guard<std::mutex> lock(m_ThreadsMutex);
+        for (size_t t = 0; t < m_Threads.size();) {
+            ThreadLog* log = m_Threads[t].get();
+            // Đọc cờ trước writeIndex: thread đã thoát thì mọi event của nó đều nằm dưới write
+            const bool retired = log->retired.load(std::memory_order_acquire);
+            uint64_t write = log->writeIndex.load(std::memory_order_acquire);
+            uint64_t begin = log->readIndex;
+            // Thread ghi nhanh hơn frame gom; slot write % kRingSize là slot thread kia ghi tiếp
+            if (write - begin >= kRingSize) begin = write - kRingSize + 1;
+
+            for (uint64_t i = begin; i < write; i++) {
+                // Seqlock: sequence phải là của event i cả trước lẫn sau khi copy, nếu không slot đã bị
+                // event i + kRingSize (hoặc sau nữa) ghi đè trong lúc đọc
+                const Slot& entry = log->slots[i % kRingSize];
+                const uint64_t expected = 2 * i + 2;
+                if (entry.sequence.load(std::memory_order_acquire) != expected) {
+                    m_Dropped++;
+                    continue;
+                }
+                const Event event = entry.event;
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (entry.sequence.load(std::memory_order_relaxed) != expected) {
+                    m_Dropped++;
+                    continue;
+                }
+
+                ZoneStats& zone = Zone(event.name, false);
+                zone.history[slot] += (float)((double)(event.endNs - event.startNs) * 1e-6);
+                zone.pendingCalls++;
+                if (IsCapturing()) m_CaptureEvents.push_back({ event, log->id });
+            }
+            m_Dropped += begin - log->readIndex;
+            log->readIndex = write;
+
+            // Ring ~640 KB mỗi thread: thread đã thoát (loader, pool tạm) không giữ lại
+            if (retired) {
+                if (IsCapturing()) m_RetiredThreads.push_back({ log->id, log->name });
+                m_Threads.erase(m_Threads.begin() + (std::ptrdiff_t)t);
+            } else {
+                t++;
+            }
+        }
+    }
+
+    if (IsCapturing() && --m_CaptureFramesLeft == 0) WriteCapture();
+
+    // Sang frame mới: xoá slot kế tiếp trước khi GPU / CPU cộng dồn vào
+    m_HistoryCursor = (slot + 1) % kHistoryFrames;
+    m_GpuMs[m_HistoryCursor] = 0.0f;
+    for (auto& entry : m_ZoneMap) {
+        ZoneStats& zone = *entry.second;
+        zone.history[m_HistoryCursor] = 0.0f;
+        zone.lastCalls = zone.pendingCalls;
+        zone.pendingCalls = 0;
+    }
+}
+
+void Profiler::StartCapture(unsigned int frames, const std::string& path) {
+    if (frames == 0) return;
+    m_CaptureEvents.clear();
+    m_RetiredThreads.clear();
+    m_CaptureFrames = frames;
+    m_CaptureFramesLeft = frames;
+    m_CapturePath = path;
+    m_CaptureStatus = "Capturing " + std::to_string(frames) + " frames...";
+}
+
+static void WriteJsonString(FILE* f, const std::string& s) {
+    std::fputc('"', f);
+    for (char c : s) {
+        if (c == '"' || c == '\\') std::fputc('\\', f);
+        if ((unsigned char)c >= 0x20) std::fputc(c, f);
+    }
+    std::fputc('"', f);
+}
+
+void Profiler::WriteCapture() {
+    // Chrome trace-event JSON (chrome://tracing, ui.perfetto.dev): event "X" = có start + duration, đơn vị µs
+    FILE* f = std::fopen(m_CapturePath.c_str(), "w");
+    if (!f) {
+        m_CaptureStatus = "Cannot write " + m_CapturePath;
+        std::cerr << "Profiler: cannot write " << m_CapturePath << std::endl;
+        m_CaptureEvents.clear();
+        return;
+    }
+
+    uint64_t origin = UINT64_MAX;
+    for (const CapturedEvent& captured : m_CaptureEvents) origin = std::min(origin, captured.event.startNs);
+
+    std::fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    std::fprintf(f, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"GPU\"}}", kGpuTrack);
+    {
+        std::lock_guard<std::mutex> lock(m_ThreadsMutex);
+        for (const std::unique_ptr<ThreadLog>& log : m_Threads) {
+            std::fprintf(f, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", log->id);
+            WriteJsonString(f, log->name);
+            std::fprintf(f, "}}");
+        }
+        for (const auto& retired : m_RetiredThreads) {
+            std::fprintf(f, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", retired.first);
+            WriteJsonString(f, retired.second);
+            std::fprintf(f, "}}");
+        }
+        m_RetiredThreads.clear();
+    }
+    for (const CapturedEvent& captured : m_CaptureEvents) {
+        const Event& event = captured.event;
+        std::fprintf(f, ",\n{\"name\":");
+        WriteJsonString(f, event.name);
+        std::fprintf(f, ",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                     captured.thread == kGpuTrack ? "gpu" : "cpu", captured.thread,
+                     (double)(event.startNs - origin) * 1e-3, (double)(event.endNs - event.startNs) * 1e-3);
+    }
+    std::fprintf(f, "\n]}\n");
+    bool ok = std::fclose(f) == 0;
+
+    m_CaptureStatus = ok ? "Saved " + std::to_string(m_CaptureFrames) + " frames (" +
+                               std::to_string(m_CaptureEvents.size()) + " events) to " + m_CapturePath
+                         : "Error writing " + m_CapturePath;
+    m_CaptureEvents.clear();
+}
+
+#endif
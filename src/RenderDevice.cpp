@@ -0,0 +1,277 @@
+#include "RenderDevice.h"
+
+#include <atomic>
+#include <cstring>
+
+const char* GpuCallName(GpuCall call) {
+    static const char* kNames[kCallCount] = {
+        "UseProgram", "BindVertexArray", "PolygonMode", "ActiveTexture", "BindTexture", "Uniform",
+        "BindBufferBase", "BindBuffer", "BufferData", "BufferSubData", "Draw", "MultiDraw",
+    };
+    return call < kCallCount ? kNames[call] : "?";
+}
+
+uint32_t GpuCallCounts::Total() const {
+    uint32_t total = 0;
+    for (uint32_t count : calls) total += count;
+    return total;
+}
+
+void GpuCallCounts::Add(const GpuCallCounts& other) {
+    for (uint32_t i = 0; i < kCallCount; i++) calls[i] += other.calls[i];
+}
+
+// --- REFLECTION ---
+int ProgramReflection::Location(const char* name) const {
+    for (const UniformInfo& uniform : uniforms)
+        if (uniform.name == name) return uniform.location;
+    return -1;
+}
+
+const UniformBlockInfo* ProgramReflection::Block(const char* name) const {
+    for (const UniformBlockInfo& block : blocks)
+        if (block.name == name) return &block;
+    return nullptr;
+}
+
+uint64_t NextProgramSerial() {
+    static std::atomic<uint64_t> serial{ 0 };
+    return ++serial;
+}
+
+bool ValidateBlockLayout(const ProgramReflection& program, const char* block, const UniformBlockMember* expected,
+                         size_t expectedCount, size_t cppSize, std::string& error) {
+    const UniformBlockInfo* info = program.Block(block);
+    if (!info) {
+        error = std::string("uniform block ") + block + " not found";
+        return false;
+    }
+    if ((size_t)info->dataSize < cppSize) {
+        error = std::string("uniform block ") + block + " is " + std::to_string(info->dataSize) + " bytes, expected "
+                + std::to_string(cppSize);
+        return false;
+    }
+    for (size_t i = 0; i < expectedCount; i++) {
+        const UniformBlockMember* found = nullptr;
+        for (const UniformBlockMember& member : info->members)
+            if (member.name == expected[i].name) found = &member;
+        // Member không dùng có thể bị bỏ khi link: chỉ member còn lại phải đúng offset
+        if (found && found->offset != expected[i].offset) {
+            error = std::string(block) + "." + expected[i].name + " at offset " + std::to_string(found->offset)
+                    + ", expected " + std::to_string(expected[i].offset) + " (std140)";
+            return false;
+        }
+    }
+    return true;
+}
+
+// --- RECORDING BACKEND ---
+void RecordingBackend::UseProgram(unsigned int program) {
+    Record(kCallUseProgram);
+    if (m_Next) m_Next->UseProgram(program);
+}
+
+void RecordingBackend::BindVertexArray(unsigned int vao) {
+    Record(kCallBindVertexArray);
+    if (m_Next) m_Next->BindVertexArray(vao);
+}
+
+void RecordingBackend::SetPolygonMode(PolygonMode mode) {
+    Record(kCallPolygonMode);
+    if (m_Next) m_Next->SetPolygonMode(mode);
+}
+
+void RecordingBackend::ActiveTexture(unsigned int unit) {
+    Record(kCallActiveTexture);
+    if (m_Next) m_Next->ActiveTexture(unit);
+}
+
+void RecordingBackend::BindTexture(TextureTarget target, unsigned int texture) {
+    Record(kCallBindTexture);
+    if (m_Next) m_Next->BindTexture(target, texture);
+}
+
+void RecordingBackend::Uniform1i(int location, int value) {
+    Record(kCallUniform);
+    if (m_Next) m_Next->Uniform1i(location, value);
+}
+
+void RecordingBackend::Uniform4f(int location, const float value[4]) {
+    Record(kCallUniform);
+    if (m_Next) m_Next->Uniform4f(location, value);
+}
+
+void RecordingBackend::BindUniformBufferBase(unsigned int binding, unsigned int buffer) {
+    Record(kCallBindBufferBase);
+    if (m_Next) m_Next->BindUniformBufferBase(binding, buffer);
+}
+
+void RecordingBackend::BindUniformBuffer(unsigned int buffer) {
+    Record(kCallBindBuffer);
+    if (m_Next) m_Next->BindUniformBuffer(buffer);
+}
+
+void RecordingBackend::UniformBufferData(size_t size, const void* data) {
+    Record(kCallBufferData);
+    if (m_Next) m_Next->UniformBufferData(size, data);
+}
+
+void RecordingBackend::UniformBufferSubData(size_t offset, size_t size, const void* data) {
+    Record(kCallBufferSubData);
+    if (m_Next) m_Next->UniformBufferSubData(offset, size, data);
+}
+
+void RecordingBackend::DrawElements(unsigned int indexSize, int count, size_t indexOffset, int baseVertex,
+                                    unsigned int instanceCount) {
+    Record(kCallDraw);
+    if (m_Next) m_Next->DrawElements(indexSize, count, indexOffset, baseVertex, instanceCount);
+}
+
+void RecordingBackend::MultiDrawElements(unsigned int indexSize, const int* counts, const void* const* offsets,
+                                         const int* baseVertices, int drawCount) {
+    Record(kCallMultiDraw);
+    if (m_Next) m_Next->MultiDrawElements(indexSize, counts, offsets, baseVertices, drawCount);
+}
+
+// --- DEVICE ---
+void RenderDevice::Invalidate() {
+    m_Program = kUnknown;
+    m_ProgramCache = nullptr;
+    m_ProgramCaches.clear();
+    m_PolygonMode = 0xFF;
+    for (unsigned int& binding : m_UniformBindings) binding = kUnknown;
+    BeginFrame();
+}
+
+void RenderDevice::BeginFrame() {
+    m_VAO = kUnknown;
+    m_ActiveUnit = kUnknown;
+    for (auto& unit : m_Textures) unit[0] = unit[1] = kUnknown;
+    m_UniformBuffer = kUnknown;
+}
+
+void RenderDevice::EndFrame() {
+    BindVertexArray(0);
+    if (m_ActiveUnit != 0) {
+        m_ActiveUnit = 0;
+        m_Backend->ActiveTexture(0);
+    }
+}
+
+void RenderDevice::UseProgram(const ProgramReflection& program) {
+    if (program.program == m_Program && m_ProgramCache && m_ProgramCache->serial == program.serial) {
+        m_Skipped.calls[kCallUseProgram]++;
+        return;
+    }
+    // Program link lại (hot reload) có thể trùng id với program đã xoá: serial khác thì bỏ cache uniform cũ
+    ProgramCache& cache = m_ProgramCaches[program.program];
+    if (cache.serial != program.serial) {
+        cache.serial = program.serial;
+        cache.values.clear();
+    }
+    m_ProgramCache = &cache;
+    if (program.program == m_Program) {
+        m_Skipped.calls[kCallUseProgram]++;
+        return;
+    }
+    m_Program = program.program;
+    m_Backend->UseProgram(program.program);
+}
+
+void RenderDevice::BindVertexArray(unsigned int vao) {
+    if (vao == m_VAO) {
+        m_Skipped.calls[kCallBindVertexArray]++;
+        return;
+    }
+    m_VAO = vao;
+    m_Backend->BindVertexArray(vao);
+}
+
+void RenderDevice::SetPolygonMode(PolygonMode mode) {
+    if ((uint8_t)mode == m_PolygonMode) {
+        m_Skipped.calls[kCallPolygonMode]++;
+        return;
+    }
+    m_PolygonMode = (uint8_t)mode;
+    m_Backend->SetPolygonMode(mode);
+}
+
+void RenderDevice::BindTexture(unsigned int unit, TextureTarget target, unsigned int texture) {
+    unsigned int& bound = m_Textures[unit][(int)target];
+    if (bound == texture) {
+        m_Skipped.calls[kCallBindTexture]++;
+        return;
+    }
+    if (m_ActiveUnit != unit) {
+        m_ActiveUnit = unit;
+        m_Backend->ActiveTexture(unit);
+    }
+    bound = texture;
+    m_Backend->BindTexture(target, texture);
+}
+
+RenderDevice::UniformValue* RenderDevice::CachedUniform(int location) {
+    if (!m_ProgramCache) return nullptr;
+    std::vector<UniformValue>& values = m_ProgramCache->values;
+    if ((size_t)location >= values.size()) values.resize((size_t)location + 1);
+    return &values[location];
+}
+
+void RenderDevice::SetUniform(int location, int value) {
+    if (location < 0) return;
+    UniformValue* cached = CachedUniform(location);
+    if (cached && cached->kind == 1 && cached->i == value) {
+        m_Skipped.calls[kCallUniform]++;
+        return;
+    }
+    if (cached) {
+        cached->kind = 1;
+        cached->i = value;
+    }
+    m_Backend->Uniform1i(location, value);
+}
+
+void RenderDevice::SetUniform(int location, const float value[4]) {
+    if (location < 0) return;
+    UniformValue* cached = CachedUniform(location);
+    if (cached && cached->kind == 2 && std::memcmp(cached->f, value, sizeof(cached->f)) == 0) {
+        m_Skipped.calls[kCallUniform]++;
+        return;
+    }
+    if (cached) {
+        cached->kind = 2;
+        std::memcpy(cached->f, value, sizeof(cached->f));
+    }
+    m_Backend->Uniform4f(location, value);
+}
+
+void RenderDevice::BindUniformBuffer(unsigned int binding, unsigned int buffer) {
+    if (m_UniformBindings[binding] == buffer) {
+        m_Skipped.calls[kCallBindBufferBase]++;
+        return;
+    }
+    m_UniformBindings[binding] = buffer;
+    m_UniformBuffer = buffer; // glBindBufferBase đặt luôn binding generic
+    m_Backend->BindUniformBufferBase(binding, buffer);
+}
+
+void RenderDevice::UpdateUniformBuffer(unsigned int buffer, const void* data, size_t size) {
+    if (m_UniformBuffer != buffer) {
+        m_UniformBuffer = buffer;
+        m_Backend->BindUniformBuffer(buffer);
+    } else {
+        m_Skipped.calls[kCallBindBuffer]++;
+    }
+    m_Backend->UniformBufferData(size, nullptr);
+    m_Backend->UniformBufferSubData(0, size, data);
+}
+
+void RenderDevice::DrawElements(unsigned int indexSize, int count, size_t indexOffset, int baseVertex,
+                                unsigned int instanceCount) {
+    m_Backend->DrawElements(indexSize, count, indexOffset, baseVertex, instanceCount);
+}
+
+void RenderDevice::MultiDrawElements(unsigned int indexSize, const int* counts, const void* const* offsets,
+                                     const int* baseVertices, int drawCount) {
+    m_Backend->MultiDrawElements(indexSize, counts, offsets, baseVertices, drawCount);
+}
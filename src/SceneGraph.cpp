@@ -0,0 +1,140 @@
+#include "SceneGraph.h"
+
+#include <glm/gtc/type_ptr.hpp>
+
+#include <algorithm>
+
+void SceneGraph::Clear() {
+    m_Parent.clear();
+    m_SubtreeSize.clear();
+    m_Local.clear();
+    m_World.clear();
+    m_Dirty.clear();
+    m_AnyDirty = false;
+    m_NodeSlotOffset.clear();
+    m_NodeSlots.clear();
+    m_InstanceOffset.clear();
+    m_InstancePart.clear();
+    m_Instances.clear();
+    m_PartBounds.clear();
+    m_InstanceBounds.clear();
+    m_ChangedBegin = m_ChangedEnd = 0;
+}
+
+void SceneGraph::Build(const MeshView& mesh) {
+    Clear();
+
+    const size_t partCount = mesh.partCount;
+    m_InstanceOffset.assign(partCount + 1, 0);
+    m_PartBounds.resize(partCount);
+    for (size_t p = 0; p < partCount; p++) {
+        const MeshPart& part = mesh.parts[p];
+        m_PartBounds[p] = { glm::make_vec3(part.boundsMin), glm::make_vec3(part.boundsMax) };
+    }
+
+    if (mesh.nodeCount == 0) {
+        for (size_t p = 0; p < partCount; p++) m_InstanceOffset[p + 1] = (unsigned int)(p + 1);
+        m_InstancePart.resize(partCount);
+        for (size_t p = 0; p < partCount; p++) m_InstancePart[p] = (unsigned int)p;
+        m_Instances.assign(partCount, glm::mat4(1.0f));
+        m_InstanceBounds = m_PartBounds;
+        m_ChangedEnd = m_Instances.size();
+        return;
+    }
+
+    const size_t nodeCount = mesh.nodeCount;
+    m_Parent.resize(nodeCount);
+    m_SubtreeSize.resize(nodeCount);
+    m_Local.resize(nodeCount);
+    m_World.resize(nodeCount);
+    m_Dirty.assign(nodeCount, 0);
+
+    // Đếm instance theo part rồi prefix sum
+    for (size_t n = 0; n < nodeCount; n++) {
+        const SceneNode& node = mesh.nodes[n];
+        m_Parent[n] = node.parent;
+        m_SubtreeSize[n] = node.subtreeSize;
+        m_Local[n] = glm::make_mat4(node.local);
+        for (unsigned int r = 0; r < node.meshRefCount; r++) {
+            unsigned int part = mesh.meshRefs[node.firstMeshRef + r];
+            if (part < partCount) m_InstanceOffset[part + 1]++;
+        }
+    }
+    for (size_t p = 0; p < partCount; p++) m_InstanceOffset[p + 1] += m_InstanceOffset[p];
+
+    // Gán slot cố định cho từng (node, mesh ref)
+    std::vector<unsigned int> cursor(m_InstanceOffset.begin(), m_InstanceOffset.end() - 1);
+    m_NodeSlotOffset.assign(nodeCount + 1, 0);
+    m_NodeSlots.reserve(m_InstanceOffset[partCount]);
+    for (size_t n = 0; n < nodeCount; n++) {
+        const SceneNode& node = mesh.nodes[n];
+        for (unsigned int r = 0; r < node.meshRefCount; r++) {
+            unsigned int part = mesh.meshRefs[node.firstMeshRef + r];
+            if (part < partCount) m_NodeSlots.push_back(cursor[part]++);
+        }
+        m_NodeSlotOffset[n + 1] = (unsigned int)m_NodeSlots.size();
+    }
+
+    m_Instances.resize(m_InstanceOffset[partCount]);
+    m_InstanceBounds.resize(m_Instances.size());
+    m_InstancePart.resize(m_Instances.size());
+    for (size_t p = 0; p < partCount; p++)
+        for (unsigned int i = m_InstanceOffset[p]; i < m_InstanceOffset[p + 1]; i++) m_InstancePart[i] = (unsigned int)p;
+    // Các root đều dirty -> lần Update đầu tiên tính toàn bộ
+    for (size_t n = 0; n < nodeCount; n++)
+        if (m_Parent[n] < 0) m_Dirty[n] = 1;
+    m_AnyDirty = true;
+    UpdateWorldTransforms();
+}
+
+void SceneGraph::SetLocalTransform(size_t node, const glm::mat4& local) {
+    m_Local[node] = local;
+    m_Dirty[node] = 1;
+    m_AnyDirty = true;
+}
+
+void SceneGraph::WriteInstance(size_t slot, const glm::mat4& world) {
+    m_Instances[slot] = world;
+    m_InstanceBounds[slot] = TransformAABB(world, m_PartBounds[m_InstancePart[slot]]);
+
+    if (m_ChangedBegin >= m_ChangedEnd) {
+        m_ChangedBegin = slot;
+        m_ChangedEnd = slot + 1;
+    } else {
+        m_ChangedBegin = std::min(m_ChangedBegin, slot);
+        m_ChangedEnd = std::max(m_ChangedEnd, slot + 1);
+    }
+}
+
+size_t SceneGraph::UpdateWorldTransforms() {
+    if (!m_AnyDirty) return 0;
+
+    size_t updated = 0;
+    const size_t nodeCount = m_Parent.size();
+    size_t n = 0;
+    while (n < nodeCount) {
+        if (!m_Dirty[n]) {
+            n++;
+            continue;
+        }
+
+        // Cả subtree [n, end) tính lại; parent luôn đứng trước con nên một vòng là đủ
+        size_t end = n + m_SubtreeSize[n];
+        for (size_t i = n; i < end; i++) {
+            int parent = m_Parent[i];
+            m_World[i] = parent >= 0 ? m_World[parent] * m_Local[i] : m_Local[i];
+            m_Dirty[i] = 0;
+            for (unsigned int s = m_NodeSlotOffset[i]; s < m_NodeSlotOffset[i + 1]; s++)
+                WriteInstance(m_NodeSlots[s], m_World[i]);
+        }
+        updated += end - n;
+        n = end;
+    }
+
+    m_AnyDirty = false;
+    return updated;
+}
+
+void SceneGraph::ClearInstanceChanges() {
+    m_ChangedBegin = m_ChangedEnd = 0;
+}
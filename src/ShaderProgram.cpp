@@ -0,0 +1,219 @@
+#include "ShaderProgram.h"
+#include "Profiler.h"
+
+#include <glad/glad.h>
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+// GL_KHR_parallel_shader_compile / GL_ARB_parallel_shader_compile (glad của repo không sinh phần này)
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
+static bool ReadTextFile(const std::string& path, std::string& out) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+    std::ostringstream text;
+    text << file.rdbuf();
+    out = text.str();
+    return true;
+}
+
+static bool HasParallelCompile() {
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (GLint i = 0; i < count; i++) {
+        const char* name = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, (GLuint)i));
+        if (name && (std::strcmp(name, "GL_KHR_parallel_shader_compile") == 0
+                     || std::strcmp(name, "GL_ARB_parallel_shader_compile") == 0))
+            return true;
+    }
+    return false;
+}
+
+ShaderProgram::~ShaderProgram() { Destroy(); }
+
+bool ShaderProgram::Load(const std::string& vertexPath, const std::string& fragmentPath,
+                         const ProgramBindings& bindings, Validator validator) {
+    Destroy();
+    m_VertexPath = vertexPath;
+    m_FragmentPath = fragmentPath;
+    m_Bindings = bindings;
+    m_Validator = std::move(validator);
+    m_ParallelCompile = HasParallelCompile();
+    unsigned int program = Submit();
+    if (!program || !Finish(program)) {
+        std::cerr << "Shader: " << m_Status << std::endl;
+        return false;
+    }
+    m_Program = program;
+    m_Reflection = std::move(m_PendingReflection);
+    return true;
+}
+
+void ShaderProgram::Reload() {
+    if (m_PendingProgram) {
+        // Bản đang build đã cũ: bỏ, build lại từ file mới nhất
+        glDeleteShader(m_PendingShaders[0]);
+        glDeleteShader(m_PendingShaders[1]);
+        glDeleteProgram(m_PendingProgram);
+        m_PendingProgram = 0;
+    }
+    m_PendingProgram = Submit();
+    if (!m_PendingProgram) std::cerr << "Shader: " << m_Status << std::endl;
+}
+
+bool ShaderProgram::Update() {
+    if (!m_PendingProgram) return false;
+    if (m_ParallelCompile) {
+        GLint done = GL_FALSE;
+        glGetProgramiv(m_PendingProgram, GL_COMPLETION_STATUS_KHR, &done);
+        if (!done) return false;
+    }
+    unsigned int program = m_PendingProgram;
+    m_PendingProgram = 0;
+    if (!Finish(program)) {
+        std::cerr << "Shader: " << m_Status << " (keeping the previous program)" << std::endl;
+        return false;
+    }
+    if (m_Program) glDeleteProgram(m_Program);
+    m_Program = program;
+    m_Reflection = std::move(m_PendingReflection);
+    std::cout << "Shader: " << m_Status << std::endl;
+    return true;
+}
+
+void ShaderProgram::Destroy() {
+    if (m_PendingProgram) {
+        glDeleteShader(m_PendingShaders[0]);
+        glDeleteShader(m_PendingShaders[1]);
+        glDeleteProgram(m_PendingProgram);
+    }
+    if (m_Program) glDeleteProgram(m_Program);
+    m_Program = m_PendingProgram = 0;
+    m_PendingShaders[0] = m_PendingShaders[1] = 0;
+    m_Reflection = ProgramReflection();
+}
+
+unsigned int ShaderProgram::Submit() {
+    PROFILE_SCOPE("Shader Submit");
+    std::string sources[2];
+    const std::string* paths[2] = { &m_VertexPath, &m_FragmentPath };
+    for (int i = 0; i < 2; i++) {
+        if (!ReadTextFile(*paths[i], sources[i])) {
+            m_Status = "cannot read " + *paths[i];
+            return 0;
+        }
+    }
+
+    // Không hỏi trạng thái compile ở đây: để driver làm song song, Finish() mới hỏi
+    const GLenum types[2] = { GL_VERTEX_SHADER, GL_FRAGMENT_SHADER };
+    unsigned int program = glCreateProgram();
+    for (int i = 0; i < 2; i++) {
+        const char* text = sources[i].c_str();
+        m_PendingShaders[i] = glCreateShader(types[i]);
+        glShaderSource(m_PendingShaders[i], 1, &text, nullptr);
+        glCompileShader(m_PendingShaders[i]);
+        glAttachShader(program, m_PendingShaders[i]);
+    }
+    glLinkProgram(program);
+    return program;
+}
+
+bool ShaderProgram::Finish(unsigned int program) {
+    PROFILE_SCOPE("Shader Finish");
+    char log[1024];
+    std::string errors;
+    const std::string* paths[2] = { &m_VertexPath, &m_FragmentPath };
+    for (int i = 0; i < 2; i++) {
+        GLint ok = GL_FALSE;
+        glGetShaderiv(m_PendingShaders[i], GL_COMPILE_STATUS, &ok);
+        if (!ok) {
+            glGetShaderInfoLog(m_PendingShaders[i], sizeof(log), nullptr, log);
+            errors += *paths[i] + ": " + log;
+        }
+        glDetachShader(program, m_PendingShaders[i]);
+        glDeleteShader(m_PendingShaders[i]);
+        m_PendingShaders[i] = 0;
+    }
+    GLint linked = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (!linked && errors.empty()) {
+        glGetProgramInfoLog(program, sizeof(log), nullptr, log);
+        errors = std::string("link: ") + log;
+    }
+    if (!linked) {
+        glDeleteProgram(program);
+        m_Status = errors;
+        return false;
+    }
+    m_PendingReflection = ProgramReflection();
+    Reflect(program, m_PendingReflection);
+    if (m_Validator && !m_Validator(m_PendingReflection, errors)) {
+        glDeleteProgram(program);
+        m_PendingReflection = ProgramReflection();
+        m_Status = errors;
+        return false;
+    }
+    m_Status = "built " + m_VertexPath + " + " + m_FragmentPath;
+    return true;
+}
+
+void ShaderProgram::Reflect(unsigned int program, ProgramReflection& out) const {
+    out.program = program;
+    out.serial = NextProgramSerial();
+    char name[256];
+
+    GLint uniformCount = 0;
+    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &uniformCount);
+    std::vector<GLint> blockIndex(uniformCount, -1), offsets(uniformCount, -1);
+    if (uniformCount > 0) {
+        std::vector<GLuint> indices(uniformCount);
+        for (GLint i = 0; i < uniformCount; i++) indices[i] = (GLuint)i;
+        glGetActiveUniformsiv(program, uniformCount, indices.data(), GL_UNIFORM_BLOCK_INDEX, blockIndex.data());
+        glGetActiveUniformsiv(program, uniformCount, indices.data(), GL_UNIFORM_OFFSET, offsets.data());
+    }
+    for (GLint i = 0; i < uniformCount; i++) {
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(program, (GLuint)i, sizeof(name), nullptr, &size, &type, name);
+        std::string uniformName = name;
+        const size_t bracket = uniformName.find("[0]");
+        if (bracket != std::string::npos && bracket + 3 == uniformName.size()) uniformName.resize(bracket);
+        if (blockIndex[i] >= 0) continue;
+        out.uniforms.push_back({ uniformName, glGetUniformLocation(program, name), (uint32_t)type, (int)size });
+    }
+
+    GLint blockCount = 0;
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_BLOCKS, &blockCount);
+    for (GLint b = 0; b < blockCount; b++) {
+        UniformBlockInfo block;
+        glGetActiveUniformBlockName(program, (GLuint)b, sizeof(name), nullptr, name);
+        block.name = name;
+        block.index = (uint32_t)b;
+        GLint dataSize = 0;
+        glGetActiveUniformBlockiv(program, (GLuint)b, GL_UNIFORM_BLOCK_DATA_SIZE, &dataSize);
+        block.dataSize = dataSize;
+        for (GLint i = 0; i < uniformCount; i++) {
+            if (blockIndex[i] != b) continue;
+            glGetActiveUniform(program, (GLuint)i, sizeof(name), nullptr, nullptr, nullptr, name);
+            block.members.push_back({ name, offsets[i] });
+        }
+        block.binding = 0;
+        for (const auto& binding : m_Bindings.blocks)
+            if (binding.first == block.name) block.binding = binding.second;
+        glUniformBlockBinding(program, block.index, block.binding);
+        out.blocks.push_back(std::move(block));
+    }
+
+    // Sampler -> unit là state của program object: đặt một lần ở đây, frame không đặt lại
+    for (const auto& sampler : m_Bindings.samplers) {
+        const int location = out.Location(sampler.first.c_str());
+        if (location >= 0) glProgramUniform1i(program, location, sampler.second);
+    }
+}
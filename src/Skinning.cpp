@@ -0,0 +1,116 @@
+#include "Skinning.h"
+
+#include <glm/gtc/type_ptr.hpp>
+
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define HZ_SKIN_SSE 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define HZ_SKIN_NEON 1
+#endif
+
+void SkinVerticesScalar(const float* vertices, const VertexSkin* skin, size_t count, const glm::mat4* palette,
+                        float* out) {
+    for (size_t v = 0; v < count; v++) {
+        const float* src = vertices + v * kVertexFloatCount;
+        float* dst = out + v * kVertexFloatCount;
+        std::memcpy(dst, src, kVertexStride);
+
+        const VertexSkin& s = skin[v];
+        if (s.weights[0] + s.weights[1] + s.weights[2] + s.weights[3] == 0.0f) continue;
+        const glm::vec4 position(src[0], src[1], src[2], 1.0f);
+        glm::vec4 result(0.0f);
+        for (unsigned int k = 0; k < kMaxVertexInfluences; k++)
+            if (s.weights[k] != 0.0f) result += s.weights[k] * (palette[s.joints[k]] * position);
+        dst[0] = result.x;
+        dst[1] = result.y;
+        dst[2] = result.z;
+    }
+}
+
+void SkinVertices(const float* vertices, const VertexSkin* skin, size_t count, const glm::mat4* palette, float* out) {
+#if defined(HZ_SKIN_SSE) || defined(HZ_SKIN_NEON)
+    for (size_t v = 0; v < count; v++) {
+        const float* src = vertices + v * kVertexFloatCount;
+        float* dst = out + v * kVertexFloatCount;
+        const VertexSkin& s = skin[v];
+        const float u = src[3], w = src[4];
+        bool any = false;
+  #if defined(HZ_SKIN_SSE)
+        const __m128 x = _mm_set1_ps(src[0]), y = _mm_set1_ps(src[1]), z = _mm_set1_ps(src[2]);
+        __m128 acc = _mm_setzero_ps();
+        for (unsigned int k = 0; k < kMaxVertexInfluences; k++) {
+            if (s.weights[k] == 0.0f) continue;
+            const float* m = glm::value_ptr(palette[s.joints[k]]);
+            __m128 p = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(m), x), _mm_mul_ps(_mm_loadu_ps(m + 4), y));
+            p = _mm_add_ps(p, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(m + 8), z), _mm_loadu_ps(m + 12)));
+            acc = _mm_add_ps(acc, _mm_mul_ps(p, _mm_set1_ps(s.weights[k])));
+            any = true;
+        }
+        if (any) _mm_storeu_ps(dst, acc); // ghi 4 float, float thứ 4 bị UV đè ngay sau
+  #else
+        float32x4_t acc = vdupq_n_f32(0.0f);
+        for (unsigned int k = 0; k < kMaxVertexInfluences; k++) {
+            if (s.weights[k] == 0.0f) continue;
+            const float* m = glm::value_ptr(palette[s.joints[k]]);
+            float32x4_t p = vld1q_f32(m + 12);
+            p = vmlaq_n_f32(p, vld1q_f32(m), src[0]);
+            p = vmlaq_n_f32(p, vld1q_f32(m + 4), src[1]);
+            p = vmlaq_n_f32(p, vld1q_f32(m + 8), src[2]);
+            acc = vmlaq_n_f32(acc, p, s.weights[k]);
+            any = true;
+        }
+        if (any) vst1q_f32(dst, acc);
+  #endif
+        if (!any) {
+            dst[0] = src[0];
+            dst[1] = src[1];
+            dst[2] = src[2];
+        }
+        dst[3] = u;
+        dst[4] = w;
+    }
+#else
+    SkinVerticesScalar(vertices, skin, count, palette, out);
+#endif
+}
+
+void SkinVerticesParallel(const float* vertices, const VertexSkin* skin, size_t count, const glm::mat4* palette,
+                          float* out, JobSystem& jobs) {
+    jobs.ParallelFor(count, 4096, [&](size_t begin, size_t end) {
+        SkinVertices(vertices + begin * kVertexFloatCount, skin + begin, end - begin, palette,
+                     out + begin * kVertexFloatCount);
+    });
+}
+
+const char* SkinSimdName() {
+#if defined(HZ_SKIN_SSE)
+    return "SSE";
+#elif defined(HZ_SKIN_NEON)
+    return "NEON";
+#else
+    return "scalar";
+#endif
+}
+
+size_t GatherSkinnedVertices(const MeshView& mesh, std::vector<float>& outVertices, std::vector<VertexSkin>& outSkin,
+                             std::vector<unsigned int>& outBase) {
+    outVertices.clear();
+    outSkin.clear();
+    outBase.assign(mesh.partCount, ~0u);
+    if (!mesh.skin) return 0;
+
+    const float* vertices = static_cast<const float*>(mesh.vertexData);
+    for (size_t p = 0; p < mesh.partCount; p++) {
+        const MeshPart& part = mesh.parts[p];
+        if (!part.skinned) continue;
+        outBase[p] = (unsigned int)outSkin.size();
+        outVertices.insert(outVertices.end(), vertices + (size_t)part.baseVertex * kVertexFloatCount,
+                           vertices + ((size_t)part.baseVertex + part.vertexCount) * kVertexFloatCount);
+        outSkin.insert(outSkin.end(), mesh.skin + part.baseVertex, mesh.skin + part.baseVertex + part.vertexCount);
+    }
+    return outSkin.size();
+}
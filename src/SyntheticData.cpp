@@ -0,0 +1,259 @@
+#include "SyntheticData.h"
+#include "MeshOptimizer.h"
+#include "SceneGraph.h"
+
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+void MakeSyntheticParts(size_t count, std::vector<MeshPart>& parts) {
+    parts.resize(count);
+    unsigned int offset = 0;
+    for (size_t i = 0; i < count; i++) {
+        MeshPart& p = parts[i];
+        p.indexSize = (i % 7 == 0) ? 4 : 2;
+        offset = (offset + p.indexSize - 1) / p.indexSize * p.indexSize;
+        p.indexOffset = offset;
+        p.indexCount = 3 * (unsigned int)(16 + i % 200);
+        p.baseVertex = (unsigned int)i * 100;
+        p.vertexCount = 100;
+        p.color[0] = p.color[1] = p.color[2] = p.color[3] = 1.0f;
+        p.textureIndex = -1;
+        p.skinned = 0;
+        offset += p.indexCount * p.indexSize;
+    }
+}
+
+void MakeSphere(unsigned int segments, MeshData& out) {
+    out = MeshData();
+    for (unsigned int y = 0; y <= segments; y++)
+        for (unsigned int x = 0; x <= segments; x++) {
+            float theta = glm::pi<float>() * (float)y / (float)segments;
+            float phi = glm::two_pi<float>() * (float)x / (float)segments;
+            out.vertices.insert(out.vertices.end(), { std::sin(theta) * std::cos(phi), std::cos(theta),
+                                                      std::sin(theta) * std::sin(phi),
+                                                      (float)x / (float)segments, (float)y / (float)segments });
+        }
+    std::vector<unsigned int> indices;
+    for (unsigned int y = 0; y < segments; y++)
+        for (unsigned int x = 0; x < segments; x++) {
+            unsigned int a = y * (segments + 1) + x, b = a + 1, c = a + segments + 1, d = c + 1;
+            indices.insert(indices.end(), { a, c, b, b, c, d });
+        }
+    out.indices.resize(indices.size() * sizeof(unsigned int));
+    std::memcpy(out.indices.data(), indices.data(), out.indices.size());
+    MeshPart part = {};
+    part.indexCount = (unsigned int)indices.size();
+    part.vertexCount = (segments + 1) * (segments + 1);
+    part.indexSize = 4;
+    part.color[0] = part.color[1] = part.color[2] = part.color[3] = 1.0f;
+    part.textureIndex = -1;
+    out.parts.push_back(part);
+}
+
+void MakeSyntheticImage(unsigned int size, bool withAlpha, Image& out) {
+    out.width = out.height = size;
+    out.rgba.resize((size_t)size * size * 4);
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> noise(-12, 12);
+    for (unsigned int y = 0; y < size; y++) {
+        for (unsigned int x = 0; x < size; x++) {
+            unsigned char* p = &out.rgba[((size_t)y * size + x) * 4];
+            bool checker = ((x / 32) + (y / 32)) & 1;
+            int r = (int)(255.0f * x / size) + noise(rng);
+            int g = (int)(255.0f * y / size) + noise(rng);
+            int b = (checker ? 200 : 60) + noise(rng);
+            p[0] = (unsigned char)std::clamp(r, 0, 255);
+            p[1] = (unsigned char)std::clamp(g, 0, 255);
+            p[2] = (unsigned char)std::clamp(b, 0, 255);
+            float dx = x - size * 0.5f, dy = y - size * 0.5f;
+            float d = std::sqrt(dx * dx + dy * dy) / (size * 0.5f);
+            p[3] = withAlpha ? (unsigned char)std::clamp((int)((1.2f - d) * 512.0f), 0, 255) : 255;
+        }
+    }
+}
+
+void MakeSyntheticCharacter(unsigned int bones, unsigned int vertexCount, MeshData& out) {
+    const unsigned int kChains = 5;
+    const unsigned int perChain = std::max(1u, bones / kChains);
+    bones = perChain * kChains;
+
+    out = MeshData();
+    out.nodes.resize(bones + 1);
+    std::vector<glm::mat4> bindWorld(bones + 1, glm::mat4(1.0f));
+    SceneNode& root = out.nodes[0];
+    root = {};
+    root.parent = -1;
+    root.subtreeSize = bones + 1;
+    root.meshRefCount = 1;
+    std::memcpy(root.local, glm::value_ptr(glm::mat4(1.0f)), sizeof(root.local));
+    out.meshRefs.push_back(0);
+    for (unsigned int c = 0; c < kChains; c++) {
+        for (unsigned int k = 0; k < perChain; k++) {
+            unsigned int i = 1 + c * perChain + k;
+            SceneNode& node = out.nodes[i];
+            node = {};
+            node.parent = k == 0 ? 0 : (int)i - 1;
+            node.subtreeSize = perChain - k;
+            glm::mat4 local = k == 0 ? glm::rotate(glm::mat4(1.0f), glm::two_pi<float>() * c / kChains, glm::vec3(0, 0, 1))
+                                     : glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.1f, 0.0f));
+            std::memcpy(node.local, glm::value_ptr(local), sizeof(node.local));
+            bindWorld[i] = bindWorld[node.parent] * local;
+
+            SkinJoint joint;
+            joint.node = i;
+            joint.skinNode = 0;
+            std::memcpy(joint.inverseBind, glm::value_ptr(glm::inverse(bindWorld[i])), sizeof(joint.inverseBind));
+            out.joints.push_back(joint);
+        }
+    }
+
+    auto addClip = [&](const char* name, float duration, unsigned int keysPerSecond, glm::vec3 axis, bool scale) {
+        AnimationClip clip = {};
+        std::snprintf(clip.name, sizeof(clip.name), "%s", name);
+        clip.duration = duration;
+        clip.firstChannel = (uint32_t)out.channels.size();
+        const unsigned int keyCount = (unsigned int)(duration * keysPerSecond) + 1;
+        for (unsigned int b = 1; b <= bones; b++) {
+            AnimationChannel channel = {};
+            channel.node = b;
+            const glm::mat4 local = glm::make_mat4(out.nodes[b].local);
+            const glm::quat bindRotation = glm::quat_cast(glm::mat3(local));
+            channel.firstKey[kTrackTranslation] = (uint32_t)out.keys.size();
+            channel.keyCount[kTrackTranslation] = 2;
+            for (int k = 0; k < 2; k++)
+                out.keys.push_back({ k * duration, { local[3].x, local[3].y, local[3].z, 0.0f } });
+            channel.firstKey[kTrackRotation] = (uint32_t)out.keys.size();
+            channel.keyCount[kTrackRotation] = keyCount;
+            for (unsigned int k = 0; k < keyCount; k++) {
+                float t = duration * k / (keyCount - 1);
+                float angle = 0.4f * std::sin(glm::two_pi<float>() * t / duration + 0.3f * b);
+                glm::quat q = bindRotation * glm::angleAxis(angle, axis);
+                out.keys.push_back({ t, { q.x, q.y, q.z, q.w } });
+            }
+            if (scale) {
+                channel.firstKey[kTrackScale] = (uint32_t)out.keys.size();
+                channel.keyCount[kTrackScale] = 3;
+                for (int k = 0; k < 3; k++) {
+                    float f = k == 1 ? 1.2f : 1.0f;
+                    out.keys.push_back({ duration * k / 2.0f, { f, f, f, 0.0f } });
+                }
+            }
+            out.channels.push_back(channel);
+        }
+        clip.channelCount = (uint32_t)out.channels.size() - clip.firstChannel;
+        out.clips.push_back(clip);
+    };
+    addClip("wave", 2.0f, 30, glm::vec3(0, 0, 1), false);
+    addClip("twist", 1.5f, 30, glm::vec3(0, 1, 0), true);
+
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> jitter(-0.05f, 0.05f);
+    out.vertices.resize((size_t)vertexCount * kVertexFloatCount);
+    out.skin.resize(vertexCount);
+    for (unsigned int v = 0; v < vertexCount; v++) {
+        unsigned int bone = v % bones; // joint index == node - 1
+        glm::vec4 p = bindWorld[bone + 1] * glm::vec4(jitter(rng), 0.05f + jitter(rng), jitter(rng), 1.0f);
+        float* dst = &out.vertices[(size_t)v * kVertexFloatCount];
+        dst[0] = p.x; dst[1] = p.y; dst[2] = p.z;
+        dst[3] = (float)v / vertexCount; dst[4] = 0.5f;
+        VertexSkin& skin = out.skin[v];
+        skin = {};
+        unsigned int chainStart = bone / perChain * perChain;
+        skin.joints[0] = (uint16_t)bone;
+        skin.joints[1] = (uint16_t)(bone > chainStart ? bone - 1 : bone);
+        skin.joints[2] = (uint16_t)(bone + 1 < chainStart + perChain ? bone + 1 : bone);
+        skin.weights[0] = 0.6f; skin.weights[1] = 0.3f; skin.weights[2] = 0.1f;
+    }
+    MeshPart part = {};
+    part.vertexCount = vertexCount;
+    part.indexSize = 4;
+    part.textureIndex = -1;
+    part.skinned = 1;
+    out.parts.push_back(part);
+}
+
+void MakeSyntheticScene(size_t repeats, MeshData& out) {
+    const unsigned int kGrid = 24;
+    out = MeshData();
+    for (unsigned int y = 0; y <= kGrid; y++)
+        for (unsigned int x = 0; x <= kGrid; x++) {
+            out.vertices.push_back((float)x / kGrid);
+            out.vertices.push_back(0.1f * (float)((x * 7 + y * 3) % 5));
+            out.vertices.push_back((float)y / kGrid);
+            out.vertices.push_back((float)x / kGrid); // UV
+            out.vertices.push_back((float)y / kGrid);
+        }
+    std::vector<uint16_t> indices;
+    for (unsigned int y = 0; y < kGrid; y++)
+        for (unsigned int x = 0; x < kGrid; x++) {
+            uint16_t a = (uint16_t)(y * (kGrid + 1) + x), b = a + 1, c = a + kGrid + 1, d = c + 1;
+            indices.insert(indices.end(), { a, b, c, b, d, c });
+        }
+    out.indices.resize(indices.size() * 2);
+    std::memcpy(out.indices.data(), indices.data(), out.indices.size());
+    MeshPart part = {};
+    part.indexCount = (unsigned int)indices.size();
+    part.vertexCount = (kGrid + 1) * (kGrid + 1);
+    part.indexSize = 2;
+    part.color[0] = part.color[1] = part.color[2] = 0.8f;
+    part.color[3] = 1.0f;
+    part.textureIndex = -1;
+    ComputePartBounds(out.vertices.data(), part.vertexCount, kVertexFloatCount, part);
+    out.parts.push_back(part);
+
+    auto addNode = [&out](int parent, const glm::mat4& local, bool withMesh) {
+        SceneNode node = {};
+        node.parent = parent;
+        node.subtreeSize = 1;
+        node.firstMeshRef = (unsigned int)out.meshRefs.size();
+        node.meshRefCount = withMesh ? 1 : 0;
+        std::memcpy(node.local, &local[0][0], sizeof(node.local));
+        if (withMesh) out.meshRefs.push_back(0);
+        out.nodes.push_back(node);
+        return (int)out.nodes.size() - 1;
+    };
+
+    const size_t kGroupSize = 64;
+    int root = addNode(-1, glm::mat4(1.0f), false);
+    for (size_t first = 0; first < repeats; first += kGroupSize) {
+        int group = addNode(root, glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, 1.5f * (first / kGroupSize))), false);
+        size_t count = std::min(kGroupSize, repeats - first);
+        for (size_t i = 0; i < count; i++)
+            addNode(group, glm::translate(glm::mat4(1.0f), glm::vec3(1.5f * i, 0.0f, 0.0f)), true);
+        out.nodes[group].subtreeSize = (unsigned int)(count + 1);
+    }
+    out.nodes[root].subtreeSize = (unsigned int)out.nodes.size();
+}
+
+void FlattenScene(const MeshData& in, MeshData& out) {
+    SceneGraph scene;
+    scene.Build(in.View());
+    out = MeshData();
+    for (size_t p = 0; p < in.parts.size(); p++) {
+        const MeshPart& src = in.parts[p];
+        for (unsigned int i = 0; i < scene.InstanceCount(p); i++) {
+            const glm::mat4& m = scene.Instances()[scene.InstanceOffset(p) + i];
+            MeshPart dst = src;
+            dst.lodCount = 0; // chỉ so sánh LOD 0
+            dst.baseVertex = (unsigned int)(out.vertices.size() / kVertexFloatCount);
+            dst.indexOffset = (unsigned int)((out.indices.size() + src.indexSize - 1) / src.indexSize * src.indexSize);
+            for (unsigned int v = 0; v < src.vertexCount; v++) {
+                const float* pos = &in.vertices[(src.baseVertex + v) * kVertexFloatCount];
+                glm::vec4 world = m * glm::vec4(pos[0], pos[1], pos[2], 1.0f);
+                out.vertices.insert(out.vertices.end(), { world.x, world.y, world.z, pos[3], pos[4] });
+            }
+            size_t bytes = (size_t)src.indexCount * src.indexSize;
+            out.indices.resize(dst.indexOffset + bytes);
+            std::memcpy(out.indices.data() + dst.indexOffset, in.indices.data() + src.indexOffset, bytes);
+            out.parts.push_back(dst);
+        }
+    }
+}
@@ -0,0 +1,416 @@
+#include "TextureCodec.h"
+
+#include "stb_image/stb_image.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+// --- DECODE ---
+static bool FinishDecode(unsigned char* pixels, int width, int height, Image& outImage, std::string* outError) {
+    if (!pixels) {
+        if (outError) *outError = stbi_failure_reason() ? stbi_failure_reason() : "unknown image format";
+        return false;
+    }
+    outImage.width = (unsigned int)width;
+    outImage.height = (unsigned int)height;
+    outImage.rgba.assign(pixels, pixels + (size_t)width * height * 4);
+    stbi_image_free(pixels);
+    return true;
+}
+
+bool DecodeImage(const void* data, size_t size, Image& outImage, std::string* outError) {
+    int width = 0, height = 0, channels = 0;
+    unsigned char* pixels = stbi_load_from_memory(static_cast<const stbi_uc*>(data), (int)size, &width, &height,
+                                                  &channels, 4);
+    return FinishDecode(pixels, width, height, outImage, outError);
+}
+
+bool DecodeImageFile(const char* path, Image& outImage, std::string* outError) {
+    int width = 0, height = 0, channels = 0;
+    unsigned char* pixels = stbi_load(path, &width, &height, &channels, 4);
+    return FinishDecode(pixels, width, height, outImage, outError);
+}
+
+unsigned int MipCount(unsigned int width, unsigned int height) {
+    unsigned int size = std::max(width, height), count = 1;
+    while (size > 1) {
+        size >>= 1;
+        count++;
+    }
+    return count;
+}
+
+size_t TextureLevelBytes(TextureFormat format, unsigned int width, unsigned int height) {
+    size_t blocks = (size_t)((width + 3) / 4) * ((height + 3) / 4);
+    switch (format) {
+    case TextureFormat::BC1: return blocks * 8;
+    case TextureFormat::BC3: return blocks * 16;
+    default: return (size_t)width * height * 4;
+    }
+}
+
+bool ImageHasAlpha(const Image& image) {
+    for (size_t i = 3; i < image.rgba.size(); i += 4)
+        if (image.rgba[i] != 255) return true;
+    return false;
+}
+
+// --- MIP ---
+// sRGB <-> tuyến tính qua bảng: 256 giá trị vào, 4096 mức ra (sai số < 1/2 bước 8 bit)
+struct SrgbTables {
+    float toLinear[256];
+    unsigned char toSrgb[4096];
+
+    SrgbTables() {
+        for (int i = 0; i < 256; i++) {
+            float c = (float)i / 255.0f;
+            toLinear[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+        }
+        for (int i = 0; i < 4096; i++) {
+            float l = (float)i / 4095.0f;
+            float c = l <= 0.0031308f ? l * 12.92f : 1.055f * std::pow(l, 1.0f / 2.4f) - 0.055f;
+            toSrgb[i] = (unsigned char)std::min(255.0f, c * 255.0f + 0.5f);
+        }
+    }
+};
+
+static const SrgbTables& Srgb() {
+    static const SrgbTables tables;
+    return tables;
+}
+
+void DownsampleImage(const Image& src, Image& outDst, JobSystem& jobs) {
+    const SrgbTables& srgb = Srgb();
+    const unsigned int width = std::max(1u, src.width / 2), height = std::max(1u, src.height / 2);
+    outDst.width = width;
+    outDst.height = height;
+    outDst.rgba.resize((size_t)width * height * 4);
+
+    const unsigned char* in = src.rgba.data();
+    unsigned char* out = outDst.rgba.data();
+    const size_t rowGrain = std::max<size_t>(1, 16384 / width);
+    jobs.ParallelFor(height, rowGrain, [&](size_t begin, size_t end) {
+        for (size_t y = begin; y < end; y++) {
+            const size_t y0 = std::min<size_t>(y * 2, src.height - 1), y1 = std::min<size_t>(y * 2 + 1, src.height - 1);
+            for (size_t x = 0; x < width; x++) {
+                const size_t x0 = std::min<size_t>(x * 2, src.width - 1), x1 = std::min<size_t>(x * 2 + 1, src.width - 1);
+                const unsigned char* p[4] = { in + (y0 * src.width + x0) * 4, in + (y0 * src.width + x1) * 4,
+                                              in + (y1 * src.width + x0) * 4, in + (y1 * src.width + x1) * 4 };
+                unsigned char* dst = out + (y * width + x) * 4;
+                for (int c = 0; c < 3; c++) {
+                    float linear = srgb.toLinear[p[0][c]] + srgb.toLinear[p[1][c]] + srgb.toLinear[p[2][c]] +
+                                   srgb.toLinear[p[3][c]];
+                    dst[c] = srgb.toSrgb[(int)(linear * (4095.0f / 4.0f) + 0.5f)];
+                }
+                dst[3] = (unsigned char)((p[0][3] + p[1][3] + p[2][3] + p[3][3] + 2) / 4);
+            }
+        }
+    });
+}
+
+// --- BC1 / BC3 ---
+static uint16_t Pack565(const float color[3]) {
+    auto Quantize = [](float value, float levels) {
+        return (unsigned int)std::min(levels, std::max(0.0f, value * levels / 255.0f + 0.5f));
+    };
+    return (uint16_t)(Quantize(color[0], 31.0f) << 11 | Quantize(color[1], 63.0f) << 5 | Quantize(color[2], 31.0f));
+}
+
+static void Unpack565(uint16_t packed, int out[3]) {
+    int r = (packed >> 11) & 31, g = (packed >> 5) & 63, b = packed & 31;
+    out[0] = (r << 3) | (r >> 2);
+    out[1] = (g << 2) | (g >> 4);
+    out[2] = (b << 3) | (b >> 2);
+}
+
+// Palette 4 màu: c0, c1, 2/3 c0 + 1/3 c1, 1/3 c0 + 2/3 c1
+static void BuildPalette(uint16_t c0, uint16_t c1, int palette[4][3]) {
+    Unpack565(c0, palette[0]);
+    Unpack565(c1, palette[1]);
+    for (int c = 0; c < 3; c++) {
+        palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+        palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+    }
+}
+
+// Chọn index gần nhất cho từng pixel, trả về tổng sai số bình phương
+static int FitIndices(const unsigned char* pixels, uint16_t c0, uint16_t c1, uint32_t& outIndices) {
+    int palette[4][3];
+    BuildPalette(c0, c1, palette);
+    int total = 0;
+    outIndices = 0;
+    for (int i = 0; i < 16; i++) {
+        const unsigned char* p = pixels + i * 4;
+        int best = 0, bestError = INT32_MAX;
+        for (int k = 0; k < 4; k++) {
+            int dr = p[0] - palette[k][0], dg = p[1] - palette[k][1], db = p[2] - palette[k][2];
+            int error = dr * dr + dg * dg + db * db;
+            if (error < bestError) {
+                bestError = error;
+                best = k;
+            }
+        }
+        total += bestError;
+        outIndices |= (uint32_t)best << (i * 2);
+    }
+    return total;
+}
+
+// Endpoint theo trục chính (PCA) của 16 màu, rồi tinh lại bằng bình phương tối thiểu theo index đã chọn
+static void EncodeColorBlock(const unsigned char* pixels, unsigned char* out) {
+    float mean[3] = {};
+    for (int i = 0; i < 16; i++)
+        for (int c = 0; c < 3; c++) mean[c] += pixels[i * 4 + c];
+    for (float& m : mean) m /= 16.0f;
+
+    float cov[6] = {}; // rr rg rb gg gb bb
+    float minColor[3] = { 255.0f, 255.0f, 255.0f }, maxColor[3] = {};
+    for (int i = 0; i < 16; i++) {
+        float d[3];
+        for (int c = 0; c < 3; c++) {
+            d[c] = pixels[i * 4 + c] - mean[c];
+            minColor[c] = std::min(minColor[c], (float)pixels[i * 4 + c]);
+            maxColor[c] = std::max(maxColor[c], (float)pixels[i * 4 + c]);
+        }
+        cov[0] += d[0] * d[0]; cov[1] += d[0] * d[1]; cov[2] += d[0] * d[2];
+        cov[3] += d[1] * d[1]; cov[4] += d[1] * d[2]; cov[5] += d[2] * d[2];
+    }
+
+    // Power iteration, bắt đầu từ đường chéo bounding box
+    float axis[3] = { maxColor[0] - minColor[0], maxColor[1] - minColor[1], maxColor[2] - minColor[2] };
+    for (int iteration = 0; iteration < 8; iteration++) {
+        float next[3] = { cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2],
+                          cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2],
+                          cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2] };
+        float length = std::max({ std::fabs(next[0]), std::fabs(next[1]), std::fabs(next[2]) });
+        if (length < 1e-6f) break;
+        for (int c = 0; c < 3; c++) axis[c] = next[c] / length;
+    }
+
+    float tMin = 0.0f, tMax = 0.0f;
+    float axisLength2 = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+    if (axisLength2 > 1e-12f) {
+        tMin = FLT_MAX;
+        tMax = -FLT_MAX;
+        for (int i = 0; i < 16; i++) {
+            float t = 0.0f;
+            for (int c = 0; c < 3; c++) t += (pixels[i * 4 + c] - mean[c]) * axis[c];
+            t /= axisLength2;
+            tMin = std::min(tMin, t);
+            tMax = std::max(tMax, t);
+        }
+        // Thu endpoint vào trong một chút: hai màu nội suy phủ khoảng giữa tốt hơn
+        float inset = (tMax - tMin) / 16.0f;
+        tMin += inset;
+        tMax -= inset;
+    }
+    float e0[3], e1[3];
+    for (int c = 0; c < 3; c++) {
+        e0[c] = mean[c] + axis[c] * tMax;
+        e1[c] = mean[c] + axis[c] * tMin;
+    }
+
+    uint16_t c0 = Pack565(e0), c1 = Pack565(e1);
+    uint32_t indices = 0;
+    int error = FitIndices(pixels, c0, c1, indices);
+
+    static const float kWeights[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f }; // phần của c0 theo index
+    for (int refine = 0; refine < 2 && error > 0; refine++) {
+        float aa = 0.0f, ab = 0.0f, bb = 0.0f, ax[3] = {}, bx[3] = {};
+        for (int i = 0; i < 16; i++) {
+            float a = kWeights[(indices >> (i * 2)) & 3], b = 1.0f - a;
+            aa += a * a; ab += a * b; bb += b * b;
+            for (int c = 0; c < 3; c++) {
+                ax[c] += a * pixels[i * 4 + c];
+                bx[c] += b * pixels[i * 4 + c];
+            }
+        }
+        float det = aa * bb - ab * ab;
+        if (std::fabs(det) < 1e-6f) break;
+        for (int c = 0; c < 3; c++) {
+            e0[c] = (ax[c] * bb - bx[c] * ab) / det;
+            e1[c] = (bx[c] * aa - ax[c] * ab) / det;
+        }
+        uint16_t n0 = Pack565(e0), n1 = Pack565(e1);
+        uint32_t newIndices = 0;
+        int newError = FitIndices(pixels, n0, n1, newIndices);
+        if (newError >= error) break;
+        c0 = n0; c1 = n1; indices = newIndices; error = newError;
+    }
+
+    // c0 > c1 mới là chế độ 4 màu: đổi chỗ endpoint thì đổi 0<->1, 2<->3
+    if (c0 < c1) {
+        std::swap(c0, c1);
+        indices ^= 0x55555555u;
+    } else if (c0 == c1) {
+        indices = 0;
+    }
+    out[0] = (unsigned char)(c0 & 0xff); out[1] = (unsigned char)(c0 >> 8);
+    out[2] = (unsigned char)(c1 & 0xff); out[3] = (unsigned char)(c1 >> 8);
+    for (int b = 0; b < 4; b++) out[4 + b] = (unsigned char)(indices >> (b * 8));
+}
+
+// Alpha BC3: chế độ 8 mức (a0 > a1) giữa min và max của block
+static void EncodeAlphaBlock(const unsigned char* pixels, unsigned char* out) {
+    int minAlpha = 255, maxAlpha = 0;
+    for (int i = 0; i < 16; i++) {
+        minAlpha = std::min(minAlpha, (int)pixels[i * 4 + 3]);
+        maxAlpha = std::max(maxAlpha, (int)pixels[i * 4 + 3]);
+    }
+    out[0] = (unsigned char)maxAlpha;
+    out[1] = (unsigned char)minAlpha;
+
+    uint64_t bits = 0;
+    if (maxAlpha > minAlpha) {
+        int palette[8] = { maxAlpha, minAlpha };
+        for (int k = 2; k < 8; k++) palette[k] = ((8 - k) * maxAlpha + (k - 1) * minAlpha) / 7;
+        for (int i = 0; i < 16; i++) {
+            int alpha = pixels[i * 4 + 3], best = 0;
+            for (int k = 1; k < 8; k++)
+                if (std::abs(alpha - palette[k]) < std::abs(alpha - palette[best])) best = k;
+            bits |= (uint64_t)best << (i * 3);
+        }
+    }
+    for (int b = 0; b < 6; b++) out[2 + b] = (unsigned char)(bits >> (b * 8));
+}
+
+// Lấy block 4x4 (kẹp mép với ảnh không chia hết cho 4)
+static void GatherBlock(const Image& image, unsigned int blockX, unsigned int blockY, unsigned char* pixels) {
+    for (unsigned int y = 0; y < 4; y++) {
+        unsigned int sy = std::min(blockY * 4 + y, image.height - 1);
+        for (unsigned int x = 0; x < 4; x++) {
+            unsigned int sx = std::min(blockX * 4 + x, image.width - 1);
+            std::memcpy(pixels + (y * 4 + x) * 4, &image.rgba[((size_t)sy * image.width + sx) * 4], 4);
+        }
+    }
+}
+
+void EncodeImage(const Image& image, TextureFormat format, unsigned char* out, JobSystem& jobs) {
+    if (format == TextureFormat::RGBA8) {
+        std::memcpy(out, image.rgba.data(), image.rgba.size());
+        return;
+    }
+    const unsigned int blocksX = (image.width + 3) / 4, blocksY = (image.height + 3) / 4;
+    const size_t blockBytes = format == TextureFormat::BC3 ? 16 : 8;
+    const size_t rowGrain = std::max<size_t>(1, 1024 / blocksX); // ~1024 block / job
+    jobs.ParallelFor(blocksY, rowGrain, [&](size_t begin, size_t end) {
+        unsigned char pixels[64];
+        for (size_t by = begin; by < end; by++) {
+            unsigned char* dst = out + by * blocksX * blockBytes;
+            for (unsigned int bx = 0; bx < blocksX; bx++, dst += blockBytes) {
+                GatherBlock(image, bx, (unsigned int)by, pixels);
+                if (format == TextureFormat::BC3) {
+                    EncodeAlphaBlock(pixels, dst);
+                    EncodeColorBlock(pixels, dst + 8);
+                } else {
+                    EncodeColorBlock(pixels, dst);
+                }
+            }
+        }
+    });
+}
+
+static void DecodeColorBlock(const unsigned char* block, bool fourColorOnly, unsigned char* pixels) {
+    uint16_t c0 = (uint16_t)(block[0] | block[1] << 8), c1 = (uint16_t)(block[2] | block[3] << 8);
+    int palette[4][3];
+    int alpha[4] = { 255, 255, 255, 255 };
+    BuildPalette(c0, c1, palette);
+    if (!fourColorOnly && c0 <= c1) {
+        // Chế độ 3 màu + trong suốt (encoder ở đây không sinh ra, nhưng file BC1 khác có thể có)
+        for (int c = 0; c < 3; c++) {
+            palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+            palette[3][c] = 0;
+        }
+        alpha[3] = 0;
+    }
+    uint32_t indices = (uint32_t)block[4] | (uint32_t)block[5] << 8 | (uint32_t)block[6] << 16 | (uint32_t)block[7] << 24;
+    for (int i = 0; i < 16; i++) {
+        int k = (indices >> (i * 2)) & 3;
+        for (int c = 0; c < 3; c++) pixels[i * 4 + c] = (unsigned char)palette[k][c];
+        pixels[i * 4 + 3] = (unsigned char)alpha[k];
+    }
+}
+
+static void DecodeAlphaBlock(const unsigned char* block, unsigned char* pixels) {
+    int palette[8] = { block[0], block[1] };
+    if (palette[0] > palette[1]) {
+        for (int k = 2; k < 8; k++) palette[k] = ((8 - k) * palette[0] + (k - 1) * palette[1]) / 7;
+    } else {
+        for (int k = 2; k < 6; k++) palette[k] = ((6 - k) * palette[0] + (k - 1) * palette[1]) / 5;
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+    uint64_t bits = 0;
+    for (int b = 0; b < 6; b++) bits |= (uint64_t)block[2 + b] << (b * 8);
+    for (int i = 0; i < 16; i++) pixels[i * 4 + 3] = (unsigned char)palette[(bits >> (i * 3)) & 7];
+}
+
+void DecodeTextureLevel(const unsigned char* data, TextureFormat format, unsigned int width, unsigned int height,
+                        Image& outImage) {
+    outImage.width = width;
+    outImage.height = height;
+    outImage.rgba.resize((size_t)width * height * 4);
+    if (format == TextureFormat::RGBA8) {
+        std::memcpy(outImage.rgba.data(), data, outImage.rgba.size());
+        return;
+    }
+
+    const unsigned int blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+    const size_t blockBytes = format == TextureFormat::BC3 ? 16 : 8;
+    unsigned char pixels[64];
+    for (unsigned int by = 0; by < blocksY; by++) {
+        for (unsigned int bx = 0; bx < blocksX; bx++) {
+            const unsigned char* block = data + ((size_t)by * blocksX + bx) * blockBytes;
+            if (format == TextureFormat::BC3) {
+                DecodeColorBlock(block + 8, true, pixels);
+                DecodeAlphaBlock(block, pixels);
+            } else {
+                DecodeColorBlock(block, false, pixels);
+            }
+            for (unsigned int y = 0; y < 4 && by * 4 + y < height; y++)
+                for (unsigned int x = 0; x < 4 && bx * 4 + x < width; x++)
+                    std::memcpy(&outImage.rgba[((size_t)(by * 4 + y) * width + bx * 4 + x) * 4], pixels + (y * 4 + x) * 4, 4);
+        }
+    }
+}
+
+double ImagePsnr(const Image& a, const Image& b, int channels) {
+    double sum = 0.0;
+    size_t count = 0;
+    for (size_t i = 0; i < a.rgba.size(); i += 4) {
+        for (int c = 0; c < channels; c++) {
+            double d = (double)a.rgba[i + c] - (double)b.rgba[i + c];
+            sum += d * d;
+        }
+        count += channels;
+    }
+    if (sum == 0.0) return 99.0;
+    return 10.0 * std::log10(255.0 * 255.0 / (sum / count));
+}
+
+void CookTexture(const Image& base, TextureDesc& outDesc, std::vector<unsigned char>& outBlob, bool compress,
+                 JobSystem& jobs) {
+    outDesc = TextureDesc();
+    outDesc.format = !compress ? TextureFormat::RGBA8 : ImageHasAlpha(base) ? TextureFormat::BC3 : TextureFormat::BC1;
+    outDesc.width = base.width;
+    outDesc.height = base.height;
+    outDesc.mipCount = std::min(MipCount(base.width, base.height), kMaxTextureMips);
+
+    // Level sau lọc từ level trước; hai buffer luân phiên
+    Image scratch[2];
+    const Image* level = &base;
+    for (unsigned int l = 0; l < outDesc.mipCount; l++) {
+        if (l > 0) {
+            DownsampleImage(*level, scratch[l & 1], jobs);
+            level = &scratch[l & 1];
+        }
+        size_t offset = (outBlob.size() + kTextureAlignment - 1) & ~(kTextureAlignment - 1);
+        size_t size = TextureLevelBytes(outDesc.format, level->width, level->height);
+        outBlob.resize(offset + size);
+        EncodeImage(*level, outDesc.format, outBlob.data() + offset, jobs);
+        outDesc.mips[l] = { offset, size };
+    }
+}
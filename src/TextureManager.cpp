@@ -0,0 +1,101 @@
+#include "TextureManager.h"
+#include "Profiler.h"
+
+#include <glad/glad.h>
+
+#include <algorithm>
+
+TextureManager::~TextureManager() { Clear(); }
+
+void TextureManager::Load(const MeshView& mesh) {
+    Clear();
+    m_HasS3TC = GLAD_GL_EXT_texture_compression_s3tc != 0;
+    if (GLAD_GL_EXT_texture_filter_anisotropic)
+        glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &m_MaxAnisotropy);
+
+    const unsigned char* data = static_cast<const unsigned char*>(mesh.textureData);
+    m_Descs.assign(mesh.textures, mesh.textures + mesh.textureCount);
+    m_Data.assign(data, data + mesh.textureBytes);
+    m_Textures.assign(mesh.textureCount, Texture());
+
+    // Chưa có request nào: target = mip nhỏ nhất được phép
+    m_Residency.Reset(m_Descs.data(), m_Descs.size());
+    m_Residency.Update(m_Params);
+    for (unsigned int i = 0; i < (unsigned int)m_Textures.size(); i++) Upload(i, m_Residency.TargetMip(i));
+}
+
+void TextureManager::Clear() {
+    for (Texture& texture : m_Textures)
+        if (texture.handle) glDeleteTextures(1, &texture.handle);
+    m_Textures.clear();
+    m_Descs.clear();
+    m_Data.clear();
+    m_Data.shrink_to_fit();
+    m_Residency.Reset(nullptr, 0);
+    m_ResidentBytes = 0;
+}
+
+void TextureManager::Upload(unsigned int index, unsigned int topMip) {
+    const TextureDesc& desc = m_Descs[index];
+    Texture& texture = m_Textures[index];
+
+    unsigned int handle = 0;
+    glGenTextures(1, &handle);
+    glBindTexture(GL_TEXTURE_2D, handle);
+    size_t bytes = 0;
+    for (unsigned int l = topMip; l < desc.mipCount; l++) {
+        const GLsizei width = (GLsizei)MipExtent(desc.width, l), height = (GLsizei)MipExtent(desc.height, l);
+        const unsigned char* level = m_Data.data() + desc.mips[l].offset;
+        const GLint target = (GLint)(l - topMip);
+        if (desc.format == TextureFormat::RGBA8) {
+            glTexImage2D(GL_TEXTURE_2D, target, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, level);
+        } else if (m_HasS3TC) {
+            GLenum format = desc.format == TextureFormat::BC1 ? GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+                                                               : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+            glCompressedTexImage2D(GL_TEXTURE_2D, target, format, width, height, 0, (GLsizei)desc.mips[l].size, level);
+        } else {
+            DecodeTextureLevel(level, desc.format, (unsigned int)width, (unsigned int)height, m_Scratch);
+            glTexImage2D(GL_TEXTURE_2D, target, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                         m_Scratch.rgba.data());
+        }
+        bytes += (size_t)desc.mips[l].size;
+    }
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint)(desc.mipCount - 1 - topMip));
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    if (m_MaxAnisotropy > 1.0f) glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, m_MaxAnisotropy);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    // Texture cũ được thay nguyên cái: draw đang xếp hàng vẫn đọc bản cũ tới khi xong
+    if (texture.handle) glDeleteTextures(1, &texture.handle);
+    m_ResidentBytes = m_ResidentBytes - texture.bytes + bytes;
+    texture.handle = handle;
+    texture.residentMip = topMip;
+    texture.bytes = bytes;
+}
+
+bool TextureManager::Update(size_t uploadBudget) {
+    if (m_Textures.empty()) return false;
+    PROFILE_SCOPE("Texture Residency");
+    m_Residency.Update(m_Params);
+
+    size_t uploaded = 0;
+    bool deferred = false;
+    for (unsigned int i = 0; i < (unsigned int)m_Textures.size(); i++) {
+        const unsigned int target = m_Residency.TargetMip(i);
+        const unsigned int current = m_Textures[i].residentMip;
+        if (target == current) continue;
+        if (target < current) {
+            size_t bytes = m_Residency.ResidentBytes(i, target);
+            if (uploaded > 0 && uploaded + bytes > uploadBudget) { // frame sau
+                deferred = true;
+                continue;
+            }
+            uploaded += bytes;
+        }
+        Upload(i, target);
+    }
+    return deferred;
+}
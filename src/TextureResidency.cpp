@@ -0,0 +1,101 @@
+#include "TextureResidency.h"
+#include "LodSelection.h"
+
+#include <algorithm>
+#include <cmath>
+
+void TextureResidency::Reset(const TextureDesc* textures, size_t count) {
+    m_Entries.assign(count, Entry());
+    for (size_t i = 0; i < count; i++) m_Entries[i].desc = textures[i];
+    m_Frame = 0;
+    m_TargetBytes = m_WantedBytes = 0;
+}
+
+void TextureResidency::BeginFrame() {
+    m_Frame++;
+}
+
+void TextureResidency::Request(unsigned int texture, float screenPixels) {
+    Entry& entry = m_Entries[texture];
+    if (entry.lastUsedFrame != m_Frame) {
+        entry.lastUsedFrame = m_Frame;
+        entry.screenPixels = screenPixels;
+    } else {
+        entry.screenPixels = std::max(entry.screenPixels, screenPixels);
+    }
+}
+
+size_t TextureResidency::ResidentBytes(unsigned int texture, unsigned int topMip) const {
+    const TextureDesc& desc = m_Entries[texture].desc;
+    size_t bytes = 0;
+    for (unsigned int l = topMip; l < desc.mipCount; l++) bytes += (size_t)desc.mips[l].size;
+    return bytes;
+}
+
+void TextureResidency::Update(const TextureResidencyParams& params) {
+    // 1. Mức màn hình cần, kẹp bởi level thô nhất được phép (luôn giữ phần mip nhỏ)
+    auto CoarsestMip = [&params](const TextureDesc& desc) {
+        unsigned int level = 0;
+        const uint32_t size = std::max(desc.width, desc.height);
+        while (level + 1 < desc.mipCount && MipExtent(size, level) > params.minResidentSize) level++;
+        return level;
+    };
+
+    size_t total = 0;
+    for (unsigned int i = 0; i < (unsigned int)m_Entries.size(); i++) {
+        Entry& entry = m_Entries[i];
+        const unsigned int coarsest = CoarsestMip(entry.desc);
+
+        // Texture không còn được vẽ giữ mức của lần dùng cuối; budget quyết định có thả hay không
+        unsigned int wanted = coarsest;
+        if (entry.lastUsedFrame != 0) {
+            // Level nhỏ nhất mà cạnh vẫn >= số pixel trên màn hình
+            float ratio = (float)std::max(entry.desc.width, entry.desc.height) /
+                          std::max(entry.screenPixels * params.bias, 1.0f);
+            wanted = ratio <= 1.0f ? 0 : std::min(coarsest, (unsigned int)std::floor(std::log2(ratio)));
+        }
+        entry.wantedMip = entry.targetMip = wanted;
+        total += ResidentBytes(i, wanted);
+    }
+    m_WantedBytes = total;
+
+    // 2. Vượt budget: thả mip của texture ít quan trọng nhất trước.
+    //    Lâu không dùng (cũ nhất trước) rồi tới texture nhỏ nhất trên màn hình.
+    if (total > params.budgetBytes) {
+        auto Unused = [this, &params](const Entry& entry) { return m_Frame - entry.lastUsedFrame > params.unusedFrames; };
+        m_Order.resize(m_Entries.size());
+        for (unsigned int i = 0; i < (unsigned int)m_Order.size(); i++) m_Order[i] = i;
+        std::sort(m_Order.begin(), m_Order.end(), [this, &Unused](unsigned int a, unsigned int b) {
+            const Entry& ea = m_Entries[a];
+            const Entry& eb = m_Entries[b];
+            if (Unused(ea) != Unused(eb)) return Unused(ea);
+            if (Unused(ea)) return ea.lastUsedFrame < eb.lastUsedFrame;
+            return ea.screenPixels < eb.screenPixels;
+        });
+        for (unsigned int i : m_Order) {
+            Entry& entry = m_Entries[i];
+            const unsigned int coarsest = CoarsestMip(entry.desc);
+            while (entry.targetMip < coarsest && total > params.budgetBytes)
+                total -= (size_t)entry.desc.mips[entry.targetMip++].size;
+            if (total <= params.budgetBytes) break;
+        }
+    }
+    m_TargetBytes = total;
+}
+
+void RequestInstanceTextures(const MeshPart* parts, const SceneGraph& scene, const uint8_t* visible,
+                             const glm::vec3& cameraPos, float pixelsPerUnit, TextureResidency& residency) {
+    // Giả định UV phủ cả part một lần: texture trải trên đường kính bounds
+    const std::vector<AABB>& bounds = scene.InstanceBounds();
+    for (size_t p = 0; p < scene.PartCount(); p++) {
+        if (parts[p].textureIndex < 0) continue;
+        const unsigned int first = scene.InstanceOffset(p), end = first + scene.InstanceCount(p);
+        for (unsigned int i = first; i < end; i++) {
+            if (!visible[i]) continue;
+            glm::vec3 outside = glm::max(glm::max(bounds[i].min - cameraPos, cameraPos - bounds[i].max), glm::vec3(0.0f));
+            float diameter = glm::length(bounds[i].max - bounds[i].min);
+            residency.Request((unsigned int)parts[p].textureIndex,
+                              ProjectedError(diameter, glm::length(outside), pixelsPerUnit));
+        }
+    }
+}
@@ -0,0 +1,189 @@
+#include "VertexFormat.h"
+#include "Profiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+const char* VertexFormatName(VertexFormat format) {
+    switch (format) {
+    case VertexFormat::Float: return "float";
+    case VertexFormat::Quantized: return "quantized";
+    }
+    return "?";
+}
+
+bool ParseVertexFormat(const char* name, VertexFormat& out) {
+    if (std::strcmp(name, "float") == 0) out = VertexFormat::Float;
+    else if (std::strcmp(name, "quantized") == 0) out = VertexFormat::Quantized;
+    else return false;
+    return true;
+}
+
+unsigned int VertexFormatStride(VertexFormat format) {
+    return format == VertexFormat::Quantized ? (unsigned int)sizeof(QuantizedVertex) : kVertexStride;
+}
+
+// --- HALF ---
+uint16_t FloatToHalf(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, 4);
+    const uint16_t sign = (uint16_t)((bits >> 16) & 0x8000);
+    const uint32_t abs = bits & 0x7FFFFFFF;
+    if (abs >= 0x7F800000) return sign | 0x7C00 | (abs > 0x7F800000 ? 0x200 : 0); // vô cực / NaN
+    if (abs >= 0x477FF000) return sign | 0x7C00;                                   // >= 65520: tràn
+    if (abs < 0x38800000) {
+        // Denormal của half: mantissa (kèm bit ẩn) dịch phải, làm tròn chẵn phần bị bỏ
+        const uint32_t exponent = abs >> 23;
+        if (exponent < 102) return sign;
+        const uint32_t mantissa = (abs & 0x7FFFFF) | 0x800000;
+        const uint32_t shift = 126 - exponent;
+        uint32_t half = mantissa >> shift;
+        const uint32_t rest = mantissa & ((1u << shift) - 1), midpoint = 1u << (shift - 1);
+        if (rest > midpoint || (rest == midpoint && (half & 1))) half++;
+        return sign | (uint16_t)half;
+    }
+    // Đổi bias số mũ 127 -> 15, bỏ 13 bit mantissa (nhớ tràn sang số mũ là đúng)
+    uint32_t half = (abs - 0x38000000) >> 13;
+    const uint32_t rest = abs & 0x1FFF;
+    if (rest > 0x1000 || (rest == 0x1000 && (half & 1))) half++;
+    return sign | (uint16_t)half;
+}
+
+float HalfToFloat(uint16_t half) {
+    const uint32_t sign = (uint32_t)(half & 0x8000) << 16;
+    const uint32_t exponent = (half >> 10) & 0x1F, mantissa = half & 0x3FF;
+    uint32_t bits;
+    if (exponent == 0) {
+        float value = (float)mantissa * 5.9604644775390625e-8f; // 2^-24
+        return sign ? -value : value;
+    } else if (exponent == 31) {
+        bits = sign | 0x7F800000 | (mantissa << 13);
+    } else {
+        bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    }
+    float value;
+    std::memcpy(&value, &bits, 4);
+    return value;
+}
+
+// --- POSITION ---
+uint16_t QuantizeUnorm16(float value, float min, float extent) {
+    if (!(extent > 0.0f)) return 0;
+    const float t = std::min(std::max((value - min) / extent, 0.0f), 1.0f);
+    return (uint16_t)(t * 65535.0f + 0.5f);
+}
+
+float DequantizeUnorm16(uint16_t quantized, float min, float extent) {
+    return min + (float)quantized * (1.0f / 65535.0f) * extent;
+}
+
+// --- OCTAHEDRAL ---
+static float SignNotZero(float v) { return v < 0.0f ? -1.0f : 1.0f; }
+
+static void OctDecodeFloat(float x, float y, float out[3]) {
+    float z = 1.0f - std::fabs(x) - std::fabs(y);
+    if (z < 0.0f) {
+        const float wx = (1.0f - std::fabs(y)) * SignNotZero(x);
+        const float wy = (1.0f - std::fabs(x)) * SignNotZero(y);
+        x = wx;
+        y = wy;
+    }
+    const float length = std::sqrt(x * x + y * y + z * z);
+    out[0] = x / length;
+    out[1] = y / length;
+    out[2] = z / length;
+}
+
+void OctEncode(const float normal[3], unsigned int bits, int16_t out[2]) {
+    const float l1 = std::fabs(normal[0]) + std::fabs(normal[1]) + std::fabs(normal[2]);
+    if (!(l1 > 0.0f)) {
+        out[0] = out[1] = 0; // vector 0: giải ra +z
+        return;
+    }
+    float x = normal[0] / l1, y = normal[1] / l1;
+    if (normal[2] < 0.0f) {
+        const float wx = (1.0f - std::fabs(y)) * SignNotZero(x);
+        const float wy = (1.0f - std::fabs(x)) * SignNotZero(y);
+        x = wx;
+        y = wy;
+    }
+
+    // Làm tròn từng trục không cho sai số góc nhỏ nhất: thử 4 tổ hợp floor / ceil, giữ cặp gần normal nhất
+    const float scale = (float)((1 << (bits - 1)) - 1);
+    const float fx = std::floor(x * scale), fy = std::floor(y * scale);
+    float bestDot = -2.0f;
+    for (int i = 0; i < 4; i++) {
+        const float qx = std::min(std::max(fx + (float)(i & 1), -scale), scale);
+        const float qy = std::min(std::max(fy + (float)(i >> 1), -scale), scale);
+        float decoded[3];
+        OctDecodeFloat(qx / scale, qy / scale, decoded);
+        const float dot = decoded[0] * normal[0] + decoded[1] * normal[1] + decoded[2] * normal[2];
+        if (dot > bestDot) {
+            bestDot = dot;
+            out[0] = (int16_t)qx;
+            out[1] = (int16_t)qy;
+        }
+    }
+}
+
+void OctDecode(const int16_t encoded[2], unsigned int bits, float out[3]) {
+    const float scale = (float)((1 << (bits - 1)) - 1);
+    OctDecodeFloat(std::max((float)encoded[0] / scale, -1.0f), std::max((float)encoded[1] / scale, -1.0f), out);
+}
+
+void PackTangent(const float tangent[4], unsigned int bits, int16_t outOct[2], uint16_t& outSignLane) {
+    OctEncode(tangent, bits, outOct);
+    outSignLane = tangent[3] < 0.0f ? kTangentSignNegative : 0;
+}
+
+void UnpackTangent(const int16_t oct[2], uint16_t signLane, unsigned int bits, float out[4]) {
+    OctDecode(oct, bits, out);
+    out[3] = 1.0f - 2.0f * ((float)signLane / 65535.0f);
+}
+
+double AngleDegrees(const float a[3], const float b[3]) {
+    double dot = (double)a[0] * b[0] + (double)a[1] * b[1] + (double)a[2] * b[2];
+    double la = std::sqrt((double)a[0] * a[0] + (double)a[1] * a[1] + (double)a[2] * a[2]);
+    double lb = std::sqrt((double)b[0] * b[0] + (double)b[1] * b[1] + (double)b[2] * b[2]);
+    return std::acos(std::min(std::max(dot / (la * lb), -1.0), 1.0)) * 180.0 / 3.14159265358979323846;
+}
+
+// --- MESH ---
+void BuildPositionDecodeBuffer(const MeshPart* parts, size_t partCount, std::vector<float>& outRGBA) {
+    outRGBA.assign(partCount * 8, 0.0f);
+    for (size_t p = 0; p < partCount; p++) {
+        float* texels = &outRGBA[p * 8];
+        for (int k = 0; k < 3; k++) {
+            texels[k] = parts[p].boundsMin[k];
+            texels[4 + k] = std::max(parts[p].boundsMax[k] - parts[p].boundsMin[k], 0.0f);
+        }
+    }
+}
+
+void QuantizeVertices(const float* vertices, size_t vertexCount, const MeshPart& part, QuantizedVertex* out) {
+    float extent[3];
+    for (int k = 0; k < 3; k++) extent[k] = std::max(part.boundsMax[k] - part.boundsMin[k], 0.0f);
+    for (size_t v = 0; v < vertexCount; v++) {
+        const float* src = vertices + v * kVertexFloatCount;
+        QuantizedVertex& dst = out[v];
+        for (int k = 0; k < 3; k++) dst.position[k] = QuantizeUnorm16(src[k], part.boundsMin[k], extent[k]);
+        dst.position[3] = 0;
+        dst.uv[0] = FloatToHalf(src[3]);
+        dst.uv[1] = FloatToHalf(src[4]);
+    }
+}
+
+void QuantizeMesh(const MeshView& mesh, std::vector<QuantizedVertex>& out, JobSystem& jobs) {
+    PROFILE_SCOPE("Quantize Vertices");
+    out.assign(mesh.vertexCount, QuantizedVertex());
+    const float* vertices = static_cast<const float*>(mesh.vertexData);
+    jobs.ParallelFor(mesh.partCount, 16, [&](size_t begin, size_t end) {
+        for (size_t p = begin; p < end; p++) {
+            const MeshPart& part = mesh.parts[p];
+            if (part.baseVertex >= mesh.vertexCount) continue;
+            const size_t count = std::min<size_t>(part.vertexCount, mesh.vertexCount - part.baseVertex);
+            QuantizeVertices(vertices + (size_t)part.baseVertex * kVertexFloatCount, count, part, &out[part.baseVertex]);
+        }
+    });
+}
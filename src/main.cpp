@@ -1,14 +1,98 @@
 #include "Application.h"
 
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
 // Không cần #define SDL_MAIN_HANDLED nữa
 
+static void PrintUsage(const char* exe) {
+    std::printf("usage: %s [--headless] [--size WxH] [--no-vsync] [--pacing <mode>] [--fps N] [--still]\n"
+                "             [--run-for <seconds>] [--report <file.json>] [--vertex-format float|quantized]\n", exe);
+    std::printf("       %s --bench <model> [--frames N] [--warmup N] [--camera <script>] [--out <file.json>]\n"
+                "             [--instanced] [--headless] [--size WxH]\n", exe);
+    std::printf("  --headless   GLFW null platform + OSMesa (Mesa llvmpipe), no display needed\n");
+    std::printf("  --bench      load <model>, run the camera script with vsync off, write per-frame timings\n");
+    std::printf("  --camera     lines of 'time rotation scale distance', time in [0, 1] (default: orbit, pull back, close in)\n");
+    std::printf("  --instanced  import with Keep Hierarchy (instanced draws)\n");
+    std::printf("  --pacing     continuous (default), on-demand (redraw only on input / animation / load) or low-latency\n");
+    std::printf("  --fps        frame rate cap, 0 = uncapped\n");
+    std::printf("  --still      start with auto-rotate off\n");
+    std::printf("  --run-for    quit after <seconds> once the startup model is loaded and print frames rendered + CPU usage\n");
+    std::printf("  --report     write that pacing report as JSON\n");
+    std::printf("  --vertex-format  GPU vertex layout: quantized (default, 12 B) or float (20 B)\n");
+}
+
+// Chạy từ root repo: shaders/ của source (hot reload sửa thẳng file gốc).
+// Chạy từ chỗ khác (vd. build/): bản copy POST_BUILD nằm cạnh file chạy.
+static std::string FindShaderDir(const char* exe) {
+    std::error_code ec;
+    if (fs::exists("shaders/model.vert", ec)) return "shaders";
+    const fs::path besideExe = fs::path(exe).parent_path() / "shaders";
+    return fs::exists(besideExe / "model.vert", ec) ? besideExe.string() : "shaders";
+}
+
 int main(int argc, char* argv[]) {
+    AppOptions options;
+    BenchConfig bench;
+    bool benchMode = false;
+    int width = 1280, height = 720;
+
+#ifdef APP_HEADLESS_ONLY
+    options.headless = true; // build không có backend cửa sổ nào khác
+#endif
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        auto TakeValue = [&]() { i++; return value; };
+
+        if (std::strcmp(arg, "--headless") == 0) options.headless = true;
+        else if (std::strcmp(arg, "--no-vsync") == 0) options.vsync = false;
+        else if (std::strcmp(arg, "--instanced") == 0) bench.keepHierarchy = true;
+        else if (std::strcmp(arg, "--still") == 0) options.autoRotate = false;
+        else if (std::strcmp(arg, "--pacing") == 0 && value && ParseFrameMode(value, options.pacing.mode)) i++;
+        else if (std::strcmp(arg, "--vertex-format") == 0 && value && ParseVertexFormat(value, options.vertexFormat)) i++;
+        else if (std::strcmp(arg, "--fps") == 0 && value) options.pacing.maxFps = std::strtod(TakeValue(), nullptr);
+        else if (std::strcmp(arg, "--run-for") == 0 && value) options.runSeconds = std::strtod(TakeValue(), nullptr);
+        else if (std::strcmp(arg, "--report") == 0 && value) options.pacingReportPath = TakeValue();
+        else if (std::strcmp(arg, "--bench") == 0 && value) { benchMode = true; bench.modelPath = TakeValue(); }
+        else if (std::strcmp(arg, "--frames") == 0 && value) bench.frames = (unsigned int)std::strtoul(TakeValue(), nullptr, 10);
+        else if (std::strcmp(arg, "--warmup") == 0 && value) bench.warmupFrames = (unsigned int)std::strtoul(TakeValue(), nullptr, 10);
+        else if (std::strcmp(arg, "--camera") == 0 && value) bench.cameraScriptPath = TakeValue();
+        else if (std::strcmp(arg, "--out") == 0 && value) bench.outputPath = TakeValue();
+        else if (std::strcmp(arg, "--size") == 0 && value && std::sscanf(value, "%dx%d", &width, &height) == 2) i++;
+        else {
+            PrintUsage(argv[0]);
+            return std::strcmp(arg, "--help") == 0 || std::strcmp(arg, "-h") == 0 ? 0 : 1;
+        }
+    }
+    if (width <= 0 || height <= 0 || (benchMode && bench.frames == 0)) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    if (benchMode) {
+        options.vsync = false;       // đo CPU/GPU, không đo tần số màn hình
+        options.modelPath.clear();   // RunBenchmark tự load và tính giờ
+    }
+
+    options.shaderDir = FindShaderDir(argv[0]);
     Application* app = new Application();
 
-    if (app->Init("My Graphics Engine (GLFW)", 1280, 720)) {
-        app->Run();
+    int exitCode = 1;
+    if (app->Init("My Graphics Engine (GLFW)", width, height, options)) {
+        if (benchMode) {
+            exitCode = app->RunBenchmark(bench);
+        } else {
+            app->Run();
+            exitCode = 0;
+        }
     }
 
     delete app;
-    return 0;
+    return exitCode;
 }
@@ -0,0 +1,98 @@
+// Cull SIMD và BVH phải cho đúng kết quả của test scalar từng box (TestAABB), kể cả phần lẻ không đủ một
+// lane SIMD và sau khi Refit box đã di chuyển.
+
+#include "TestFixtures.h"
+
+#include "Culling.h"
+
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// Số box khác nhau giữa hai kết quả
+static size_t CountMismatches(const std::vector<uint8_t>& a, const uint8_t* b) {
+    size_t mismatches = 0;
+    for (size_t i = 0; i < a.size(); i++) mismatches += a[i] != b[i];
+    return mismatches;
+}
+
+int RunCullingTests() {
+    TestReport report("culling");
+    // Số box lẻ: phần đuôi không đủ 4 / 8 lane
+    const size_t count = 5003;
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f), extent(0.25f, 2.0f), offset(-3.0f, 3.0f);
+    std::vector<AABB> boxes(count);
+    BoundsSoA soa;
+    soa.Resize(count);
+    for (size_t i = 0; i < count; i++) {
+        glm::vec3 c(position(rng), position(rng), position(rng));
+        glm::vec3 e(extent(rng), extent(rng), extent(rng));
+        boxes[i] = { c - e, c + e };
+        soa.Set(i, boxes[i]);
+    }
+
+    // Camera ở tâm quay một vòng, far 150 để một phần box nằm ngoài far plane
+    const int kFrames = 32;
+    const glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 150.0f);
+    std::vector<Frustum> frustums(kFrames);
+    for (int f = 0; f < kFrames; f++) {
+        float yaw = glm::two_pi<float>() * (float)f / (float)kFrames;
+        glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(std::sin(yaw), 0.2f, std::cos(yaw)), glm::vec3(0, 1, 0));
+        frustums[f] = Frustum::FromMatrix(projection * view);
+    }
+
+    BoundsBVH bvh;
+    bvh.Build(boxes);
+    std::vector<uint8_t> reference(count), scalarVisible(count), simdVisible(count), bvhVisible;
+    size_t scalarMismatches = 0, simdMismatches = 0, bvhMismatches = 0, visibleTotal = 0, bvhCount = 0;
+    for (int pass = 0; pass < 2; pass++) {
+        // Lượt 2: dời mọi box rồi Refit, cấu trúc BVH giữ nguyên
+        if (pass == 1) {
+            for (size_t i = 0; i < count; i++) {
+                glm::vec3 d(offset(rng), offset(rng), offset(rng));
+                boxes[i] = { boxes[i].min + d, boxes[i].max + d };
+                soa.Set(i, boxes[i]);
+            }
+            bvh.Refit(boxes);
+        }
+        for (int f = 0; f < kFrames; f++) {
+            for (size_t i = 0; i < count; i++) reference[i] = TestAABB(frustums[f], boxes[i]) != CullResult::Outside;
+            CullBoxesScalar(frustums[f], soa, 0, count, scalarVisible.data());
+            CullBoxes(frustums[f], soa, 0, count, simdVisible.data());
+            const size_t visible = bvh.Cull(frustums[f], bvhVisible);
+            scalarMismatches += CountMismatches(reference, scalarVisible.data());
+            simdMismatches += CountMismatches(reference, simdVisible.data());
+            bvhMismatches += CountMismatches(reference, bvhVisible.data());
+            for (uint8_t v : reference) visibleTotal += v;
+            bvhCount += visible;
+        }
+    }
+
+    char detail[96];
+    std::snprintf(detail, sizeof(detail), "%zu boxes x %d frames, %.1f%% visible", count, 2 * kFrames,
+                  100.0 * (double)visibleTotal / ((double)count * 2 * kFrames));
+    report.Check("some boxes culled, some kept", visibleTotal > 0 && visibleTotal < count * 2 * kFrames, detail);
+    std::snprintf(detail, sizeof(detail), "%zu mismatches", scalarMismatches);
+    report.Check("scalar = TestAABB", scalarMismatches == 0, detail);
+    std::snprintf(detail, sizeof(detail), "%s, %zu mismatches", CullSimdName(), simdMismatches);
+    report.Check("SIMD = TestAABB", simdMismatches == 0, detail);
+    std::snprintf(detail, sizeof(detail), "%zu nodes, %zu mismatches", bvh.NodeCount(), bvhMismatches);
+    report.Check("BVH = TestAABB, also after refit", bvhMismatches == 0 && bvhCount == visibleTotal, detail);
+
+    // Partial range: chỉ ghi [begin, end), phần ngoài giữ nguyên
+    std::vector<uint8_t> marked(count, 7);
+    CullBoxes(frustums[0], soa, 13, 1013, marked.data());
+    bool untouched = true;
+    for (size_t i = 0; i < count; i++)
+        if (i < 13 || i >= 1013) untouched = untouched && marked[i] == 7;
+    CullBoxesScalar(frustums[0], soa, 0, count, scalarVisible.data());
+    bool inRange = true;
+    for (size_t i = 13; i < 1013; i++) inRange = inRange && marked[i] == scalarVisible[i];
+    report.Check("SIMD sub-range", untouched && inRange);
+    return report.Finish();
+}
@@ -0,0 +1,129 @@
+// Draw list phải vẽ đúng những gì đường per-part vẽ: mỗi part visible đúng một command với level được chọn,
+// mỗi state một lần gọi; batch cũ giữ lại khi số part visible giảm rồi tăng.
+
+#include "TestFixtures.h"
+
+#include "DrawBatch.h"
+#include "SyntheticData.h"
+
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+// So draw list với đường per-part: mỗi part visible đúng một command (count, offset, baseVertex) của level
+// được chọn, nằm trong batch cùng state; mỗi state đúng một batch, offset tăng dần trong batch
+static bool SameDrawsAsPerPart(const std::vector<MeshPart>& parts, const std::vector<uint8_t>& visible,
+                               const std::vector<uint8_t>& lods, const DrawList& list, std::string& detail) {
+    std::vector<int> drawn(parts.size(), 0);
+    std::set<std::pair<unsigned int, int>> states;
+    for (size_t b = 0; b < list.CallCount(); b++) {
+        const DrawBatch& batch = list.batches[b];
+        if (!states.insert({ batch.indexSize, batch.texture }).second) {
+            detail = "state split across batches";
+            return false;
+        }
+        for (size_t c = 0; c < batch.DrawCount(); c++) {
+            if (c > 0 && batch.offsets[c] <= batch.offsets[c - 1]) {
+                detail = "offsets not ascending";
+                return false;
+            }
+            // Tìm part khớp command: cùng state, baseVertex, level
+            bool found = false;
+            for (size_t p = 0; p < parts.size() && !found; p++) {
+                const MeshLod lod = PartLod(parts[p], lods[p]);
+                found = parts[p].indexSize == batch.indexSize && parts[p].textureIndex == batch.texture
+                        && (int)parts[p].baseVertex == batch.baseVertices[c] && (int)lod.indexCount == batch.counts[c]
+                        && (const void*)(size_t)lod.indexOffset == batch.offsets[c];
+                if (found) drawn[p]++;
+            }
+            if (!found) {
+                detail = "command matches no part";
+                return false;
+            }
+        }
+    }
+    size_t expected = 0;
+    for (size_t p = 0; p < parts.size(); p++) {
+        const bool draws = visible[p] && PartLod(parts[p], lods[p]).indexCount > 0;
+        expected += draws;
+        if (drawn[p] != (draws ? 1 : 0)) {
+            char text[64];
+            std::snprintf(text, sizeof(text), "part %zu drawn %d times", p, drawn[p]);
+            detail = text;
+            return false;
+        }
+    }
+    if (list.partCount != expected || list.CommandCount() != expected || list.CallCount() != states.size()) {
+        detail = "counts disagree";
+        return false;
+    }
+    char text[64];
+    std::snprintf(text, sizeof(text), "%zu parts, %zu calls", expected, list.CallCount());
+    detail = text;
+    return true;
+}
+
+int RunDrawBatchTests() {
+    TestReport report("draw-batch");
+    const size_t count = 300;
+    std::vector<MeshPart> parts;
+    MakeSyntheticParts(count, parts);
+    // 3 texture + không texture; part chia 3 có 2 LOD (LOD 1 = nửa đầu index), part 50 rỗng
+    for (size_t p = 0; p < count; p++) {
+        MeshPart& part = parts[p];
+        part.textureIndex = (int)(p % 4) - 1;
+        if (p % 3 == 0) {
+            part.lodCount = 2;
+            part.lods[0] = { part.indexOffset, part.indexCount, 0.0f };
+            part.lods[1] = { part.indexOffset, part.indexCount / 6 * 3, 0.01f };
+        }
+    }
+    parts[50].indexCount = 0;
+
+    std::mt19937 rng(3);
+    std::vector<uint8_t> allVisible(count, 1), visible(count), lod0(count, 0), lods(count);
+    for (size_t p = 0; p < count; p++) {
+        visible[p] = rng() % 4 != 0;
+        lods[p] = (uint8_t)(rng() % 3); // level 2 quá số LOD -> level thô nhất
+    }
+
+    DrawList list;
+    std::string detail;
+    BuildDrawList(parts.data(), parts.size(), nullptr, nullptr, list);
+    report.Check("all visible, LOD 0", SameDrawsAsPerPart(parts, allVisible, lod0, list, detail), detail);
+    BuildDrawList(parts.data(), parts.size(), visible.data(), lods.data(), list);
+    report.Check("75% visible, mixed LODs", SameDrawsAsPerPart(parts, visible, lods, list, detail), detail);
+
+    // Visible giảm còn một state rồi tăng lại: batch và vector command của frame trước phải còn nguyên
+    BuildDrawList(parts.data(), parts.size(), nullptr, nullptr, list);
+    const DrawBatch* batches = list.batches.data();
+    std::vector<const int*> counts;
+    for (size_t b = 0; b < list.CallCount(); b++) counts.push_back(list.batches[b].counts.data());
+    std::vector<uint8_t> few(count, 0);
+    few[1] = few[5] = 1; // cùng index 16-bit, cùng texture
+    BuildDrawList(parts.data(), parts.size(), few.data(), nullptr, list);
+    const bool shrunk = list.CallCount() == 1;
+    BuildDrawList(parts.data(), parts.size(), nullptr, nullptr, list);
+    bool reused = shrunk && list.batches.data() == batches && list.CallCount() == counts.size();
+    for (size_t b = 0; reused && b < counts.size(); b++) reused = list.batches[b].counts.data() == counts[b];
+    report.Check("batches kept when visibility drops", reused);
+
+    // Draw ID theo vertex: vertex của part p mang id p
+    std::vector<unsigned char> ids;
+    const size_t vertexCount = (size_t)parts.back().baseVertex + parts.back().vertexCount;
+    const unsigned int idSize = BuildVertexDrawIDs(parts.data(), parts.size(), vertexCount, ids);
+    bool idsOk = idSize == 2;
+    for (size_t p = 0; idsOk && p < count; p++) {
+        for (unsigned int v = 0; idsOk && v < parts[p].vertexCount; v++) {
+            uint16_t id;
+            std::memcpy(&id, &ids[((size_t)parts[p].baseVertex + v) * 2], 2);
+            idsOk = id == p;
+        }
+    }
+    report.Check("vertex draw IDs", idsOk);
+    return report.Finish();
+}
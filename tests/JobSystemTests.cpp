@@ -0,0 +1,121 @@
+// OptimizeMesh phải cho kết quả giống hệt nhau với mọi số thread; ParallelFor phải phủ mỗi phần tử đúng một lần,
+// kể cả khi lồng nhau và khi gọi từ thread ngoài pool; Wait phải thức dậy khi job cuối xong trên thread khác.
+
+#include "TestFixtures.h"
+
+#include "JobSystem.h"
+#include "MeshOptimizer.h"
+#include "SyntheticData.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+static bool SameMesh(const MeshData& a, const MeshData& b) {
+    return a.vertices == b.vertices && a.indices == b.indices && a.skin.size() == b.skin.size() &&
+           (a.skin.empty() || std::memcmp(a.skin.data(), b.skin.data(), a.skin.size() * sizeof(VertexSkin)) == 0) &&
+           a.parts.size() == b.parts.size() &&
+           (a.parts.empty() || std::memcmp(a.parts.data(), b.parts.data(), a.parts.size() * sizeof(MeshPart)) == 0);
+}
+
+// Mesh vừa import: nhiều mặt cầu độ mịn khác nhau nối lại, part nặng nhẹ lệch nhau để các thread xong lệch nhau;
+// part lẻ skinned (2 xương, weight theo độ cao) để weld / LOD mang skin theo
+static void MakeImportedMesh(size_t partCount, MeshData& out) {
+    out = MeshData();
+    MeshData sphere;
+    for (size_t p = 0; p < partCount; p++) {
+        MakeSphere(3 + (unsigned int)(p * 5 % 24), sphere);
+        MeshPart part = sphere.parts[0];
+        part.baseVertex = (unsigned int)(out.vertices.size() / kVertexFloatCount);
+        part.indexOffset = (unsigned int)out.indices.size();
+        part.skinned = p % 2;
+        for (unsigned int v = 0; v < part.vertexCount; v++) {
+            VertexSkin skin = {};
+            if (part.skinned) {
+                const float w = 0.5f + 0.5f * sphere.vertices[(size_t)v * kVertexFloatCount + 1];
+                skin.joints[0] = 0;
+                skin.joints[1] = (uint16_t)(1 + p % 3);
+                skin.weights[0] = w;
+                skin.weights[1] = 1.0f - w;
+            }
+            out.skin.push_back(skin);
+        }
+        out.vertices.insert(out.vertices.end(), sphere.vertices.begin(), sphere.vertices.end());
+        out.indices.insert(out.indices.end(), sphere.indices.begin(), sphere.indices.end());
+        out.parts.push_back(part);
+    }
+}
+
+int RunJobSystemTests() {
+    TestReport report("job-system");
+    MeshData imported;
+    MakeImportedMesh(32, imported);
+
+    MeshData reference;
+    {
+        JobSystem serial(1);
+        OptimizeMesh(imported, reference, nullptr, LodSettings(), serial);
+    }
+    const unsigned int maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    const unsigned int threadCounts[] = { 2, 3, 8, maxThreads };
+    bool same = reference.parts.size() == imported.parts.size()
+                && reference.skin.size() * kVertexFloatCount == reference.vertices.size();
+    for (unsigned int threads : threadCounts) {
+        JobSystem jobs(threads);
+        MeshData optimized;
+        OptimizeMesh(imported, optimized, nullptr, LodSettings(), jobs);
+        same = same && SameMesh(optimized, reference);
+    }
+    char detail[64];
+    std::snprintf(detail, sizeof(detail), "%zu parts, 2/3/8/%u threads", reference.parts.size(), maxThreads);
+    report.Check("optimize same for any thread count", same, detail);
+
+    // Đếm số lần mỗi phần tử được thăm: grain lẻ, count không chia hết, ParallelFor lồng trong body
+    JobSystem jobs(4);
+    const size_t count = 10007, inner = 37;
+    std::vector<std::atomic<int>> visits(count * inner);
+    jobs.ParallelFor(count, 13, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            if (i % 1000 != 0) {
+                for (size_t k = 0; k < inner; k++) visits[i * inner + k].fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            jobs.ParallelFor(inner, 1, [&](size_t b, size_t e) {
+                for (size_t k = b; k < e; k++) visits[i * inner + k].fetch_add(1, std::memory_order_relaxed);
+            });
+        }
+    });
+    // Thread ngoài pool gọi cùng lúc với thread chính
+    std::vector<std::atomic<int>> outside(count);
+    std::thread caller([&]() {
+        jobs.ParallelFor(count, 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) outside[i].fetch_add(1, std::memory_order_relaxed);
+        });
+    });
+    jobs.ParallelFor(count, 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) outside[i].fetch_add(1, std::memory_order_relaxed);
+    });
+    caller.join();
+    bool once = true, twice = true;
+    for (const std::atomic<int>& v : visits) once = once && v.load() == 1;
+    for (const std::atomic<int>& v : outside) twice = twice && v.load() == 2;
+    report.Check("ParallelFor covers once, nested", once);
+    report.Check("ParallelFor from outside thread", twice);
+
+    // Job cuối chạy trên worker: Wait hết job để giúp phải ngủ rồi được đánh thức khi counter về 0
+    JobSystem pair(2);
+    JobCounter counter;
+    std::atomic<bool> started{false};
+    pair.Submit(counter, [&started]() {
+        started = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    });
+    while (!started) std::this_thread::yield();
+    pair.Wait(counter);
+    report.Check("Wait wakes when worker finishes", counter.Done());
+    return report.Finish();
+}
@@ -0,0 +1,86 @@
+// Chuỗi LOD phải tất định, mỗi level giảm đủ tam giác, sai số báo tăng dần, nằm dưới giới hạn và bám sát sai số
+// đo được; chọn level phải có hysteresis để không nhấp nháy ở ranh giới.
+
+#include "TestFixtures.h"
+
+#include "LodSelection.h"
+#include "MeshOptimizer.h"
+#include "SyntheticData.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+int RunLodTests() {
+    TestReport report("lod");
+    MeshData raw, first, second;
+    MakeSphere(48, raw);
+    LodSettings settings;
+    OptimizeMesh(raw, first, nullptr, settings);
+    OptimizeMesh(raw, second, nullptr, settings);
+    report.Check("optimize + LOD deterministic", first.indices == second.indices && first.parts.size() == second.parts.size()
+                 && std::memcmp(first.parts.data(), second.parts.data(), first.parts.size() * sizeof(MeshPart)) == 0);
+
+    const MeshPart& part = first.parts[0];
+    char detail[128];
+    std::snprintf(detail, sizeof(detail), "%u levels, radius %.3g", PartLodCount(part), part.sphere[3]);
+    if (!report.Check("sphere gets a LOD chain", PartLodCount(part) >= 3, detail)) return report.Finish();
+
+    // Level l so với level l - 1: số tam giác, sai số báo, sai số đo (Hausdorff một chiều từ vertex LOD 0)
+    const float* vertices = first.vertices.data() + (size_t)part.baseVertex * kVertexFloatCount;
+    std::vector<unsigned int> previous, current;
+    ReadLodIndices(first, part, PartLod(part, 0), previous);
+    bool reduced = true, bounded = true, ascending = true, tracked = true;
+    std::string levels;
+    for (unsigned int l = 1; l < PartLodCount(part); l++) {
+        const MeshLod lod = PartLod(part, l);
+        ReadLodIndices(first, part, lod, current);
+        const float measured = MeasureDeviation(vertices, part.vertexCount, kVertexFloatCount, current);
+        reduced = reduced && (float)current.size() <= (float)previous.size() * settings.minGain;
+        bounded = bounded && lod.error <= settings.maxRelativeError * part.sphere[3] + 1e-6f;
+        ascending = ascending && lod.error >= PartLod(part, l - 1).error;
+        // QEM đo bình phương khoảng cách tới mặt phẳng, không phải tới tam giác: cho phép lệch 2 lần
+        tracked = tracked && measured <= 2.0f * lod.error && lod.error <= 2.0f * measured;
+        char level[48];
+        std::snprintf(level, sizeof(level), " %zu:%.3g/%.3g", current.size() / 3, lod.error, measured);
+        levels += level;
+        previous.swap(current);
+    }
+    report.Check("each level <= minGain x previous", reduced);
+    report.Check("error within maxRelativeError", bounded);
+    report.Check("error ascending", ascending);
+    report.Check("reported error tracks measured", tracked, "tris:reported/measured" + levels);
+
+    MeshData tiny, tinyOut;
+    MakeSphere(3, tiny);
+    OptimizeMesh(tiny, tinyOut, nullptr, settings);
+    report.Check("small part gets no LOD", PartLodCount(tinyOut.parts[0]) == 1);
+
+    // Chọn level: gần -> LOD 0, xa -> level thô nhất, forcedLevel kẹp theo số level
+    LodParams params;
+    params.pixelsPerUnit = 540.0f; // 1080p, fovY 90°
+    const unsigned int last = PartLodCount(part) - 1;
+    LodParams forced = params;
+    forced.forcedLevel = 99;
+    report.Check("near / far / forced selection", SelectLod(part, 1.0f, 0.01f, last, params) == 0
+                 && SelectLod(part, 1.0f, 1e6f, 0, params) == last && SelectLod(part, 1.0f, 0.01f, 0, forced) == last);
+
+    // Hysteresis: khoảng cách dao động ±2% quanh ranh giới LOD 0/1, đếm số lần đổi level
+    const float boundary = PartLod(part, 1).error * params.pixelsPerUnit / params.threshold;
+    int switches[2] = { 0, 0 };
+    for (int withHysteresis = 0; withHysteresis < 2; withHysteresis++) {
+        params.hysteresis = withHysteresis ? LodParams().hysteresis : 1.0f;
+        unsigned int lod = 0;
+        for (int frame = 0; frame < 1000; frame++) {
+            float distance = boundary * (1.0f + 0.02f * std::sin((float)frame * 0.1f));
+            unsigned int next = SelectLod(part, 1.0f, distance, lod, params);
+            switches[withHysteresis] += next != lod;
+            lod = next;
+        }
+    }
+    std::snprintf(detail, sizeof(detail), "%d switches without, %d with over 1000 frames at +-2%%", switches[0], switches[1]);
+    report.Check("hysteresis stops flicker", switches[0] > 10 && switches[1] <= 1, detail);
+    return report.Finish();
+}
@@ -0,0 +1,118 @@
+// MeshCacheReader::Open phải từ chối cache có giá trị sẽ được dùng làm index / offset mà trỏ ra ngoài bảng,
+// để loader import lại thay vì đọc ngoài vùng nhớ.
+
+#include "TestFixtures.h"
+
+#include "MeshCache.h"
+#include "SyntheticData.h"
+#include "TextureCodec.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <string>
+
+namespace fs = std::filesystem;
+
+// Ghi mesh (sau khi corrupt sửa) ra file tạm, sửa header nếu có corruptHeader, rồi mở lại; true nếu Open nhận
+static bool CacheOpens(const MeshData& source, const std::function<void(MeshData&)>& corrupt,
+                       const std::function<void(MeshCacheHeader&)>& corruptHeader = nullptr) {
+    MeshData mesh = source;
+    if (corrupt) corrupt(mesh);
+    const std::string path = (fs::temp_directory_path() / "renderer_tests.meshcache").string();
+    MeshCacheKey key;
+    if (!WriteMeshCache(path, key, mesh.View())) return false;
+    if (corruptHeader) {
+        FILE* f = std::fopen(path.c_str(), "r+b");
+        MeshCacheHeader header;
+        bool patched = f && std::fread(&header, sizeof(header), 1, f) == 1;
+        if (patched) {
+            corruptHeader(header);
+            patched = std::fseek(f, 0, SEEK_SET) == 0 && std::fwrite(&header, sizeof(header), 1, f) == 1;
+        }
+        if (f) std::fclose(f);
+        if (!patched) return false;
+    }
+    MeshCacheReader reader;
+    const bool opened = reader.Open(path, nullptr);
+    reader.Close();
+    std::error_code ec;
+    fs::remove(path, ec);
+    return opened;
+}
+
+int RunMeshCacheTests() {
+    TestReport report("mesh-cache");
+    // Part: draw và hot reload đọc index / vertex theo offset, count, LOD của part
+    MeshData parts;
+    MakeReloadMesh({ 1, 2, 3, 9, 18 }, parts);
+    if (!report.Check("valid parts open", CacheOpens(parts, nullptr))) return report.Finish();
+    report.Check("index size not 2 or 4", !CacheOpens(parts, [](MeshData& m) {
+        m.parts[1].indexSize = 3;
+    }));
+    report.Check("misaligned index offset", !CacheOpens(parts, [](MeshData& m) {
+        m.parts[3].indexOffset += 2; // part 3 dùng index 32-bit
+    }));
+    report.Check("indices past the index buffer", !CacheOpens(parts, [](MeshData& m) {
+        m.parts[4].indexCount = 0x7FFFFFFF;
+    }));
+    report.Check("vertices past the vertex buffer", !CacheOpens(parts, [](MeshData& m) {
+        m.parts[2].baseVertex = 0xFFFFFFF0;
+    }));
+    report.Check("LOD count past the LOD table", !CacheOpens(parts, [](MeshData& m) {
+        m.parts[0].lodCount = kMaxMeshLods + 1;
+    }));
+    report.Check("LOD indices past the index buffer", !CacheOpens(parts, [](MeshData& m) {
+        m.parts[0].lods[1].indexOffset = (unsigned int)m.indices.size();
+    }));
+
+    // Header: offset / count tràn uint64 khi nhân, hoặc lệch lề so với lúc ghi
+    report.Check("part count overflowing the file size", !CacheOpens(parts, nullptr, [](MeshCacheHeader& h) {
+        h.partCount = 0xFFFFFFFF;
+    }));
+    report.Check("vertex count wrapping around", !CacheOpens(parts, nullptr, [](MeshCacheHeader& h) {
+        h.vertexCount = ~0ull / kVertexStride + 2;
+    }));
+    report.Check("misaligned part table", !CacheOpens(parts, nullptr, [](MeshCacheHeader& h) {
+        h.partsOffset += 4;
+    }));
+
+    MeshData character;
+    MakeSyntheticCharacter(20, 200, character);
+    if (!report.Check("valid skinned mesh opens", CacheOpens(character, nullptr))) return report.Finish();
+
+    report.Check("joint index past the joint table", !CacheOpens(character, [](MeshData& m) {
+        m.skin[17].joints[1] = (uint16_t)m.joints.size();
+    }));
+    report.Check("unweighted slot past the joint table", !CacheOpens(character, [](MeshData& m) {
+        m.skin[3].joints[3] = 0xFFFF; // shader fetch cả 4 joint
+    }));
+    report.Check("weighted vertex without joints", !CacheOpens(character, [](MeshData& m) {
+        m.joints.clear();
+    }));
+
+    // Texture: loader upload từng mip theo offset / size trong desc, part tra textures[textureIndex]
+    MeshData textured = character;
+    Image image;
+    MakeSyntheticImage(64, false, image);
+    textured.textures.resize(1);
+    CookTexture(image, textured.textures[0], textured.textureData);
+    textured.parts[0].textureIndex = 0;
+    if (!report.Check("valid textured mesh opens", CacheOpens(textured, nullptr))) return report.Finish();
+    report.Check("texture without mips", !CacheOpens(textured, [](MeshData& m) {
+        m.textures[0].mipCount = 0;
+    }));
+    report.Check("mip count past the mip table", !CacheOpens(textured, [](MeshData& m) {
+        m.textures[0].mipCount = kMaxTextureMips + 1;
+    }));
+    report.Check("mip offset past the texture blob", !CacheOpens(textured, [](MeshData& m) {
+        m.textures[0].mips[2].offset = m.textureData.size() - 4;
+    }));
+    report.Check("mip smaller than its level", !CacheOpens(textured, [](MeshData& m) {
+        m.textures[0].mips[0].size -= 8;
+    }));
+    report.Check("part texture past the texture table", !CacheOpens(textured, [](MeshData& m) {
+        m.parts[0].textureIndex = 1;
+    }));
+    return report.Finish();
+}
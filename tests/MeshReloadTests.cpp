@@ -0,0 +1,149 @@
+// Hot reload theo hash từng part: plan của PlanMeshReload áp lên buffer giả lập trên CPU phải cho ra đúng mesh mới
+// ở offset mới, chỉ ghi phần đổi.
+
+#include "TestFixtures.h"
+
+#include "MeshReload.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// Buffer GPU giả lập trên CPU: VBO + draw ID (32-bit cho gọn) + EBO
+struct ReloadBuffers {
+    std::vector<unsigned char> vertices;
+    std::vector<uint32_t> drawIDs;
+    std::vector<unsigned char> indices;
+};
+
+// Như một lần upload toàn bộ của ModelUploader với headroom
+static void UploadFullCpu(const MeshData& mesh, float headroom, ReloadBuffers& gpu, ResidentMesh& resident) {
+    const MeshView view = mesh.View();
+    const size_t vertexCapacity = view.vertexCount + (size_t)((double)view.vertexCount * headroom);
+    const size_t indexCapacity = ((view.IndexBytes() + (size_t)((double)view.IndexBytes() * headroom)) + 3) / 4 * 4;
+    gpu.vertices.assign(vertexCapacity * kVertexStride, 0);
+    gpu.drawIDs.assign(vertexCapacity, 0xFFFFFFFFu);
+    gpu.indices.assign(indexCapacity, 0);
+    std::memcpy(gpu.vertices.data(), view.vertexData, view.VertexBytes());
+    std::memcpy(gpu.indices.data(), view.indexData, view.IndexBytes());
+    for (size_t p = 0; p < view.partCount; p++)
+        for (unsigned int v = 0; v < view.parts[p].vertexCount; v++) gpu.drawIDs[view.parts[p].baseVertex + v] = (uint32_t)p;
+    std::vector<uint64_t> hashes;
+    HashMeshParts(view, hashes);
+    ResetResidentMesh(view, std::move(hashes), vertexCapacity, indexCapacity, view.partCount <= 0x10000 ? 2 : 4,
+                      kVertexStride, resident);
+}
+
+// Như UploadReloadPlan
+static void ApplyReloadPlanCpu(const MeshData& mesh, const MeshReloadPlan& plan, ReloadBuffers& gpu) {
+    for (const MeshReloadPlan::Copy& copy : plan.vertexCopies)
+        std::memcpy(&gpu.vertices[copy.dest * kVertexStride], &mesh.vertices[copy.source * kVertexFloatCount],
+                    copy.count * kVertexStride);
+    for (const MeshReloadPlan::Copy& copy : plan.indexCopies)
+        std::memcpy(&gpu.indices[copy.dest], &mesh.indices[copy.source], copy.count);
+    for (unsigned int p : plan.drawIDParts)
+        for (unsigned int v = 0; v < plan.parts[p].vertexCount; v++) gpu.drawIDs[plan.parts[p].baseVertex + v] = p;
+}
+
+// Bảng part resident phải vẽ ra đúng mesh mới: vertex, index mọi LOD và draw ID tại offset mới
+static size_t VerifyResident(const MeshData& mesh, const std::vector<MeshPart>& parts, const ReloadBuffers& gpu) {
+    size_t bad = 0;
+    for (size_t p = 0; p < mesh.parts.size(); p++) {
+        const MeshPart& src = mesh.parts[p];
+        const MeshPart& dst = parts[p];
+        bool ok = dst.vertexCount == src.vertexCount && dst.lodCount == src.lodCount
+                  && (size_t)(dst.baseVertex + dst.vertexCount) * kVertexStride <= gpu.vertices.size()
+                  && std::memcmp(&gpu.vertices[(size_t)dst.baseVertex * kVertexStride],
+                                 &mesh.vertices[(size_t)src.baseVertex * kVertexFloatCount],
+                                 (size_t)src.vertexCount * kVertexStride) == 0;
+        for (unsigned int v = 0; ok && v < dst.vertexCount; v++) ok = gpu.drawIDs[dst.baseVertex + v] == p;
+        for (unsigned int l = 0; ok && l < PartLodCount(src); l++) {
+            const MeshLod a = PartLod(src, l), b = PartLod(dst, l);
+            ok = a.indexCount == b.indexCount && b.indexOffset + (size_t)b.indexCount * src.indexSize <= gpu.indices.size()
+                 && std::memcmp(&gpu.indices[b.indexOffset], &mesh.indices[a.indexOffset],
+                                (size_t)a.indexCount * src.indexSize) == 0;
+        }
+        ok = ok && dst.indexOffset == dst.lods[0].indexOffset && dst.indexCount == dst.lods[0].indexCount;
+        if (!ok) bad++;
+    }
+    return bad;
+}
+
+// Chuỗi chỉnh sửa trên mesh giả lập (sửa / thêm / xoá / đổi chỗ part), mỗi lần: plan theo hash, ghi vào
+// buffer giả lập, kiểm tra mọi part ở offset mới; in byte ghi so với upload toàn bộ và số lần phải nén lại
+int RunMeshReloadTests() {
+    TestReport report("mesh-reload");
+    const size_t count = 500;
+    std::vector<uint32_t> ids(count);
+    for (size_t p = 0; p < count; p++) ids[p] = (uint32_t)p;
+    MeshData mesh;
+    MakeReloadMesh(ids, mesh);
+    ReloadBuffers gpu;
+    ResidentMesh resident;
+    UploadFullCpu(mesh, kReloadHeadroom, gpu, resident);
+    std::vector<MeshPart> residentParts = mesh.parts;
+    auto FullBytes = [](const MeshData& m) { return m.View().VertexBytes() + m.View().IndexBytes() + m.View().vertexCount * 2; };
+    std::printf(" %zu parts, %.1f KiB per full upload (+%.0f%% headroom)\n", count, FullBytes(mesh) / 1024.0,
+                kReloadHeadroom * 100.0f);
+
+    struct Edit { const char* name; int modify, add, remove, swap; };
+    const Edit edits[] = {
+        { "unchanged", 0, 0, 0, 0 },
+        { "edit 1 part", 1, 0, 0, 0 },
+        { "edit 10 parts", 10, 0, 0, 0 },
+        { "add 5 parts", 0, 5, 0, 0 },
+        { "remove 5 parts", 0, 0, 5, 0 },
+        { "swap 2 parts", 0, 0, 0, 1 },
+        { "mixed", 8, 3, 3, 2 },
+        { "rewrite 1/4", (int)(count / 4), 0, 0, 0 },
+        { "add 1/3", 0, (int)(count / 3), 0, 0 },
+    };
+    std::vector<uint64_t> hashes;
+    std::mt19937 rng(42);
+    uint32_t nextId = (uint32_t)count;
+    size_t mismatched = 0, fullUploads = 0, round = 0;
+    bool unchangedFree = true;
+    for (int pass = 0; pass < 4; pass++) {
+        for (const Edit& edit : edits) {
+            for (int i = 0; i < edit.modify; i++) ids[rng() % ids.size()] = nextId++;
+            for (int i = 0; i < edit.add; i++) ids.insert(ids.begin() + rng() % (ids.size() + 1), nextId++);
+            for (int i = 0; i < edit.remove; i++) ids.erase(ids.begin() + rng() % ids.size());
+            for (int i = 0; i < edit.swap; i++) std::swap(ids[rng() % ids.size()], ids[rng() % ids.size()]);
+            MakeReloadMesh(ids, mesh);
+            HashMeshParts(mesh.View(), hashes);
+
+            MeshReloadPlan plan;
+            const bool incremental = PlanMeshReload(mesh.View(), hashes, residentParts.data(), residentParts.size(),
+                                                    resident, plan);
+            if (incremental) {
+                ApplyReloadPlanCpu(mesh, plan, gpu);
+                residentParts = plan.parts;
+            } else {
+                UploadFullCpu(mesh, kReloadHeadroom, gpu, resident);
+                residentParts = mesh.parts;
+                fullUploads++;
+            }
+            const size_t bad = VerifyResident(mesh, residentParts, gpu);
+            mismatched += bad;
+            if (edit.modify + edit.add + edit.remove + edit.swap == 0)
+                unchangedFree = unchangedFree && incremental && plan.uploadBytes == 0;
+            if (!incremental)
+                std::printf("    #%-3zu %-15s full upload %8.1f KiB (%s)%s\n", round, edit.name, FullBytes(mesh) / 1024.0,
+                            plan.fullReason.c_str(), bad ? " MISMATCH" : "");
+            else if (pass == 0 || bad)
+                std::printf("    #%-3zu %-15s kept %5zu, wrote %4zu, removed %3zu: %8.1f KiB (%5.2f%% of full)%s\n", round,
+                            edit.name, plan.reusedParts, plan.uploadedParts, plan.removedParts, plan.uploadBytes / 1024.0,
+                            100.0 * (double)plan.uploadBytes / (double)FullBytes(mesh), bad ? " MISMATCH" : "");
+            round++;
+        }
+    }
+    char detail[128];
+    std::snprintf(detail, sizeof(detail), "%zu reloads, %zu full uploads (compaction / out of space), %zu mismatched parts",
+                  round, fullUploads, mismatched);
+    report.Check("resident parts match the new mesh", mismatched == 0, detail);
+    report.Check("unchanged mesh writes nothing", unchangedFree);
+    report.Check("most reloads stay incremental", fullUploads * 4 < round);
+    return report.Finish();
+}
@@ -0,0 +1,155 @@
+// Submit model qua RenderDevice + RecordingBackend không GPU: lệnh mỗi frame theo loại là ngân sách API
+// (in ra để so giữa các commit), frame ổn định không được đặt lại program / polygon mode / uniform không đổi.
+
+#include "TestFixtures.h"
+
+#include "DrawBatch.h"
+#include "ModelSubmit.h"
+#include "RenderDevice.h"
+#include "SyntheticData.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+static std::string FormatCalls(const GpuCallCounts& counts) {
+    std::string out;
+    for (uint32_t c = 0; c < kCallCount; c++) {
+        if (!counts.calls[c]) continue;
+        out += " " + std::string(GpuCallName((GpuCall)c)) + "=" + std::to_string(counts.calls[c]);
+    }
+    return out;
+}
+
+int RunRenderDeviceTests() {
+    TestReport report("render-device");
+    const size_t count = 500;
+    std::vector<MeshPart> parts;
+    MakeSyntheticParts(count, parts);
+    // 4 texture + không texture; 0..3 instance mỗi part (0 = bị cull); part chia 3 có stream CPU skinning
+    const unsigned int textureHandles[4] = { 11, 12, 13, 14 };
+    std::vector<unsigned int> visibleOffset(count * kMaxMeshLods + 1, 0), skinnedBase(count, ~0u);
+    std::vector<uint8_t> visible(count);
+    unsigned int instances = 0, skinnedVertices = 0;
+    for (size_t p = 0; p < count; p++) {
+        parts[p].textureIndex = (int)(p % 5) - 1;
+        visibleOffset[p * kMaxMeshLods] = instances;
+        const unsigned int n = (unsigned int)(p % 4);
+        for (unsigned int lod = 0; lod < kMaxMeshLods; lod++) visibleOffset[p * kMaxMeshLods + lod + 1] = instances + n;
+        instances += n;
+        visible[p] = n > 0;
+        if (p % 3 == 0) {
+            skinnedBase[p] = skinnedVertices;
+            skinnedVertices += parts[p].vertexCount;
+        }
+    }
+    DrawList list;
+    BuildDrawList(parts.data(), parts.size(), visible.data(), nullptr, list);
+
+    ModelUniforms uniforms;
+    std::string error;
+    const bool rejected = !uniforms.Resolve(MakeModelReflection(1, 96), error);
+    report.Check("mismatched Camera block", rejected, rejected ? error : "u_Model at offset 96 accepted");
+    ProgramReflection program = MakeModelReflection(1, 128);
+    const bool resolved = uniforms.Resolve(program, error);
+    if (!report.Check("model program layout", resolved, resolved ? "" : error)) return report.Finish();
+
+    RecordingBackend recorder;
+    RenderDevice device(&recorder);
+    CameraBlock camera = { glm::mat4(1.0f), glm::mat4(1.0f), glm::mat4(1.0f) };
+
+    struct Mode { const char* name; bool batched, flattened, cpuSkinning; };
+    const Mode modes[] = {
+        { "batched, flattened", true, true, false },
+        { "batched, instanced", true, false, false },
+        { "instanced + CPU skin", true, false, true },
+        { "per part", false, false, false },
+    };
+    for (const Mode& mode : modes) {
+        device.SetBackend(&recorder);
+        uniforms.Resolve(program, error);
+        ModelSubmitInput input;
+        input.program = &program;
+        input.uniforms = &uniforms;
+        input.cameraBuffer = 1;
+        input.camera = &camera;
+        input.modelVAO = 1;
+        input.skinnedVAO = mode.cpuSkinning ? 2 : 0;
+        input.skinnedBase = skinnedBase.data();
+        input.textureHandles = textureHandles;
+        input.textureCount = 4;
+        input.materialTexture = 1;
+        input.instanceTexture = 2;
+        input.instanceIndexTexture = 3;
+        input.paletteTexture = 4;
+        input.partDecodeTexture = 5;
+        input.batched = mode.batched;
+        input.flattened = mode.flattened;
+        input.cpuSkinning = mode.cpuSkinning;
+        input.gpuSkinning = !mode.cpuSkinning;
+        input.quantizedPositions = true;
+        input.parts = parts.data();
+        input.partCount = parts.size();
+        input.visibleOffset = visibleOffset.data();
+        input.drawList = &list;
+
+        // Số draw mong đợi: một lần gọi mỗi batch / mỗi part có instance / mỗi instance
+        int expectedDraws = 0;
+        for (size_t p = 0; p < count; p++) {
+            const unsigned int n = visibleOffset[(p + 1) * kMaxMeshLods] - visibleOffset[p * kMaxMeshLods];
+            expectedDraws += mode.batched ? (n > 0 ? 1 : 0) : (int)n;
+        }
+        if (mode.flattened) expectedDraws = (int)list.CallCount();
+
+        std::printf(" %s: %d draws expected\n", mode.name, expectedDraws);
+        GpuCallCounts frames[6];
+        const char* frameNames[6] = { "cold", "steady", "steady", "wireframe", "camera moved", "shader reload" };
+        bool drawsOk = true, cameraOk = true, stateOk = true, coldOk = true;
+        for (int f = 0; f < 6; f++) {
+            if (f == 3) input.wireframe = true;
+            if (f == 4) camera.view = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -2.0f));
+            if (f == 5) {
+                program = MakeModelReflection(7, 128); // link lại: id + serial mới, sampler đã gán lúc link
+                uniforms.Resolve(program, error);
+            }
+            recorder.ResetCounts();
+            recorder.SetTrace(f == 0);
+            device.ResetSkipped();
+            device.BeginFrame();
+            const int draws = SubmitModel(device, input);
+            frames[f] = recorder.Counts();
+            const GpuCallCounts& c = frames[f];
+            std::printf("    %-13s %5u calls, %5u skipped:%s\n", frameNames[f], c.Total(), device.Skipped().Total(),
+                        FormatCalls(c).c_str());
+
+            const int recordedDraws = (int)(c.calls[kCallDraw] + c.calls[kCallMultiDraw]);
+            drawsOk = drawsOk && draws == expectedDraws && recordedDraws == draws;
+            // Camera: một lần orphan + ghi mỗi frame, binding point chỉ đặt khi chưa biết
+            cameraOk = cameraOk && c.calls[kCallBufferData] == 1 && c.calls[kCallBufferSubData] == 1
+                       && c.calls[kCallBindBufferBase] <= 1;
+            const bool newProgram = f == 0 || f == 5;
+            stateOk = stateOk && c.calls[kCallUseProgram] == (newProgram ? 1u : 0u)
+                      && c.calls[kCallPolygonMode] == (f == 0 || f == 3 ? 1u : 0u);
+            if (f == 0) coldOk = !recorder.Trace().empty() && recorder.Trace()[0] == kCallUseProgram;
+        }
+        report.Check("draws submitted = recorded", drawsOk);
+        report.Check("camera block written once", cameraOk);
+        report.Check("program / polygon mode filtered", stateOk);
+        report.Check("cold frame starts with UseProgram", coldOk);
+        // Frame ổn định giống hệt nhau; uniform không đổi không gửi lại (ít hơn frame lạnh), program mới gửi lại hết
+        report.Check("steady frames identical",
+                     std::memcmp(&frames[1], &frames[2], sizeof(GpuCallCounts)) == 0 && frames[4].Total() == frames[1].Total());
+        char detail[96];
+        std::snprintf(detail, sizeof(detail), "cold %u, steady %u, reload %u", frames[0].calls[kCallUniform],
+                      frames[1].calls[kCallUniform], frames[5].calls[kCallUniform]);
+        report.Check("uniform cache", frames[1].calls[kCallUniform] < frames[0].calls[kCallUniform]
+                                      && frames[5].calls[kCallUniform] == frames[0].calls[kCallUniform], detail);
+        input.wireframe = false;
+        camera.view = glm::mat4(1.0f);
+        program = MakeModelReflection(1, 128);
+    }
+    return report.Finish();
+}
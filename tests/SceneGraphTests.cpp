@@ -0,0 +1,107 @@
+// Chế độ instanced phải vẽ đúng hình của chế độ flattened: instance matrix = tích local dọc đường tới root,
+// bounds của instance khớp bản copy đã transform; cập nhật subtree dirty phải ra giống build lại từ đầu.
+
+#include "TestFixtures.h"
+
+#include "DrawBatch.h"
+#include "MeshOptimizer.h"
+#include "SceneGraph.h"
+#include "SyntheticData.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+static float MaxDifference(const glm::mat4& a, const glm::mat4& b) {
+    float maxError = 0.0f;
+    for (int c = 0; c < 4; c++)
+        for (int r = 0; r < 4; r++) maxError = std::max(maxError, std::abs(a[c][r] - b[c][r]));
+    return maxError;
+}
+
+// World matrix tính lại từ bảng node (không qua SceneGraph), instance theo thứ tự node như slot của part 0
+static void ReferenceInstances(const MeshData& mesh, std::vector<glm::mat4>& out) {
+    std::vector<glm::mat4> world(mesh.nodes.size());
+    out.clear();
+    for (size_t n = 0; n < mesh.nodes.size(); n++) {
+        const SceneNode& node = mesh.nodes[n];
+        const glm::mat4 local = glm::make_mat4(node.local);
+        world[n] = node.parent >= 0 ? world[node.parent] * local : local;
+        for (unsigned int r = 0; r < node.meshRefCount; r++) out.push_back(world[n]);
+    }
+}
+
+static bool SameInstances(const SceneGraph& scene, const std::vector<glm::mat4>& expected, float tolerance) {
+    if (scene.TotalInstances() != expected.size()) return false;
+    for (size_t i = 0; i < expected.size(); i++)
+        if (MaxDifference(scene.Instances()[i], expected[i]) > tolerance) return false;
+    return true;
+}
+
+int RunSceneGraphTests() {
+    TestReport report("scene-graph");
+    const size_t repeats = 300;
+    MeshData instanced, flattened;
+    MakeSyntheticScene(repeats, instanced);
+    FlattenScene(instanced, flattened);
+
+    SceneGraph scene;
+    scene.Build(instanced.View());
+    std::vector<glm::mat4> expected;
+    ReferenceInstances(instanced, expected);
+    char detail[96];
+    std::snprintf(detail, sizeof(detail), "%zu nodes, %zu instances", scene.NodeCount(), scene.TotalInstances());
+    if (!report.Check("instances = parent chain products", SameInstances(scene, expected, 0.0f), detail))
+        return report.Finish();
+
+    // Flattened: mỗi instance một part; cùng số tam giác, bounds instance (để cull) bao đúng bản copy
+    const MeshPart& mesh = instanced.parts[0];
+    DrawList list;
+    BuildDrawList(flattened.parts.data(), flattened.parts.size(), nullptr, nullptr, list);
+    size_t flatIndices = 0;
+    for (const MeshPart& part : flattened.parts) flatIndices += part.indexCount;
+    std::snprintf(detail, sizeof(detail), "%zu commands, %zu vs %zu indices", list.CommandCount(), flatIndices,
+                  (size_t)mesh.indexCount * scene.InstanceCount(0));
+    report.Check("flattened draws the same triangles", list.CommandCount() == scene.TotalInstances()
+                 && flatIndices == (size_t)mesh.indexCount * scene.InstanceCount(0), detail);
+    float boundsError = 0.0f;
+    for (size_t i = 0; i < flattened.parts.size() && i < scene.TotalInstances(); i++) {
+        MeshPart copy = flattened.parts[i];
+        ComputePartBounds(&flattened.vertices[(size_t)copy.baseVertex * kVertexFloatCount], copy.vertexCount,
+                          kVertexFloatCount, copy);
+        const AABB& bounds = scene.InstanceBounds()[i];
+        for (int k = 0; k < 3; k++) {
+            boundsError = std::max(boundsError, std::abs(bounds.min[k] - copy.boundsMin[k]));
+            boundsError = std::max(boundsError, std::abs(bounds.max[k] - copy.boundsMax[k]));
+        }
+    }
+    std::snprintf(detail, sizeof(detail), "max diff %.2g", boundsError);
+    report.Check("instance bounds = flattened bounds", boundsError < 1e-4f, detail);
+
+    // Xoay group thứ 2 (node 66: root, group 1 + 64 node, rồi group 2) và dời một leaf của group 1
+    const size_t group = 66, leaf = 10;
+    const glm::mat4 groupLocal = glm::rotate(scene.LocalTransform(group), 0.7f, glm::vec3(0.0f, 1.0f, 0.0f));
+    const glm::mat4 leafLocal = glm::translate(scene.LocalTransform(leaf), glm::vec3(0.0f, 2.0f, 0.0f));
+    MeshData moved = instanced;
+    std::memcpy(moved.nodes[group].local, glm::value_ptr(groupLocal), sizeof(moved.nodes[group].local));
+    std::memcpy(moved.nodes[leaf].local, glm::value_ptr(leafLocal), sizeof(moved.nodes[leaf].local));
+    ReferenceInstances(moved, expected);
+
+    scene.ClearInstanceChanges();
+    scene.SetLocalTransform(group, groupLocal);
+    scene.SetLocalTransform(leaf, leafLocal);
+    const size_t updated = scene.UpdateWorldTransforms();
+    // Slot theo thứ tự node có mesh: leaf 10 là instance 8, group 2 là instance 64..127
+    std::snprintf(detail, sizeof(detail), "%zu nodes recomputed, instances [%zu, %zu) changed", updated,
+                  scene.ChangedBegin(), scene.ChangedEnd());
+    report.Check("dirty subtrees only", updated == 1 + instanced.nodes[group].subtreeSize && scene.ChangedBegin() == 8
+                 && scene.ChangedEnd() == 128, detail);
+    report.Check("dirty update = rebuild", SameInstances(scene, expected, 0.0f));
+    report.Check("clean update does nothing", scene.UpdateWorldTransforms() == 0);
+    return report.Finish();
+}
@@ -0,0 +1,80 @@
+// Lấy mẫu animation có cache key phải giống hệt binary search, CPU skinning SIMD / song song phải khớp scalar.
+
+#include "TestFixtures.h"
+
+#include "Animation.h"
+#include "JobSystem.h"
+#include "Skinning.h"
+#include "SyntheticData.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+static bool SamePose(const LocalPose& a, const LocalPose& b) {
+    return a.tx == b.tx && a.ty == b.ty && a.tz == b.tz && a.rx == b.rx && a.ry == b.ry && a.rz == b.rz
+        && a.rw == b.rw && a.sx == b.sx && a.sy == b.sy && a.sz == b.sz;
+}
+
+static float MaxDifference(const std::vector<float>& a, const std::vector<float>& b) {
+    float maxError = 0.0f;
+    for (size_t i = 0; i < a.size(); i++) maxError = std::max(maxError, std::abs(a[i] - b[i]));
+    return maxError;
+}
+
+int RunSkinningTests() {
+    TestReport report("skinning");
+    MeshData mesh;
+    MakeSyntheticCharacter(60, 5000, mesh);
+    const MeshView view = mesh.View();
+    AnimationRig rig;
+    rig.Build(view);
+    if (!report.Check("synthetic character rig", rig.ClipCount() == 2 && rig.JointCount() > 0)) return report.Finish();
+
+    // Key cache: bước 1/60 s qua nhiều vòng loop, thỉnh thoảng tua lại; pose phải giống hệt từng bit
+    bool same = true;
+    int samples = 0;
+    LocalPose cached = rig.BindPose(), reference = rig.BindPose();
+    for (int clip = 0; clip < (int)rig.ClipCount() && same; clip++) {
+        AnimationCursor cursor;
+        cursor.clip = clip;
+        const float duration = rig.Clip(clip).duration;
+        for (int step = 0; step < 600 && same; step++) {
+            rig.Advance(cursor, step % 97 == 96 ? -duration * 0.37f : 1.0f / 60.0f);
+            rig.Sample(cursor, cached);
+            rig.SampleReference(clip, cursor.time, reference);
+            same = SamePose(cached, reference);
+            samples++;
+        }
+    }
+    char detail[128];
+    std::snprintf(detail, sizeof(detail), "%d poses over %zu clips, stepping and rewinding", samples, rig.ClipCount());
+    report.Check("cached keys = binary search", same, detail);
+
+    // Palette của một nhân vật đang trộn 2 clip
+    CharacterAnimation character;
+    character.base.clip = 0;
+    character.base.time = 0.3f;
+    character.blend.clip = 1;
+    character.blendWeight = 0.5f;
+    std::vector<glm::mat4> world(rig.NodeCount()), palette(rig.JointCount());
+    rig.Evaluate(&character, 1, 1.0f / 60.0f, nullptr, world.data(), palette.data());
+
+    std::vector<float> source;
+    std::vector<VertexSkin> weights;
+    std::vector<unsigned int> skinnedBase;
+    const size_t vertexCount = GatherSkinnedVertices(view, source, weights, skinnedBase);
+    std::vector<float> scalarOut(source.size()), simdOut(source.size()), parallelOut(source.size());
+    SkinVerticesScalar(source.data(), weights.data(), vertexCount, palette.data(), scalarOut.data());
+    SkinVertices(source.data(), weights.data(), vertexCount, palette.data(), simdOut.data());
+    JobSystem jobs(4);
+    SkinVerticesParallel(source.data(), weights.data(), vertexCount, palette.data(), parallelOut.data(), jobs);
+
+    const float simdError = MaxDifference(scalarOut, simdOut), parallelError = MaxDifference(simdOut, parallelOut);
+    std::snprintf(detail, sizeof(detail), "%zu vertices, %s, max diff %.2g", vertexCount, SkinSimdName(), simdError);
+    report.Check("SIMD skinning = scalar", vertexCount > 0 && simdError < 1e-4f, detail);
+    std::snprintf(detail, sizeof(detail), "4 threads, max diff %.2g", parallelError);
+    report.Check("parallel skinning = single thread", parallelError == 0.0f, detail);
+    return report.Finish();
+}
@@ -0,0 +1,79 @@
+#include "TestFixtures.h"
+#include "ModelSubmit.h"
+
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+TestReport::TestReport(const char* suite) : m_Suite(suite) {
+    std::printf("%s\n", suite);
+}
+
+bool TestReport::Check(const char* name, bool ok, const std::string& detail) {
+    std::printf("  %-36s %s  %s\n", name, ok ? "ok  " : "FAIL", detail.c_str());
+    if (!ok) m_Failures++;
+    return ok;
+}
+
+int TestReport::Finish() const {
+    std::printf("%s: %d failures\n", m_Suite, m_Failures);
+    return m_Failures ? 1 : 0;
+}
+
+void MakeReloadMesh(const std::vector<uint32_t>& ids, MeshData& out) {
+    out = MeshData();
+    out.parts.resize(ids.size());
+    std::vector<std::vector<uint32_t>> lodIndices[2];
+    lodIndices[0].resize(ids.size());
+    lodIndices[1].resize(ids.size());
+    for (size_t p = 0; p < ids.size(); p++) {
+        std::mt19937 rng(ids[p] * 7919u + 1);
+        std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+        MeshPart& part = out.parts[p];
+        std::memset(&part, 0, sizeof(part));
+        part.vertexCount = 40 + ids[p] % 5 * 8;
+        part.baseVertex = (unsigned int)(out.vertices.size() / kVertexFloatCount);
+        part.indexSize = ids[p] % 9 == 0 ? 4 : 2;
+        part.textureIndex = -1;
+        part.lodCount = 2;
+        for (unsigned int v = 0; v < part.vertexCount * kVertexFloatCount; v++) out.vertices.push_back(value(rng));
+        for (unsigned int l = 0; l < 2; l++) {
+            const unsigned int triangles = (part.vertexCount - 2) >> l;
+            for (unsigned int i = 0; i < triangles * 3; i++) lodIndices[l][p].push_back(rng() % part.vertexCount);
+        }
+    }
+    for (unsigned int l = 0; l < 2; l++) {
+        for (size_t p = 0; p < ids.size(); p++) {
+            MeshPart& part = out.parts[p];
+            size_t offset = (out.indices.size() + part.indexSize - 1) / part.indexSize * part.indexSize;
+            const std::vector<uint32_t>& source = lodIndices[l][p];
+            out.indices.resize(offset + source.size() * part.indexSize);
+            for (size_t i = 0; i < source.size(); i++) {
+                if (part.indexSize == 2) {
+                    uint16_t index = (uint16_t)source[i];
+                    std::memcpy(&out.indices[offset + i * 2], &index, 2);
+                } else {
+                    std::memcpy(&out.indices[offset + i * 4], &source[i], 4);
+                }
+            }
+            part.lods[l] = { (unsigned int)offset, (unsigned int)source.size(), 0.01f * l };
+        }
+    }
+    for (MeshPart& part : out.parts) {
+        part.indexOffset = part.lods[0].indexOffset;
+        part.indexCount = part.lods[0].indexCount;
+    }
+}
+
+ProgramReflection MakeModelReflection(unsigned int programId, int cameraModelOffset) {
+    ProgramReflection program;
+    program.program = programId;
+    program.serial = NextProgramSerial();
+    const char* names[] = { "u_Materials", "u_Instances", "u_InstanceIndices", "u_Palette", "u_PartDecode",
+                            "u_InstanceBase", "u_UseMaterials", "u_GpuSkinning", "u_QuantizedPositions",
+                            "u_Color", "u_BaseColor", "u_HasTexture" };
+    for (int i = 0; i < (int)(sizeof(names) / sizeof(names[0])); i++) program.uniforms.push_back({ names[i], i, 0, 1 });
+    program.blocks.push_back({ "Camera", 0, kCameraBlockBinding, 192,
+                               { { "u_Projection", 0 }, { "u_View", 64 }, { "u_Model", cameraModelOffset } } });
+    return program;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "MeshData.h"
+#include "RenderDevice.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// --- TEST FIXTURES ---
+// Cách báo kết quả của renderer_tests (mỗi kiểm tra một dòng "ok" / "FAIL", exit code khác 0 nếu có lỗi)
+// và dữ liệu chỉ test cần; mesh / ảnh / nhân vật tổng hợp dùng chung với meshcook nằm trong SyntheticData.h.
+
+class TestReport {
+public:
+    explicit TestReport(const char* suite);
+
+    // In một dòng; false = tính là lỗi
+    bool Check(const char* name, bool ok, const std::string& detail = std::string());
+    int Failures() const { return m_Failures; }
+    // In tổng kết, trả về exit code
+    int Finish() const;
+
+private:
+    const char* m_Suite;
+    int m_Failures = 0;
+};
+
+// Mesh giả lập cho hot reload: nội dung part p chỉ phụ thuộc ids[p], 2 LOD xếp xen kẽ như OptimizeMesh
+// (LOD 0 của mọi part rồi mới tới LOD 1), part p % 9 == 0 dùng index 32-bit
+void MakeReloadMesh(const std::vector<uint32_t>& ids, MeshData& out);
+
+// Reflection như ShaderProgram đọc từ shaders/model.*, location giả; programId / serial khác = program mới
+ProgramReflection MakeModelReflection(unsigned int programId, int cameraModelOffset);
+
+// Các nhóm test (tests/*Tests.cpp), mỗi nhóm trả về exit code
+int RunCullingTests();
+int RunDrawBatchTests();
+int RunJobSystemTests();
+int RunLodTests();
+int RunMeshCacheTests();
+int RunMeshReloadTests();
+int RunRenderDeviceTests();
+int RunSceneGraphTests();
+int RunSkinningTests();
+int RunTextureCodecTests();
+int RunVertexFormatTests();
@@ -0,0 +1,47 @@
+// renderer_tests [suite]...: các kiểm tra không cần GPU / file model, ctest gọi từng nhóm.
+// Không có tham số = chạy hết.
+
+#include "TestFixtures.h"
+
+#include <cstdio>
+#include <cstring>
+
+struct TestSuite {
+    const char* name;
+    int (*run)();
+};
+
+static const TestSuite kSuites[] = {
+    { "culling", RunCullingTests },
+    { "draw-batch", RunDrawBatchTests },
+    { "job-system", RunJobSystemTests },
+    { "lod", RunLodTests },
+    { "mesh-cache", RunMeshCacheTests },
+    { "mesh-reload", RunMeshReloadTests },
+    { "render-device", RunRenderDeviceTests },
+    { "scene-graph", RunSceneGraphTests },
+    { "skinning", RunSkinningTests },
+    { "texture-codec", RunTextureCodecTests },
+    { "vertex-format", RunVertexFormatTests },
+};
+
+int main(int argc, char* argv[]) {
+    int result = 0;
+    if (argc < 2) {
+        for (const TestSuite& suite : kSuites) result |= suite.run();
+        return result;
+    }
+    for (int i = 1; i < argc; i++) {
+        const TestSuite* found = nullptr;
+        for (const TestSuite& suite : kSuites)
+            if (std::strcmp(suite.name, argv[i]) == 0) found = &suite;
+        if (!found) {
+            std::fprintf(stderr, "renderer_tests: unknown suite %s; suites:", argv[i]);
+            for (const TestSuite& suite : kSuites) std::fprintf(stderr, " %s", suite.name);
+            std::fprintf(stderr, "\n");
+            return 1;
+        }
+        result |= found->run();
+    }
+    return result;
+}
@@ -0,0 +1,77 @@
+// BC1 / BC3 trên ảnh tổng hợp phải giữ chất lượng tối thiểu; CookTexture phải ra bảng mip khớp blob
+// (đúng số level, căn lề, đủ byte) vì loader và MeshCacheReader tin vào nó.
+
+#include "TestFixtures.h"
+
+#include "SyntheticData.h"
+#include "TextureCodec.h"
+
+#include <cstdio>
+#include <vector>
+
+// Desc + blob do CookTexture sinh: mip tới 1x1, căn lề kTextureAlignment, mỗi level đủ byte và nằm trong blob
+static bool ValidCookedTexture(const TextureDesc& desc, const std::vector<unsigned char>& blob) {
+    if (desc.mipCount != MipCount(desc.width, desc.height)) return false;
+    for (unsigned int l = 0; l < desc.mipCount; l++) {
+        const TextureMip& mip = desc.mips[l];
+        if (mip.offset % kTextureAlignment != 0 || mip.offset + mip.size > blob.size()) return false;
+        if (mip.size != TextureLevelBytes(desc.format, MipExtent(desc.width, l), MipExtent(desc.height, l))) return false;
+    }
+    return true;
+}
+
+int RunTextureCodecTests() {
+    TestReport report("texture-codec");
+    Image opaque, alpha;
+    MakeSyntheticImage(256, false, opaque);
+    MakeSyntheticImage(256, true, alpha);
+
+    // Chỉ sai khi codec hỏng hẳn (ảnh tổng hợp có nhiễu nên không đạt mức ảnh thật)
+    std::vector<unsigned char> bc1(TextureLevelBytes(TextureFormat::BC1, opaque.width, opaque.height));
+    std::vector<unsigned char> bc3(TextureLevelBytes(TextureFormat::BC3, alpha.width, alpha.height));
+    EncodeImage(opaque, TextureFormat::BC1, bc1.data());
+    EncodeImage(alpha, TextureFormat::BC3, bc3.data());
+    Image decoded;
+    char detail[64];
+    DecodeTextureLevel(bc1.data(), TextureFormat::BC1, opaque.width, opaque.height, decoded);
+    const double bc1Psnr = ImagePsnr(opaque, decoded, 3);
+    std::snprintf(detail, sizeof(detail), "%.2f dB", bc1Psnr);
+    report.Check("BC1 RGB PSNR > 25 dB", bc1Psnr > 25.0, detail);
+
+    DecodeTextureLevel(bc3.data(), TextureFormat::BC3, alpha.width, alpha.height, decoded);
+    const double bc3Psnr = ImagePsnr(alpha, decoded, 3);
+    std::snprintf(detail, sizeof(detail), "%.2f dB", bc3Psnr);
+    report.Check("BC3 RGB PSNR > 25 dB", bc3Psnr > 25.0, detail);
+    // PSNR riêng kênh alpha: dời alpha về kênh 0
+    Image a = alpha, b = decoded;
+    for (size_t i = 0; i < a.rgba.size(); i += 4) {
+        a.rgba[i] = a.rgba[i + 3];
+        b.rgba[i] = b.rgba[i + 3];
+    }
+    const double alphaPsnr = ImagePsnr(a, b, 1);
+    std::snprintf(detail, sizeof(detail), "%.2f dB", alphaPsnr);
+    report.Check("BC3 alpha PSNR > 25 dB", alphaPsnr > 25.0, detail);
+
+    // Ảnh không vuông để mip chạm 1 ở một cạnh trước
+    Image wide;
+    MakeSyntheticImage(64, false, wide);
+    wide.height = 16;
+    wide.rgba.resize((size_t)wide.width * wide.height * 4);
+    struct Case { const char* name; const Image* image; bool compress; TextureFormat format; };
+    const Case cases[] = {
+        { "opaque image cooks to BC1", &opaque, true, TextureFormat::BC1 },
+        { "alpha image cooks to BC3", &alpha, true, TextureFormat::BC3 },
+        { "uncompressed cooks to RGBA8", &opaque, false, TextureFormat::RGBA8 },
+        { "64x16 mip chain", &wide, true, TextureFormat::BC1 },
+    };
+    for (const Case& c : cases) {
+        TextureDesc desc;
+        std::vector<unsigned char> blob(5, 0); // nối vào blob có sẵn: offset tính từ đầu blob
+        CookTexture(*c.image, desc, blob, c.compress);
+        std::snprintf(detail, sizeof(detail), "format %u, %u mips, %zu bytes", (unsigned int)desc.format,
+                      desc.mipCount, blob.size());
+        report.Check(c.name, desc.format == c.format && desc.width == c.image->width
+                             && desc.height == c.image->height && ValidCookedTexture(desc, blob), detail);
+    }
+    return report.Finish();
+}
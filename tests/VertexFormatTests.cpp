@@ -0,0 +1,193 @@
+// Encoder của định dạng vertex GPU đi một vòng trong giới hạn sai số, và mesh lượng tử hoá theo AABB của part
+// giải lại được như vertex shader.
+
+#include "TestFixtures.h"
+
+#include "SyntheticData.h"
+#include "VertexFormat.h"
+
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <initializer_list>
+#include <random>
+#include <vector>
+
+static void RandomUnitVector(std::mt19937& rng, float out[3]) {
+    std::normal_distribution<float> gauss;
+    float length = 0.0f;
+    while (length < 1e-6f) {
+        for (int k = 0; k < 3; k++) out[k] = gauss(rng);
+        length = std::sqrt(out[0] * out[0] + out[1] * out[1] + out[2] * out[2]);
+    }
+    for (int k = 0; k < 3; k++) out[k] /= length;
+}
+
+// Encoder của VertexFormat: half, unorm16 theo AABB, octahedral + dấu tangent
+static void CheckEncoders(TestReport& report, float octBound16, float octBound8) {
+    char detail[160];
+    std::mt19937 rng(7);
+
+    // Half: mọi giá trị hữu hạn đi một vòng giữ nguyên bit; float ngẫu nhiên về half gần nhất
+    size_t badRoundTrip = 0;
+    for (uint32_t h = 0; h < 0x10000; h++) {
+        if (((h >> 10) & 0x1F) == 31 && (h & 0x3FF)) {
+            badRoundTrip += !std::isnan(HalfToFloat((uint16_t)h));
+            continue;
+        }
+        badRoundTrip += FloatToHalf(HalfToFloat((uint16_t)h)) != h;
+    }
+    std::snprintf(detail, sizeof(detail), "65536 bit patterns, %zu mismatched", badRoundTrip);
+    report.Check("half round trip", badRoundTrip == 0, detail);
+
+    std::uniform_real_distribution<float> exponent(-26.0f, 16.0f);
+    size_t notNearest = 0;
+    double maxRelative = 0.0;
+    for (int i = 0; i < 1000000; i++) {
+        float value = std::exp2(exponent(rng)) * ((rng() & 1) ? -1.0f : 1.0f);
+        if (std::fabs(value) >= 65504.0f) continue;
+        uint16_t h = FloatToHalf(value);
+        double error = std::fabs((double)HalfToFloat(h) - value);
+        // Hai half kề bên (cùng dấu) không được gần hơn
+        for (int step : { -1, 1 }) {
+            uint16_t neighbor = (uint16_t)(h + step);
+            if ((neighbor & 0x7FFF) >= 0x7C00 || ((neighbor ^ h) & 0x8000)) continue;
+            if (std::fabs((double)HalfToFloat(neighbor) - value) < error) notNearest++;
+        }
+        if (std::fabs(value) >= 6.103515625e-5f) maxRelative = std::max(maxRelative, error / std::fabs(value));
+    }
+    std::snprintf(detail, sizeof(detail), "1M values, %zu not nearest, max relative error %.3g (bound %.3g)", notNearest,
+                  maxRelative, std::exp2(-11.0));
+    report.Check("half rounding", notNearest == 0 && maxRelative <= std::exp2(-11.0), detail);
+    const bool overflow = FloatToHalf(65519.0f) == 0x7BFF && FloatToHalf(65520.0f) == 0x7C00
+                          && FloatToHalf(-1e9f) == 0xFC00 && std::isnan(HalfToFloat(FloatToHalf(NAN)));
+    report.Check("half overflow / NaN", overflow, "65519 -> 65504, 65520 -> inf, NaN stays NaN");
+
+    // Unorm16 theo AABB (extent = max - min như QuantizeVertices): sai số <= nửa bước + làm tròn float,
+    // hai đầu chính xác, ngoài hộp bị kẹp
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    double worstSteps = 0.0;
+    size_t aboveBound = 0;
+    bool ends = true;
+    for (int i = 0; i < 100000; i++) {
+        const float size = std::exp2(unit(rng) * 20.0f - 10.0f);
+        const float min = (unit(rng) - 0.5f) * 20.0f * size, max = min + size * (0.5f + unit(rng));
+        const float extent = max - min, value = min + unit(rng) * extent;
+        const double step = extent / 65535.0;
+        const double ulp = std::max(std::fabs(min), std::fabs(max)) * std::exp2(-23.0);
+        const double error = std::fabs((double)DequantizeUnorm16(QuantizeUnorm16(value, min, extent), min, extent) - value);
+        worstSteps = std::max(worstSteps, error / step);
+        aboveBound += error > 0.5 * step + 4.0 * ulp;
+        ends = ends && QuantizeUnorm16(min, min, extent) == 0 && QuantizeUnorm16(max, min, extent) == 65535
+               && QuantizeUnorm16(min - extent, min, extent) == 0 && QuantizeUnorm16(max + extent, min, extent) == 65535;
+    }
+    ends = ends && QuantizeUnorm16(3.0f, 3.0f, 0.0f) == 0 && DequantizeUnorm16(0, 3.0f, 0.0f) == 3.0f;
+    std::snprintf(detail, sizeof(detail), "100k values, max error %.3f steps, %zu above 0.5 step + float rounding",
+                  worstSteps, aboveBound);
+    report.Check("position unorm16", aboveBound == 0, detail);
+    report.Check("position ends / clamp", ends, "min -> 0, max -> 65535, outside clamped, zero extent -> min");
+
+    // Octahedral: ngẫu nhiên + trục + biên các bát phân (chỗ gập của phép chiếu)
+    std::vector<std::array<float, 3>> directions;
+    for (int i = 0; i < 200000; i++) {
+        std::array<float, 3> n;
+        RandomUnitVector(rng, n.data());
+        directions.push_back(n);
+    }
+    const float r = std::sqrt(0.5f);
+    for (float sx : { -1.0f, 0.0f, 1.0f })
+        for (float sy : { -1.0f, 0.0f, 1.0f })
+            for (float sz : { -1.0f, 0.0f, 1.0f }) {
+                float length = std::sqrt(sx * sx + sy * sy + sz * sz);
+                if (length > 0.0f) directions.push_back({ sx / length, sy / length, sz / length });
+            }
+    directions.push_back({ r, -r, 0.0f });
+    directions.push_back({ 0.0f, r, -r });
+    for (unsigned int bits : { 16u, 8u }) {
+        double worst = 0.0, mean = 0.0;
+        for (const std::array<float, 3>& n : directions) {
+            int16_t encoded[2];
+            float decoded[3];
+            OctEncode(n.data(), bits, encoded);
+            OctDecode(encoded, bits, decoded);
+            const double angle = AngleDegrees(n.data(), decoded);
+            worst = std::max(worst, angle);
+            mean += angle;
+        }
+        mean /= (double)directions.size();
+        const float bound = bits == 16 ? octBound16 : octBound8;
+        std::snprintf(detail, sizeof(detail), "%zu directions, max %.5f deg, mean %.5f deg (bound %.4g)",
+                      directions.size(), worst, mean, bound);
+        report.Check(bits == 16 ? "octahedral 2 x snorm16" : "octahedral 2 x snorm8", worst <= bound, detail);
+    }
+
+    size_t signErrors = 0;
+    double tangentWorst = 0.0;
+    for (int i = 0; i < 100000; i++) {
+        float tangent[4], decoded[4];
+        RandomUnitVector(rng, tangent);
+        tangent[3] = (rng() & 1) ? -1.0f : 1.0f;
+        int16_t oct[2];
+        uint16_t lane = 0;
+        PackTangent(tangent, 16, oct, lane);
+        UnpackTangent(oct, lane, 16, decoded);
+        signErrors += decoded[3] != tangent[3];
+        tangentWorst = std::max(tangentWorst, AngleDegrees(tangent, decoded));
+    }
+    std::snprintf(detail, sizeof(detail), "100k tangents, %zu sign errors, max %.5f deg", signErrors, tangentWorst);
+    report.Check("tangent + handedness", signErrors == 0 && tangentWorst <= octBound16, detail);
+}
+
+
+// Như vertex shader: offset + (q / 65535) * extent từ buffer hằng số của part; sai số trong nửa bước lượng tử
+static void CheckQuantizedSphere(TestReport& report) {
+    MeshData mesh;
+    MakeSphere(64, mesh);
+    MeshPart& part = mesh.parts[0];
+    for (int k = 0; k < 3; k++) {
+        part.boundsMin[k] = FLT_MAX;
+        part.boundsMax[k] = -FLT_MAX;
+    }
+    for (size_t v = 0; v < part.vertexCount; v++)
+        for (int k = 0; k < 3; k++) {
+            part.boundsMin[k] = std::min(part.boundsMin[k], mesh.vertices[v * kVertexFloatCount + k]);
+            part.boundsMax[k] = std::max(part.boundsMax[k], mesh.vertices[v * kVertexFloatCount + k]);
+        }
+    std::vector<QuantizedVertex> quantized(part.vertexCount);
+    QuantizeVertices(mesh.vertices.data(), part.vertexCount, part, quantized.data());
+    std::vector<float> decode;
+    BuildPositionDecodeBuffer(mesh.parts.data(), mesh.parts.size(), decode);
+
+    const float* offset = &decode[0];
+    const float* scale = &decode[4];
+    const float largest = std::max({ scale[0], scale[1], scale[2], 1e-20f });
+    double maxRelative = 0.0;
+    size_t uvAboveBound = 0;
+    for (size_t v = 0; v < part.vertexCount; v++) {
+        const float* src = &mesh.vertices[v * kVertexFloatCount];
+        const QuantizedVertex& q = quantized[v];
+        for (int k = 0; k < 3; k++) {
+            const double error = std::fabs(offset[k] + (q.position[k] / 65535.0f) * scale[k] - src[k]);
+            maxRelative = std::max(maxRelative, error / largest);
+        }
+        for (int k = 0; k < 2; k++) {
+            const double error = std::fabs((double)HalfToFloat(q.uv[k]) - src[3 + k]);
+            uvAboveBound += error > std::max(std::fabs(src[3 + k]) * std::exp2(-11.0), std::exp2(-25.0));
+        }
+    }
+    char detail[160];
+    std::snprintf(detail, sizeof(detail), "%u vertices, max error %.3g of the AABB (bound %.3g)", part.vertexCount,
+                  maxRelative, 0.51 / 65535.0);
+    report.Check("quantized positions decode", maxRelative <= 0.51 / 65535.0 + 1e-6, detail);
+    std::snprintf(detail, sizeof(detail), "%zu UVs above half a half ulp", uvAboveBound);
+    report.Check("quantized UVs", uvAboveBound == 0, detail);
+}
+
+int RunVertexFormatTests() {
+    TestReport report("vertex-format");
+    CheckEncoders(report, 0.01f, 1.0f); // độ
+    CheckQuantizedSphere(report);
+    return report.Finish();
+}
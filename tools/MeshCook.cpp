@@ -0,0 +1,1031 @@
+// meshcook: nấu sẵn mesh cache cho model và so sánh thời gian import / load cache.
+//
+//   meshcook cook <model>... [--force]
+//   meshcook inspect <model|cache>...
+//   meshcook bench-batch <model|cache|N>
+//   meshcook compare-instancing <model|N>
+//   meshcook bench-cull <N>
+//   meshcook check-lod <model|N>
+//   meshcook bench-jobs [N]
+//   meshcook bench-texture [image|N]
+//   meshcook bench-skin [model|N]
+//   meshcook check-vertex [model|N]
+
+#include "Animation.h"
+#include "Culling.h"
+#include "DrawBatch.h"
+#include "JobSystem.h"
+#include "LodSelection.h"
+#include "MeshCache.h"
+#include "MeshOptimizer.h"
+#include "SceneGraph.h"
+#include "Skinning.h"
+#include "SyntheticData.h"
+#include "TextureCodec.h"
+#include "VertexFormat.h"
+
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include "ModelImporter.h"
+
+#include <assimp/mesh.h>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+static double MsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+static bool EndsWith(const std::string& s, const char* suffix) {
+    size_t n = std::strlen(suffix);
+    return s.size() >= n && s.compare(s.size() - n, n, suffix) == 0;
+}
+
+static void PrintUsage() {
+    std::printf("usage:\n");
+    std::printf("  meshcook cook <model>... [--force]   import + optimize + write cache, report per-part stats and import vs cache-load time\n");
+    std::printf("  meshcook inspect <model|cache>...    print cache header and part table\n");
+    std::printf("  meshcook bench-batch <model|cache|N> time draw list building (N = synthetic part count)\n");
+    std::printf("  meshcook compare-instancing <model|N> memory/draw figures, flattened vs instanced (N = synthetic repeats)\n");
+    std::printf("  meshcook bench-cull <N>              frustum culling throughput on N random boxes: scalar vs %s vs BVH\n",
+                CullSimdName());
+    std::printf("  meshcook check-lod <model|N>         LOD chain: determinism, reduction, reported vs measured error, hysteresis (N = sphere segments)\n");
+    std::printf("  meshcook bench-jobs [N]              import conversion + optimize scaling 1..%u threads on N synthetic meshes\n",
+                std::max(1u, std::thread::hardware_concurrency()));
+    std::printf("  meshcook bench-texture [image|N]     decode / mip / BC1+BC3 encode throughput per thread count, PSNR and size (N = synthetic size)\n");
+    std::printf("  meshcook bench-skin [model|N]        key sampling, pose bones/ms and CPU skinning vertices/ms per thread count (N = characters)\n");
+    std::printf("  meshcook check-vertex [model|N]      bytes/vertex and max position / UV / normal error per format (N = sphere segments)\n");
+}
+
+static const char* TextureFormatName(TextureFormat format) {
+    switch (format) {
+    case TextureFormat::BC1: return "BC1";
+    case TextureFormat::BC3: return "BC3";
+    default: return "RGBA8";
+    }
+}
+
+static void PrintLods(const MeshPart& part) {
+    if (PartLodCount(part) < 2) return;
+    std::printf("        LOD tris");
+    for (unsigned int l = 0; l < PartLodCount(part); l++) std::printf(" %u", PartLod(part, l).indexCount / 3);
+    std::printf(" | error");
+    for (unsigned int l = 1; l < PartLodCount(part); l++) std::printf(" %.4g", PartLod(part, l).error);
+    std::printf(" (radius %.4g)\n", part.sphere[3]);
+}
+
+static void PrintOptimizeStats(const std::vector<MeshPartStats>& stats, const std::vector<MeshPart>& parts) {
+    size_t before = 0, after = 0, lodBytes = 0;
+    for (size_t i = 0; i < stats.size(); i++) {
+        const MeshPartStats& s = stats[i];
+        std::printf("  [%3zu] tris %zu, verts %zu -> %zu, ACMR %.3f -> %.3f, VB %zu -> %zu, IB %zu -> %zu (%d-bit)\n",
+                    i, s.triangleCount, s.vertexCountBefore, s.vertexCountAfter, s.acmrBefore, s.acmrAfter,
+                    s.vertexBytesBefore, s.vertexBytesAfter, s.indexBytesBefore, s.indexBytesAfter,
+                    parts[i].indexSize * 8);
+        PrintLods(parts[i]);
+        before += s.vertexBytesBefore + s.indexBytesBefore;
+        after += s.vertexBytesAfter + s.indexBytesAfter;
+        lodBytes += s.lodIndexBytes;
+    }
+    std::printf("  total buffers %.1f KiB -> %.1f KiB (+ %.1f KiB LOD indices)\n", before / 1024.0, after / 1024.0,
+                lodBytes / 1024.0);
+}
+
+static int Cook(const std::vector<std::string>& files, bool force) {
+    int failures = 0;
+    for (const std::string& path : files) {
+        MeshCacheKey key;
+        if (!MakeMeshCacheKey(path.c_str(), kDefaultImportFlags, key)) {
+            std::fprintf(stderr, "%s: cannot stat source\n", path.c_str());
+            failures++;
+            continue;
+        }
+        std::string cachePath = MeshCachePath(path.c_str(), kDefaultImportFlags);
+
+        MeshCacheReader reader;
+        if (!force && reader.Open(cachePath, &key)) {
+            std::printf("%s: up to date (%s)\n", path.c_str(), cachePath.c_str());
+            continue;
+        }
+        reader.Close();
+
+        auto start = Clock::now();
+        MeshData raw;
+        std::string error;
+        if (!ImportModel(path.c_str(), kDefaultImportFlags, raw, &error)) {
+            std::fprintf(stderr, "%s: import failed: %s\n", path.c_str(), error.c_str());
+            failures++;
+            continue;
+        }
+        double importMs = MsSince(start);
+
+        start = Clock::now();
+        MeshData mesh;
+        std::vector<MeshPartStats> stats;
+        OptimizeMesh(raw, mesh, &stats);
+        double optimizeMs = MsSince(start);
+
+        start = Clock::now();
+        if (!WriteMeshCache(cachePath, key, mesh.View(), mesh.textureFiles)) {
+            failures++;
+            continue;
+        }
+        double writeMs = MsSince(start);
+
+        start = Clock::now();
+        if (!reader.Open(cachePath, &key)) {
+            std::fprintf(stderr, "%s: freshly written cache failed validation\n", path.c_str());
+            failures++;
+            continue;
+        }
+        double mapMs = MsSince(start);
+
+        // Chạm từng page một lần để thấy chi phí page-in thật sự
+        start = Clock::now();
+        const MeshView& view = reader.View();
+        const unsigned char* bytes = static_cast<const unsigned char*>(view.vertexData);
+        size_t total = reader.Header()->fileSize - reader.Header()->verticesOffset;
+        unsigned int checksum = 0;
+        for (size_t i = 0; i < total; i += 4096) checksum += bytes[i];
+        double touchMs = MsSince(start);
+
+        std::printf("%s -> %s\n", path.c_str(), cachePath.c_str());
+        std::printf("  parts %zu, vertices %zu, index bytes %zu, %.1f KiB\n",
+                    view.partCount, view.vertexCount, view.indexBytes, reader.Header()->fileSize / 1024.0);
+        PrintOptimizeStats(stats, mesh.parts);
+        if (!mesh.textures.empty())
+            std::printf("  textures %zu, %.1f KiB compressed (+ %zu external files tracked)\n", mesh.textures.size(),
+                        mesh.textureData.size() / 1024.0, mesh.textureFiles.size());
+        std::printf("  import %.2f ms + optimize %.2f ms | write %.2f ms | cache map %.3f ms + page-in %.3f ms (x%.0f faster) [%u]\n",
+                    importMs, optimizeMs, writeMs, mapMs, touchMs,
+                    (importMs + optimizeMs) / (mapMs + touchMs + 1e-6), checksum & 0xff);
+    }
+    return failures ? 1 : 0;
+}
+
+static int Inspect(const std::vector<std::string>& files) {
+    int failures = 0;
+    for (const std::string& path : files) {
+        std::string cachePath = EndsWith(path, ".meshcache") ? path : MeshCachePath(path.c_str(), kDefaultImportFlags);
+        MeshCacheReader reader;
+        if (!reader.Open(cachePath, nullptr)) {
+            std::fprintf(stderr, "%s: not a valid mesh cache (version %u)\n", cachePath.c_str(), kMeshCacheVersion);
+            failures++;
+            continue;
+        }
+
+        const MeshCacheHeader* h = reader.Header();
+        std::printf("%s\n", cachePath.c_str());
+        std::printf("  version %u, flags 0x%08x, source size %llu, mtime %llu, path hash %016llx\n",
+                    h->version, h->importFlags, (unsigned long long)h->sourceSize,
+                    (unsigned long long)h->sourceMtime, (unsigned long long)h->pathHash);
+        std::printf("  parts %u @%llu, vertices %llu @%llu, index bytes %llu @%llu, file %llu bytes\n",
+                    h->partCount, (unsigned long long)h->partsOffset,
+                    (unsigned long long)h->vertexCount, (unsigned long long)h->verticesOffset,
+                    (unsigned long long)h->indexBytes, (unsigned long long)h->indicesOffset,
+                    (unsigned long long)h->fileSize);
+
+        MeshCacheKey key;
+        if (MakeMeshCacheKey(path.c_str(), h->importFlags, key) && !EndsWith(path, ".meshcache")) {
+            bool fresh = key.pathHash == h->pathHash && key.sourceMtime == h->sourceMtime && key.sourceSize == h->sourceSize;
+            std::printf("  %s\n", fresh ? "up to date" : "STALE");
+        }
+
+        const MeshView& view = reader.View();
+        for (size_t i = 0; i < view.partCount; i++) {
+            const MeshPart& p = view.parts[i];
+            std::printf("  [%3zu] indices %u @%u (%u-bit), vertices %u @%u, color (%.2f %.2f %.2f %.2f), texture %d\n", i,
+                        p.indexCount, p.indexOffset, p.indexSize * 8, p.vertexCount, p.baseVertex,
+                        p.color[0], p.color[1], p.color[2], p.color[3], p.textureIndex);
+            PrintLods(p);
+        }
+        std::printf("  skin %s, joints %llu, clips %llu, channels %llu, keys %llu\n", h->skinCount ? "yes" : "no",
+                    (unsigned long long)h->jointCount, (unsigned long long)h->clipCount,
+                    (unsigned long long)h->channelCount, (unsigned long long)h->keyCount);
+        for (size_t i = 0; i < view.clipCount; i++)
+            std::printf("  clip[%zu] %.63s %.2f s, %u channels\n", i, view.clips[i].name, view.clips[i].duration,
+                        view.clips[i].channelCount);
+        std::printf("  textures %llu @%llu (%llu bytes), dependencies %llu\n", (unsigned long long)h->textureCount,
+                    (unsigned long long)h->textureDataOffset, (unsigned long long)h->textureBytes,
+                    (unsigned long long)h->dependencyCount);
+        for (size_t i = 0; i < view.textureCount; i++) {
+            const TextureDesc& t = view.textures[i];
+            std::printf("  tex[%zu] %s %ux%u, %u mips, %.1f KiB\n", i, TextureFormatName(t.format), t.width, t.height,
+                        t.mipCount, (double)(t.mips[t.mipCount - 1].offset + t.mips[t.mipCount - 1].size - t.mips[0].offset) / 1024.0);
+        }
+    }
+    return failures ? 1 : 0;
+}
+
+static int BenchBatch(const std::string& arg) {
+    std::vector<MeshPart> parts;
+    char* end = nullptr;
+    unsigned long synthetic = std::strtoul(arg.c_str(), &end, 10);
+    if (end && *end == '\0' && synthetic > 0) {
+        MakeSyntheticParts(synthetic, parts);
+    } else {
+        std::string cachePath = EndsWith(arg, ".meshcache") ? arg : MeshCachePath(arg.c_str(), kDefaultImportFlags);
+        MeshCacheReader reader;
+        if (!reader.Open(cachePath, nullptr)) {
+            std::fprintf(stderr, "%s: no mesh cache, run 'meshcook cook' first\n", cachePath.c_str());
+            return 1;
+        }
+        parts.assign(reader.View().parts, reader.View().parts + reader.View().partCount);
+    }
+
+    DrawList list;
+    std::vector<uint8_t> visible(parts.size());
+    for (size_t i = 0; i < visible.size(); i++) visible[i] = (i % 4) != 0;
+
+    const int kIterations = 200;
+    BuildDrawList(parts.data(), parts.size(), nullptr, nullptr, list); // warm-up, cấp phát một lần
+    auto start = Clock::now();
+    for (int i = 0; i < kIterations; i++) BuildDrawList(parts.data(), parts.size(), nullptr, nullptr, list);
+    double allMs = MsSince(start) / kIterations;
+    size_t calls = list.CallCount(), commands = list.CommandCount();
+
+    start = Clock::now();
+    for (int i = 0; i < kIterations; i++) BuildDrawList(parts.data(), parts.size(), visible.data(), nullptr, list);
+    double partialMs = MsSince(start) / kIterations;
+
+    std::printf("parts %zu -> %zu multi-draw calls, %zu commands\n", parts.size(), calls, commands);
+    std::printf("  per-part path: %zu draw calls + %zu glUniform4f\n", parts.size(), parts.size());
+    std::printf("  build all visible   %.4f ms (%.1f ns/part)\n", allMs, allMs * 1e6 / (double)parts.size());
+    std::printf("  build 75%% visible   %.4f ms -> %zu commands\n", partialMs, list.CommandCount());
+    return 0;
+}
+
+static void PrintModeFigures(const char* label, const MeshData& mesh) {
+    SceneGraph scene;
+    scene.Build(mesh.View());
+    DrawList list;
+    BuildDrawList(mesh.parts.data(), mesh.parts.size(), nullptr, nullptr, list);
+
+    size_t geometryBytes = mesh.vertices.size() * sizeof(float) + mesh.indices.size();
+    size_t instanceBytes = scene.TotalInstances() * sizeof(glm::mat4);
+    size_t usedParts = 0;
+    for (size_t p = 0; p < mesh.parts.size(); p++) usedParts += scene.InstanceCount(p) > 0;
+
+    std::printf("  %-10s geometry %9.1f KiB + instances %8.1f KiB = %9.1f KiB | ", label,
+                geometryBytes / 1024.0, instanceBytes / 1024.0, (geometryBytes + instanceBytes) / 1024.0);
+    if (scene.IsFlattened())
+        std::printf("draws: per-part %zu, batched %zu multi-draw (%zu cmds)\n",
+                    mesh.parts.size(), list.CallCount(), list.CommandCount());
+    else
+        std::printf("draws: per-instance %zu, instanced %zu\n", scene.TotalInstances(), usedParts);
+}
+
+static int CompareInstancing(const std::string& arg) {
+    MeshData instanced, flattened;
+    char* end = nullptr;
+    unsigned long repeats = std::strtoul(arg.c_str(), &end, 10);
+    if (end && *end == '\0' && repeats > 0) {
+        MakeSyntheticScene(repeats, instanced);
+        FlattenScene(instanced, flattened);
+        std::printf("synthetic scene: %lu repeats of a %u-vertex mesh\n", repeats, instanced.parts[0].vertexCount);
+    } else {
+        MeshData raw;
+        std::string error;
+        if (!ImportModel(arg.c_str(), kDefaultImportFlags, raw, &error)) {
+            std::fprintf(stderr, "%s: import failed: %s\n", arg.c_str(), error.c_str());
+            return 1;
+        }
+        OptimizeMesh(raw, flattened);
+        if (!ImportModel(arg.c_str(), kInstancedImportFlags, raw, &error)) {
+            std::fprintf(stderr, "%s: import failed: %s\n", arg.c_str(), error.c_str());
+            return 1;
+        }
+        OptimizeMesh(raw, instanced);
+        std::printf("%s\n", arg.c_str());
+    }
+
+    PrintModeFigures("flattened", flattened);
+    PrintModeFigures("instanced", instanced);
+
+    // Chi phí cập nhật transform: toàn bộ vs một subtree dirty
+    SceneGraph scene;
+    scene.Build(instanced.View());
+    if (scene.NodeCount() > 1) {
+        const int kIterations = 100;
+        auto start = Clock::now();
+        for (int i = 0; i < kIterations; i++) {
+            scene.SetLocalTransform(0, scene.LocalTransform(0));
+            scene.UpdateWorldTransforms();
+        }
+        double fullMs = MsSince(start) / kIterations;
+
+        size_t leaf = scene.NodeCount() - 1;
+        start = Clock::now();
+        for (int i = 0; i < kIterations; i++) {
+            scene.SetLocalTransform(leaf, scene.LocalTransform(leaf));
+            scene.UpdateWorldTransforms();
+        }
+        double leafMs = MsSince(start) / kIterations;
+        std::printf("  world update: full tree %.4f ms (%zu nodes), one dirty leaf %.4f ms\n",
+                    fullMs, scene.NodeCount(), leafMs);
+    }
+    return 0;
+}
+
+// N box ngẫu nhiên trong khối 200^3, camera ở tâm quay một vòng: so sánh scalar / SIMD / BVH
+static int BenchCull(const std::string& arg) {
+    size_t count = std::strtoul(arg.c_str(), nullptr, 10);
+    if (count == 0) {
+        std::fprintf(stderr, "bench-cull: expected a box count\n");
+        return 1;
+    }
+
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f), extent(0.25f, 2.0f);
+    std::vector<AABB> boxes(count);
+    BoundsSoA soa;
+    soa.Resize(count);
+    for (size_t i = 0; i < count; i++) {
+        glm::vec3 c(position(rng), position(rng), position(rng));
+        glm::vec3 e(extent(rng), extent(rng), extent(rng));
+        boxes[i] = { c - e, c + e };
+        soa.Set(i, boxes[i]);
+    }
+
+    const int kFrames = 64;
+    glm::mat4 projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 150.0f);
+    std::vector<Frustum> frustums(kFrames);
+    for (int f = 0; f < kFrames; f++) {
+        float yaw = glm::two_pi<float>() * (float)f / (float)kFrames;
+        glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(std::sin(yaw), 0.2f, std::cos(yaw)), glm::vec3(0, 1, 0));
+        frustums[f] = Frustum::FromMatrix(projection * view);
+    }
+
+    std::vector<uint8_t> scalarVisible(count), simdVisible(count), bvhVisible;
+    size_t visibleTotal = 0, mismatches = 0;
+
+    auto start = Clock::now();
+    for (int f = 0; f < kFrames; f++) CullBoxesScalar(frustums[f], soa, 0, count, scalarVisible.data());
+    double scalarMs = MsSince(start) / kFrames;
+
+    start = Clock::now();
+    for (int f = 0; f < kFrames; f++) CullBoxes(frustums[f], soa, 0, count, simdVisible.data());
+    double simdMs = MsSince(start) / kFrames;
+
+    BoundsBVH bvh;
+    start = Clock::now();
+    bvh.Build(boxes);
+    double buildMs = MsSince(start);
+    start = Clock::now();
+    bvh.Refit(boxes);
+    double refitMs = MsSince(start);
+
+    start = Clock::now();
+    for (int f = 0; f < kFrames; f++) visibleTotal += bvh.Cull(frustums[f], bvhVisible);
+    double bvhMs = MsSince(start) / kFrames;
+
+    // Cả ba cách phải cho cùng kết quả
+    for (int f = 0; f < kFrames; f++) {
+        CullBoxesScalar(frustums[f], soa, 0, count, scalarVisible.data());
+        CullBoxes(frustums[f], soa, 0, count, simdVisible.data());
+        bvh.Cull(frustums[f], bvhVisible);
+        for (size_t i = 0; i < count; i++)
+            mismatches += (scalarVisible[i] != simdVisible[i]) + (scalarVisible[i] != bvhVisible[i]);
+    }
+
+    auto rate = [count](double ms) { return (double)count / (ms * 1e3); };
+    std::printf("boxes %zu, %d frames, avg %.1f%% visible, BVH %zu nodes (leaf %u)\n", count, kFrames,
+                100.0 * (double)visibleTotal / ((double)count * kFrames), bvh.NodeCount(), BoundsBVH::kLeafSize);
+    std::printf("  brute scalar %8.3f ms/frame (%6.1f Mbox/s)\n", scalarMs, rate(scalarMs));
+    std::printf("  brute %-6s %8.3f ms/frame (%6.1f Mbox/s, %.2fx)\n", CullSimdName(), simdMs, rate(simdMs), scalarMs / simdMs);
+    std::printf("  BVH          %8.3f ms/frame (%6.1f Mbox/s, %.2fx)\n", bvhMs, rate(bvhMs), scalarMs / bvhMs);
+    std::printf("  BVH build %.3f ms, refit %.3f ms\n", buildMs, refitMs);
+    std::printf("  mismatches vs scalar: %zu\n", mismatches);
+    return mismatches ? 1 : 0;
+}
+
+static int CheckLod(const std::string& arg) {
+    MeshData raw;
+    char* end = nullptr;
+    unsigned long segments = std::strtoul(arg.c_str(), &end, 10);
+    if (end && *end == '\0' && segments >= 4) {
+        MakeSphere((unsigned int)segments, raw);
+    } else {
+        std::string error;
+        if (!ImportModel(arg.c_str(), kDefaultImportFlags, raw, &error)) {
+            std::fprintf(stderr, "%s: import failed: %s\n", arg.c_str(), error.c_str());
+            return 1;
+        }
+    }
+
+    LodSettings settings;
+    MeshData first, second;
+    auto start = Clock::now();
+    OptimizeMesh(raw, first, nullptr, settings);
+    double optimizeMs = MsSince(start);
+    OptimizeMesh(raw, second, nullptr, settings);
+
+    bool deterministic = first.indices == second.indices && first.parts.size() == second.parts.size()
+        && std::memcmp(first.parts.data(), second.parts.data(), first.parts.size() * sizeof(MeshPart)) == 0;
+    std::printf("optimize + LOD %.1f ms, deterministic: %s\n", optimizeMs, deterministic ? "yes" : "NO");
+
+    int failures = deterministic ? 0 : 1;
+    std::vector<unsigned int> previous, current;
+    for (size_t p = 0; p < first.parts.size(); p++) {
+        const MeshPart& part = first.parts[p];
+        const float* vertices = first.vertices.data() + (size_t)part.baseVertex * kVertexFloatCount;
+        std::printf("  [%3zu] %u tris, radius %.4g, %u levels\n", p, part.indexCount / 3, part.sphere[3], PartLodCount(part));
+        ReadLodIndices(first, part, PartLod(part, 0), previous);
+        for (unsigned int l = 1; l < PartLodCount(part); l++) {
+            const MeshLod lod = PartLod(part, l);
+            ReadLodIndices(first, part, lod, current);
+            float ratio = (float)current.size() / (float)previous.size();
+            float measured = MeasureDeviation(vertices, part.vertexCount, kVertexFloatCount, current);
+            bool ok = ratio <= settings.minGain && lod.error <= settings.maxRelativeError * part.sphere[3] + 1e-6f
+                && lod.error >= PartLod(part, l - 1).error;
+            std::printf("        LOD %u: %7zu tris (x%.2f), error %.4g reported / %.4g measured %s\n", l, current.size() / 3,
+                        ratio, lod.error, measured, ok ? "" : "FAIL");
+            failures += ok ? 0 : 1;
+            previous.swap(current);
+        }
+    }
+
+    // Hysteresis: khoảng cách dao động ±2% quanh ngưỡng chuyển level, đếm số lần đổi level
+    for (const MeshPart& part : first.parts) {
+        if (PartLodCount(part) < 2) continue;
+        LodParams params;
+        params.pixelsPerUnit = 540.0f; // 1080p, fovY 90°
+        float boundary = PartLod(part, 1).error * params.pixelsPerUnit / params.threshold;
+        int switches[2] = { 0, 0 };
+        for (int withHysteresis = 0; withHysteresis < 2; withHysteresis++) {
+            params.hysteresis = withHysteresis ? LodParams().hysteresis : 1.0f;
+            unsigned int lod = 0;
+            for (int frame = 0; frame < 1000; frame++) {
+                float distance = boundary * (1.0f + 0.02f * std::sin((float)frame * 0.1f));
+                unsigned int next = SelectLod(part, 1.0f, distance, lod, params);
+                switches[withHysteresis] += next != lod;
+                lod = next;
+            }
+        }
+        std::printf("hysteresis: %d LOD switches without, %d with (1000 frames at +-2%% around the LOD 0/1 boundary)\n",
+                    switches[0], switches[1]);
+        break;
+    }
+    return failures ? 1 : 0;
+}
+
+// N aiMesh dạng lưới gồ ghề, kích thước khác nhau để các chunk nặng nhẹ không đều
+static void MakeSyntheticAiMeshes(size_t count, std::vector<std::unique_ptr<aiMesh>>& out) {
+    std::mt19937 rng(99);
+    std::uniform_int_distribution<unsigned int> side(4, 40);
+    std::uniform_real_distribution<float> noise(-0.05f, 0.05f);
+    out.clear();
+    for (size_t m = 0; m < count; m++) {
+        unsigned int w = side(rng), h = side(rng);
+        std::unique_ptr<aiMesh> mesh(new aiMesh());
+        mesh->mNumVertices = (w + 1) * (h + 1);
+        mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+        mesh->mTextureCoords[0] = new aiVector3D[mesh->mNumVertices];
+        mesh->mNumUVComponents[0] = 2;
+        for (unsigned int y = 0; y <= h; y++)
+            for (unsigned int x = 0; x <= w; x++) {
+                mesh->mVertices[y * (w + 1) + x] = aiVector3D((float)x, noise(rng), (float)y);
+                mesh->mTextureCoords[0][y * (w + 1) + x] = aiVector3D((float)x / w, (float)y / h, 0.0f);
+            }
+
+        // Mỗi ô 2 tam giác, thêm 1 face line để kiểm tra nhánh bỏ face không phải tam giác
+        mesh->mNumFaces = w * h * 2 + 1;
+        mesh->mFaces = new aiFace[mesh->mNumFaces];
+        unsigned int f = 0;
+        auto setFace = [&](std::initializer_list<unsigned int> indices) {
+            aiFace& face = mesh->mFaces[f++];
+            face.mNumIndices = (unsigned int)indices.size();
+            face.mIndices = new unsigned int[indices.size()];
+            std::copy(indices.begin(), indices.end(), face.mIndices);
+        };
+        for (unsigned int y = 0; y < h; y++) {
+            for (unsigned int x = 0; x < w; x++) {
+                unsigned int i0 = y * (w + 1) + x, i1 = i0 + 1, i2 = i0 + w + 1, i3 = i2 + 1;
+                setFace({ i0, i2, i1 });
+                setFace({ i1, i2, i3 });
+            }
+        }
+        setFace({ 0, 1 });
+        out.push_back(std::move(mesh));
+    }
+}
+
+// Bản tuần tự cũ của vòng chuyển đổi (push_back từng phần tử), làm chuẩn để so kết quả
+static void ConvertMeshesReference(const std::vector<std::unique_ptr<aiMesh>>& meshes, MeshData& out) {
+    std::vector<unsigned int> indices;
+    out = MeshData();
+    unsigned int currentVertexOffset = 0;
+    for (const std::unique_ptr<aiMesh>& mesh : meshes) {
+        MeshPart part = {};
+        part.indexOffset = (unsigned int)(indices.size() * sizeof(unsigned int));
+        part.baseVertex = currentVertexOffset;
+        part.vertexCount = mesh->mNumVertices;
+        part.indexSize = sizeof(unsigned int);
+        part.color[0] = part.color[1] = part.color[2] = 0.8f;
+        part.color[3] = 1.0f;
+        part.textureIndex = -1;
+        for (unsigned int j = 0; j < mesh->mNumVertices; j++) {
+            out.vertices.push_back(mesh->mVertices[j].x);
+            out.vertices.push_back(mesh->mVertices[j].y);
+            out.vertices.push_back(mesh->mVertices[j].z);
+            out.vertices.push_back(mesh->mTextureCoords[0] ? mesh->mTextureCoords[0][j].x : 0.0f);
+            out.vertices.push_back(mesh->mTextureCoords[0] ? mesh->mTextureCoords[0][j].y : 0.0f);
+        }
+        size_t firstIndex = indices.size();
+        for (unsigned int j = 0; j < mesh->mNumFaces; j++) {
+            const aiFace& face = mesh->mFaces[j];
+            if (face.mNumIndices != 3) continue;
+            for (unsigned int k = 0; k < face.mNumIndices; k++) indices.push_back(face.mIndices[k]);
+        }
+        part.indexCount = (unsigned int)(indices.size() - firstIndex);
+        out.parts.push_back(part);
+        currentVertexOffset += mesh->mNumVertices;
+    }
+    out.indices.resize(indices.size() * sizeof(unsigned int));
+    if (!indices.empty()) std::memcpy(out.indices.data(), indices.data(), out.indices.size());
+}
+
+static bool SameMesh(const MeshData& a, const MeshData& b) {
+    return a.vertices == b.vertices && a.indices == b.indices && a.parts.size() == b.parts.size() &&
+           (a.parts.empty() || std::memcmp(a.parts.data(), b.parts.data(), a.parts.size() * sizeof(MeshPart)) == 0);
+}
+
+// Thời gian ConvertMeshes / OptimizeMesh với pool 1, 2, 4, ... N thread; output phải giống hệt bản tuần tự.
+// Kiểm tra OptimizeMesh không phụ thuộc số thread: renderer_tests job-system.
+static int BenchJobs(const std::string& arg) {
+    size_t count = arg.empty() ? 4000 : std::strtoul(arg.c_str(), nullptr, 10);
+    if (count == 0) {
+        std::fprintf(stderr, "bench-jobs: expected a mesh count\n");
+        return 1;
+    }
+
+    std::vector<std::unique_ptr<aiMesh>> meshes;
+    MakeSyntheticAiMeshes(count, meshes);
+    std::vector<const aiMesh*> meshPointers;
+    for (const std::unique_ptr<aiMesh>& mesh : meshes) meshPointers.push_back(mesh.get());
+
+    const int kIterations = 5;
+    auto start = Clock::now();
+    MeshData reference;
+    for (int i = 0; i < kIterations; i++) ConvertMeshesReference(meshes, reference);
+    double referenceMs = MsSince(start) / kIterations;
+    std::printf("meshes %zu, vertices %zu, triangles %zu\n", count, reference.vertices.size() / kVertexFloatCount,
+                reference.indices.size() / sizeof(unsigned int) / 3);
+    std::printf("  serial push_back reference  %8.3f ms\n", referenceMs);
+
+    // Optimize (weld + cache + LOD) nặng hơn nhiều -> chỉ lấy một phần số mesh
+    MeshData optimizeInput;
+    ConvertMeshes(meshPointers.data(), (unsigned int)std::min<size_t>(count, 500), optimizeInput);
+    MeshData optimizeReference;
+    {
+        JobSystem serial(1);
+        OptimizeMesh(optimizeInput, optimizeReference, nullptr, LodSettings(), serial);
+    }
+
+    std::vector<unsigned int> threadCounts;
+    unsigned int maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned int t = 1; t < maxThreads; t *= 2) threadCounts.push_back(t);
+    threadCounts.push_back(maxThreads);
+
+    int failures = 0;
+    double convertBase = 0.0, optimizeBase = 0.0;
+    for (unsigned int threads : threadCounts) {
+        JobSystem jobs(threads);
+        MeshData converted, optimized;
+
+        start = Clock::now();
+        for (int i = 0; i < kIterations; i++) ConvertMeshes(meshPointers.data(), (unsigned int)count, converted, jobs);
+        double convertMs = MsSince(start) / kIterations;
+
+        start = Clock::now();
+        OptimizeMesh(optimizeInput, optimized, nullptr, LodSettings(), jobs);
+        double optimizeMs = MsSince(start);
+
+        if (threads == 1) {
+            convertBase = convertMs;
+            optimizeBase = optimizeMs;
+        }
+        bool same = SameMesh(converted, reference) && SameMesh(optimized, optimizeReference);
+        failures += !same;
+        std::printf("  %2u threads: convert %8.3f ms (%.2fx), optimize %zu parts %8.1f ms (%.2fx)%s\n", threads,
+                    convertMs, convertBase / convertMs, optimizeInput.parts.size(), optimizeMs, optimizeBase / optimizeMs,
+                    same ? "" : "  MISMATCH");
+    }
+    return failures ? 1 : 0;
+}
+
+// Decode (nếu là file), mip chain và nén BC1/BC3 với pool 1, 2, 4, ... N thread; chất lượng và dung lượng.
+// Ngưỡng chất lượng của codec: renderer_tests texture-codec.
+static int BenchTexture(const std::string& arg) {
+    std::vector<unsigned char> fileBytes;
+    Image source;
+    bool fromFile = !arg.empty() && !std::all_of(arg.begin(), arg.end(), ::isdigit);
+    if (fromFile) {
+        FILE* f = std::fopen(arg.c_str(), "rb");
+        if (!f) {
+            std::fprintf(stderr, "bench-texture: cannot open %s\n", arg.c_str());
+            return 1;
+        }
+        std::fseek(f, 0, SEEK_END);
+        fileBytes.resize((size_t)std::ftell(f));
+        std::fseek(f, 0, SEEK_SET);
+        size_t read = std::fread(fileBytes.data(), 1, fileBytes.size(), f);
+        std::fclose(f);
+        std::string error;
+        if (read != fileBytes.size() || !DecodeImage(fileBytes.data(), fileBytes.size(), source, &error)) {
+            std::fprintf(stderr, "bench-texture: %s: %s\n", arg.c_str(), error.c_str());
+            return 1;
+        }
+    } else {
+        unsigned int size = arg.empty() ? 2048 : (unsigned int)std::strtoul(arg.c_str(), nullptr, 10);
+        if (size < 4) {
+            std::fprintf(stderr, "bench-texture: expected an image file or a size >= 4\n");
+            return 1;
+        }
+        MakeSyntheticImage(size, false, source);
+    }
+    Image sourceAlpha;
+    if (fromFile) sourceAlpha = source;
+    else MakeSyntheticImage(source.width, true, sourceAlpha);
+
+    const double mpix = (double)source.width * source.height / 1e6;
+    std::printf("image %ux%u (%s), %u mips, alpha %s\n", source.width, source.height, fromFile ? arg.c_str() : "synthetic",
+                MipCount(source.width, source.height), ImageHasAlpha(source) ? "yes" : "no");
+
+    std::vector<unsigned int> threadCounts;
+    unsigned int maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned int t = 1; t < maxThreads; t *= 2) threadCounts.push_back(t);
+    threadCounts.push_back(maxThreads);
+
+    // Nhiều file decode song song (mỗi job một ảnh), như lúc import
+    const size_t kDecodeCount = 8;
+    std::vector<unsigned char> bc1(TextureLevelBytes(TextureFormat::BC1, source.width, source.height));
+    std::vector<unsigned char> bc3(TextureLevelBytes(TextureFormat::BC3, source.width, source.height));
+    for (unsigned int threads : threadCounts) {
+        JobSystem jobs(threads);
+        char decode[64] = "";
+        if (fromFile) {
+            std::vector<Image> decoded(kDecodeCount);
+            auto start = Clock::now();
+            jobs.ParallelFor(kDecodeCount, 1, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; i++) DecodeImage(fileBytes.data(), fileBytes.size(), decoded[i]);
+            });
+            std::snprintf(decode, sizeof(decode), "decode %7.1f MPix/s, ", mpix * kDecodeCount / (MsSince(start) / 1000.0));
+        }
+
+        auto start = Clock::now();
+        Image level = source, next;
+        double mipPixels = 0.0;
+        while (level.width > 1 || level.height > 1) {
+            DownsampleImage(level, next, jobs);
+            mipPixels += (double)level.width * level.height / 1e6;
+            std::swap(level, next);
+        }
+        double mipMs = MsSince(start);
+
+        start = Clock::now();
+        EncodeImage(source, TextureFormat::BC1, bc1.data(), jobs);
+        double bc1Ms = MsSince(start);
+        start = Clock::now();
+        EncodeImage(sourceAlpha, TextureFormat::BC3, bc3.data(), jobs);
+        double bc3Ms = MsSince(start);
+
+        std::printf("  %2u threads: %smips %7.1f MPix/s, BC1 %7.1f MPix/s, BC3 %7.1f MPix/s\n", threads, decode,
+                    mipPixels / (mipMs / 1000.0), mpix / (bc1Ms / 1000.0), mpix / (bc3Ms / 1000.0));
+    }
+
+    Image decoded;
+    DecodeTextureLevel(bc1.data(), TextureFormat::BC1, source.width, source.height, decoded);
+    double bc1Psnr = ImagePsnr(source, decoded, 3);
+    DecodeTextureLevel(bc3.data(), TextureFormat::BC3, source.width, source.height, decoded);
+    double bc3Psnr = ImagePsnr(sourceAlpha, decoded, 3), alphaPsnr = 0.0;
+    {
+        // PSNR riêng kênh alpha: dời alpha về kênh 0
+        Image a = sourceAlpha, b = decoded;
+        for (size_t i = 0; i < a.rgba.size(); i += 4) {
+            a.rgba[i] = a.rgba[i + 3];
+            b.rgba[i] = b.rgba[i + 3];
+        }
+        alphaPsnr = ImagePsnr(a, b, 1);
+    }
+    std::printf("  quality level 0: BC1 RGB %.2f dB, BC3 RGB %.2f dB, BC3 alpha %.2f dB\n", bc1Psnr, bc3Psnr, alphaPsnr);
+
+    TextureDesc rawDesc, bcDesc;
+    std::vector<unsigned char> rawBlob, bcBlob;
+    CookTexture(source, rawDesc, rawBlob, false);
+    CookTexture(source, bcDesc, bcBlob, true);
+    std::printf("  mip chain: RGBA8 %.1f KiB, %s %.1f KiB (%.1fx smaller)\n", rawBlob.size() / 1024.0,
+                TextureFormatName(bcDesc.format), bcBlob.size() / 1024.0, (double)rawBlob.size() / bcBlob.size());
+    return 0;
+}
+
+// Lấy mẫu có cache key so với binary search, pose nhiều nhân vật theo số thread (xương/ms),
+// CPU skinning scalar vs SIMD vs song song (vertex/ms). Độ đúng của cache key / SIMD: renderer_tests skinning.
+static int BenchSkin(const std::string& arg) {
+    MeshData mesh;
+    size_t characterCount = 1000;
+    char* end = nullptr;
+    unsigned long count = std::strtoul(arg.c_str(), &end, 10);
+    const bool fromModel = !arg.empty() && !(end && *end == '\0');
+    if (fromModel) {
+        MeshData raw;
+        std::string error;
+        if (!ImportModel(arg.c_str(), kDefaultImportFlags, raw, &error)) {
+            std::fprintf(stderr, "bench-skin: %s: %s\n", arg.c_str(), error.c_str());
+            return 1;
+        }
+        OptimizeMesh(raw, mesh);
+        characterCount = 256;
+    } else {
+        if (!arg.empty()) characterCount = count;
+        if (characterCount == 0) {
+            std::fprintf(stderr, "bench-skin: expected a model or a character count\n");
+            return 1;
+        }
+        MakeSyntheticCharacter(60, 20000, mesh);
+    }
+    const MeshView view = mesh.View();
+
+    AnimationRig rig;
+    rig.Build(view);
+    if (rig.ClipCount() == 0 && rig.JointCount() == 0) {
+        std::fprintf(stderr, "bench-skin: %s has no animation or skin\n", arg.c_str());
+        return 1;
+    }
+    std::vector<float> skinSource;
+    std::vector<VertexSkin> skinWeights;
+    std::vector<unsigned int> skinnedBase;
+    const size_t vertexCount = GatherSkinnedVertices(view, skinSource, skinWeights, skinnedBase);
+    std::printf("%s: %zu nodes, %zu joints, %zu clips, %zu keys, %zu skinned vertices, SIMD %s\n",
+                fromModel ? arg.c_str() : "synthetic character", rig.NodeCount(), rig.JointCount(), rig.ClipCount(),
+                view.keyCount, vertexCount, SkinSimdName());
+
+    // 1. Key cache so với binary search
+    if (rig.ClipCount() > 0) {
+        LocalPose cached = rig.BindPose(), reference = rig.BindPose();
+        const int kSamples = 2000;
+        AnimationCursor cursor;
+        cursor.clip = 0;
+        auto start = Clock::now();
+        for (int i = 0; i < kSamples; i++) {
+            rig.Advance(cursor, 1.0f / 60.0f);
+            rig.Sample(cursor, cached);
+        }
+        double cachedUs = MsSince(start) * 1000.0 / kSamples;
+        float time = 0.0f;
+        const float duration = std::max(rig.Clip(0).duration, 1e-3f);
+        start = Clock::now();
+        for (int i = 0; i < kSamples; i++) {
+            time = std::fmod(time + 1.0f / 60.0f, duration);
+            rig.SampleReference(0, time, reference);
+        }
+        double searchUs = MsSince(start) * 1000.0 / kSamples;
+        std::printf("  sample clip 0: cached keys %8.2f us, binary search %8.2f us per pose (%.2fx)\n", cachedUs,
+                    searchUs, searchUs / cachedUs);
+    }
+
+    std::vector<unsigned int> threadCounts;
+    const unsigned int maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned int t = 1; t < maxThreads; t *= 2) threadCounts.push_back(t);
+    threadCounts.push_back(maxThreads);
+
+    // 2. Pose + palette cho nhiều nhân vật, lệch pha nhau, trộn 2 clip
+    std::vector<CharacterAnimation> characters(characterCount);
+    for (size_t i = 0; i < characterCount && rig.ClipCount() > 0; i++) {
+        CharacterAnimation& c = characters[i];
+        c.base.clip = 0;
+        c.base.time = rig.Clip(0).duration * (float)i / (float)characterCount;
+        c.blend.clip = rig.ClipCount() > 1 ? 1 : 0;
+        c.blendWeight = 0.5f;
+    }
+    std::vector<glm::mat4> world(characterCount * rig.NodeCount());
+    std::vector<glm::mat4> palette(characterCount * std::max<size_t>(rig.JointCount(), 1));
+    const int kFrames = 10;
+    const double boneCount = (double)characterCount * rig.NodeCount() * kFrames;
+    for (unsigned int threads : threadCounts) {
+        JobSystem jobs(threads);
+        auto start = Clock::now();
+        for (int f = 0; f < kFrames; f++)
+            rig.Evaluate(characters.data(), characterCount, 1.0f / 60.0f, nullptr, world.data(), palette.data(), jobs);
+        double ms = MsSince(start);
+        std::printf("  %2u threads: pose %zu characters %8.3f ms/frame, %10.0f bones/ms\n", threads, characterCount,
+                    ms / kFrames, boneCount / ms);
+    }
+
+    // 3. Skinning theo palette của nhân vật 0
+    if (vertexCount > 0) {
+        std::vector<float> scalarOut(skinSource.size()), simdOut(skinSource.size());
+        const int kIterations = 20;
+        auto start = Clock::now();
+        for (int i = 0; i < kIterations; i++)
+            SkinVerticesScalar(skinSource.data(), skinWeights.data(), vertexCount, palette.data(), scalarOut.data());
+        double scalarMs = MsSince(start) / kIterations;
+        start = Clock::now();
+        for (int i = 0; i < kIterations; i++)
+            SkinVertices(skinSource.data(), skinWeights.data(), vertexCount, palette.data(), simdOut.data());
+        double simdMs = MsSince(start) / kIterations;
+
+        std::printf("  skin %zu vertices: scalar %8.3f ms (%10.0f vertices/ms), %s %8.3f ms (%10.0f vertices/ms)\n",
+                    vertexCount, scalarMs, vertexCount / scalarMs, SkinSimdName(), simdMs, vertexCount / simdMs);
+
+        for (unsigned int threads : threadCounts) {
+            JobSystem jobs(threads);
+            start = Clock::now();
+            for (int i = 0; i < kIterations; i++)
+                SkinVerticesParallel(skinSource.data(), skinWeights.data(), vertexCount, palette.data(), simdOut.data(), jobs);
+            double ms = MsSince(start) / kIterations;
+            std::printf("  %2u threads: skin %8.3f ms, %10.0f vertices/ms\n", threads, ms, vertexCount / ms);
+        }
+    }
+    return 0;
+}
+
+// Normal mượt (trọng số diện tích) và tangent theo UV của LOD 0, cho phần đo sai số normal / tangent
+static void ComputeNormalsTangents(const MeshData& mesh, std::vector<float>& normals, std::vector<float>& tangents) {
+    const size_t vertexCount = mesh.vertices.size() / kVertexFloatCount;
+    normals.assign(vertexCount * 3, 0.0f);
+    std::vector<float> tan(vertexCount * 3, 0.0f), bitan(vertexCount * 3, 0.0f);
+    std::vector<unsigned int> indices;
+    for (const MeshPart& part : mesh.parts) {
+        ReadLodIndices(mesh, part, PartLod(part, 0), indices);
+        for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+            const unsigned int v[3] = { part.baseVertex + indices[t], part.baseVertex + indices[t + 1],
+                                        part.baseVertex + indices[t + 2] };
+            const float* p[3];
+            for (int k = 0; k < 3; k++) p[k] = &mesh.vertices[(size_t)v[k] * kVertexFloatCount];
+            const glm::vec3 e1 = glm::make_vec3(p[1]) - glm::make_vec3(p[0]), e2 = glm::make_vec3(p[2]) - glm::make_vec3(p[0]);
+            const glm::vec3 n = glm::cross(e1, e2);
+            const float du1 = p[1][3] - p[0][3], dv1 = p[1][4] - p[0][4], du2 = p[2][3] - p[0][3], dv2 = p[2][4] - p[0][4];
+            const float det = du1 * dv2 - du2 * dv1;
+            const glm::vec3 sdir = std::fabs(det) > 1e-12f ? (e1 * dv2 - e2 * dv1) / det : glm::vec3(0.0f);
+            const glm::vec3 tdir = std::fabs(det) > 1e-12f ? (e2 * du1 - e1 * du2) / det : glm::vec3(0.0f);
+            for (int k = 0; k < 3; k++)
+                for (int c = 0; c < 3; c++) {
+                    normals[(size_t)v[k] * 3 + c] += n[c];
+                    tan[(size_t)v[k] * 3 + c] += sdir[c];
+                    bitan[(size_t)v[k] * 3 + c] += tdir[c];
+                }
+        }
+    }
+    tangents.assign(vertexCount * 4, 0.0f);
+    for (size_t v = 0; v < vertexCount; v++) {
+        glm::vec3 n = glm::make_vec3(&normals[v * 3]);
+        n = glm::length(n) > 0.0f ? glm::normalize(n) : glm::vec3(0.0f, 0.0f, 1.0f);
+        glm::vec3 t = glm::make_vec3(&tan[v * 3]);
+        t -= n * glm::dot(n, t); // Gram-Schmidt
+        if (glm::length(t) < 1e-6f) t = glm::normalize(glm::cross(n, std::fabs(n.x) < 0.9f ? glm::vec3(1, 0, 0) : glm::vec3(0, 1, 0)));
+        t = glm::normalize(t);
+        const float w = glm::dot(glm::cross(n, t), glm::make_vec3(&bitan[v * 3])) < 0.0f ? -1.0f : 1.0f;
+        for (int c = 0; c < 3; c++) {
+            normals[v * 3 + c] = n[c];
+            tangents[v * 4 + c] = t[c];
+        }
+        tangents[v * 4 + 3] = w;
+    }
+}
+
+// Trên model (hoặc mặt cầu N ô) đã OptimizeMesh: byte / vertex của từng định dạng, sai số position lớn nhất
+// (tuyệt đối và theo cạnh AABB của part), UV, normal / tangent octahedral. Encoder tự kiểm trong renderer_tests.
+static int CheckVertex(const std::string& arg) {
+    int failures = 0;
+
+    MeshData raw, mesh;
+    char* end = nullptr;
+    unsigned long segments = arg.empty() ? 256 : std::strtoul(arg.c_str(), &end, 10);
+    if (arg.empty() || (end && *end == '\0' && segments >= 4)) {
+        MakeSphere((unsigned int)segments, raw);
+    } else {
+        std::string error;
+        if (!ImportModel(arg.c_str(), kDefaultImportFlags, raw, &error)) {
+            std::fprintf(stderr, "%s: import failed: %s\n", arg.c_str(), error.c_str());
+            return 1;
+        }
+    }
+    LodSettings settings;
+    settings.maxLevels = 1;
+    OptimizeMesh(raw, mesh, nullptr, settings);
+    const MeshView view = mesh.View();
+
+    auto start = Clock::now();
+    std::vector<QuantizedVertex> quantized;
+    QuantizeMesh(view, quantized);
+    const double quantizeMs = MsSince(start);
+
+    // Giải như vertex shader: offset + (q / 65535) * extent từ buffer hằng số của part
+    std::vector<float> decode;
+    BuildPositionDecodeBuffer(mesh.parts.data(), mesh.parts.size(), decode);
+    double maxPosition = 0.0, maxRelative = 0.0, maxUV = 0.0;
+    size_t uvAboveBound = 0;
+    for (size_t p = 0; p < mesh.parts.size(); p++) {
+        const MeshPart& part = mesh.parts[p];
+        const float* offset = &decode[p * 8];
+        const float* scale = &decode[p * 8 + 4];
+        const float largest = std::max({ scale[0], scale[1], scale[2], 1e-20f });
+        for (unsigned int v = part.baseVertex; v < part.baseVertex + part.vertexCount; v++) {
+            const float* src = &mesh.vertices[(size_t)v * kVertexFloatCount];
+            const QuantizedVertex& q = quantized[v];
+            for (int k = 0; k < 3; k++) {
+                const double error = std::fabs(offset[k] + (q.position[k] / 65535.0f) * scale[k] - src[k]);
+                maxPosition = std::max(maxPosition, error);
+                maxRelative = std::max(maxRelative, error / largest);
+            }
+            for (int k = 0; k < 2; k++) {
+                const double error = std::fabs((double)HalfToFloat(q.uv[k]) - src[3 + k]);
+                maxUV = std::max(maxUV, error);
+                uvAboveBound += error > std::max(std::fabs(src[3 + k]) * std::exp2(-11.0), std::exp2(-25.0));
+            }
+        }
+    }
+
+    std::vector<float> normals, tangents;
+    ComputeNormalsTangents(mesh, normals, tangents);
+    double normalError[2] = { 0.0, 0.0 }, tangentError[2] = { 0.0, 0.0 };
+    const unsigned int octBits[2] = { 16, 8 };
+    for (size_t v = 0; v < view.vertexCount; v++) {
+        for (int b = 0; b < 2; b++) {
+            int16_t encoded[2];
+            uint16_t lane = 0;
+            float decoded[4];
+            OctEncode(&normals[v * 3], octBits[b], encoded);
+            OctDecode(encoded, octBits[b], decoded);
+            normalError[b] = std::max(normalError[b], AngleDegrees(&normals[v * 3], decoded));
+            PackTangent(&tangents[v * 4], octBits[b], encoded, lane);
+            UnpackTangent(encoded, lane, octBits[b], decoded);
+            tangentError[b] = std::max(tangentError[b], decoded[3] != tangents[v * 4 + 3] ? 180.0 : AngleDegrees(&tangents[v * 4], decoded));
+        }
+    }
+
+    std::printf("%zu parts, %zu vertices, quantized in %.2f ms\n", mesh.parts.size(), view.vertexCount, quantizeMs);
+    std::printf("  %-10s %6s %10s %14s %14s %10s\n", "format", "B/vtx", "VBO KiB", "max pos err", "rel to AABB", "max UV err");
+    for (VertexFormat format : { VertexFormat::Float, VertexFormat::Quantized }) {
+        const bool q = format == VertexFormat::Quantized;
+        std::printf("  %-10s %6u %10.1f %14.3g %14.3g %10.3g\n", VertexFormatName(format), VertexFormatStride(format),
+                    view.vertexCount * VertexFormatStride(format) / 1024.0, q ? maxPosition : 0.0, q ? maxRelative : 0.0,
+                    q ? maxUV : 0.0);
+    }
+    std::printf("  normal / tangent (computed from LOD 0, not stored yet): float 12 / 16 B\n");
+    for (int b = 0; b < 2; b++)
+        std::printf("    octahedral %2ux2 bit: %u B normal + %u B tangent, max error %.4f / %.4f deg\n", octBits[b],
+                    octBits[b] / 4, octBits[b] / 4, normalError[b], tangentError[b]);
+
+    // Sai số position đã đo phải nằm trong nửa bước lượng tử (+ float) của part lớn nhất
+    const bool positionOk = maxRelative <= 0.51 / 65535.0 + 1e-6;
+    const bool uvOk = uvAboveBound == 0; // nửa ulp của half
+    if (!positionOk || !uvOk) {
+        std::printf("  FAIL: position or UV error above the quantization bound\n");
+        failures++;
+    }
+    std::printf("%d failures\n", failures);
+    return failures ? 1 : 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc == 2 && std::strcmp(argv[1], "bench-jobs") == 0) return BenchJobs("");
+    if (argc == 2 && std::strcmp(argv[1], "bench-texture") == 0) return BenchTexture("");
+    if (argc == 2 && std::strcmp(argv[1], "bench-skin") == 0) return BenchSkin("");
+    if (argc == 2 && std::strcmp(argv[1], "check-vertex") == 0) return CheckVertex("");
+    if (argc < 3) {
+        PrintUsage();
+        return 1;
+    }
+
+    std::string command = argv[1];
+    std::vector<std::string> files;
+    bool force = false;
+    for (int i = 2; i < argc; i++) {
+        if (std::strcmp(argv[i], "--force") == 0) force = true;
+        else files.push_back(argv[i]);
+    }
+
+    if (command == "cook") return Cook(files, force);
+    if (command == "inspect") return Inspect(files);
+    if (command == "bench-batch" && !files.empty()) return BenchBatch(files[0]);
+    if (command == "compare-instancing" && !files.empty()) return CompareInstancing(files[0]);
+    if (command == "bench-cull" && !files.empty()) return BenchCull(files[0]);
+    if (command == "check-lod" && !files.empty()) return CheckLod(files[0]);
+    if (command == "bench-jobs") return BenchJobs(files.empty() ? "" : files[0]);
+    if (command == "bench-texture") return BenchTexture(files.empty() ? "" : files[0]);
+    if (command == "bench-skin") return BenchSkin(files.empty() ? "" : files[0]);
+    if (command == "check-vertex") return CheckVertex(files.empty() ? "" : files[0]);
+
+    PrintUsage();
+    return 1;
+}